@@ -45,6 +45,7 @@ def cjson_object_hook(pairs):
 class CTranspiler:
     def __init__(self, api_info, ui_spec_data):
         self.api_info = api_info
+        self._enum_member_names = None # Built on first use
         self.ui_spec_data = ui_spec_data # This will be CJSONObject or list of CJSONObjects
         
         self.c_obj_vars = {}    # For lv_obj_t* : { "json_id": "c_var_name", ... }
@@ -100,6 +101,16 @@ class CTranspiler:
             self._add_decl(f"    {c_type} {c_var_name};")
             self.declared_c_vars_in_func.add(c_var_name)
 
+    def _is_known_symbol(self, s_val):
+        """True if s_val is a known LVGL enum/define that can be emitted as is."""
+        if self.api_info and 'hashed_and_sorted_enum_members' in self.api_info:
+            if self._enum_member_names is None:
+                self._enum_member_names = {member['name'] for member in self.api_info['hashed_and_sorted_enum_members']}
+            return s_val in self._enum_member_names
+        # Heuristic: if it looks like a C define/enum, pass it through raw.
+        # This is risky if a string literal happens to match this pattern.
+        return bool(re.fullmatch(r"LV_[A-Z0-9_]+", s_val) or re.fullmatch(r"[A-Z_][A-Z0-9_]*", s_val))
+
     def _format_c_value(self, json_value_node, expected_c_type, current_entity_c_var, current_context):
         """
         Converts a JSON node to a C literal string or C variable name/expression.
@@ -208,22 +219,12 @@ class CTranspiler:
                     logger.warning(f"Invalid percentage string: {s_val}. Treating as literal string.")
                     return f"\"{s_val}\"" 
 
-            # Check if it's a known LVGL enum/define (symbol)
-            # This requires api_info to have a list of all such symbols.
-            # For now, assume if it's all caps or LV_ prefixed, it's a symbol.
-            # A more robust check would use self.api_info.
-            is_known_symbol = False
-            if self.api_info and 'hashed_and_sorted_enum_members' in self.api_info:
-                 if any(member['name'] == s_val for member in self.api_info['hashed_and_sorted_enum_members']):
-                    is_known_symbol = True
-            elif re.fullmatch(r"LV_[A-Z0-9_]+", s_val) or re.fullmatch(r"[A-Z_][A-Z0-9_]*", s_val):
-                 # Heuristic: if it looks like a C define/enum, pass it through raw.
-                 # This is risky if a string literal happens to match this pattern.
-                 # logger.debug(f"Assuming '{s_val}' is an LVGL symbol/enum.")
-                 is_known_symbol = True # Tentatively
-
-            if is_known_symbol:
+            if self._is_known_symbol(s_val):
                 return s_val 
+            # Flag combination like the runtime renderer's: "LV_PART_INDICATOR|LV_STATE_PRESSED"
+            operands = [part.strip() for part in s_val.split('|')]
+            if len(operands) > 1 and all(self._is_known_symbol(op) or re.fullmatch(r"-?(0x[0-9a-fA-F]+|[0-9]+)", op) for op in operands):
+                return "(" + " | ".join(operands) + ")"
             else: 
                 escaped_s = s_val.replace('\\', '\\\\').replace('"', '\\"').replace('\n', '\\n')
                 return f"\"{escaped_s}\""
@@ -239,6 +240,9 @@ class CTranspiler:
                 # Declare as static const because it's usually for grid descriptors
                 self._add_decl(f"    static const lv_coord_t {array_var_name}[] = {{ {', '.join(c_array_elements)} }};")
                 return array_var_name 
+            elif "*" not in expected_c_type and json_value_node and all(isinstance(item, (str, int)) and not isinstance(item, bool) for item in json_value_node):
+                # Flag list, ORed like "A|B"
+                return "(" + " | ".join(self._format_c_value(item, expected_c_type, current_entity_c_var, current_context) for item in json_value_node) + ")"
             else: # Generic array - not directly supported for C literals this way
                   # For function args, each element would be formatted.
                   # This path is for when a list IS the value, e.g. for a single arg.
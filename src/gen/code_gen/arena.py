@@ -0,0 +1,197 @@
+# code_gen/arena.py
+import logging
+
+logger = logging.getLogger(__name__)
+
+
+def generate_render_arena():
+    """
+    Generates the render pass arena and the internal scratch allocator interface.
+
+    Transient data of a render pass (cJSON nodes copied or parsed while rendering, log strings,
+    stream and binary views) is bump-allocated from chunks that are kept and reused by the next
+    pass, so a pass ends in O(1) and a steady state renders without touching the heap. cJSON is
+    routed through the arena with cJSON_InitHooks() while a pass runs; the outermost pass
+    installs the hooks and restores the application's allocator (LVGL_JSON_CJSON_MALLOC/FREE)
+    when it ends. Frees of arena memory are no-ops.
+    """
+    return r"""
+// --- Render Pass Arena ---
+// Anything that outlives a pass (registry entries, component definitions, grid descriptors,
+// setter cache keys) is allocated with LV_MALLOC or inside render_arena_suspend()/resume().
+
+#ifndef LVGL_JSON_RENDER_ARENA
+#define LVGL_JSON_RENDER_ARENA 1
+#endif
+#ifndef LVGL_JSON_ARENA_CHUNK_SIZE
+#define LVGL_JSON_ARENA_CHUNK_SIZE 4096
+#endif
+// The application's cJSON allocator, restored when a render pass ends and used for cJSON memory
+// that outlives a pass. It must match the hooks the application installs (cJSON's defaults).
+#ifndef LVGL_JSON_CJSON_MALLOC
+#define LVGL_JSON_CJSON_MALLOC malloc
+#define LVGL_JSON_CJSON_FREE free
+#endif
+
+#define RENDER_ARENA_ALIGN 8u
+#define RENDER_ARENA_ALIGN_UP(n) (((n) + (RENDER_ARENA_ALIGN - 1)) & ~(size_t)(RENDER_ARENA_ALIGN - 1))
+
+typedef struct render_arena_chunk_s {
+    struct render_arena_chunk_s *next;
+    size_t capacity;
+    size_t used;
+} render_arena_chunk_t;
+
+#define RENDER_ARENA_CHUNK_HEADER RENDER_ARENA_ALIGN_UP(sizeof(render_arena_chunk_t))
+#define RENDER_ARENA_CHUNK_DATA(chunk) ((uint8_t *)(chunk) + RENDER_ARENA_CHUNK_HEADER)
+
+typedef struct {
+    render_arena_chunk_t *head;     // All chunks; kept across passes
+    render_arena_chunk_t *current;  // Chunk being filled, NULL before the first allocation
+    int depth;                      // Nesting of render passes
+    int suspended;                  // Persistent allocations in progress
+    size_t bytes_in_use;
+    size_t chunk_bytes;
+} render_arena_t;
+
+typedef struct {
+    render_arena_chunk_t *chunk;
+    size_t used;
+    size_t bytes_in_use;
+} render_arena_mark_t;
+
+static render_arena_t g_render_arena;
+
+static bool render_arena_active(void) {
+    return LVGL_JSON_RENDER_ARENA && g_render_arena.depth > 0 && g_render_arena.suspended == 0;
+}
+
+static void* render_arena_alloc(size_t size) {
+    render_arena_t *a = &g_render_arena;
+    size = RENDER_ARENA_ALIGN_UP(size ? size : 1);
+    render_arena_chunk_t *chunk = a->current;
+    if (!chunk || chunk->capacity - chunk->used < size) {
+        // Continue with the next retained chunk if it is big enough, else insert a new one.
+        render_arena_chunk_t *next = chunk ? chunk->next : a->head;
+        if (next && next->capacity >= size) {
+            next->used = 0;
+            chunk = next;
+        } else {
+            size_t capacity = size > LVGL_JSON_ARENA_CHUNK_SIZE ? size : LVGL_JSON_ARENA_CHUNK_SIZE;
+            render_arena_chunk_t *fresh = (render_arena_chunk_t *)mem_alloc(LVGL_JSON_MEM_TEMPORARY, RENDER_ARENA_CHUNK_HEADER + capacity);
+            if (!fresh) return NULL;
+            RENDER_STAT_INC(heap_allocs);
+            fresh->capacity = capacity;
+            fresh->used = 0;
+            fresh->next = next;
+            if (chunk) chunk->next = fresh;
+            else a->head = fresh;
+            a->chunk_bytes += capacity;
+            chunk = fresh;
+        }
+        a->current = chunk;
+    }
+    void *ptr = RENDER_ARENA_CHUNK_DATA(chunk) + chunk->used;
+    chunk->used += size;
+    a->bytes_in_use += size;
+    RENDER_STAT_INC(arena_allocs);
+    g_render_stats.arena_bytes += (uint32_t)size;
+    if (a->bytes_in_use > g_render_stats.arena_peak_bytes) g_render_stats.arena_peak_bytes = (uint32_t)a->bytes_in_use;
+    return ptr;
+}
+
+static bool render_arena_owns(const void *ptr) {
+    for (render_arena_chunk_t *chunk = g_render_arena.head; chunk; chunk = chunk->next) {
+        const uint8_t *data = RENDER_ARENA_CHUNK_DATA(chunk);
+        if ((const uint8_t *)ptr >= data && (const uint8_t *)ptr < data + chunk->capacity) return true;
+    }
+    return false;
+}
+
+// Everything allocated after the mark is released by render_arena_rewind(); marks nest.
+static render_arena_mark_t render_arena_mark(void) {
+    render_arena_mark_t mark = { g_render_arena.current, g_render_arena.current ? g_render_arena.current->used : 0, g_render_arena.bytes_in_use };
+    return mark;
+}
+
+static void render_arena_rewind(render_arena_mark_t mark) {
+    if (!LVGL_JSON_RENDER_ARENA) return;
+    g_render_arena.current = mark.chunk;
+    if (mark.chunk) mark.chunk->used = mark.used;
+    g_render_arena.bytes_in_use = mark.bytes_in_use;
+}
+
+// Allocations between suspend and resume go to the heap (data that outlives the pass).
+static void render_arena_suspend(void) { g_render_arena.suspended++; }
+static void render_arena_resume(void) { g_render_arena.suspended--; }
+
+static void* render_arena_cjson_malloc(size_t size) {
+    if (render_arena_active()) return render_arena_alloc(size);
+    return LVGL_JSON_CJSON_MALLOC(size);
+}
+
+static void render_arena_cjson_free(void *ptr) {
+    if (!ptr || render_arena_owns(ptr)) return;
+    LVGL_JSON_CJSON_FREE(ptr);
+}
+
+// Routes transient allocations to the arena until the matching render_arena_leave().
+static void render_arena_enter(void) {
+    if (!LVGL_JSON_RENDER_ARENA) return;
+    if (g_render_arena.depth++ == 0) {
+        cJSON_Hooks hooks = { render_arena_cjson_malloc, render_arena_cjson_free };
+        cJSON_InitHooks(&hooks);
+    }
+}
+
+// The outermost leave releases all transient memory at once and gives cJSON back to the
+// application's allocator.
+static void render_arena_leave(void) {
+    if (!LVGL_JSON_RENDER_ARENA) return;
+    if (--g_render_arena.depth == 0) {
+        g_render_arena.current = NULL;
+        g_render_arena.bytes_in_use = 0;
+        cJSON_Hooks hooks = { LVGL_JSON_CJSON_MALLOC, LVGL_JSON_CJSON_FREE };
+        cJSON_InitHooks(&hooks);
+    }
+}
+
+static void render_pass_begin(void) {
+    mem_pass_begin();
+    render_arena_enter();
+}
+
+static void render_pass_end(void) {
+    mem_pass_end();
+    render_arena_leave();
+}
+
+// Internal scratch allocator: arena memory inside a render pass, LV_MALLOC otherwise.
+static void* render_scratch_alloc(size_t size) {
+    if (render_arena_active()) return render_arena_alloc(size);
+    RENDER_STAT_INC(heap_allocs);
+    return mem_alloc(LVGL_JSON_MEM_TEMPORARY, size);
+}
+
+// `size` is the size passed to render_scratch_alloc().
+static void render_scratch_free(void *ptr, size_t size) {
+    if (!ptr || (LVGL_JSON_RENDER_ARENA && render_arena_owns(ptr))) return;
+    mem_free(LVGL_JSON_MEM_TEMPORARY, ptr, size);
+}
+
+void lvgl_json_render_arena_release(void) {
+    if (g_render_arena.depth > 0) {
+        LOG_WARN("Render Arena: Cannot release chunks during a render pass.");
+        return;
+    }
+    render_arena_chunk_t *chunk = g_render_arena.head;
+    while (chunk) {
+        render_arena_chunk_t *next = chunk->next;
+        mem_free(LVGL_JSON_MEM_TEMPORARY, chunk, RENDER_ARENA_CHUNK_HEADER + chunk->capacity);
+        chunk = next;
+    }
+    g_render_arena.head = NULL;
+    g_render_arena.current = NULL;
+    g_render_arena.chunk_bytes = 0;
+}
+"""
@@ -0,0 +1,335 @@
+# code_gen/binary_format.py
+import logging
+
+logger = logging.getLogger(__name__)
+
+
+def generate_binary_format():
+    """
+    Generates lvgl_json_render_binary(), which renders a UI from the binary format written by
+    ui_binary.py. The buffer is validated and exposed to the renderer as a cJSON tree whose nodes
+    all live in one render arena allocation and whose strings point into the buffer, so nothing is parsed or
+    copied per node. Only strings that unmarshal_value() would unescape in place are copied.
+    The view is still one cJSON per record: the renderer and everything it calls walk cJSON, and a
+    second walker over the records would have to duplicate all of them (see tools/bench/bench_binary.c
+    for its memory and boot time against cJSON_Parse()).
+
+    lvgl_json_encode_binary() writes the same format from a cJSON tree; projects use it for the
+    artifacts they cache on disk.
+    """
+    return """
+// --- Binary UI Format (see gen/ui_binary.py) ---
+
+#define LVJB_VERSION 1
+#define LVJB_NONE 0xFFFFFFFFu
+
+typedef enum {
+    LVJB_NULL = 0,
+    LVJB_FALSE = 1,
+    LVJB_TRUE = 2,
+    LVJB_NUMBER = 3,
+    LVJB_STRING = 4,
+    LVJB_ARRAY = 5,
+    LVJB_OBJECT = 6
+} lvjb_node_type_t;
+
+typedef struct {
+    char magic[4];              // "LVJB"
+    uint16_t version;
+    uint16_t header_size;
+    uint32_t node_count;
+    uint32_t nodes_offset;
+    uint32_t strings_offset;
+    uint32_t strings_size;
+    uint32_t reserved[2];
+} lvjb_header_t;
+
+typedef struct {
+    uint8_t type;               // lvjb_node_type_t
+    uint8_t reserved[3];
+    uint32_t key;               // String offset of the member name, LVJB_NONE outside objects
+    uint32_t next;              // Index of the next sibling
+    uint32_t value;             // First child index (arrays/objects) or string offset (strings)
+    double number;
+} lvjb_node_t;
+
+// Buffers may come straight from flash, so records are copied out instead of cast in place.
+static bool lvjb_read_node(const uint8_t *data, const lvjb_header_t *header, uint32_t index, lvjb_node_t *out) {
+    memcpy(out, data + header->nodes_offset + (size_t)index * sizeof(lvjb_node_t), sizeof(lvjb_node_t));
+    if (out->type > LVJB_OBJECT) return false;
+    if (out->key != LVJB_NONE && out->key >= header->strings_size) return false;
+    // Siblings come later; children directly follow their parent (see ui_binary.py)
+    if (out->next != LVJB_NONE && (out->next <= index || out->next >= header->node_count)) return false;
+    if (out->type == LVJB_STRING && out->value >= header->strings_size) return false;
+    if ((out->type == LVJB_ARRAY || out->type == LVJB_OBJECT) && out->value != LVJB_NONE && out->value != index + 1) return false;
+    return true;
+}
+
+static bool lvjb_read_header(const void *buf, size_t len, lvjb_header_t *header) {
+    if (!buf || len < sizeof(lvjb_header_t)) {
+        LOG_ERR("Binary UI Error: Buffer too small (%u bytes).", (unsigned)len);
+        return false;
+    }
+    memcpy(header, buf, sizeof(lvjb_header_t));
+    if (memcmp(header->magic, "LVJB", 4) != 0) {
+        LOG_ERR("Binary UI Error: Bad magic, not a binary UI file.");
+        return false;
+    }
+    if (header->version != LVJB_VERSION) {
+        LOG_ERR("Binary UI Error: Unsupported version %u (expected %u).", (unsigned)header->version, (unsigned)LVJB_VERSION);
+        return false;
+    }
+    if (header->header_size < sizeof(lvjb_header_t) || header->node_count == 0 || header->strings_size == 0 ||
+        (uint64_t)header->nodes_offset + (uint64_t)header->node_count * sizeof(lvjb_node_t) > len ||
+        (uint64_t)header->strings_offset + header->strings_size > len) {
+        LOG_ERR("Binary UI Error: Truncated or inconsistent header.");
+        return false;
+    }
+    const char *strings = (const char *)buf + header->strings_offset;
+    if (strings[header->strings_size - 1] != '\\0') {
+        LOG_ERR("Binary UI Error: String pool is not terminated.");
+        return false;
+    }
+    return true;
+}
+
+// Builds a cJSON view of a binary UI buffer: all nodes in one allocation of *size bytes, strings
+// pointing into `buf`. Transient views are render scratch memory (call inside a render pass);
+// persistent ones outlive it and are freed with lvjb_view_free().
+static cJSON* lvjb_view_create(const void *buf, size_t len, bool persistent, size_t *size) {
+    lvjb_header_t header;
+    if (!lvjb_read_header(buf, len, &header)) return NULL;
+
+    const uint8_t *data = (const uint8_t *)buf;
+    const char *strings = (const char *)data + header.strings_offset;
+
+    // Pass 1: validate all records and size the copies of strings that get unescaped in place.
+    size_t copy_bytes = 0;
+    for (uint32_t i = 0; i < header.node_count; ++i) {
+        lvjb_node_t rec;
+        if (!lvjb_read_node(data, &header, i, &rec)) {
+            LOG_ERR("Binary UI Error: Invalid node record %u.", (unsigned)i);
+            return NULL;
+        }
+        if (rec.type == LVJB_STRING) {
+            cJSON probe = { .type = cJSON_String, .valuestring = (char *)(strings + rec.value) };
+            if (json_string_unescapes_in_place(&probe)) copy_bytes += strlen(probe.valuestring) + 1;
+        }
+    }
+
+    size_t nodes_size = (size_t)header.node_count * sizeof(cJSON);
+    *size = nodes_size + copy_bytes;
+    uint8_t *view = (uint8_t *)(persistent ? mem_alloc(LVGL_JSON_MEM_OTHER, *size) : render_scratch_alloc(*size));
+    if (!view) {
+        LOG_ERR("Binary UI Error: Failed to allocate %u bytes for %u nodes.", (unsigned)*size, (unsigned)header.node_count);
+        return NULL;
+    }
+    memset(view, 0, nodes_size);
+    cJSON *nodes = (cJSON *)view;
+    char *copies = (char *)(view + nodes_size);
+
+    // Pass 2: link the view. A node must be referenced at most once (prev doubles as the marker).
+    bool valid = true;
+    for (uint32_t i = 0; valid && i < header.node_count; ++i) {
+        lvjb_node_t rec;
+        lvjb_read_node(data, &header, i, &rec);
+        cJSON *node = &nodes[i];
+        node->string = (rec.key != LVJB_NONE) ? (char *)(strings + rec.key) : NULL;
+        switch (rec.type) {
+            case LVJB_NULL: node->type = cJSON_NULL; break;
+            case LVJB_FALSE: node->type = cJSON_False; break;
+            case LVJB_TRUE: node->type = cJSON_True; node->valueint = 1; break;
+            case LVJB_NUMBER:
+                node->type = cJSON_Number;
+                node->valuedouble = rec.number;
+                // Same saturation as cJSON_CreateNumber()
+                if (rec.number >= INT_MAX) node->valueint = INT_MAX;
+                else if (rec.number <= (double)INT_MIN) node->valueint = INT_MIN;
+                else node->valueint = (int)rec.number;
+                break;
+            case LVJB_STRING:
+                node->type = cJSON_String;
+                node->valuestring = (char *)(strings + rec.value);
+                if (json_string_unescapes_in_place(node)) {
+                    size_t n = strlen(node->valuestring) + 1;
+                    memcpy(copies, node->valuestring, n);
+                    node->valuestring = copies;
+                    copies += n;
+                }
+                break;
+            default:
+                node->type = (rec.type == LVJB_ARRAY) ? cJSON_Array : cJSON_Object;
+                if (rec.value != LVJB_NONE) {
+                    node->child = &nodes[rec.value];
+                    valid = node->child->prev == NULL;
+                    node->child->prev = node;
+                }
+                break;
+        }
+        if (valid && rec.next != LVJB_NONE) {
+            node->next = &nodes[rec.next];
+            valid = node->next->prev == NULL;
+            node->next->prev = node;
+        }
+    }
+    if (!valid) {
+        LOG_ERR("Binary UI Error: Node table is not a tree.");
+        if (persistent) mem_free(LVGL_JSON_MEM_OTHER, view, *size);
+        else render_scratch_free(view, *size);
+        return NULL;
+    }
+    // cJSON keeps the last element in the first child's prev
+    for (uint32_t i = 0; i < header.node_count; ++i) {
+        cJSON *child = nodes[i].child;
+        if (!child) continue;
+        cJSON *last = child;
+        while (last->next) last = last->next;
+        child->prev = last;
+    }
+    nodes[0].prev = NULL;
+    return nodes;
+}
+
+#if LVGL_JSON_USE_PROJECT
+static void lvjb_view_free(cJSON *view, size_t size) {
+    mem_free(LVGL_JSON_MEM_OTHER, view, size);
+}
+#endif
+
+bool lvgl_json_render_binary(const void *buf, size_t len, lv_obj_t *parent) {
+    render_pass_begin();
+    size_t view_size = 0;
+    cJSON *view = lvjb_view_create(buf, len, false, &view_size);
+    bool success = view && lvgl_json_render_ui(view, parent);
+    render_scratch_free(view, view_size);
+    render_pass_end();
+    return success;
+}
+
+// --- Binary UI Encoder (same output as gen/ui_binary.py) ---
+
+typedef struct {
+    uint8_t *out;
+    uint32_t node_count;        // Records written so far
+    char *strings;              // String pool inside `out`
+    uint32_t strings_size;
+    uint32_t *slots;            // Pool offset + 1 of each distinct string by hash, 0 = empty
+    uint32_t slot_mask;
+} lvjb_encoder_t;
+
+static bool lvjb_count(const cJSON *node, bool keyed, uint32_t *nodes, size_t *string_bytes) {
+    for (; node; node = node->next) {
+        ++*nodes;
+        if (keyed) *string_bytes += strlen(node->string ? node->string : "") + 1;
+        switch (node->type & 0xFF) {
+            case cJSON_NULL: case cJSON_False: case cJSON_True: case cJSON_Number: break;
+            case cJSON_String: *string_bytes += strlen(node->valuestring) + 1; break;
+            case cJSON_Array: case cJSON_Object:
+                if (!lvjb_count(node->child, (node->type & 0xFF) == cJSON_Object, nodes, string_bytes)) return false;
+                break;
+            default:
+                LOG_ERR("Binary UI Error: Raw or invalid cJSON values cannot be encoded.");
+                return false;
+        }
+    }
+    return true;
+}
+
+// Strings are stored once; later uses share the offset of the first.
+static uint32_t lvjb_encode_string(lvjb_encoder_t *e, const char *s) {
+    uint32_t hash = 2166136261u;
+    for (const unsigned char *c = (const unsigned char *)s; *c; ++c) hash = (hash ^ *c) * 16777619u;
+    uint32_t i = hash & e->slot_mask;
+    for (; e->slots[i]; i = (i + 1) & e->slot_mask) {
+        if (strcmp(e->strings + e->slots[i] - 1, s) == 0) return e->slots[i] - 1;
+    }
+    uint32_t offset = e->strings_size;
+    size_t n = strlen(s) + 1;
+    memcpy(e->strings + offset, s, n);
+    e->strings_size += (uint32_t)n;
+    e->slots[i] = offset + 1;
+    return offset;
+}
+
+static uint32_t lvjb_encode_node(lvjb_encoder_t *e, const cJSON *node, bool keyed) {
+    uint32_t index = e->node_count++;
+    lvjb_node_t rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.key = keyed ? lvjb_encode_string(e, node->string ? node->string : "") : LVJB_NONE;
+    rec.next = LVJB_NONE;
+    rec.value = LVJB_NONE;
+    switch (node->type & 0xFF) {
+        case cJSON_NULL: rec.type = LVJB_NULL; break;
+        case cJSON_False: rec.type = LVJB_FALSE; break;
+        case cJSON_True: rec.type = LVJB_TRUE; break;
+        case cJSON_Number: rec.type = LVJB_NUMBER; rec.number = node->valuedouble; break;
+        case cJSON_String: rec.type = LVJB_STRING; rec.value = lvjb_encode_string(e, node->valuestring); break;
+        default: {
+            bool is_object = (node->type & 0xFF) == cJSON_Object;
+            rec.type = is_object ? LVJB_OBJECT : LVJB_ARRAY;
+            uint32_t previous = LVJB_NONE;
+            for (const cJSON *child = node->child; child; child = child->next) {
+                uint32_t child_index = lvjb_encode_node(e, child, is_object);
+                if (previous == LVJB_NONE) {
+                    rec.value = child_index;
+                } else {
+                    memcpy(e->out + sizeof(lvjb_header_t) + (size_t)previous * sizeof(lvjb_node_t) + offsetof(lvjb_node_t, next),
+                           &child_index, sizeof(child_index));
+                }
+                previous = child_index;
+            }
+            break;
+        }
+    }
+    memcpy(e->out + sizeof(lvjb_header_t) + (size_t)index * sizeof(lvjb_node_t), &rec, sizeof(rec));
+    return index;
+}
+
+void *lvgl_json_encode_binary(const cJSON *root_json, size_t *len) {
+    if (!cJSON_IsArray(root_json) && !cJSON_IsObject(root_json)) {
+        LOG_ERR("Binary UI Error: The spec root must be an array or an object.");
+        return NULL;
+    }
+    uint32_t node_count = 0;
+    size_t string_bytes = 0;
+    // The root's siblings are not part of the spec
+    cJSON root_copy = *root_json;
+    root_copy.next = NULL;
+    if (!lvjb_count(&root_copy, false, &node_count, &string_bytes)) return NULL;
+
+    uint64_t strings_offset = sizeof(lvjb_header_t) + (uint64_t)node_count * sizeof(lvjb_node_t);
+    if (strings_offset + string_bytes >= LVJB_NONE) {
+        LOG_ERR("Binary UI Error: Spec too large for the binary format (%u nodes).", (unsigned)node_count);
+        return NULL;
+    }
+    uint32_t slot_count = 16;
+    while (slot_count < node_count * 4) slot_count <<= 1; // Keys and values, at most half full
+    lvjb_encoder_t e = { 0 };
+    e.out = (uint8_t *)LV_MALLOC((size_t)strings_offset + string_bytes);
+    e.slots = (uint32_t *)mem_alloc(LVGL_JSON_MEM_TEMPORARY, slot_count * sizeof(uint32_t));
+    if (!e.out || !e.slots) {
+        LOG_ERR("Binary UI Error: Out of memory encoding %u nodes.", (unsigned)node_count);
+        if (e.out) LV_FREE(e.out);
+        mem_free(LVGL_JSON_MEM_TEMPORARY, e.slots, slot_count * sizeof(uint32_t));
+        return NULL;
+    }
+    memset(e.slots, 0, slot_count * sizeof(uint32_t));
+    e.slot_mask = slot_count - 1;
+    e.strings = (char *)e.out + strings_offset;
+    lvjb_encode_node(&e, &root_copy, false);
+    mem_free(LVGL_JSON_MEM_TEMPORARY, e.slots, slot_count * sizeof(uint32_t));
+
+    lvjb_header_t header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, "LVJB", 4);
+    header.version = LVJB_VERSION;
+    header.header_size = sizeof(lvjb_header_t);
+    header.node_count = node_count;
+    header.nodes_offset = sizeof(lvjb_header_t);
+    header.strings_offset = (uint32_t)strings_offset;
+    header.strings_size = e.strings_size;
+    memcpy(e.out, &header, sizeof(header));
+    *len = (size_t)strings_offset + e.strings_size; // Shared strings leave the end of the buffer unused
+    return e.out;
+}
+"""
@@ -0,0 +1,118 @@
+# code_gen/context.py
+import logging
+
+logger = logging.getLogger(__name__)
+
+
+def generate_context_scopes():
+    """
+    Generates the render context: a chain of scope frames for '$name' lookups.
+
+    Every 'context' object (node property, 'context' wrapper, 'use-view') pushes a frame that
+    links to the enclosing one, so nested components see outer variables unless they shadow
+    them, and nothing is copied. Frames live on the stack of the code that pushes them; larger
+    scopes that are looked up repeatedly get a hash index.
+    """
+    return r"""
+// --- Render Context Scopes ---
+
+#define CONTEXT_INDEX_MIN_MEMBERS 8 // Smaller scopes are always scanned
+#define CONTEXT_INDEX_MIN_LOOKUPS 4 // Scans before a larger scope gets its index
+
+typedef struct render_scope_s {
+    struct render_scope_s *parent;
+    cJSON *values;                  // JSON object with this scope's variables
+    cJSON **index;                  // Open addressing over the members of values (heap), NULL = scan
+    uint32_t index_mask;
+    uint16_t lookups;
+    bool index_checked;             // Index built, or values too small to need one
+} render_scope_t;
+
+static render_scope_t *g_render_scope = NULL; // Innermost scope
+
+static render_scope_t* get_current_context(void) {
+    return g_render_scope;
+}
+
+// Makes `values` the innermost scope. `scope` must stay alive until it is popped again.
+static void push_context(render_scope_t *scope, cJSON *values) {
+    scope->parent = g_render_scope;
+    scope->values = values;
+    scope->index = NULL;
+    scope->index_mask = 0;
+    scope->lookups = 0;
+    scope->index_checked = false;
+    g_render_scope = scope;
+}
+
+// Pops back to `scope`, a value get_current_context() returned before the pushes.
+static void set_current_context(render_scope_t *scope) {
+    while (g_render_scope && g_render_scope != scope) {
+        if (g_render_scope->index) mem_free(LVGL_JSON_MEM_TEMPORARY, g_render_scope->index, (g_render_scope->index_mask + 1) * sizeof(cJSON *));
+        g_render_scope = g_render_scope->parent;
+    }
+    g_render_scope = scope;
+}
+
+static void context_build_index(render_scope_t *scope) {
+    scope->index_checked = true;
+    uint32_t members = 0;
+    for (cJSON *item = scope->values->child; item; item = item->next) members++;
+    if (members < CONTEXT_INDEX_MIN_MEMBERS) return;
+
+    uint32_t capacity = 16;
+    while (capacity < members * 2) capacity *= 2;
+    cJSON **index = (cJSON **)mem_alloc(LVGL_JSON_MEM_TEMPORARY, capacity * sizeof(cJSON *));
+    if (!index) return; // Scanning still works
+    RENDER_STAT_INC(heap_allocs);
+    memset(index, 0, capacity * sizeof(cJSON *));
+    uint32_t mask = capacity - 1;
+    for (cJSON *item = scope->values->child; item; item = item->next) {
+        if (!item->string) continue;
+        uint32_t i = str_pool_hash(item->string, strlen(item->string)) & mask;
+        // The first of repeated keys wins, like cJSON_GetObjectItemCaseSensitive()
+        while (index[i] && strcmp(index[i]->string, item->string) != 0) i = (i + 1) & mask;
+        if (!index[i]) index[i] = item;
+    }
+    scope->index = index;
+    scope->index_mask = mask;
+}
+
+static cJSON* context_scope_find(render_scope_t *scope, const char *name, uint32_t hash) {
+    if (!scope->values) return NULL;
+    // Instances with template slots look each variable up once; only repeated lookups pay for an index
+    if (!scope->index_checked && ++scope->lookups > CONTEXT_INDEX_MIN_LOOKUPS) context_build_index(scope);
+    if (!scope->index) return cJSON_GetObjectItemCaseSensitive(scope->values, name);
+    uint32_t i = hash & scope->index_mask;
+    while (scope->index[i]) {
+        if (strcmp(scope->index[i]->string, name) == 0) return scope->index[i];
+        i = (i + 1) & scope->index_mask;
+    }
+    return NULL;
+}
+
+// Innermost definition of `name`, or NULL. *defining_scope receives the scope it was found in.
+static cJSON* context_lookup(const char *name, render_scope_t **defining_scope) {
+    uint32_t hash = str_pool_hash(name, strlen(name));
+    for (render_scope_t *scope = g_render_scope; scope; scope = scope->parent) {
+        cJSON *value = context_scope_find(scope, name, hash);
+        if (value) {
+            if (defining_scope) *defining_scope = scope;
+            return value;
+        }
+    }
+    return NULL;
+}
+
+// Unmarshals a context value in the scope enclosing its definition, so that a context can
+// pass outer variables on ({"title": "$title"}) instead of referring to itself.
+static bool context_unmarshal_value(cJSON *value, render_scope_t *defining_scope, uint8_t type_id, const char *expected_c_type, void *dest) {
+    render_scope_t *saved = g_render_scope;
+    render_scope_t *outer = defining_scope ? defining_scope->parent : NULL;
+    while (outer && defining_scope && outer->values == defining_scope->values) outer = outer->parent;
+    g_render_scope = outer;
+    bool ok = unmarshal_value(value, type_id, expected_c_type, dest, NULL);
+    g_render_scope = saved;
+    return ok;
+}
+"""
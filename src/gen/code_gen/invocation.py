@@ -2,7 +2,8 @@
 import logging
 from collections import defaultdict
 from . import unmarshal # Needs unmarshal functions for generation
-from type_utils import get_c_type_str, get_signature, WIDGET_CREATE_SIGNATURE
+from . import perfect_hash
+from type_utils import get_c_type_str, get_signature, get_type_id, get_ret_kind, WIDGET_CREATE_SIGNATURE
 
 logger = logging.getLogger(__name__)
 
@@ -33,17 +34,13 @@ def generate_invoke_signatures(filtered_functions):
 def _generate_widget_create_invoker():
     """Generates the specific C invoker for lv_widget_create(parent) functions."""
     sig_c_name = "invoke_widget_create"
-    # Updated signature: takes entry pointer
+    # Call half: no JSON arguments, only the parent
     c_code = f"// Specific Invoker for functions like lv_widget_create(lv_obj_t *parent)\n"
-    c_code += f"// Signature: expects target_obj_ptr = parent, dest = lv_obj_t**, args_array = NULL\n"
-    c_code += f"static bool {sig_c_name}(const invoke_table_entry_t *entry, void *target_obj_ptr, void *dest, cJSON *args_array) {{\n"
+    c_code += f"// Signature: expects target_obj_ptr = parent, dest = lv_obj_t**, values = NULL\n"
+    c_code += f"static bool {sig_c_name}_call(const invoke_table_entry_t *entry, void *target_obj_ptr, void *dest, const invoke_value_t *values) {{\n"
+    c_code += f"    (void)values;\n"
     c_code += f"    if (!entry || !entry->func_ptr) {{ LOG_ERR(\"Invoke Error: NULL entry or func_ptr for {sig_c_name}\"); return false; }}\n"
-    c_code += f"    if (!dest) {{ LOG_ERR(\"Invoke Error: dest is NULL for {sig_c_name} (needed for result)\"); return false; }}\n"
-
-    c_code += f"    // Although args_array should be NULL, add a warning if it's not.\n"
-    c_code += f"    if (args_array != NULL && cJSON_GetArraySize(args_array) > 0) {{\n"
-    c_code += f"       LOG_WARN_JSON(args_array, \"Invoke Warning: {sig_c_name} expected 0 JSON args, got %d for func '%s'. Ignoring JSON args.\", cJSON_GetArraySize(args_array), entry->name);\n"
-    c_code += f"    }}\n\n"
+    c_code += f"    if (!dest) {{ LOG_ERR(\"Invoke Error: dest is NULL for {sig_c_name} (needed for result)\"); return false; }}\n\n"
 
     # Cast arguments and function pointer
     c_code += f"    lv_obj_t* parent = (lv_obj_t*)target_obj_ptr;\n"
@@ -68,9 +65,31 @@ def _generate_widget_create_invoker():
 
     c_code += f"    return true;\n"
     c_code += f"}}\n\n"
+
+    # JSON half
+    c_code += f"// Signature: expects target_obj_ptr = parent, dest = lv_obj_t**, args = NULL\n"
+    c_code += f"static bool {sig_c_name}(const invoke_table_entry_t *entry, void *target_obj_ptr, void *dest, const invoke_args_t *args) {{\n"
+    c_code += f"    // Although args should be NULL, add a warning if it's not.\n"
+    c_code += f"    if (args != NULL && args->count > 0) {{\n"
+    c_code += f"       LOG_WARN_JSON(INVOKE_ARGS_JSON(args), \"Invoke Warning: {sig_c_name} expected 0 JSON args, got %d for func '%s'. Ignoring JSON args.\", args->count, entry ? entry->name : \"NULL_ENTRY\");\n"
+    c_code += f"    }}\n"
+    c_code += f"    return {sig_c_name}_call(entry, target_obj_ptr, dest, NULL);\n"
+    c_code += f"}}\n\n"
     return sig_c_name, c_code
 
 
+# invoke_value_t member holding each stack buffer type
+_VALUE_MEMBER_FOR_BUFFER_TYPE = {"int64_t": "i", "double": "d", "void*": "p"}
+
+
+def _first_arg_is_target(signature_category):
+    """Invokers pass target_obj_ptr as the first C argument when it is a pointer."""
+    if signature_category == WIDGET_CREATE_SIGNATURE:
+        return True
+    sig_arg_comps = signature_category[1:]
+    return len(sig_arg_comps) > 0 and (sig_arg_comps[0] == 'POINTER' or sig_arg_comps[0].endswith('*'))
+
+
 def _get_buffer_type_for_sig_component(sig_comp):
     """ Determine appropriate C stack buffer type for a simplified signature component """
     if sig_comp == 'INT' or sig_comp == 'BOOL' or sig_comp == 'lv_color_t':
@@ -224,20 +243,32 @@ def _generate_generic_invoke_fn(signature_category, sig_c_name, function_list, a
     # Assume the simplified signature grouping is good enough for the function pointer *cast*.
     # This is the original flawed assumption, but let's try making the *call* work.
 
+    first_arg_is_target = _first_arg_is_target(signature_category)
+    num_json_args_expected = num_c_args - 1 if first_arg_is_target else num_c_args
+
+    # --- Call half: takes already unmarshalled values (also used by compiled programs) ---
     c_code = f"// Generic Invoker for signature category: {signature_category}\n"
     c_code += f"// Handles {len(function_list)} functions like '{representative_func['name']}'\n"
     c_code += f"// WARNING: Uses simplified signature for casting func_ptr, relies on compatible calling conventions.\n"
-    c_code += f"static bool {sig_c_name}(const invoke_table_entry_t *entry, void *target_obj_ptr, void *dest, cJSON *args_array) {{\n"
+    c_code += f"// Call half: `values` holds the {num_json_args_expected} already unmarshalled JSON arguments.\n"
+    c_code += f"static bool {sig_c_name}_call(const invoke_table_entry_t *entry, void *target_obj_ptr, void *dest, const invoke_value_t *values) {{\n"
     c_code += f"    if (!entry || !entry->func_ptr || !entry->ret_type) {{ LOG_ERR(\"Invoke Error: Invalid entry passed to {sig_c_name} (for func '%s')\", entry ? entry->name : \"NULL_ENTRY\"); return false; }}\n"
+    if num_json_args_expected == 0:
+        c_code += "    (void)values;\n"
 
-    # Declare stack buffers based on simplified signature
-    c_code += "    // Declare stack buffers for arguments (sized based on signature category)\n"
+    # Load stack buffers based on simplified signature
+    c_code += "    // Load stack buffers for arguments (typed by signature category)\n"
     arg_buffers = [] # Store names of buffer variables
     for i in range(num_c_args):
         buffer_type = _get_buffer_type_for_sig_component(sig_arg_comps[i])
-        if buffer_type != "void":
-           c_code += f"    {buffer_type} arg_buf{i};\n"
-           arg_buffers.append(f"arg_buf{i}")
+        if buffer_type == "void":
+            continue
+        if i == 0 and first_arg_is_target:
+            c_code += f"    {buffer_type} arg_buf0 = (void*)target_obj_ptr;\n"
+        else:
+            value_index = i - (1 if first_arg_is_target else 0)
+            c_code += f"    {buffer_type} arg_buf{i} = values[{value_index}].{_VALUE_MEMBER_FOR_BUFFER_TYPE[buffer_type]};\n"
+        arg_buffers.append(f"arg_buf{i}")
 
     result_buffer_type = "void"
     result_buffer_name = None
@@ -247,41 +278,6 @@ def _generate_generic_invoke_fn(signature_category, sig_c_name, function_list, a
         c_code += f"    {result_buffer_type} {result_buffer_name};\n"
     c_code += "\n"
 
-    # --- Unmarshal using specific types from entry ---
-    num_json_args_expected = num_c_args
-    first_arg_is_target = False
-    if num_c_args > 0 and (sig_arg_comps[0] == 'POINTER' or sig_arg_comps[0].endswith('*')):
-        first_arg_is_target = True
-        num_json_args_expected = num_c_args - 1
-        c_code += f"    if (!entry->arg_types[0]) {{ LOG_ERR(\"Invoke Error: Missing type string for target arg 0 of '%s'\", entry->name); return false; }}\n"
-        c_code += f"    arg_buf0 = (void*)target_obj_ptr;\n"
-
-    # Check JSON array validity and size (same as before)
-    c_code += f"    // Expecting {num_json_args_expected} arguments from JSON array for function '{representative_func}'\n"
-    c_code += f"    if (!cJSON_IsArray(args_array)) {{\n"
-    c_code += f"       if ({num_json_args_expected} == 0 && args_array == NULL) {{ /* Okay */ }}\n"
-    c_code += f"       else {{ LOG_ERR_JSON(args_array, \"Invoke Error: args_array is not a valid array for {sig_c_name} (func '%s')\", entry->name); return false; }}\n"
-    c_code += f"    }}\n"
-    c_code += f"    int arg_count = (args_array == NULL) ? 0 : cJSON_GetArraySize(args_array);\n"
-    c_code += f"    if (arg_count != {num_json_args_expected}) {{ LOG_ERR_JSON(args_array, \"Invoke Error: Expected {num_json_args_expected} JSON args for func '%s', got %d for {sig_c_name}\", entry->name, arg_count); return false; }}\n\n"
-
-    # Unmarshal into buffers using specific types from entry
-    c_code += "    // Unmarshal arguments from JSON into stack buffers using specific types from entry\n"
-    for i in range(num_json_args_expected):
-        c_arg_index = i + (1 if first_arg_is_target else 0)
-        c_code += f"    const char* specific_type_str{c_arg_index} = entry->arg_types[{c_arg_index}];\n"
-        c_code += f"    if (!specific_type_str{c_arg_index}) {{ LOG_ERR(\"Invoke Error: Internal setup error - missing type for arg {c_arg_index} of '%s'\", entry->name); return false; }}\n"
-        buffer_ptr = f"&arg_buf{c_arg_index}"
-        c_code += f"    cJSON *json_arg{i} = cJSON_GetArrayItem(args_array, {i});\n"
-        c_code += f"    if (!json_arg{i}) {{ LOG_ERR(\"Invoke Error: Failed to get JSON arg {i} for func '%s' ({sig_c_name})\", entry->name); return false; }}\n"
-        unmarshal_call = f"unmarshal_value(json_arg{i}, specific_type_str{c_arg_index}, (void*){buffer_ptr}, target_obj_ptr)"
-        c_code += f"    // Unmarshal JSON arg {i} into C arg buffer {c_arg_index} (using specific type 'specific_type_str{c_arg_index}')\n"
-        c_code += f"    if (!({unmarshal_call})) {{\n"
-        c_code += f"        LOG_ERR_JSON(json_arg{i}, \"Invoke Error: Failed to unmarshal JSON arg {i} as type '%s' for func '%s' ({sig_c_name})\", specific_type_str{c_arg_index}, entry->name);\n"
-        c_code += f"        return false;\n"
-        c_code += f"    }}\n"
-    c_code += "\n"
-
     # --- Function Call ---
     # Cast func_ptr based on the SIMPLIFIED signature category. This is the weak point.
     c_code += "    // Cast function pointer based on simplified signature category\n"
@@ -309,22 +305,55 @@ def _generate_generic_invoke_fn(signature_category, sig_c_name, function_list, a
         c_code += "    if (dest) {\n"
         # Copy result buffer to destination. Size mismatch IS possible here.
         # Use specific type string from entry for casting the destination pointer.
-        c_code += f"        const char* specific_ret_type_str = entry->ret_type ? entry->ret_type : \"void\";\n"
-        c_code += f"        // Copy result from buffer to dest (casting dest based on specific return type '{sig_ret_comp}')\n"
+        c_code += f"        // Copy result from buffer to dest according to the entry's return kind\n"
         c_code += f"        // WARNING: Assumes calling convention compatibility & sufficient space at dest!\n"
-        # Simple assignment cast (assuming primitive/pointer returns)
-        c_code += f"        if (strchr(specific_ret_type_str, '*')) {{ // Pointer type\n"
-        c_code += f"             *(void**)dest = (void*){result_buffer_name};\n"
-        c_code += f"        }} else if (strcmp(specific_ret_type_str, \"float\") == 0 || strcmp(specific_ret_type_str, \"double\") == 0) {{ // Float/Double\n"
-        c_code += f"             *({result_buffer_type} *)dest = ({result_buffer_type}){result_buffer_name};\n" # Assumes result_buffer_type is double
-        c_code += f"        }} else if (strcmp(specific_ret_type_str, \"void\") != 0) {{ // Integer/Enum/Bool/Color?\n"
-        c_code += f"             *({result_buffer_type} *)dest = ({result_buffer_type}){result_buffer_name};\n" # Assumes result_buffer_type is int64_t
-        c_code += f"             // TODO: Potential truncation/sign issues if specific_ret_type is smaller than {result_buffer_type}\n"
+        c_code += f"        switch (entry->ret_kind) {{\n"
+        if result_buffer_type != "double":
+            c_code += f"            case RET_KIND_POINTER: *(void**)dest = (void*){result_buffer_name}; break;\n"
+        c_code += f"            case RET_KIND_FLOAT:\n"
+        c_code += f"            case RET_KIND_INT: *({result_buffer_type} *)dest = ({result_buffer_type}){result_buffer_name}; break;\n"
+        c_code += f"            default: break;\n"
         c_code += f"        }}\n"
         c_code += "    }\n"
 
     c_code += "\n    return true;\n"
     c_code += "}\n\n"
+
+    # --- JSON half: unmarshal the argument view, then call ---
+    c_code += f"// JSON half of {sig_c_name}: unmarshals the argument view and forwards to {sig_c_name}_call.\n"
+    c_code += f"static bool {sig_c_name}(const invoke_table_entry_t *entry, void *target_obj_ptr, void *dest, const invoke_args_t *args) {{\n"
+    c_code += f"    if (!entry || !entry->func_ptr || !entry->ret_type) {{ LOG_ERR(\"Invoke Error: Invalid entry passed to {sig_c_name} (for func '%s')\", entry ? entry->name : \"NULL_ENTRY\"); return false; }}\n"
+    if first_arg_is_target:
+        c_code += f"    if (!entry->arg_types[0]) {{ LOG_ERR(\"Invoke Error: Missing type string for target arg 0 of '%s'\", entry->name); return false; }}\n"
+
+    # Check argument count
+    c_code += f"    // Expecting {num_json_args_expected} JSON arguments for function '{representative_func}'\n"
+    c_code += f"    int arg_count = (args == NULL) ? 0 : args->count;\n"
+    c_code += f"    if (arg_count != {num_json_args_expected}) {{ LOG_ERR_JSON(INVOKE_ARGS_JSON(args), \"Invoke Error: Expected {num_json_args_expected} JSON args for func '%s', got %d for {sig_c_name}\", entry->name, arg_count); return false; }}\n\n"
+
+    if num_json_args_expected == 0:
+        c_code += f"    return {sig_c_name}_call(entry, target_obj_ptr, dest, NULL);\n"
+        c_code += "}\n\n"
+        return c_code
+
+    # Unmarshal into value slots using specific types from entry
+    c_code += "    // Unmarshal arguments from JSON into zeroed value slots using specific types from entry\n"
+    c_code += "    // (unmarshalers write only the width of the specific C type).\n"
+    c_code += f"    invoke_value_t values[{num_json_args_expected}];\n"
+    c_code += "    memset(values, 0, sizeof(values));\n"
+    for i in range(num_json_args_expected):
+        c_arg_index = i + (1 if first_arg_is_target else 0)
+        c_code += f"    cJSON *json_arg{i} = args->items[{i}];\n"
+        c_code += f"    if (!json_arg{i}) {{ LOG_ERR(\"Invoke Error: Failed to get JSON arg {i} for func '%s' ({sig_c_name})\", entry->name); return false; }}\n"
+        unmarshal_call = f"unmarshal_value(json_arg{i}, entry->arg_type_ids[{c_arg_index}], entry->arg_types[{c_arg_index}], (void*)&values[{i}], target_obj_ptr)"
+        c_code += f"    // Unmarshal JSON arg {i} for C argument {c_arg_index} (type id from entry->arg_type_ids[{c_arg_index}])\n"
+        c_code += f"    if (!({unmarshal_call})) {{\n"
+        c_code += f"        LOG_ERR_JSON(json_arg{i}, \"Invoke Error: Failed to unmarshal JSON arg {i} as type '%s' for func '%s' ({sig_c_name})\", entry->arg_types[{c_arg_index}], entry->name);\n"
+        c_code += f"        return false;\n"
+        c_code += f"    }}\n"
+    c_code += "\n"
+    c_code += f"    return {sig_c_name}_call(entry, target_obj_ptr, dest, values);\n"
+    c_code += "}\n\n"
     return c_code
 
 
@@ -340,7 +369,7 @@ def generate_invocation_helpers(signatures, api_info):
 
     c_code = ""
     c_code += "// Forward declaration for the main unmarshaler\n"
-    c_code += "static bool unmarshal_value(cJSON *json_value, const char *expected_c_type, void *dest, void *implicit_parent);\n\n"
+    c_code += "static bool unmarshal_value(cJSON *json_value, uint8_t type_id, const char *expected_c_type, void *dest, void *implicit_parent);\n\n"
     # Forward declare the table struct type for the invoker signatures
     c_code += "struct invoke_table_entry_s;\n"
     c_code += "typedef struct invoke_table_entry_s invoke_table_entry_t;\n\n"
@@ -412,9 +441,79 @@ def generate_invoke_table_def():
     """Generates the invoke table definition and data."""
 
     c_code = "// --- Invocation Table ---\n\n"
-    c_code += "// Forward declaration of the invoker function signature type\n"
+    c_code += "// Compact argument type identifiers, resolved by the generator from lv_def.json.\n"
+    c_code += "// unmarshal_value() dispatches on these instead of comparing C type strings.\n"
+    c_code += "typedef enum {\n"
+    c_code += "    TYPE_ID_UNKNOWN = 0,\n"
+    c_code += "    TYPE_ID_INT,      // int, and integer-passed types without a dedicated id (read like enums)\n"
+    c_code += "    TYPE_ID_INT8,\n"
+    c_code += "    TYPE_ID_UINT8,\n"
+    c_code += "    TYPE_ID_INT16,\n"
+    c_code += "    TYPE_ID_UINT16,\n"
+    c_code += "    TYPE_ID_INT32,    // Also lv_coord_t, accepts 'N%' strings\n"
+    c_code += "    TYPE_ID_UINT32,\n"
+    c_code += "    TYPE_ID_INT64,\n"
+    c_code += "    TYPE_ID_UINT64,\n"
+    c_code += "    TYPE_ID_SIZE_T,\n"
+    c_code += "    TYPE_ID_OPA,\n"
+    c_code += "    TYPE_ID_CHAR,\n"
+    c_code += "    TYPE_ID_BOOL,\n"
+    c_code += "    TYPE_ID_FLOAT,\n"
+    c_code += "    TYPE_ID_DOUBLE,\n"
+    c_code += "    TYPE_ID_COLOR,    // lv_color_t, '#RRGGBB'\n"
+    c_code += "    TYPE_ID_STRING,   // char * / const char *\n"
+    c_code += "    TYPE_ID_VOID_PTR, // void *, accepts null\n"
+    c_code += "    TYPE_ID_OBJ_PTR,  // lv_obj_t *\n"
+    c_code += "    TYPE_ID_POINTER,  // Any other pointer, '@name' only\n"
+    c_code += "} type_id_t;\n\n"
+    c_code += "#define TYPE_ID_ENUM_BIT 0x80 // Set for enum types declared in lv_def.json\n"
+    c_code += "#define TYPE_ID_BASE(id) ((id) & 0x7F)\n\n"
+    c_code += "// How an invoker stores a function's result into 'dest'\n"
+    c_code += "typedef enum {\n"
+    c_code += "    RET_KIND_VOID = 0,\n"
+    c_code += "    RET_KIND_INT,\n"
+    c_code += "    RET_KIND_FLOAT,\n"
+    c_code += "    RET_KIND_POINTER,\n"
+    c_code += "} ret_kind_t;\n\n"
+    c_code += "// Non-owning view over the JSON arguments of one invocation. It either wraps a single\n"
+    c_code += "// value (scalar property) or the items of an existing JSON array, optionally followed by\n"
+    c_code += "// an appended default (e.g. the LV_PART_MAIN selector). Filling it never allocates and\n"
+    c_code += "// invokers index items in O(1).\n"
+    c_code += "typedef struct {\n"
+    c_code += "    int count; // Number of JSON arguments (may exceed the stored items, invokers reject that)\n"
+    c_code += f"    cJSON *items[{MAX_ARGS_SUPPORTED}];\n"
+    c_code += "} invoke_args_t;\n\n"
+    c_code += "// Wraps `value`: arrays are walked in place, NULL gives no arguments, anything else is one argument.\n"
+    c_code += "static inline void invoke_args_init(invoke_args_t *args, cJSON *value) {\n"
+    c_code += "    args->count = 0;\n"
+    c_code += "    if (!value) return;\n"
+    c_code += "    if (!cJSON_IsArray(value)) {\n"
+    c_code += "        args->items[args->count++] = value;\n"
+    c_code += "        return;\n"
+    c_code += "    }\n"
+    c_code += "    for (cJSON *item = value->child; item; item = item->next) {\n"
+    c_code += f"        if (args->count < {MAX_ARGS_SUPPORTED}) args->items[args->count] = item;\n"
+    c_code += "        args->count++;\n"
+    c_code += "    }\n"
+    c_code += "}\n\n"
+    c_code += "static inline bool invoke_args_append(invoke_args_t *args, cJSON *item) {\n"
+    c_code += f"    if (args->count >= {MAX_ARGS_SUPPORTED}) return false;\n"
+    c_code += "    args->items[args->count++] = item;\n"
+    c_code += "    return true;\n"
+    c_code += "}\n\n"
+    c_code += "// First argument (or NULL) for log context\n"
+    c_code += "#define INVOKE_ARGS_JSON(args) (((args) && (args)->count > 0) ? (args)->items[0] : NULL)\n\n"
+    c_code += "// One already unmarshalled argument, in the stack buffer width the invokers use.\n"
+    c_code += "typedef union {\n"
+    c_code += "    int64_t i; // Integers, enums, bools, colors\n"
+    c_code += "    double d;  // float / double\n"
+    c_code += "    void *p;   // Pointers and strings\n"
+    c_code += "} invoke_value_t;\n\n"
+    c_code += "// Forward declaration of the invoker function signature types\n"
     c_code += "struct invoke_table_entry_s;\n"
-    c_code += "typedef bool (*invoke_fn_t)(const struct invoke_table_entry_s *entry, void *target_obj_ptr, void *dest, cJSON *args_array);\n\n"
+    c_code += "typedef bool (*invoke_fn_t)(const struct invoke_table_entry_s *entry, void *target_obj_ptr, void *dest, const invoke_args_t *args);\n"
+    c_code += "// Same call with pre-unmarshalled arguments (values[i] is JSON argument i, see first_json_arg).\n"
+    c_code += "typedef bool (*invoke_call_fn_t)(const struct invoke_table_entry_s *entry, void *target_obj_ptr, void *dest, const invoke_value_t *values);\n\n"
 
     c_code += "// Structure for each entry in the invocation table\n"
     c_code += f"typedef struct invoke_table_entry_s {{\n" # Use struct tag here
@@ -422,12 +521,20 @@ def generate_invoke_table_def():
     c_code += "    invoke_fn_t invoke;       // Pointer to the C invocation wrapper function\n"
     c_code += "    void *func_ptr;         // Pointer to the actual LVGL function\n"
     c_code += "    const char *ret_type;       // Specific C return type string\n"
-    c_code += f"    const char *arg_types[{MAX_ARGS_SUPPORTED}]; // Specific C argument type strings\n"
+    c_code += f"    const char *arg_types[{MAX_ARGS_SUPPORTED}]; // Specific C argument type strings (registry type checks, messages)\n"
+    c_code += "    uint8_t arity;              // Number of C arguments\n"
+    c_code += "    uint8_t ret_kind;           // ret_kind_t\n"
+    c_code += f"    uint8_t arg_type_ids[{MAX_ARGS_SUPPORTED}]; // type_id_t (| TYPE_ID_ENUM_BIT) per argument\n"
+    c_code += "    invoke_call_fn_t call;      // Invoker taking pre-unmarshalled values\n"
+    c_code += "    uint8_t first_json_arg;     // C argument index of JSON argument 0 (1 when arg 0 is the target)\n"
     c_code += f"}} invoke_table_entry_t;\n\n" # Typedef name here
     return c_code
 
-def generate_invoke_table(filtered_functions, signature_map):
+def generate_invoke_table(filtered_functions, signature_map, api_info):
     """Generates the invoke table definition and data."""
+    full_api = api_info.get('_full_api_data', {})
+    typedef_map = {t['name']: t.get('type') for t in full_api.get('typedefs', []) if t.get('name')}
+    enum_names = {e['name'] for e in full_api.get('enums', []) if e.get('name')}
 
     c_code = "// The global invocation table\n"
     c_code += "static const invoke_table_entry_t g_invoke_table[] = {\n"
@@ -436,8 +543,14 @@ def generate_invoke_table(filtered_functions, signature_map):
     filtered_functions.sort(key=lambda f: f['name'])
 
     count = 0
+    table_names = [] # Names in table order, for the perfect hash index
+    seen_names = set()
     for func in filtered_functions:
         name = func['name']
+        if name in seen_names:
+            # lv_def.json lists some functions twice (e.g. lv_span_set_text_static); keep the first.
+            logger.warning(f"Function '{name}' appears more than once in the API definition. Skipping duplicate invoke table entry.")
+            continue
         if name in signature_map:
             invoke_func_name = signature_map[name]
             # Ensure the C invoker function exists
@@ -455,9 +568,11 @@ def generate_invoke_table(filtered_functions, signature_map):
             if num_args > MAX_ARGS_SUPPORTED:
                 logger.error(f"Function '{name}' has {num_args} arguments, exceeding MAX_ARGS_SUPPORTED ({MAX_ARGS_SUPPORTED}). Skipping invoke table entry.")
                 continue
+            arg_type_ids = ["0"] * MAX_ARGS_SUPPORTED
             for i in range(num_args):
-                 arg_c_type, arg_ptr_lvl, _ = func['_resolved_arg_types'][i]
+                 arg_c_type, arg_ptr_lvl, arg_is_array = func['_resolved_arg_types'][i]
                  specific_arg_type_strs[i] = f"\"{get_c_type_str(arg_c_type, arg_ptr_lvl)}\"" # Store as quoted string literal
+                 arg_type_ids[i] = get_type_id(arg_c_type, arg_ptr_lvl, arg_is_array, typedef_map, enum_names)
 
             # Format the entry
             c_code += f"    {{\n"
@@ -465,17 +580,30 @@ def generate_invoke_table(filtered_functions, signature_map):
             c_code += f"        .invoke = &{invoke_func_name},\n"
             c_code += f"        .func_ptr = (void*)&{name},\n"
             c_code += f"        .ret_type = \"{specific_ret_type_str}\",\n"
-            c_code += f"        .arg_types = {{ {', '.join(specific_arg_type_strs)} }}\n"
+            c_code += f"        .arg_types = {{ {', '.join(specific_arg_type_strs)} }},\n"
+            c_code += f"        .arity = {num_args},\n"
+            c_code += f"        .ret_kind = {get_ret_kind(ret_c_type, ret_ptr_lvl)},\n"
+            c_code += f"        .arg_type_ids = {{ {', '.join(arg_type_ids)} }},\n"
+            c_code += f"        .call = &{invoke_func_name}_call,\n"
+            c_code += f"        .first_json_arg = {1 if _first_arg_is_target(sig) else 0}\n"
             c_code += f"    }},\n"
+            table_names.append(name)
+            seen_names.add(name)
             count += 1
         else:
             # This function was filtered but didn't map to any generated invoker
             logger.warning(f"Function '{name}' is filtered but has no invoker mapping. Skipping invoke table entry.")
 
-    c_code += "    {NULL, NULL, NULL, NULL, {NULL}} // Sentinel\n" # Match struct init
+    c_code += "    {NULL, NULL, NULL, NULL, {NULL}, 0, RET_KIND_VOID, {0}, NULL, 0} // Sentinel\n" # Match struct init
     c_code += "};\n\n"
     c_code += f"#define INVOKE_TABLE_SIZE {count}\n\n"
 
+    # Perfect hash index over the table names, so find_invoke_entry() is O(1).
+    ph = perfect_hash.build_perfect_hash(table_names)
+    c_code += "// Perfect hash index for g_invoke_table (generated, see code_gen/perfect_hash.py)\n"
+    c_code += perfect_hash.generate_ph_tables("g_invoke", "INVOKE", ph)
+    c_code += perfect_hash.generate_ph_find("g_invoke", "INVOKE", ph, "g_invoke_table[idx].name")
+
     logger.info(f"Generated invoke table with {count} entries.")
     return c_code
 
@@ -483,16 +611,14 @@ def generate_find_function():
     """Generates C code to find a function in the invoke table."""
     c_code = "// --- Function Lookup ---\n\n"
     c_code += "// Finds an entry in the invocation table by function name.\n"
+    c_code += "// Uses the generated perfect hash: one djb2 pass over the name, one displacement\n"
+    c_code += "// lookup and at most one strcmp (skipped when the stored hash already differs).\n"
     c_code += "static const invoke_table_entry_t* find_invoke_entry(const char *name) {\n"
     c_code += "    if (!name) return NULL;\n"
-    # Simple linear search - could be replaced with hash map or binary search if sorted
-    c_code += "    for (int i = 0; g_invoke_table[i].name != NULL; ++i) {\n"
-    c_code += "        // Direct string comparison\n"
-    c_code += "        if (strcmp(g_invoke_table[i].name, name) == 0) {\n"
-    c_code += "            return &g_invoke_table[i];\n"
-    c_code += "        }\n"
-    c_code += "    }\n"
+    c_code += "    size_t len = strlen(name);\n"
+    c_code += "    uint32_t idx = g_invoke_ph_find(name, len, djb2_hash_n(name, len));\n"
+    c_code += "    if (idx == INVOKE_PH_EMPTY) return NULL;\n"
     # Fallback logic (e.g., for lv_obj_set_prop) is handled by the caller (renderer)
-    c_code += "    return NULL;\n"
+    c_code += "    return &g_invoke_table[idx];\n"
     c_code += "}\n\n"
-    return c_code
\ No newline at end of file
+    return c_code
@@ -0,0 +1,248 @@
+# code_gen/lazy.py
+import logging
+
+logger = logging.getLogger(__name__)
+
+
+def generate_lazy_code():
+    """
+    Generates lazy subtrees: containers with "lazy": true get their "children" the first time
+    they are about to be shown instead of when the spec is rendered.
+
+    apply_setters_and_attributes() hands the "children" array to lazy_defer(), which keeps a copy
+    of it, of the variables in scope and of the path prefix. The container builds them when LVGL
+    first draws it (a tile scrolled into view, a hidden container shown) or when its tileview or
+    tabview switches to it. With prefetch on, an LVGL timer builds the pages next to the shown
+    one while there is no input.
+    """
+    return r"""
+// --- Lazy Subtrees ---
+
+typedef struct lazy_node_s {
+    struct lazy_node_s *next;
+    lv_obj_t *obj;              // Container whose children are deferred
+    lv_obj_t *view;             // Tileview/tabview that shows `obj` as a page, NULL if none
+    cJSON *children;            // Copy of the "children" array, kept while `obj` lives
+    cJSON *context;             // Variables in scope when `obj` was rendered (merged copy), NULL if none
+    const char *path;           // Interned path prefix of the children
+    size_t json_bytes;          // Accounted to LVGL_JSON_MEM_TEMPLATES with the node
+    bool built;
+    bool scheduled;             // lazy_build_async() is queued
+} lazy_node_t;
+
+static lazy_node_t *g_lazy_nodes;       // Every lazy container alive, newest first
+static uint32_t g_lazy_pending;
+static lv_timer_t *g_lazy_prefetch_timer;
+
+static void lazy_draw_event_cb(lv_event_t *e);
+
+static bool lazy_requested(cJSON *attributes) {
+    return cJSON_IsTrue(cJSON_GetObjectItemCaseSensitive(attributes, "lazy"));
+}
+
+// The tileview or tabview that shows `container` as one of its pages.
+static lv_obj_t* lazy_find_view(lv_obj_t *container) {
+    lv_obj_t *parent = lv_obj_get_parent(container);
+    if (!parent) return NULL;
+#if LV_USE_TILEVIEW
+    if (lv_obj_check_type(parent, &lv_tileview_class)) return parent;
+#endif
+#if LV_USE_TABVIEW
+    lv_obj_t *view = lv_obj_get_parent(parent);
+    if (view && lv_obj_check_type(view, &lv_tabview_class) && lv_tabview_get_content(view) == parent) return view;
+#endif
+    return NULL;
+}
+
+static lv_obj_t* lazy_view_active_page(lv_obj_t *view) {
+#if LV_USE_TILEVIEW
+    if (lv_obj_check_type(view, &lv_tileview_class)) return lv_tileview_get_tile_active(view);
+#endif
+#if LV_USE_TABVIEW
+    if (lv_obj_check_type(view, &lv_tabview_class)) {
+        return lv_obj_get_child(lv_tabview_get_content(view), (int32_t)lv_tabview_get_tab_active(view));
+    }
+#endif
+    return NULL;
+}
+
+// The value a variable that passes another one on ({"rows": "$data"}) stands for, looked up
+// in the scopes outside the one defining it. A merged copy has no outer scopes to do it later.
+static cJSON* lazy_forwarded_value(cJSON *value, render_scope_t *scope) {
+    render_scope_t *saved = g_render_scope;
+    for (int hops = 0; hops < 8; ++hops) { // Bounded: variables may pass each other on in a cycle
+        if (!cJSON_IsString(value) || value->valuestring[0] != '$' || value->valuestring[1] == '$') break;
+        render_scope_t *outer = scope->parent;
+        while (outer && outer->values == scope->values) outer = outer->parent;
+        g_render_scope = outer;
+        render_scope_t *found = NULL;
+        cJSON *target = outer ? context_lookup(value->valuestring + 1, &found) : NULL;
+        if (!target) break;
+        value = target;
+        scope = found;
+    }
+    g_render_scope = saved;
+    return value;
+}
+
+// All variables visible in the current scope chain in one object, inner scopes first.
+static cJSON* lazy_capture_context(void) {
+    if (!g_render_scope) return NULL;
+    cJSON *merged = cJSON_CreateObject();
+    for (render_scope_t *scope = g_render_scope; merged && scope; scope = scope->parent) {
+        cJSON *item = NULL;
+        cJSON_ArrayForEach(item, scope->values) {
+            if (!item->string || cJSON_GetObjectItemCaseSensitive(merged, item->string)) continue;
+            cJSON *copy = cJSON_Duplicate(lazy_forwarded_value(item, scope), true);
+            if (!copy) {
+                cJSON_Delete(merged);
+                return NULL;
+            }
+            cJSON_AddItemToObject(merged, item->string, copy);
+        }
+    }
+    return merged;
+}
+
+static bool lazy_build(lazy_node_t *rec) {
+    if (rec->built) return false;
+    rec->built = true; // Before rendering: drawing or switching pages must not build it twice
+    g_lazy_pending--;
+    lv_obj_remove_event_cb(rec->obj, lazy_draw_event_cb);
+
+    render_pass_begin();
+    render_scope_t *saved_scope = get_current_context();
+    render_scope_t scope;
+    if (rec->context) push_context(&scope, rec->context);
+    cJSON *child = NULL;
+    cJSON_ArrayForEach(child, rec->children) {
+        if (render_json_node(child, rec->obj, rec->path) == NULL) {
+            LOG_ERR_JSON(child, "Lazy Error: Failed to render child node. Aborting siblings.");
+            break;
+        }
+    }
+    set_current_context(saved_scope);
+    render_pass_end();
+    LOG_DEBUG("Lazy: built the children of %p, %u containers pending.", (void *)rec->obj, (unsigned)g_lazy_pending);
+    return true;
+}
+
+static void lazy_build_async(void *data) {
+    lazy_node_t *rec = (lazy_node_t *)data;
+    rec->scheduled = false;
+    lazy_build(rec);
+}
+
+// Drawing is not the place to create widgets, so the first draw queues the build.
+static void lazy_draw_event_cb(lv_event_t *e) {
+    lazy_node_t *rec = (lazy_node_t *)lv_event_get_user_data(e);
+    if (rec->built || rec->scheduled) return;
+    rec->scheduled = lv_async_call(lazy_build_async, rec) == LV_RESULT_OK;
+}
+
+static void lazy_delete_event_cb(lv_event_t *e) {
+    lazy_node_t *rec = (lazy_node_t *)lv_event_get_user_data(e);
+    for (lazy_node_t **link = &g_lazy_nodes; *link; link = &(*link)->next) {
+        if (*link == rec) {
+            *link = rec->next;
+            break;
+        }
+    }
+    if (rec->scheduled) lv_async_call_cancel(lazy_build_async, rec);
+    if (!rec->built) g_lazy_pending--;
+    mem_unaccount(LVGL_JSON_MEM_TEMPLATES, rec->json_bytes);
+    cJSON_Delete(rec->children);
+    cJSON_Delete(rec->context);
+    str_pool_release(rec->path);
+    mem_free(LVGL_JSON_MEM_TEMPLATES, rec, sizeof(*rec));
+}
+
+static void lazy_view_event_cb(lv_event_t *e) {
+    lv_obj_t *view = (lv_obj_t *)lv_event_get_current_target(e);
+    lv_obj_t *page = lazy_view_active_page(view);
+    for (lazy_node_t *rec = g_lazy_nodes; page && rec; rec = rec->next) {
+        if (rec->obj == page) {
+            lazy_build(rec);
+            return;
+        }
+    }
+}
+
+// Keeps `children` of `container` for later. Returns false if they have to be rendered now.
+static bool lazy_defer(lv_obj_t *container, cJSON *children, const char *path) {
+    render_arena_suspend(); // Kept until the container is deleted
+    lazy_node_t *rec = (lazy_node_t *)mem_alloc(LVGL_JSON_MEM_TEMPLATES, sizeof(lazy_node_t));
+    if (rec) {
+        memset(rec, 0, sizeof(*rec));
+        rec->children = cJSON_Duplicate(children, true);
+        rec->context = lazy_capture_context();
+    }
+    render_arena_resume();
+    if (!rec || !rec->children || (g_render_scope && !rec->context)) {
+        if (rec) {
+            cJSON_Delete(rec->children);
+            cJSON_Delete(rec->context);
+        }
+        mem_free(LVGL_JSON_MEM_TEMPLATES, rec, sizeof(lazy_node_t));
+        return false;
+    }
+    RENDER_STAT_INC(heap_allocs);
+    RENDER_STAT_INC(json_allocs);
+    RENDER_STAT_INC(lazy_deferred);
+    rec->path = str_pool_retain(path ? path : "", path ? strlen(path) : 0);
+    rec->obj = container;
+    rec->view = lazy_find_view(container);
+    rec->json_bytes = mem_json_bytes(rec->children) + mem_json_bytes(rec->context);
+    mem_account(LVGL_JSON_MEM_TEMPLATES, rec->json_bytes);
+
+    // One page switch handler per view
+    bool view_hooked = false;
+    for (lazy_node_t *other = g_lazy_nodes; rec->view && other && !view_hooked; other = other->next) {
+        view_hooked = other->view == rec->view;
+    }
+    if (rec->view && !view_hooked) lv_obj_add_event_cb(rec->view, lazy_view_event_cb, LV_EVENT_VALUE_CHANGED, NULL);
+    lv_obj_add_event_cb(container, lazy_draw_event_cb, LV_EVENT_DRAW_MAIN_BEGIN, rec);
+    lv_obj_add_event_cb(container, lazy_delete_event_cb, LV_EVENT_DELETE, rec);
+
+    rec->next = g_lazy_nodes;
+    g_lazy_nodes = rec;
+    g_lazy_pending++;
+    return true;
+}
+
+// Builds one pending page next to the page its view shows; one per tick keeps frames short.
+static void lazy_prefetch_timer_cb(lv_timer_t *timer) {
+    (void)timer;
+    if (g_lazy_pending == 0 || lv_display_get_inactive_time(NULL) < LVGL_JSON_LAZY_PREFETCH_IDLE_MS) return;
+    for (lazy_node_t *rec = g_lazy_nodes; rec; rec = rec->next) {
+        if (rec->built || !rec->view) continue;
+        lv_obj_t *active = lazy_view_active_page(rec->view);
+        if (!active) continue;
+        int32_t distance = lv_obj_get_index(rec->obj) - lv_obj_get_index(active);
+        if (distance == 1 || distance == -1) {
+            lazy_build(rec);
+            return;
+        }
+    }
+}
+
+bool lvgl_json_lazy_build(lv_obj_t *container) {
+    for (lazy_node_t *rec = g_lazy_nodes; rec; rec = rec->next) {
+        if (rec->obj == container) return lazy_build(rec);
+    }
+    return false;
+}
+
+uint32_t lvgl_json_lazy_pending(void) {
+    return g_lazy_pending;
+}
+
+void lvgl_json_lazy_set_prefetch(bool enable) {
+    if (enable && !g_lazy_prefetch_timer) {
+        g_lazy_prefetch_timer = lv_timer_create(lazy_prefetch_timer_cb, LVGL_JSON_LAZY_PREFETCH_PERIOD_MS, NULL);
+    } else if (!enable && g_lazy_prefetch_timer) {
+        lv_timer_delete(g_lazy_prefetch_timer);
+        g_lazy_prefetch_timer = NULL;
+    }
+}
+"""
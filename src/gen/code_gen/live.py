@@ -0,0 +1,645 @@
+# code_gen/live.py
+import logging
+
+logger = logging.getLogger(__name__)
+
+
+def generate_live_ui():
+    """
+    Generates the live UI: diff-based reloading of a rendered spec (lvgl_json_live_ui_update()).
+
+    While a live UI renders, render_json_node() records which widget each spec node created, the
+    root of each use-view instance and the target of each 'with' block. On the next update the old
+    and new specs are walked side by side: changed properties are re-applied to the existing widget
+    (or instance root, or 'with' target), changed or added children are rendered and removed ones
+    deleted. A node the diff cannot patch safely (removed properties, structural attributes, a
+    changed use-view context) is rendered again on its own; only changes to styles and component
+    definitions, which may be used anywhere, render the whole UI again.
+    """
+    return r"""
+// --- Live UI (diff-based reload) ---
+
+// The live map below is also how virtual lists find the widgets of their rows; only the
+// live UI itself is left out without LVGL_JSON_USE_LIVE.
+
+#define LIVE_MAP_MIN_CAPACITY 64
+
+typedef enum {
+    LIVE_NODE_WIDGET,           // `obj` was created from the node
+    LIVE_NODE_VIEW,             // A 'use-view' instance: `obj` is the root of the component
+    LIVE_NODE_WITH              // The value of a 'with' attribute: `obj` is its target
+} live_node_kind_t;
+
+typedef struct {
+    const cJSON *node;          // Spec node the widget was rendered from, NULL = free slot
+    lv_obj_t *obj;
+    live_node_kind_t kind;
+    const void *component;      // LIVE_NODE_VIEW: the component_def_t the instance was made from
+    const char *actual_type;    // Interned, e.g. "grid"
+    const char *create_type;    // Interned, e.g. "obj" for "grid"
+    const char *path;           // Interned path of the node, prefix of its children
+    bool registered;            // `path` was registered for the widget ('id')
+    bool shared;                // Rendered more than once (shared through a YAML alias): `obj` is one of them
+} live_node_t;
+
+struct live_map_s {
+    live_node_t *slots;         // Open addressing on the node pointer
+    uint32_t capacity;          // Power of two, 0 before the first insert
+    uint32_t count;
+};
+
+static uint32_t live_map_hash(const cJSON *node) {
+    uintptr_t p = (uintptr_t)node;
+    return hash_finalize((uint32_t)(p >> 3) ^ (uint32_t)((uint64_t)p >> 32));
+}
+
+static live_node_t* live_map_find(const live_map_t *map, const cJSON *node) {
+    if (!map->capacity) return NULL;
+    uint32_t mask = map->capacity - 1;
+    for (uint32_t i = live_map_hash(node) & mask; map->slots[i].node; i = (i + 1) & mask) {
+        if (map->slots[i].node == node) return &map->slots[i];
+    }
+    return NULL;
+}
+
+static bool live_map_grow(live_map_t *map) {
+    uint32_t capacity = map->capacity ? map->capacity * 2 : LIVE_MAP_MIN_CAPACITY;
+    live_node_t *slots = (live_node_t *)mem_alloc(LVGL_JSON_MEM_OTHER, capacity * sizeof(live_node_t));
+    if (!slots) return false;
+    RENDER_STAT_INC(heap_allocs);
+    memset(slots, 0, capacity * sizeof(live_node_t));
+    for (uint32_t i = 0; i < map->capacity; ++i) {
+        if (!map->slots[i].node) continue;
+        uint32_t j = live_map_hash(map->slots[i].node) & (capacity - 1);
+        while (slots[j].node) j = (j + 1) & (capacity - 1);
+        slots[j] = map->slots[i];
+    }
+    mem_free(LVGL_JSON_MEM_OTHER, map->slots, map->capacity * sizeof(live_node_t));
+    map->slots = slots;
+    map->capacity = capacity;
+    return true;
+}
+
+// Slot for `node`, with its previous record if there was one. NULL if out of memory.
+static live_node_t* live_map_insert(live_map_t *map, const cJSON *node) {
+    live_node_t *rec = live_map_find(map, node);
+    if (rec) return rec;
+    if ((map->count + 1) * 4 > map->capacity * 3 && !live_map_grow(map)) return NULL;
+    uint32_t mask = map->capacity - 1;
+    uint32_t i = live_map_hash(node) & mask;
+    while (map->slots[i].node) i = (i + 1) & mask;
+    map->count++;
+    map->slots[i].node = node;
+    return &map->slots[i];
+}
+
+static void live_node_release(live_node_t *rec) {
+    str_pool_release(rec->actual_type);
+    str_pool_release(rec->create_type);
+    str_pool_release(rec->path);
+}
+
+static void live_map_clear(live_map_t *map) {
+    for (uint32_t i = 0; i < map->capacity; ++i) {
+        if (map->slots[i].node) live_node_release(&map->slots[i]);
+    }
+    mem_free(LVGL_JSON_MEM_OTHER, map->slots, map->capacity * sizeof(live_node_t));
+    memset(map, 0, sizeof(*map));
+}
+
+// Records what `node` rendered to. NULL if out of memory: untracked widgets make the next
+// update render their parent, or everything, again.
+static live_node_t* live_map_record(const cJSON *node, live_node_kind_t kind, lv_obj_t *obj, const char *actual_type, const char *create_type, const char *path, bool registered) {
+    live_node_t *rec = live_map_insert(g_live_capture, node);
+    if (!rec) return NULL;
+    if (rec->obj) {
+        live_node_release(rec);
+        rec->shared = true;
+    }
+    rec->obj = obj;
+    rec->kind = kind;
+    rec->component = NULL;
+    rec->actual_type = str_pool_retain(actual_type, strlen(actual_type));
+    rec->create_type = str_pool_retain(create_type, strlen(create_type));
+    rec->path = str_pool_retain(path ? path : "", path ? strlen(path) : 0);
+    rec->registered = registered;
+    return rec;
+}
+
+// Called by render_json_node() for every widget it creates while a live UI renders.
+static void live_map_capture(const cJSON *node, lv_obj_t *obj, const char *actual_type, const char *create_type, const char *path, bool registered) {
+    live_map_record(node, LIVE_NODE_WIDGET, obj, actual_type, create_type, path, registered);
+}
+
+// A 'use-view' instance; its path is the one its 'do' block is applied with.
+static void live_map_capture_view(const cJSON *node, const component_def_t *component, const char *named_path_prefix, void *root) {
+    cJSON *type = cJSON_GetObjectItemCaseSensitive(component->root, "type");
+    const char *actual_type = cJSON_IsString(type) ? type->valuestring : "obj";
+    if (strcmp(actual_type, "style") == 0) return; // Not a widget
+    cJSON *id = cJSON_GetObjectItemCaseSensitive(component->root, "id");
+    const char *root_id = cJSON_IsString(id) && id->valuestring[0] == '@' ? id->valuestring + 1 : NULL;
+    char buf[REGISTRY_PATH_BUF_SIZE];
+    char *path = registry_path_join(buf, named_path_prefix, root_id);
+    live_node_t *rec = live_map_record(node, LIVE_NODE_VIEW, (lv_obj_t *)root, actual_type,
+                                       strcmp(actual_type, "grid") == 0 ? "obj" : actual_type, path, root_id && root_id[0]);
+    if (rec) rec->component = component;
+    registry_path_free(path, buf);
+}
+
+// A 'with' block; `path` is the one its 'do' block is applied with.
+static void live_map_capture_with(const cJSON *with, lv_obj_t *target, const char *path) {
+    live_map_record(with, LIVE_NODE_WITH, target, "obj", "obj", path, false);
+}
+
+// Attributes that are not plain setters: re-applying them would add a second event handler,
+// style or binding, or they change how the node and its children are created.
+static bool live_attr_is_structural(const char *name) {
+    static const char *const names[] = { "type", "id", "named", "context", "with", "do", "action", "observes", "cols", "rows", "lazy" };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+        if (strcmp(name, names[i]) == 0) return true;
+    }
+    return strncmp(name, "add_", 4) == 0 || strncmp(name, "remove_", 7) == 0;
+}
+
+#if LVGL_JSON_USE_LIVE
+
+#define LIVE_DIFF_LOOKAHEAD 16 // Siblings searched for the old version of a node
+
+struct lvgl_json_live_ui_s {
+    lv_obj_t *parent;
+    cJSON *spec;                // Spec the widgets were rendered from (owned)
+    live_map_t map;
+};
+
+typedef enum {
+    LIVE_DIFF_OK,               // Widget kept, patched in place
+    LIVE_DIFF_REPLACE,          // Node must be rendered again
+    LIVE_DIFF_REBUILD           // The whole UI must be rendered again
+} live_diff_result_t;
+
+typedef struct {
+    lvgl_json_live_ui_t *ui;
+    live_map_t next;            // Widgets of the new spec
+    lvgl_json_live_stats_t *stats;
+} live_diff_t;
+
+// Path prefix for a node's children, as apply_setters_and_attributes() builds it from 'named'.
+static char* live_children_prefix(cJSON *node, live_node_t *rec, char *buf) {
+    cJSON *named = cJSON_GetObjectItemCaseSensitive(node, "named");
+    char *named_str = NULL;
+    if (cJSON_IsString(named) && unmarshal_value(named, TYPE_ID_STRING, "char *", &named_str, rec->obj) && named_str) {
+        return registry_path_join(buf, rec->path, named_str);
+    }
+    return registry_path_join(buf, rec->path, NULL);
+}
+
+static bool live_is_context(const cJSON *node) {
+    const char *type = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(node, "type"));
+    return type && strcmp(type, "context") == 0;
+}
+
+// Record of the widget a node rendered to: its own, the root of its use-view instance, or that of
+// the 'for' node of a context wrapper.
+static live_node_t* live_node_widget(const live_map_t *map, const cJSON *node) {
+    live_node_t *rec = live_map_find(map, node);
+    if (!rec && live_is_context(node)) return live_node_widget(map, cJSON_GetObjectItemCaseSensitive(node, "for"));
+    return rec;
+}
+
+static void live_unregister(live_diff_t *d, cJSON *node);
+
+// Unregisters the nodes rendered from the 'children', 'with' and 'do' blocks of `attrs`, and
+// the 'for' node of a context wrapper.
+static void live_unregister_attrs(live_diff_t *d, cJSON *attrs) {
+    cJSON *item = NULL;
+    cJSON_ArrayForEach(item, attrs) {
+        if (!item->string) continue;
+        if (strcmp(item->string, "children") == 0) {
+            cJSON *child = NULL;
+            cJSON_ArrayForEach(child, item) live_unregister(d, child);
+        } else if (strcmp(item->string, "with") == 0) {
+            live_unregister_attrs(d, cJSON_GetObjectItemCaseSensitive(item, "do"));
+        } else if (strcmp(item->string, "do") == 0) {
+            live_unregister_attrs(d, item);
+        } else if (strcmp(item->string, "for") == 0 && live_is_context(attrs)) {
+            live_unregister(d, item);
+        }
+    }
+}
+
+static void live_unregister(live_diff_t *d, cJSON *node) {
+    live_node_t *rec = live_map_find(&d->ui->map, node);
+    if (rec && rec->path) {
+        char buf[REGISTRY_PATH_BUF_SIZE];
+        char *prefix = live_children_prefix(node, rec, buf);
+        // Removing a path also removes everything registered below it
+        if (prefix[0] && strcmp(prefix, rec->path) != 0) lvgl_json_registry_remove(prefix);
+        if (rec->registered) lvgl_json_registry_remove(rec->path);
+        registry_path_free(prefix, buf);
+    }
+    if (cJSON_IsObject(node)) live_unregister_attrs(d, node);
+}
+
+static bool live_delete(live_diff_t *d, cJSON *old_node) {
+    live_node_t *rec = live_node_widget(&d->ui->map, old_node);
+    if (!rec || rec->shared) return false;
+    lv_obj_t *obj = rec->obj;
+    live_unregister(d, old_node);
+    lv_obj_delete(obj);
+    d->stats->subtrees_deleted++;
+    return true;
+}
+
+// Renders a new node and moves its widget to `index` (-1 = last). *obj_out receives the widget,
+// NULL for styles, components and other nodes that are not tracked.
+static bool live_create(live_diff_t *d, cJSON *new_node, lv_obj_t *parent, const char *prefix, int32_t index, lv_obj_t **obj_out) {
+    if (!render_json_node(new_node, parent, prefix)) return false;
+    live_node_t *rec = live_node_widget(&d->next, new_node);
+    if (rec && rec->shared) return false;
+    if (rec && index >= 0) lv_obj_move_to_index(rec->obj, index);
+    if (obj_out) *obj_out = rec ? rec->obj : NULL;
+    d->stats->subtrees_created++;
+    return true;
+}
+
+static live_diff_result_t live_replace(live_diff_t *d, cJSON *old_node, cJSON *new_node, lv_obj_t *parent, const char *prefix) {
+    live_node_t *rec = live_node_widget(&d->ui->map, old_node);
+    if (!rec) return LIVE_DIFF_REBUILD;
+    int32_t index = lv_obj_get_index(rec->obj);
+    if (!live_delete(d, old_node)) return LIVE_DIFF_REBUILD;
+    lv_obj_t *obj = NULL;
+    if (!live_create(d, new_node, parent, prefix, index, &obj) || !obj) return LIVE_DIFF_REBUILD;
+    return LIVE_DIFF_OK;
+}
+
+// Moves the record of an old node to the new node that took its place. NULL if out of memory or
+// if the new node was met before (it is in the spec twice).
+static live_node_t* live_map_move(live_diff_t *d, live_node_t *rec, cJSON *new_node) {
+    live_node_t *next_rec = live_map_insert(&d->next, new_node);
+    if (!next_rec || next_rec->obj) return NULL;
+    *next_rec = *rec;
+    next_rec->node = new_node;
+    rec->actual_type = rec->create_type = rec->path = NULL; // Moved to next_rec
+    return next_rec;
+}
+
+// The members of two objects other than `except` are the same, in the same order.
+static bool live_equal_except(const cJSON *a, const cJSON *b, const char *except) {
+    const cJSON *ia = a->child, *ib = b->child;
+    for (;;) {
+        while (ia && ia->string && strcmp(ia->string, except) == 0) ia = ia->next;
+        while (ib && ib->string && strcmp(ib->string, except) == 0) ib = ib->next;
+        if (!ia || !ib) return ia == ib;
+        if (!ia->string || !ib->string || strcmp(ia->string, ib->string) != 0 || !cJSON_Compare(ia, ib, true)) return false;
+        ia = ia->next;
+        ib = ib->next;
+    }
+}
+
+static live_diff_result_t live_diff_children(live_diff_t *d, cJSON *old_node, cJSON *new_node, lv_obj_t *parent, const char *prefix);
+static bool live_attrs_patchable(live_diff_t *d, cJSON *old_attrs, cJSON *new_attrs);
+
+// A changed 'with' block can be patched if its target is tracked and only its 'do' block changed.
+static bool live_with_patchable(live_diff_t *d, cJSON *old_with, cJSON *new_with) {
+    if (cJSON_Compare(old_with, new_with, true)) return true;
+    live_node_t *rec = live_map_find(&d->ui->map, old_with);
+    if (!rec || rec->shared || !cJSON_IsObject(new_with) || !live_equal_except(old_with, new_with, "do")) return false;
+    cJSON *old_do = cJSON_GetObjectItemCaseSensitive(old_with, "do");
+    cJSON *new_do = cJSON_GetObjectItemCaseSensitive(new_with, "do");
+    return cJSON_IsObject(old_do) && cJSON_IsObject(new_do) && live_attrs_patchable(d, old_do, new_do);
+}
+
+// Whether new_attrs can be applied over old_attrs in place. Members are paired by position, so
+// repeated keys ('with') work and the order in which setters ran is kept. Nothing is modified.
+static bool live_attrs_patchable(live_diff_t *d, cJSON *old_attrs, cJSON *new_attrs) {
+    cJSON *old_children = NULL, *new_children = NULL;
+    cJSON *old_item = old_attrs->child, *item = new_attrs->child;
+    while (old_item || item) {
+        if (old_item && old_item->string && strcmp(old_item->string, "children") == 0) {
+            old_children = old_item;
+            old_item = old_item->next;
+            continue;
+        }
+        if (item && item->string && strcmp(item->string, "children") == 0) {
+            new_children = item;
+            item = item->next;
+            continue;
+        }
+        // Added, removed or reordered properties: setters cannot be undone, use a fresh widget
+        if (!old_item || !item || !old_item->string || !item->string || strcmp(old_item->string, item->string) != 0) {
+            return false;
+        }
+        if (strcmp(item->string, "with") == 0) {
+            if (!live_with_patchable(d, old_item, item)) return false;
+        } else if (live_attr_is_structural(item->string) && !cJSON_Compare(old_item, item, true)) {
+            return false;
+        }
+        old_item = old_item->next;
+        item = item->next;
+    }
+    if ((old_children && !cJSON_IsArray(old_children)) || (new_children && !cJSON_IsArray(new_children))) {
+        return false;
+    }
+    // Children of a lazy container may not exist yet, or were rendered outside the live UI
+    return !lazy_requested(old_attrs) || (old_children && new_children && cJSON_Compare(old_children, new_children, true));
+}
+
+static live_diff_result_t live_patch_attrs(live_diff_t *d, live_node_t *rec, cJSON *old_attrs, cJSON *new_attrs);
+
+static live_diff_result_t live_patch_with(live_diff_t *d, cJSON *old_with, cJSON *new_with) {
+    live_node_t *rec = live_map_find(&d->ui->map, old_with);
+    if (!rec || rec->shared) return LIVE_DIFF_OK; // Unchanged (see live_with_patchable())
+    rec = live_map_move(d, rec, new_with);
+    if (!rec) return LIVE_DIFF_REBUILD;
+    return live_patch_attrs(d, rec, cJSON_GetObjectItemCaseSensitive(old_with, "do"), cJSON_GetObjectItemCaseSensitive(new_with, "do"));
+}
+
+// Applies new_attrs over old_attrs on the target of `rec` (a widget, a use-view instance's root or
+// a 'with' target), which live_attrs_patchable() allowed: changed setters run again, children and
+// 'with' blocks are diffed in turn.
+static live_diff_result_t live_patch_attrs(live_diff_t *d, live_node_t *rec, cJSON *old_attrs, cJSON *new_attrs) {
+    cJSON *old_children = NULL, *new_children = NULL;
+    cJSON *patch = NULL;
+    uint32_t changed = 0;
+    cJSON *old_item = old_attrs->child;
+    for (cJSON *item = new_attrs->child; item; item = item->next) {
+        if (strcmp(item->string, "children") == 0) {
+            new_children = item;
+            continue;
+        }
+        for (; strcmp(old_item->string, "children") == 0; old_item = old_item->next) old_children = old_item;
+        if (strcmp(item->string, "with") != 0 && !cJSON_Compare(old_item, item, true)) {
+            if (!patch) patch = cJSON_CreateObject();
+            if (patch) cJSON_AddItemReferenceToObject(patch, item->string, item);
+            changed++;
+        }
+        old_item = old_item->next;
+    }
+    for (; old_item; old_item = old_item->next) {
+        if (strcmp(old_item->string, "children") == 0) old_children = old_item;
+    }
+
+    bool ok = !changed || patch;
+    if (patch) {
+        char type_name_for_registry[64];
+        snprintf(type_name_for_registry, sizeof(type_name_for_registry), "lv_%s_t", rec->create_type);
+#if LVGL_JSON_STYLE_SHARING
+        // A changed value is set locally, on top of the shared style that holds the old one
+        bool saved_style_sharing = g_style_share_enabled;
+        g_style_share_enabled = false;
+#endif
+        ok = apply_setters_and_attributes(patch, rec->obj, rec->actual_type, rec->create_type, true,
+                                          rec->obj, rec->path, type_name_for_registry);
+#if LVGL_JSON_STYLE_SHARING
+        g_style_share_enabled = saved_style_sharing;
+#endif
+        cJSON_Delete(patch);
+        d->stats->widgets_patched++;
+        d->stats->properties_set += changed;
+    }
+
+    live_diff_result_t result = ok ? LIVE_DIFF_OK : LIVE_DIFF_REBUILD;
+    if (result == LIVE_DIFF_OK && (old_children || new_children)) {
+        char buf[REGISTRY_PATH_BUF_SIZE];
+        char *children_prefix = live_children_prefix(new_attrs, rec, buf);
+        result = live_diff_children(d, old_children ? old_children->child : NULL, new_children ? new_children->child : NULL,
+                                    rec->obj, children_prefix);
+        registry_path_free(children_prefix, buf);
+    }
+    // 'with' targets after the children, as apply_setters_and_attributes() may have created them there
+    old_item = old_attrs->child;
+    for (cJSON *item = new_attrs->child; result == LIVE_DIFF_OK && item; item = item->next) {
+        if (strcmp(item->string, "children") == 0) continue;
+        while (strcmp(old_item->string, "children") == 0) old_item = old_item->next;
+        if (strcmp(item->string, "with") == 0) result = live_patch_with(d, old_item, item);
+        old_item = old_item->next;
+    }
+    return result;
+}
+
+// A use-view instance: changes to its 'do' block are patched onto the component's root, any other
+// change renders the instance again. So does a component defined again under the same id.
+static live_diff_result_t live_diff_view(live_diff_t *d, live_node_t *rec, cJSON *old_node, cJSON *new_node) {
+    cJSON *id = cJSON_GetObjectItemCaseSensitive(new_node, "id");
+    if (!live_equal_except(old_node, new_node, "do") || !cJSON_IsString(id) || id->valuestring[0] != '@' ||
+        lvgl_json_get_registered_ptr(id->valuestring + 1, "component_def") != rec->component) {
+        return LIVE_DIFF_REPLACE;
+    }
+    cJSON *old_do = cJSON_GetObjectItemCaseSensitive(old_node, "do");
+    cJSON *new_do = cJSON_GetObjectItemCaseSensitive(new_node, "do");
+    bool patch_do = cJSON_IsObject(old_do) && cJSON_IsObject(new_do);
+    if (patch_do ? !live_attrs_patchable(d, old_do, new_do) : !(old_do == new_do || cJSON_Compare(old_do, new_do, true))) {
+        return LIVE_DIFF_REPLACE;
+    }
+    rec = live_map_move(d, rec, new_node);
+    if (!rec) return LIVE_DIFF_REBUILD;
+    d->stats->widgets_kept++;
+    if (!patch_do) return LIVE_DIFF_OK;
+
+    // The 'do' block was applied in the instance's context
+    render_scope_t *saved_scope = get_current_context();
+    render_scope_t scope;
+    cJSON *context = cJSON_GetObjectItemCaseSensitive(new_node, "context");
+    if (cJSON_IsObject(context)) push_context(&scope, context);
+    live_diff_result_t result = live_patch_attrs(d, rec, old_do, new_do);
+    set_current_context(saved_scope);
+    return result;
+}
+
+// Patches the widget of old_node in place; its object and path come from the live map.
+static live_diff_result_t live_diff_node(live_diff_t *d, cJSON *old_node, cJSON *new_node) {
+    live_node_t *rec = live_map_find(&d->ui->map, old_node);
+    if (!rec || rec->shared) {
+        // Styles and components are not tracked; if they changed, widgets anywhere may depend on
+        // them. Neither are nodes with several widgets.
+        return cJSON_Compare(old_node, new_node, true) ? LIVE_DIFF_OK : LIVE_DIFF_REBUILD;
+    }
+    if (!cJSON_IsObject(new_node)) return LIVE_DIFF_REBUILD;
+    if (rec->kind == LIVE_NODE_VIEW) return live_diff_view(d, rec, old_node, new_node);
+    if (!live_attrs_patchable(d, old_node, new_node)) return LIVE_DIFF_REPLACE;
+
+    rec = live_map_move(d, rec, new_node);
+    if (!rec) return LIVE_DIFF_REBUILD; // A new node in two places
+    d->stats->widgets_kept++;
+
+    render_scope_t *saved_scope = get_current_context();
+    render_scope_t scope;
+    cJSON *context = cJSON_GetObjectItemCaseSensitive(new_node, "context");
+    if (cJSON_IsObject(context)) push_context(&scope, context);
+    live_diff_result_t result = live_patch_attrs(d, rec, old_node, new_node);
+    set_current_context(saved_scope);
+    return result;
+}
+
+// Nodes with the same type, id and name are taken to be the same widget (possibly edited).
+static bool live_same_identity(cJSON *a, cJSON *b) {
+    static const char *const keys[] = { "type", "id", "named" };
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); ++i) {
+        cJSON *va = cJSON_GetObjectItemCaseSensitive(a, keys[i]);
+        cJSON *vb = cJSON_GetObjectItemCaseSensitive(b, keys[i]);
+        if ((va || vb) && !(va && vb && cJSON_Compare(va, vb, true))) return false;
+    }
+    return true;
+}
+
+static live_diff_result_t live_diff_pair(live_diff_t *d, cJSON *old_node, cJSON *new_node, lv_obj_t *parent, const char *prefix);
+
+// A context wrapper: with the same values its 'for' node is diffed in their scope, otherwise the
+// wrapper is rendered again.
+static live_diff_result_t live_diff_context(live_diff_t *d, cJSON *old_node, cJSON *new_node, lv_obj_t *parent, const char *prefix) {
+    cJSON *values = cJSON_GetObjectItemCaseSensitive(new_node, "values");
+    cJSON *old_for = cJSON_GetObjectItemCaseSensitive(old_node, "for");
+    cJSON *new_for = cJSON_GetObjectItemCaseSensitive(new_node, "for");
+    if (!cJSON_IsObject(values) || !cJSON_IsObject(old_for) || !cJSON_IsObject(new_for) ||
+        !live_equal_except(old_node, new_node, "for")) {
+        return cJSON_Compare(old_node, new_node, true) ? LIVE_DIFF_OK : LIVE_DIFF_REPLACE;
+    }
+    render_scope_t *saved_scope = get_current_context();
+    render_scope_t scope;
+    push_context(&scope, values);
+    live_diff_result_t result = live_diff_pair(d, old_for, new_for, parent, prefix);
+    set_current_context(saved_scope);
+    return result;
+}
+
+static live_diff_result_t live_diff_pair(live_diff_t *d, cJSON *old_node, cJSON *new_node, lv_obj_t *parent, const char *prefix) {
+    live_diff_result_t result = live_is_context(old_node) && live_is_context(new_node) ?
+        live_diff_context(d, old_node, new_node, parent, prefix) : live_diff_node(d, old_node, new_node);
+    if (result == LIVE_DIFF_REPLACE) result = live_replace(d, old_node, new_node, parent, prefix);
+    return result;
+}
+
+// Diffs two sibling lists. New nodes are matched to the next old node with the same identity
+// within a few siblings, so inserting or removing a node leaves its siblings alone; old nodes
+// skipped over are deleted, and new nodes without a match are created in place.
+static live_diff_result_t live_diff_children(live_diff_t *d, cJSON *old_first, cJSON *new_first, lv_obj_t *parent, const char *prefix) {
+    uint32_t old_count = 0;
+    for (cJSON *n = old_first; n; n = n->next) old_count++;
+    cJSON **old_nodes = NULL;
+    if (old_count) {
+        old_nodes = (cJSON **)render_scratch_alloc(old_count * sizeof(cJSON *));
+        if (!old_nodes) return LIVE_DIFF_REBUILD;
+        uint32_t i = 0;
+        for (cJSON *n = old_first; n; n = n->next) old_nodes[i++] = n;
+    }
+
+    live_diff_result_t result = LIVE_DIFF_OK;
+    uint32_t next_old = 0; // Old nodes before this one are paired or deleted
+    for (cJSON *new_node = new_first; result == LIVE_DIFF_OK && new_node; new_node = new_node->next) {
+        uint32_t limit = old_count - next_old > LIVE_DIFF_LOOKAHEAD ? next_old + LIVE_DIFF_LOOKAHEAD : old_count;
+        uint32_t match = next_old;
+        while (match < limit && !live_same_identity(old_nodes[match], new_node)) match++;
+        if (match < limit) {
+            for (; result == LIVE_DIFF_OK && next_old < match; ++next_old) {
+                if (!live_delete(d, old_nodes[next_old])) result = LIVE_DIFF_REBUILD;
+            }
+            if (result == LIVE_DIFF_OK) result = live_diff_pair(d, old_nodes[next_old++], new_node, parent, prefix);
+        } else {
+            // Goes in front of the widget of the next old node, or last
+            int32_t index = -1;
+            for (uint32_t i = next_old; index < 0 && i < old_count; ++i) {
+                live_node_t *rec = live_node_widget(&d->ui->map, old_nodes[i]);
+                if (rec && !rec->shared) index = lv_obj_get_index(rec->obj);
+            }
+            if (!live_create(d, new_node, parent, prefix, index, NULL)) result = LIVE_DIFF_REBUILD;
+        }
+    }
+    for (; result == LIVE_DIFF_OK && next_old < old_count; ++next_old) {
+        if (!live_delete(d, old_nodes[next_old])) result = LIVE_DIFF_REBUILD;
+    }
+    render_scratch_free(old_nodes, old_count * sizeof(cJSON *));
+    return result == LIVE_DIFF_OK ? LIVE_DIFF_OK : LIVE_DIFF_REBUILD;
+}
+
+lvgl_json_live_ui_t *lvgl_json_live_ui_create(lv_obj_t *parent) {
+    lvgl_json_live_ui_t *ui = (lvgl_json_live_ui_t *)mem_alloc(LVGL_JSON_MEM_OTHER, sizeof(lvgl_json_live_ui_t));
+    if (!ui) {
+        LOG_ERR("Live UI Error: Out of memory.");
+        return NULL;
+    }
+    RENDER_STAT_INC(heap_allocs);
+    memset(ui, 0, sizeof(*ui));
+    ui->parent = parent ? parent : lv_screen_active();
+    return ui;
+}
+
+// Marks the '!' strings in `node` (see unmarshal_value()) that are pooled as static again.
+static void live_mark_static_strings(const cJSON *node) {
+    for (; node; node = node->next) {
+        const char *s = cJSON_IsString(node) ? node->valuestring : NULL;
+        size_t len = s ? strlen(s) : 0;
+        if (len > 1 && s[0] == '!' && s[len - 1] != '!') {
+            const char *pooled = str_pool_lookup(s + 1, len - 1);
+            if (pooled) STR_POOL_ENTRY(pooled)->is_static = true;
+        }
+        if (node->child) live_mark_static_strings(node->child);
+    }
+}
+
+// After a patch, releases the lvgl_json_register_str() strings the new spec no longer uses.
+// Kept widgets only point to strings of values that did not change, so those are in the new
+// spec too (as are the contexts '$' values come from); a full render releases them all.
+static void live_release_static_strings(const cJSON *spec) {
+    str_pool_unmark_static();
+    live_mark_static_strings(spec);
+    str_pool_compact();
+}
+
+bool lvgl_json_live_ui_update(lvgl_json_live_ui_t *ui, cJSON *spec, lvgl_json_live_stats_t *stats) {
+    lvgl_json_live_stats_t local_stats;
+    if (!stats) stats = &local_stats;
+    memset(stats, 0, sizeof(*stats));
+    if (!ui || !spec) {
+        LOG_ERR("Live UI Error: Invalid arguments.");
+        if (spec) cJSON_Delete(spec);
+        return false;
+    }
+
+    live_diff_t d = { ui, { NULL, 0, 0 }, stats };
+    live_map_t *saved_capture = g_live_capture;
+    g_live_capture = &d.next;
+
+    bool rebuild = !ui->spec || cJSON_IsArray(ui->spec) != cJSON_IsArray(spec);
+    if (!rebuild) {
+        render_pass_begin();
+        render_scope_t *saved_scope = get_current_context();
+        cJSON *old_first = cJSON_IsArray(ui->spec) ? ui->spec->child : ui->spec;
+        cJSON *new_first = cJSON_IsArray(spec) ? spec->child : spec;
+        rebuild = live_diff_children(&d, old_first, new_first, ui->parent, NULL) != LIVE_DIFF_OK;
+        set_current_context(saved_scope);
+        render_pass_end();
+    }
+
+    bool success = true;
+    if (rebuild) {
+        live_map_clear(&d.next);
+        memset(stats, 0, sizeof(*stats));
+        stats->full_render = true;
+        lv_obj_clean(ui->parent);
+        lvgl_json_register_str_clear();
+        lvgl_json_shared_styles_clear();
+        success = lvgl_json_render_ui(spec, ui->parent);
+    } else {
+        live_release_static_strings(spec);
+    }
+    g_live_capture = saved_capture;
+
+    live_map_clear(&ui->map);
+    ui->map = d.next;
+    if (ui->spec) cJSON_Delete(ui->spec);
+    ui->spec = spec;
+    LOG_INFO("Live UI: %s, %u widgets kept (%u patched, %u properties), %u created, %u deleted.",
+             stats->full_render ? "full render" : "patched", (unsigned)stats->widgets_kept, (unsigned)stats->widgets_patched,
+             (unsigned)stats->properties_set, (unsigned)stats->subtrees_created, (unsigned)stats->subtrees_deleted);
+    return success;
+}
+
+void lvgl_json_live_ui_free(lvgl_json_live_ui_t *ui) {
+    if (!ui) return;
+    live_map_clear(&ui->map);
+    if (ui->spec) cJSON_Delete(ui->spec);
+    mem_free(LVGL_JSON_MEM_OTHER, ui, sizeof(*ui));
+}
+
+#endif // LVGL_JSON_USE_LIVE
+"""
@@ -0,0 +1,276 @@
+# code_gen/log_sink.py
+import bisect
+import logging
+import re
+
+logger = logging.getLogger(__name__)
+
+# Log calls in the generated source are given a site ID: LOG_ERR("...") becomes
+# LOG_ERR_ID(0x..., "..."), and the ring buffer sink stores the ID as the record's code.
+# The ID is a hash of the enclosing function, the format string and its occurrence in that
+# function, so it survives regeneration as long as that call is unchanged, unlike __LINE__.
+LOG_CALL_RE = re.compile(r'\bLOG_(ERR|WARN|INFO|DEBUG)(_JSON)?\(')
+FUNCTION_HEAD_RE = re.compile(r'^(?!typedef\b|return\b|else\b|if\b)[A-Za-z_][\w \t\*]*?\b([A-Za-z_]\w*)\s*\([^;]*$')
+LOG_SITE_ID_MASK = 0x7FFFFFFF # The top bit marks __LINE__ codes of log calls outside the renderer
+
+
+def _fnv1a(text):
+    h = 0x811C9DC5
+    for b in text.encode('utf-8'):
+        h = ((h ^ b) * 0x01000193) & 0xFFFFFFFF
+    return h
+
+
+def _skip_c_string(src, i):
+    """Returns the index after the C string literal starting at src[i] == '"'."""
+    i += 1
+    while src[i] != '"':
+        i += 2 if src[i] == '\\' else 1
+    return i + 1
+
+
+def _format_arg(src, start, skip_first):
+    """Source text of the format argument of a log call whose arguments start at `start`."""
+    i, depth = start, 0
+    if skip_first: # The JSON node comes first
+        while depth or src[i] != ',':
+            if src[i] == '"': i = _skip_c_string(src, i); continue
+            if src[i] in '([{': depth += 1
+            elif src[i] in ')]}': depth -= 1
+            i += 1
+        i += 1
+    while src[i].isspace():
+        i += 1
+    if src[i] != '"':
+        return src[i:src.find(',', i)] # Not a literal, e.g. a macro; good enough as a key
+    end = i
+    while src[end] == '"': # Adjacent literals are one string
+        end = _skip_c_string(src, end)
+        while src[end].isspace():
+            end += 1
+    return src[i:end].rstrip()
+
+
+def assign_log_site_ids(c_source):
+    """
+    Rewrites every LOG_<LEVEL>[_JSON]( call in the generated C source to LOG_<LEVEL>[_JSON]_ID(<id>, .
+    tools/lvgl_log_decode.py maps the IDs back to the calls.
+    """
+    line_starts = [0] + [m.end() for m in re.finditer('\n', c_source)]
+    lines = c_source.split('\n')
+    heads = [(n, m.group(1)) for n, line in enumerate(lines) if (m := FUNCTION_HEAD_RE.match(line))]
+    head_lines = [n for n, _ in heads]
+
+    out, pos, used, occurrences = [], 0, {}, {}
+    for m in LOG_CALL_RE.finditer(c_source):
+        line_no = bisect.bisect_right(line_starts, m.start()) - 1
+        line = lines[line_no]
+        column = m.start() - line_starts[line_no]
+        if '//' in line[:column] or line.lstrip().startswith(('*', '/*', '#define LOG_')):
+            continue # Comments and the macros themselves
+        h = bisect.bisect_right(head_lines, line_no) - 1
+        function = heads[h][1] if h >= 0 else ''
+        key = (function, _format_arg(c_source, m.end(), m.group(2) is not None))
+        occurrence = occurrences.get(key, 0)
+        occurrences[key] = occurrence + 1
+        site_id = _fnv1a(f'{key[0]}\0{key[1]}\0{occurrence}') & LOG_SITE_ID_MASK
+        while site_id == 0 or site_id in used: # Rare; bumped in source order
+            site_id = (site_id + 1) & LOG_SITE_ID_MASK
+        used[site_id] = key
+        out.append(c_source[pos:m.end() - 1])
+        out.append(f'_ID(0x{site_id:08x}, ')
+        pos = m.end()
+    out.append(c_source[pos:])
+    logger.info(f"Assigned IDs to {len(used)} log calls.")
+    return ''.join(out)
+
+
+def generate_log_sink():
+    """
+    Generates the ring buffer log sink (LVGL_JSON_LOG_SINK_RING=1).
+
+    Log calls store a fixed-size record in a single-producer/single-consumer ring instead of
+    writing to stdio: the log site's ID, the id of the node being rendered, the property name
+    and a raw copy of the JSON value. The JSON is not serialized at log time;
+    lvgl_json_log_format() builds the text when records are drained, and
+    tools/lvgl_log_decode.py decodes raw dumps.
+
+    The message itself is still formatted by the producer: '%s' arguments are mostly names
+    and paths that are freed once the render pass is over, so they would have to be copied
+    anyway, and copying typed varargs means parsing the format at log time, which costs about
+    what vsnprintf into the record does for messages this short.
+    """
+    return r"""
+// --- Ring Buffer Log Sink ---
+
+#if LVGL_JSON_LOG_SINK_RING
+
+#if (LVGL_JSON_LOG_RING_RECORDS & (LVGL_JSON_LOG_RING_RECORDS - 1)) != 0
+#error "LVGL_JSON_LOG_RING_RECORDS must be a power of two"
+#endif
+
+// One producer: the renderer, like LVGL, runs on one thread, and application log calls must
+// come from that thread too. head is published with release stores so the consumer never reads
+// a record that is still being written; seq and dropped are atomic so they can be read anywhere.
+typedef struct {
+    lvgl_json_log_record_t records[LVGL_JSON_LOG_RING_RECORDS];
+    uint32_t head;      // Next record to write, only advanced by the producer
+    uint32_t tail;      // Next record to drain, only advanced by the consumer
+    uint32_t seq;       // Log calls so far, dropped ones included
+    uint32_t dropped;
+} log_ring_t;
+
+static log_ring_t g_log_ring;
+static const cJSON *g_log_render_node = NULL; // Node render_json_node() is working on
+
+static void log_copy_str(char *dest, size_t size, const char *src, uint8_t *flags) {
+    size_t len = src ? strlen(src) : 0;
+    if (len >= size) {
+        len = size - 1;
+        if (flags) *flags |= LVGL_JSON_LOG_FLAG_TRUNCATED;
+    }
+    if (len) memcpy(dest, src, len);
+    dest[len] = '\0';
+}
+
+static const char* log_node_name(const cJSON *node) {
+    static const char *const keys[] = { "id", "named", "type" };
+    for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); ++i) {
+        cJSON *item = cJSON_GetObjectItemCaseSensitive(node, keys[i]);
+        if (cJSON_IsString(item) && item->valuestring) return item->valuestring;
+    }
+    return "obj";
+}
+
+void lvgl_json_log_write(uint8_t level, uint32_t code, const cJSON *json, const char *fmt, ...) {
+    uint32_t seq = __atomic_fetch_add(&g_log_ring.seq, 1, __ATOMIC_RELAXED);
+    uint32_t head = __atomic_load_n(&g_log_ring.head, __ATOMIC_RELAXED); // Only this thread stores it
+    if (head - __atomic_load_n(&g_log_ring.tail, __ATOMIC_ACQUIRE) >= LVGL_JSON_LOG_RING_RECORDS) {
+        __atomic_fetch_add(&g_log_ring.dropped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+    lvgl_json_log_record_t *rec = &g_log_ring.records[head & (LVGL_JSON_LOG_RING_RECORDS - 1)];
+    memset(rec, 0, sizeof(*rec));
+    rec->seq = seq;
+    rec->code = code;
+    rec->level = level;
+
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(rec->message, sizeof(rec->message), fmt, args);
+    va_end(args);
+
+    if (g_log_render_node) log_copy_str(rec->node_id, sizeof(rec->node_id), log_node_name(g_log_render_node), NULL);
+    if (json) {
+        log_copy_str(rec->property, sizeof(rec->property), json->string, NULL);
+        switch (json->type & 0xFF) {
+            case cJSON_NULL: rec->value_type = LVGL_JSON_LOG_VALUE_NULL; break;
+            case cJSON_False: rec->value_type = LVGL_JSON_LOG_VALUE_FALSE; break;
+            case cJSON_True: rec->value_type = LVGL_JSON_LOG_VALUE_TRUE; break;
+            case cJSON_Number:
+                rec->value_type = LVGL_JSON_LOG_VALUE_NUMBER;
+                rec->number = json->valuedouble;
+                break;
+            case cJSON_String:
+            case cJSON_Raw:
+                rec->value_type = LVGL_JSON_LOG_VALUE_STRING;
+                log_copy_str(rec->value, sizeof(rec->value), json->valuestring, &rec->flags);
+                break;
+            case cJSON_Array: rec->value_type = LVGL_JSON_LOG_VALUE_ARRAY; break;
+            case cJSON_Object: {
+                // The node type is usually enough to recognize an object
+                rec->value_type = LVGL_JSON_LOG_VALUE_OBJECT;
+                cJSON *type_item = cJSON_GetObjectItemCaseSensitive(json, "type");
+                if (cJSON_IsString(type_item)) log_copy_str(rec->value, sizeof(rec->value), type_item->valuestring, &rec->flags);
+                break;
+            }
+            default: break;
+        }
+    }
+    __atomic_store_n(&g_log_ring.head, head + 1, __ATOMIC_RELEASE);
+}
+
+size_t lvgl_json_log_drain(lvgl_json_log_record_t *out, size_t max_records) {
+    if (!out) return 0;
+    uint32_t tail = g_log_ring.tail;
+    uint32_t head = __atomic_load_n(&g_log_ring.head, __ATOMIC_ACQUIRE);
+    size_t count = 0;
+    while (tail != head && count < max_records) {
+        out[count++] = g_log_ring.records[tail & (LVGL_JSON_LOG_RING_RECORDS - 1)];
+        tail++;
+    }
+    __atomic_store_n(&g_log_ring.tail, tail, __ATOMIC_RELEASE);
+    return count;
+}
+
+uint32_t lvgl_json_log_dropped(void) {
+    return __atomic_load_n(&g_log_ring.dropped, __ATOMIC_RELAXED);
+}
+
+// Appends to buf at *pos like snprintf, keeping *pos within size
+static void log_append(char *buf, size_t size, size_t *pos, const char *fmt, ...) {
+    if (*pos >= size) return;
+    va_list args;
+    va_start(args, fmt);
+    int n = vsnprintf(buf + *pos, size - *pos, fmt, args);
+    va_end(args);
+    if (n > 0) *pos = (*pos + (size_t)n < size) ? *pos + (size_t)n : size - 1;
+}
+
+static void log_append_json_str(char *buf, size_t size, size_t *pos, const char *s, bool truncated) {
+    log_append(buf, size, pos, "\"");
+    for (; *s; ++s) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') log_append(buf, size, pos, "\\%c", c);
+        else if (c < 0x20) log_append(buf, size, pos, "\\u%04x", c);
+        else log_append(buf, size, pos, "%c", c);
+    }
+    log_append(buf, size, pos, truncated ? "...\"" : "\"");
+}
+
+int lvgl_json_log_format(const lvgl_json_log_record_t *rec, char *buf, size_t size) {
+    static const char *const level_names[] = { "NONE", "ERROR", "WARN", "INFO", "DEBUG" };
+    if (!rec || !buf || size == 0) return 0;
+    size_t pos = 0;
+    buf[0] = '\0';
+    const char *level = rec->level < sizeof(level_names) / sizeof(level_names[0]) ? level_names[rec->level] : "?";
+    if (rec->code & LVGL_JSON_LOG_CODE_LINE) {
+        log_append(buf, size, &pos, "%s: [#%u line %u", level, (unsigned)rec->seq, (unsigned)(rec->code & ~LVGL_JSON_LOG_CODE_LINE));
+    } else {
+        log_append(buf, size, &pos, "%s: [#%u site %08x", level, (unsigned)rec->seq, (unsigned)rec->code);
+    }
+    if (rec->node_id[0]) log_append(buf, size, &pos, " node '%s'", rec->node_id);
+    log_append(buf, size, &pos, "] %s", rec->message);
+    if (rec->value_type == LVGL_JSON_LOG_VALUE_NONE) return (int)pos;
+
+    // The JSON snippet is only built here, not when the record was logged
+    bool truncated = (rec->flags & LVGL_JSON_LOG_FLAG_TRUNCATED) != 0;
+    log_append(buf, size, &pos, " [Near JSON: ");
+    if (rec->property[0]) {
+        log_append_json_str(buf, size, &pos, rec->property, false);
+        log_append(buf, size, &pos, ": ");
+    }
+    switch (rec->value_type) {
+        case LVGL_JSON_LOG_VALUE_NULL: log_append(buf, size, &pos, "null"); break;
+        case LVGL_JSON_LOG_VALUE_FALSE: log_append(buf, size, &pos, "false"); break;
+        case LVGL_JSON_LOG_VALUE_TRUE: log_append(buf, size, &pos, "true"); break;
+        case LVGL_JSON_LOG_VALUE_NUMBER: log_append(buf, size, &pos, "%g", rec->number); break;
+        case LVGL_JSON_LOG_VALUE_STRING: log_append_json_str(buf, size, &pos, rec->value, truncated); break;
+        case LVGL_JSON_LOG_VALUE_ARRAY: log_append(buf, size, &pos, "[...]"); break;
+        case LVGL_JSON_LOG_VALUE_OBJECT:
+            if (rec->value[0]) {
+                log_append(buf, size, &pos, "{\"type\": ");
+                log_append_json_str(buf, size, &pos, rec->value, truncated);
+                log_append(buf, size, &pos, ", ...}");
+            } else {
+                log_append(buf, size, &pos, "{...}");
+            }
+            break;
+        default: break;
+    }
+    log_append(buf, size, &pos, "]");
+    return (int)pos;
+}
+
+#endif // LVGL_JSON_LOG_SINK_RING
+"""
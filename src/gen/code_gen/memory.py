@@ -0,0 +1,192 @@
+# code_gen/memory.py
+import logging
+
+logger = logging.getLogger(__name__)
+
+
+def generate_memory_accounting():
+    """
+    Generates the heap accounting used by every allocation of the renderer.
+
+    mem_alloc()/mem_realloc()/mem_free() wrap LV_MALLOC/LV_REALLOC/LV_FREE and add the size to
+    one of the LVGL_JSON_MEM_* categories. Callers pass the size again when freeing (they all
+    know it: table capacities, string lengths, struct sizes), so blocks carry no header and
+    can still be handed to code that frees them with lv_free(). The outermost render pass also
+    snapshots LVGL's heap with lv_mem_monitor() when it begins and ends.
+    """
+    return r"""
+// --- Memory Accounting ---
+
+#ifndef LVGL_JSON_MEM_LVGL_SNAPSHOTS
+#define LVGL_JSON_MEM_LVGL_SNAPSHOTS 1 // lv_mem_monitor() around each render
+#endif
+
+typedef struct {
+    const char *create_name; // Create function of the widget type (invoke table name)
+    uint32_t count;
+} mem_widget_count_t;
+
+typedef struct {
+    uint32_t bytes[LVGL_JSON_MEM_CATEGORY_COUNT];
+    uint32_t peak_bytes[LVGL_JSON_MEM_CATEGORY_COUNT];
+    uint32_t allocs[LVGL_JSON_MEM_CATEGORY_COUNT];
+    mem_widget_count_t widgets[LVGL_JSON_MEM_REPORT_WIDGET_TYPES]; // The rest are counted as other
+    uint32_t widget_types;
+    uint32_t widgets_other;
+    int pass_depth;
+    bool lvgl_heap_valid;
+    lvgl_json_heap_snapshot_t lvgl_before;
+    lvgl_json_heap_snapshot_t lvgl_after;
+} mem_accounting_t;
+
+static mem_accounting_t g_mem;
+
+static void mem_account(uint8_t cat, size_t size) {
+    g_mem.bytes[cat] += (uint32_t)size;
+    g_mem.allocs[cat]++;
+    if (g_mem.bytes[cat] > g_mem.peak_bytes[cat]) g_mem.peak_bytes[cat] = g_mem.bytes[cat];
+}
+
+static void mem_unaccount(uint8_t cat, size_t size) {
+    g_mem.bytes[cat] = g_mem.bytes[cat] > size ? g_mem.bytes[cat] - (uint32_t)size : 0;
+}
+
+static void* mem_alloc(uint8_t cat, size_t size) {
+    void *ptr = LV_MALLOC(size);
+    if (ptr) mem_account(cat, size);
+    return ptr;
+}
+
+// `old_size` is the size of `ptr`, 0 if it is NULL.
+static void* mem_realloc(uint8_t cat, void *ptr, size_t old_size, size_t new_size) {
+    void *fresh = LV_REALLOC(ptr, new_size);
+    if (!fresh) return NULL;
+    mem_unaccount(cat, old_size);
+    mem_account(cat, new_size);
+    return fresh;
+}
+
+static void mem_free(uint8_t cat, void *ptr, size_t size) {
+    if (!ptr) return;
+    mem_unaccount(cat, size);
+    LV_FREE(ptr);
+}
+
+// Approximate heap held by a cJSON tree allocated outside the render arena
+static size_t mem_json_bytes(const cJSON *node) {
+    size_t bytes = 0;
+    for (; node; node = node->next) {
+        bytes += sizeof(cJSON);
+        if (node->string && !(node->type & cJSON_StringIsConst)) bytes += strlen(node->string) + 1;
+        if (node->valuestring && !(node->type & cJSON_IsReference)) bytes += strlen(node->valuestring) + 1;
+        if (node->child && !(node->type & cJSON_IsReference)) bytes += mem_json_bytes(node->child);
+    }
+    return bytes;
+}
+
+static void mem_count_widget(const char *create_name) {
+    for (uint32_t i = 0; i < g_mem.widget_types; ++i) {
+        if (g_mem.widgets[i].create_name == create_name) {
+            g_mem.widgets[i].count++;
+            return;
+        }
+    }
+    if (g_mem.widget_types < LVGL_JSON_MEM_REPORT_WIDGET_TYPES) {
+        g_mem.widgets[g_mem.widget_types].create_name = create_name;
+        g_mem.widgets[g_mem.widget_types++].count = 1;
+    } else {
+        g_mem.widgets_other++;
+    }
+}
+
+static void mem_snapshot_lvgl(lvgl_json_heap_snapshot_t *out) {
+    lv_mem_monitor_t mon;
+    memset(&mon, 0, sizeof(mon));
+    lv_mem_monitor(&mon);
+    out->total_size = (uint32_t)mon.total_size;
+    out->free_size = (uint32_t)mon.free_size;
+    out->free_biggest_size = (uint32_t)mon.free_biggest_size;
+    out->used_pct = mon.used_pct;
+    out->frag_pct = mon.frag_pct;
+}
+
+static void mem_reset_widget_counts(void) {
+    memset(g_mem.widgets, 0, sizeof(g_mem.widgets));
+    g_mem.widget_types = 0;
+    g_mem.widgets_other = 0;
+}
+
+// Called by render_pass_begin()/render_pass_end(); only the outermost pass takes snapshots.
+static void mem_pass_begin(void) {
+    if (g_mem.pass_depth++ > 0 || !LVGL_JSON_MEM_LVGL_SNAPSHOTS) return;
+    mem_snapshot_lvgl(&g_mem.lvgl_before);
+}
+
+static void mem_pass_end(void) {
+    if (--g_mem.pass_depth > 0 || !LVGL_JSON_MEM_LVGL_SNAPSHOTS) return;
+    mem_snapshot_lvgl(&g_mem.lvgl_after);
+    g_mem.lvgl_heap_valid = true;
+}
+"""
+
+
+def generate_memory_report():
+    """Generates lvgl_json_get_memory_report(), which needs the registry and string pool."""
+    return r"""
+// --- Memory Report ---
+
+static const char *const g_mem_category_names[LVGL_JSON_MEM_CATEGORY_COUNT] = {
+    "registry", "templates", "grid", "styles", "strings", "temporary", "other"
+};
+
+const char* lvgl_json_mem_category_name(lvgl_json_mem_category_t category) {
+    return (unsigned)category < LVGL_JSON_MEM_CATEGORY_COUNT ? g_mem_category_names[category] : "?";
+}
+
+// "lv_button_create" -> "button"
+static void mem_widget_type_name(char *dest, size_t size, const char *create_name) {
+    size_t len = strlen(create_name);
+    if (len > 10 && strncmp(create_name, "lv_", 3) == 0 && strcmp(create_name + len - 7, "_create") == 0) {
+        create_name += 3;
+        len -= 10;
+    }
+    if (len >= size) len = size - 1;
+    memcpy(dest, create_name, len);
+    dest[len] = '\0';
+}
+
+void lvgl_json_get_memory_report(lvgl_json_memory_report_t *out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    for (int c = 0; c < LVGL_JSON_MEM_CATEGORY_COUNT; ++c) {
+        out->bytes[c] = g_mem.bytes[c];
+        out->peak_bytes[c] = g_mem.peak_bytes[c];
+        out->allocs[c] = g_mem.allocs[c];
+        out->total_bytes += g_mem.bytes[c];
+    }
+
+    out->lvgl_heap_valid = g_mem.lvgl_heap_valid;
+    out->lvgl_before = g_mem.lvgl_before;
+    out->lvgl_after = g_mem.lvgl_after;
+
+    for (uint32_t i = 0; i < g_mem.widget_types; ++i) {
+        mem_widget_type_name(out->widget_types[i].type, sizeof(out->widget_types[i].type), g_mem.widgets[i].create_name);
+        out->widget_types[i].count = g_mem.widgets[i].count;
+        out->widget_type_count++;
+    }
+    for (uint32_t i = 0; i < g_mem.widget_types; ++i) out->widgets_created += g_mem.widgets[i].count;
+    out->widgets_created += g_mem.widgets_other;
+
+    lvgl_json_registry_stats(&out->registry);
+    for (uint32_t i = 0; i < g_registry_capacity; ++i) {
+        const registry_entry_t *entry = &g_registry[i];
+        if (!entry->name || !entry->ptr) continue;
+        if (strcmp(entry->type_name, "component_def") == 0) out->registry_components++;
+        else if (strcmp(entry->type_name, "lv_style_t") == 0) out->registry_styles++;
+    }
+    out->strings = g_str_pool_count;
+    for (uint32_t i = 0; i < g_str_pool_capacity; ++i) {
+        if (g_str_pool[i] && g_str_pool[i]->is_static) out->static_strings++;
+    }
+}
+"""
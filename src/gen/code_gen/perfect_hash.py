@@ -0,0 +1,226 @@
+# code_gen/perfect_hash.py
+import logging
+from api_parser import djb2_hash
+
+logger = logging.getLogger(__name__)
+
+# Hash-and-displace construction: every key is first hashed with djb2 (the same
+# hash used at runtime by djb2_hash_c), keys are grouped into buckets by the low
+# bits of that hash, and each bucket gets a displacement value that moves all of
+# its keys into free slots of the final table. Lookup is then one hash of the
+# input string, one displacement read and one slot read, followed by a single
+# strcmp against the candidate to reject names that are not in the table.
+#
+# If no displacement fits a bucket, the construction is retried with other seeds
+# (XORed into the hash before mixing) and then with a larger table. Keys with the
+# same djb2 hash cannot be separated at all; for those, and if every attempt fails,
+# the index falls back to a table sorted by hash and a binary search, so adding a
+# function never breaks the generator.
+
+PH_EMPTY_SLOT = 0xFFFF
+PH_MAX_DISPLACEMENT = 0xFFFF
+PH_SEEDS = 16
+
+
+def ph_mix(h, d):
+    """Python mirror of the C ph_mix() emitted by generate_ph_mix_function()."""
+    x = (h ^ ((d * 0x9E3779B1) & 0xFFFFFFFF)) & 0xFFFFFFFF
+    x ^= x >> 16
+    x = (x * 0x85EBCA6B) & 0xFFFFFFFF
+    x ^= x >> 13
+    x = (x * 0xC2B2AE35) & 0xFFFFFFFF
+    x ^= x >> 16
+    return x
+
+
+def _next_pow2(n):
+    p = 1
+    while p < n:
+        p <<= 1
+    return p
+
+
+def _seed(attempt):
+    return (attempt * 0x9E3779B9) & 0xFFFFFFFF
+
+
+def _place(hashes, num_buckets, num_slots, seed):
+    """One hash-and-displace attempt; returns (displacements, slots) or None."""
+    buckets = [[] for _ in range(num_buckets)]
+    for idx, h in enumerate(hashes):
+        buckets[h & (num_buckets - 1)].append(idx)
+
+    displacements = [0] * num_buckets
+    slots = [PH_EMPTY_SLOT] * num_slots
+
+    # Place the largest buckets first while the table is still sparse.
+    order = sorted(range(num_buckets), key=lambda b: -len(buckets[b]))
+    for b in order:
+        members = buckets[b]
+        if not members:
+            continue
+        for d in range(PH_MAX_DISPLACEMENT + 1):
+            positions = [ph_mix(hashes[i] ^ seed, d) & (num_slots - 1) for i in members]
+            if len(set(positions)) != len(positions):
+                continue
+            if any(slots[p] != PH_EMPTY_SLOT for p in positions):
+                continue
+            for i, p in zip(members, positions):
+                slots[p] = i
+            displacements[b] = d
+            break
+        else:
+            return None
+    return displacements, slots
+
+
+def build_perfect_hash(names):
+    """
+    Builds a minimal-ish perfect hash over `names`.
+
+    Returns a dict:
+        'hashes':        djb2 hash per name (same order as `names`)
+        'sorted':        True if no perfect hash was found and lookups binary-search 'order'
+        'seed':          XORed into the hash before ph_mix()
+        'num_buckets':   power of two
+        'num_slots':     power of two >= len(names)
+        'displacements': list[num_buckets]
+        'slots':         list[num_slots], index into `names` or PH_EMPTY_SLOT
+        'order':         indices into `names` sorted by hash ('sorted' only)
+    """
+    n = len(names)
+    if n >= PH_EMPTY_SLOT:
+        raise ValueError(f"Perfect hash supports at most {PH_EMPTY_SLOT - 1} keys, got {n}")
+
+    hashes = [djb2_hash(name) for name in names]
+    if len(set(hashes)) == n:
+        num_buckets = _next_pow2(max(n // 4, 1))
+        for num_slots in (_next_pow2(max(n + n // 2, 1)), _next_pow2(max(n * 2, 1))):
+            for attempt in range(PH_SEEDS):
+                placed = _place(hashes, num_buckets, num_slots, _seed(attempt))
+                if not placed:
+                    continue
+                displacements, slots = placed
+                logger.info(f"Perfect hash: {n} keys, {num_buckets} buckets, {num_slots} slots, "
+                            f"seed {attempt}, max displacement {max(displacements)}.")
+                return {
+                    'hashes': hashes,
+                    'sorted': False,
+                    'seed': _seed(attempt),
+                    'num_buckets': num_buckets,
+                    'num_slots': num_slots,
+                    'displacements': displacements,
+                    'slots': slots,
+                }
+        logger.warning(f"Perfect hash: no displacement found for {n} keys; using a sorted table instead.")
+    else:
+        # Keys with identical djb2 hashes can never be separated by displacement.
+        seen = {}
+        for name, h in zip(names, hashes):
+            if h in seen:
+                logger.warning(f"Perfect hash: '{name}' and '{seen[h]}' share djb2 hash {h:#010x}; using a sorted table instead.")
+            seen.setdefault(h, name)
+
+    return {
+        'hashes': hashes,
+        'sorted': True,
+        'order': sorted(range(n), key=lambda i: (hashes[i], names[i])),
+    }
+
+
+def generate_ph_mix_function():
+    """C counterpart of ph_mix(); must stay bit-identical to the Python version."""
+    c_code = "// Mixes a djb2 hash with a perfect hash displacement value (see code_gen/perfect_hash.py).\n"
+    c_code += "static inline uint32_t ph_mix(uint32_t h, uint32_t d) {\n"
+    c_code += "    uint32_t x = h ^ (d * 0x9E3779B1u);\n"
+    c_code += "    x ^= x >> 16;\n"
+    c_code += "    x *= 0x85EBCA6Bu;\n"
+    c_code += "    x ^= x >> 13;\n"
+    c_code += "    x *= 0xC2B2AE35u;\n"
+    c_code += "    x ^= x >> 16;\n"
+    c_code += "    return x;\n"
+    c_code += "}\n\n"
+    return c_code
+
+
+def _format_u16_rows(values, per_row=16):
+    rows = []
+    for i in range(0, len(values), per_row):
+        rows.append("    " + ", ".join(f"{v:#06x}" for v in values[i:i + per_row]) + ",")
+    return "\n".join(rows) + "\n"
+
+
+def _format_u32_rows(values, per_row=8):
+    rows = []
+    for i in range(0, len(values), per_row):
+        rows.append("    " + ", ".join(f"0x{v:08x}u" for v in values[i:i + per_row]) + ",")
+    return "\n".join(rows) + "\n"
+
+
+def generate_ph_tables(prefix, macro_prefix, ph):
+    """
+    Emits the static lookup tables for a perfect hash built by build_perfect_hash().
+    Names: <prefix>_ph_disp[], <prefix>_ph_slot[], <prefix>_ph_hash[] and the
+    matching <macro_prefix>_PH_BUCKET_MASK / <macro_prefix>_PH_SLOT_MASK / <macro_prefix>_PH_SEED
+    macros; for the sorted fallback <prefix>_ph_hash[] and <prefix>_ph_order[].
+    """
+    upper = macro_prefix
+    c_code = f"#define {upper}_PH_EMPTY {PH_EMPTY_SLOT:#06x}u\n"
+    if ph['sorted']:
+        c_code += f"#define {upper}_PH_SORTED 1 // No perfect hash was found, see code_gen/perfect_hash.py\n\n"
+        c_code += "// Table indices sorted by djb2 hash, for a binary search\n"
+        c_code += f"static const uint16_t {prefix}_ph_order[{max(len(ph['order']), 1)}] = {{\n"
+        c_code += _format_u16_rows(ph['order'] or [PH_EMPTY_SLOT])
+        c_code += "};\n\n"
+    else:
+        c_code += f"#define {upper}_PH_BUCKET_MASK {ph['num_buckets'] - 1}u\n"
+        c_code += f"#define {upper}_PH_SLOT_MASK {ph['num_slots'] - 1}u\n"
+        c_code += f"#define {upper}_PH_SEED {ph['seed']:#010x}u\n\n"
+
+        c_code += "// Per-bucket displacement values\n"
+        c_code += f"static const uint16_t {prefix}_ph_disp[{ph['num_buckets']}] = {{\n"
+        c_code += _format_u16_rows(ph['displacements'])
+        c_code += "};\n\n"
+
+        c_code += f"// Slot -> table index ({PH_EMPTY_SLOT:#06x} = empty)\n"
+        c_code += f"static const uint16_t {prefix}_ph_slot[{ph['num_slots']}] = {{\n"
+        c_code += _format_u16_rows(ph['slots'])
+        c_code += "};\n\n"
+
+    c_code += "// djb2 hash of each table entry's name, used to reject misses without a strcmp\n"
+    c_code += f"static const uint32_t {prefix}_ph_hash[{max(len(ph['hashes']), 1)}] = {{\n"
+    c_code += _format_u32_rows(ph['hashes'] or [0])
+    c_code += "};\n\n"
+    return c_code
+
+
+def generate_ph_find(prefix, macro_prefix, ph, name_of_idx):
+    """
+    Emits `static uint32_t <prefix>_ph_find(const char *s, size_t len, uint32_t hash)`, which
+    returns the table index of the name s[0..len) with djb2 `hash`, or <macro_prefix>_PH_EMPTY.
+    `name_of_idx` is the C expression for the name of table entry `idx`.
+    """
+    upper = macro_prefix
+    c_code = f"static uint32_t {prefix}_ph_find(const char *s, size_t len, uint32_t hash) {{\n"
+    if ph['sorted']:
+        n = len(ph['order'])
+        c_code += f"    uint32_t lo = 0, hi = {n}u;\n"
+        c_code += "    while (lo < hi) {\n"
+        c_code += "        uint32_t mid = lo + (hi - lo) / 2;\n"
+        c_code += f"        if ({prefix}_ph_hash[{prefix}_ph_order[mid]] < hash) lo = mid + 1;\n"
+        c_code += "        else hi = mid;\n"
+        c_code += "    }\n"
+        c_code += f"    for (; lo < {n}u && {prefix}_ph_hash[{prefix}_ph_order[lo]] == hash; ++lo) {{\n"
+        c_code += f"        uint32_t idx = {prefix}_ph_order[lo];\n"
+        c_code += f"        const char *name = {name_of_idx};\n"
+        c_code += "        if (strncmp(name, s, len) == 0 && name[len] == '\\0') return idx;\n"
+        c_code += "    }\n"
+        c_code += f"    return {upper}_PH_EMPTY;\n"
+    else:
+        c_code += f"    uint32_t d = {prefix}_ph_disp[hash & {upper}_PH_BUCKET_MASK];\n"
+        c_code += f"    uint32_t idx = {prefix}_ph_slot[ph_mix(hash ^ {upper}_PH_SEED, d) & {upper}_PH_SLOT_MASK];\n"
+        c_code += f"    if (idx == {upper}_PH_EMPTY || {prefix}_ph_hash[idx] != hash) return {upper}_PH_EMPTY;\n"
+        c_code += f"    const char *name = {name_of_idx};\n"
+        c_code += f"    return strncmp(name, s, len) == 0 && name[len] == '\\0' ? idx : {upper}_PH_EMPTY;\n"
+    c_code += "}\n\n"
+    return c_code
@@ -0,0 +1,368 @@
+# code_gen/profiler.py
+import logging
+
+logger = logging.getLogger(__name__)
+
+
+def generate_profiler():
+    """
+    Generates the render profiler (LVGL_JSON_PROFILE=1).
+
+    Spans around render_json_node(), apply_setters_and_attributes(), unmarshal_value() and the
+    invoke calls are stored as fixed-size events in a buffer allocated by lvgl_json_profile_start().
+    Every event carries the source path of the node being rendered (sibling indices, e.g.
+    "/0/3/1") and its type. lvgl_json_profile_write_trace() exports Chrome trace-event JSON and
+    lvgl_json_profile_print_summary() prints totals per category and the slowest setters.
+    With LVGL_JSON_PROFILE=0 the span macros expand to nothing.
+    """
+    return r"""
+// --- Render Profiler ---
+
+#if LVGL_JSON_PROFILE
+
+#include <time.h>
+
+#ifndef LVGL_JSON_PROFILE_CLOCK_NS
+static uint64_t profile_clock_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+#define LVGL_JSON_PROFILE_CLOCK_NS() profile_clock_ns()
+#endif
+
+#define PROFILE_MAX_DEPTH 64
+#define PROFILE_PATH_MAX 256
+
+enum {
+    PROFILE_CAT_NODE,        // render_json_node(), inclusive of its children
+    PROFILE_CAT_ATTRIBUTES,  // apply_setters_and_attributes()
+    PROFILE_CAT_UNMARSHAL,   // unmarshal_value()
+    PROFILE_CAT_INVOKE,      // Setter, create and nested calls through the invoke table
+    PROFILE_CAT_COUNT
+};
+
+static const char *const g_profile_cat_names[PROFILE_CAT_COUNT] = { "node", "attributes", "unmarshal", "invoke" };
+
+typedef struct {
+    const char *name;       // Static (setter or C type name); NULL for nodes, which use `type`
+    const char *property;   // Interned JSON member name, or NULL
+    const char *path;       // Interned source path of the node being rendered
+    const char *type;       // Interned type of that node
+    uint64_t ts_ns;         // Since lvgl_json_profile_start()
+    uint32_t dur_ns;
+    uint32_t self_ns;       // dur_ns minus the spans nested in it
+    uint8_t cat;
+    uint8_t depth;
+} profile_event_t;
+
+typedef struct {
+    const cJSON *last_node; // Last node rendered at this depth, to number its next sibling
+    uint32_t last_index;
+    uint16_t path_len;      // Length of the parent's path
+    const char *path;       // Interned path and type of the node entered at this depth
+    const char *type;
+} profile_level_t;
+
+typedef struct {
+    bool active;
+    profile_event_t *events;
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t dropped;
+    uint64_t start_ns;
+    uint32_t depth;                             // Open spans
+    uint64_t child_ns[PROFILE_MAX_DEPTH + 1];   // Time of the closed spans nested in each open one
+    uint32_t node_depth;                        // Nodes entered
+    profile_level_t levels[PROFILE_MAX_DEPTH];
+    char path[PROFILE_PATH_MAX];                // Source path of the innermost node
+    size_t path_len;
+} profile_state_t;
+
+static profile_state_t g_profile;
+
+typedef struct {
+    bool active;
+    uint64_t start_ns;
+} profile_span_t;
+
+static inline void profile_span_begin(profile_span_t *span) {
+    span->active = g_profile.active;
+    if (!span->active) return;
+    if (g_profile.depth < PROFILE_MAX_DEPTH) g_profile.child_ns[g_profile.depth + 1] = 0;
+    g_profile.depth++;
+    span->start_ns = LVGL_JSON_PROFILE_CLOCK_NS();
+}
+
+static const profile_level_t* profile_current_level(void) {
+    if (g_profile.node_depth == 0 || g_profile.node_depth > PROFILE_MAX_DEPTH) return NULL;
+    return &g_profile.levels[g_profile.node_depth - 1];
+}
+
+// Takes another reference to an interned string
+static const char* profile_str_ref(const char *pooled) {
+    if (pooled) STR_POOL_ENTRY(pooled)->refs++;
+    return pooled;
+}
+
+static void profile_span_record(const profile_span_t *span, uint8_t cat, const char *name, const char *property) {
+    uint64_t end_ns = LVGL_JSON_PROFILE_CLOCK_NS();
+    uint64_t dur_ns = end_ns - span->start_ns;
+    uint32_t depth = --g_profile.depth;
+    if (depth >= PROFILE_MAX_DEPTH) return;
+    uint64_t nested_ns = g_profile.child_ns[depth + 1];
+    g_profile.child_ns[depth] += dur_ns;
+    if (g_profile.count >= g_profile.capacity) {
+        g_profile.dropped++;
+        return;
+    }
+    profile_event_t *ev = &g_profile.events[g_profile.count++];
+    const profile_level_t *level = profile_current_level();
+    ev->name = name;
+    ev->property = property ? str_pool_retain(property, strlen(property)) : NULL;
+    ev->path = level ? profile_str_ref(level->path) : NULL;
+    ev->type = level ? profile_str_ref(level->type) : NULL;
+    ev->ts_ns = span->start_ns - g_profile.start_ns;
+    ev->dur_ns = dur_ns > UINT32_MAX ? UINT32_MAX : (uint32_t)dur_ns;
+    ev->self_ns = dur_ns > nested_ns ? (uint32_t)(dur_ns - nested_ns) : 0;
+    ev->cat = cat;
+    ev->depth = (uint8_t)depth;
+}
+
+#define PROFILE_SPAN_BEGIN(span) profile_span_t span; profile_span_begin(&span)
+#define PROFILE_SPAN_END(span, cat, name, property) do { if (span.active) profile_span_record(&span, cat, name, property); } while (0)
+
+// Appends the node's segment to the source path: its index among its siblings, or its member
+// name if it is not in an array (e.g. a component root). Only called while profiling.
+static void profile_node_enter(const cJSON *node) {
+    uint32_t d = g_profile.node_depth++;
+    if (d >= PROFILE_MAX_DEPTH) return;
+    profile_level_t *level = &g_profile.levels[d];
+    if (d + 1 < PROFILE_MAX_DEPTH) g_profile.levels[d + 1].last_node = NULL;
+
+    size_t len = g_profile.path_len;
+    level->path_len = (uint16_t)len;
+    char segment[32];
+    bool in_array = node->prev && node->prev->next == node;
+    if (node->string && !in_array) {
+        snprintf(segment, sizeof(segment), "/%s", node->string);
+    } else {
+        uint32_t index = 0;
+        if (d > 0 && level->last_node && node->prev == level->last_node) {
+            index = level->last_index + 1;
+        } else {
+            for (const cJSON *c = node; c->prev && c->prev->next == c; c = c->prev) index++;
+        }
+        level->last_index = index;
+        snprintf(segment, sizeof(segment), "/%u", (unsigned)index);
+    }
+    level->last_node = node;
+    size_t seg_len = strlen(segment);
+    if (len + seg_len < sizeof(g_profile.path)) {
+        memcpy(g_profile.path + len, segment, seg_len + 1);
+        len += seg_len;
+    }
+    g_profile.path_len = len;
+
+    cJSON *type_item = cJSON_GetObjectItemCaseSensitive(node, "type");
+    const char *type = cJSON_IsString(type_item) && type_item->valuestring ? type_item->valuestring : "obj";
+    level->path = str_pool_retain(g_profile.path, len);
+    level->type = str_pool_retain(type, strlen(type));
+}
+
+static void profile_node_leave(void) {
+    uint32_t d = --g_profile.node_depth;
+    if (d >= PROFILE_MAX_DEPTH) return;
+    profile_level_t *level = &g_profile.levels[d];
+    str_pool_release(level->path);
+    str_pool_release(level->type);
+    level->path = NULL;
+    level->type = NULL;
+    g_profile.path_len = level->path_len;
+    g_profile.path[g_profile.path_len] = '\0';
+}
+
+static void profile_release_events(void) {
+    for (uint32_t i = 0; i < g_profile.count; ++i) {
+        str_pool_release(g_profile.events[i].property);
+        str_pool_release(g_profile.events[i].path);
+        str_pool_release(g_profile.events[i].type);
+    }
+    g_profile.count = 0;
+    g_profile.dropped = 0;
+}
+
+bool lvgl_json_profile_start(uint32_t max_events) {
+    if (max_events == 0) max_events = LVGL_JSON_PROFILE_DEFAULT_EVENTS;
+    profile_release_events();
+    if (g_profile.capacity != max_events) {
+        mem_free(LVGL_JSON_MEM_OTHER, g_profile.events, sizeof(profile_event_t) * g_profile.capacity);
+        g_profile.capacity = 0;
+        g_profile.events = (profile_event_t *)mem_alloc(LVGL_JSON_MEM_OTHER, sizeof(profile_event_t) * max_events);
+        if (!g_profile.events) {
+            LOG_ERR("Profile Error: Failed to allocate %u events.", (unsigned)max_events);
+            g_profile.active = false;
+            return false;
+        }
+        RENDER_STAT_INC(heap_allocs);
+        g_profile.capacity = max_events;
+    }
+    g_profile.depth = 0;
+    g_profile.node_depth = 0;
+    g_profile.path[0] = '\0';
+    g_profile.path_len = 0;
+    memset(g_profile.levels, 0, sizeof(g_profile.levels));
+    g_profile.start_ns = LVGL_JSON_PROFILE_CLOCK_NS();
+    g_profile.active = true;
+    return true;
+}
+
+void lvgl_json_profile_stop(void) {
+    g_profile.active = false;
+}
+
+void lvgl_json_profile_reset(void) {
+    g_profile.active = false;
+    profile_release_events();
+    mem_free(LVGL_JSON_MEM_OTHER, g_profile.events, sizeof(profile_event_t) * g_profile.capacity);
+    g_profile.events = NULL;
+    g_profile.capacity = 0;
+}
+
+uint32_t lvgl_json_profile_event_count(uint32_t *dropped) {
+    if (dropped) *dropped = g_profile.dropped;
+    return g_profile.count;
+}
+
+static void profile_write_json_str(FILE *f, const char *s) {
+    fputc('"', f);
+    for (; *s; ++s) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') fprintf(f, "\\%c", c);
+        else if (c < 0x20) fprintf(f, "\\u%04x", c);
+        else fputc(c, f);
+    }
+    fputc('"', f);
+}
+
+bool lvgl_json_profile_write_trace(const char *path) {
+    FILE *f = path ? fopen(path, "w") : NULL;
+    if (!f) {
+        LOG_ERR("Profile Error: Cannot open '%s' for writing.", path ? path : "NULL");
+        return false;
+    }
+    fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n", f);
+    for (uint32_t i = 0; i < g_profile.count; ++i) {
+        const profile_event_t *ev = &g_profile.events[i];
+        const char *name = ev->name ? ev->name : (ev->type ? ev->type : "node");
+        fputs(i ? ",\n{\"name\":" : "{\"name\":", f);
+        profile_write_json_str(f, name);
+        fprintf(f, ",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f,\"args\":{",
+                g_profile_cat_names[ev->cat], ev->ts_ns / 1000.0, ev->dur_ns / 1000.0);
+        fputs("\"path\":", f);
+        profile_write_json_str(f, ev->path ? ev->path : "");
+        if (ev->type) {
+            fputs(",\"type\":", f);
+            profile_write_json_str(f, ev->type);
+        }
+        if (ev->property) {
+            fputs(",\"property\":", f);
+            profile_write_json_str(f, ev->property);
+        }
+        fputs("}}", f);
+    }
+    fputs("\n]}\n", f);
+    bool ok = !ferror(f);
+    if (fclose(f) != 0) ok = false;
+    if (!ok) LOG_ERR("Profile Error: Failed to write '%s'.", path);
+    return ok;
+}
+
+typedef struct {
+    const char *name;
+    uint32_t calls;
+    uint64_t total_ns;
+    uint32_t max_ns;
+} profile_func_stat_t;
+
+static int profile_cmp_name(const void *a, const void *b) {
+    const char *na = ((const profile_func_stat_t *)a)->name;
+    const char *nb = ((const profile_func_stat_t *)b)->name;
+    return na == nb ? 0 : strcmp(na, nb);
+}
+
+static int profile_cmp_total(const void *a, const void *b) {
+    uint64_t ta = ((const profile_func_stat_t *)a)->total_ns;
+    uint64_t tb = ((const profile_func_stat_t *)b)->total_ns;
+    return ta < tb ? 1 : (ta > tb ? -1 : 0);
+}
+
+void lvgl_json_profile_print_summary(uint32_t top_n) {
+    uint32_t cat_calls[PROFILE_CAT_COUNT] = {0};
+    uint64_t cat_self_ns[PROFILE_CAT_COUNT] = {0};
+    uint64_t total_ns = 0;
+    uint32_t invokes = 0;
+    for (uint32_t i = 0; i < g_profile.count; ++i) {
+        const profile_event_t *ev = &g_profile.events[i];
+        cat_calls[ev->cat]++;
+        cat_self_ns[ev->cat] += ev->self_ns;
+        if (ev->depth == 0) total_ns += ev->dur_ns;
+        if (ev->cat == PROFILE_CAT_INVOKE) invokes++;
+    }
+    printf("Profile: %u events (%u dropped), %.3f ms in top-level spans\n",
+           (unsigned)g_profile.count, (unsigned)g_profile.dropped, total_ns / 1e6);
+    printf("  %-12s %8s %12s\n", "category", "spans", "self ms");
+    for (int c = 0; c < PROFILE_CAT_COUNT; ++c) {
+        printf("  %-12s %8u %12.3f\n", g_profile_cat_names[c], (unsigned)cat_calls[c], cat_self_ns[c] / 1e6);
+    }
+    if (invokes == 0 || top_n == 0) return;
+
+    // Aggregate invoke spans per function: sort by name, then merge runs
+    profile_func_stat_t *stats = (profile_func_stat_t *)mem_alloc(LVGL_JSON_MEM_OTHER, sizeof(profile_func_stat_t) * invokes);
+    if (!stats) {
+        LOG_ERR("Profile Error: Out of memory for the summary.");
+        return;
+    }
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < g_profile.count; ++i) {
+        const profile_event_t *ev = &g_profile.events[i];
+        if (ev->cat != PROFILE_CAT_INVOKE) continue;
+        stats[n].name = ev->name ? ev->name : "?";
+        stats[n].calls = 1;
+        stats[n].total_ns = ev->dur_ns;
+        stats[n].max_ns = ev->dur_ns;
+        n++;
+    }
+    qsort(stats, n, sizeof(stats[0]), profile_cmp_name);
+    uint32_t groups = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        if (groups > 0 && profile_cmp_name(&stats[groups - 1], &stats[i]) == 0) {
+            profile_func_stat_t *g = &stats[groups - 1];
+            g->calls++;
+            g->total_ns += stats[i].total_ns;
+            if (stats[i].max_ns > g->max_ns) g->max_ns = stats[i].max_ns;
+        } else {
+            stats[groups++] = stats[i];
+        }
+    }
+    qsort(stats, groups, sizeof(stats[0]), profile_cmp_total);
+
+    if (top_n > groups) top_n = groups;
+    printf("  Top %u calls by total time:\n", (unsigned)top_n);
+    printf("  %-36s %7s %10s %9s %9s\n", "function", "calls", "total ms", "avg us", "max us");
+    for (uint32_t i = 0; i < top_n; ++i) {
+        const profile_func_stat_t *s = &stats[i];
+        int bar = stats[0].total_ns ? (int)((s->total_ns * 30 + stats[0].total_ns / 2) / stats[0].total_ns) : 0;
+        printf("  %-36s %7u %10.3f %9.2f %9.2f %.*s\n", s->name, (unsigned)s->calls, s->total_ns / 1e6,
+               s->total_ns / 1e3 / s->calls, s->max_ns / 1e3, bar, "##############################");
+    }
+    mem_free(LVGL_JSON_MEM_OTHER, stats, sizeof(profile_func_stat_t) * invokes);
+}
+
+#else
+
+#define PROFILE_SPAN_BEGIN(span) ((void)0)
+#define PROFILE_SPAN_END(span, cat, name, property) ((void)0)
+
+#endif // LVGL_JSON_PROFILE
+"""
@@ -0,0 +1,1089 @@
+# code_gen/program.py
+import logging
+
+from .invocation import MAX_ARGS_SUPPORTED
+
+logger = logging.getLogger(__name__)
+
+
+def generate_program(custom_creators_map):
+    """
+    Generates the UI program compiler and interpreter.
+
+    lvgl_json_compile_ui() walks a UI spec once, the same way render_json_node() does, but
+    records the work as a flat list of instructions instead of performing it: widget create
+    entries, resolved setters with pre-unmarshalled arguments, registrations and children
+    structure. lvgl_json_run_program() then replays that list. Only values that depend on run
+    time state ('@' references, '$' context values, '!' registered strings, nested calls) are
+    kept as JSON and unmarshalled when the program runs.
+
+    Components are compiled the same way into template programs on their first 'use-view'.
+    Templates keep registry paths relative to the instance and turn '$' arguments into slots
+    that are bound once per instance from the use-view's context.
+    """
+    # custom_creators_map: {'style': 'lv_style_create_managed', ...}
+    creators = list(custom_creators_map.items())
+
+    c_code = "// --- Compiled UI Programs ---\n\n"
+
+    # Managed creators are addressed by index so the interpreter does not compare type names.
+    c_code += "// Managed (custom creator) types, indexed by PROG_OP_CREATE_MANAGED.value_index\n"
+    c_code += "static const char *const g_prog_managed_types[] = {"
+    c_code += ", ".join(f"\"{type_name}\"" for type_name, _ in creators) if creators else "NULL"
+    c_code += "};\n"
+    c_code += "static const char *const g_prog_managed_registry_types[] = {"
+    c_code += ", ".join(f"\"lv_{type_name}_t\"" for type_name, _ in creators) if creators else "NULL"
+    c_code += "};\n"
+    c_code += f"#define PROG_MANAGED_TYPE_COUNT {len(creators)}\n"
+    c_code += f"#define PROGRAM_MAX_CALL_ARGS {MAX_ARGS_SUPPORTED} // JSON arguments of an invoke table entry\n\n"
+
+    c_code += "static void* prog_create_managed(uint32_t creator_index, const char *name) {\n"
+    c_code += "    switch (creator_index) {\n"
+    for i, (type_name, creator_func) in enumerate(creators):
+        c_code += f"        case {i}: return (void*){creator_func}(name);\n"
+    c_code += "        default: return NULL;\n"
+    c_code += "    }\n"
+    c_code += "}\n\n"
+
+    c_code += """
+// Instructions. Every node pushes exactly one entity (the created widget/object, the
+// resolved 'with' target, or (void*)1 for component definitions) which the node's
+// parent pops once it has applied anything else that targets it.
+typedef enum {
+    PROG_OP_CREATE,             // entry: lv_<type>_create, parent is the current children parent
+    PROG_OP_CREATE_MANAGED,     // value_index: managed creator, str: registration name
+    PROG_OP_PUSH_PARENT,        // 'with' node: the current parent becomes the entity
+    PROG_OP_WITH,               // node: 'with.obj' value, resolved when run; jump: past the matching POP
+    PROG_OP_POP,                // Drops the top entity
+    PROG_OP_REGISTER,           // Registers the top entity as str (type_name), or str:<slot value_index> (PROG_FLAG_NAME_SLOT)
+    PROG_OP_GRID,               // node: grid node, apply_grid_layout() on the top entity
+    PROG_OP_CALL,               // entry->call() on the top entity with values[value_index..]
+    PROG_OP_CALL_SLOTS,         // Like PROG_OP_CALL; arguments in the jump bitmask are bound from slot values[i].i
+    PROG_OP_INVOKE_JSON,        // entry->invoke() on the top entity with node as runtime-dependent arguments
+    PROG_OP_PUSH_CONTEXT,       // node: context object
+    PROG_OP_POP_CONTEXT,
+    PROG_OP_CHILDREN_BEGIN,     // Top entity becomes the parent; jump: matching CHILDREN_END
+    PROG_OP_CHILDREN_END,
+    PROG_OP_REGISTER_COMPONENT, // node: component root, str: component id
+    PROG_OP_RENDER_JSON,        // node: rendered with render_json_node() (not compilable), str: path prefix
+    PROG_OP_SHARED_STYLE,       // Adds a shared style: values[value_index] selector, then jump (style setter, value) pairs
+    PROG_OP_END
+} prog_opcode_t;
+
+#define PROG_FLAG_DEFAULT_SELECTOR 0x01 // PROG_OP_INVOKE_JSON / CALL_SLOTS: append LV_PART_MAIN to a single argument
+#define PROG_FLAG_NAME_SLOT 0x02        // PROG_OP_REGISTER: 'named' value comes from a slot
+
+typedef struct {
+    uint8_t op;                         // prog_opcode_t
+    uint8_t flags;
+    uint32_t jump;                      // Instruction index (see opcode)
+    uint32_t value_index;               // Index into values[] or managed creator index
+    const invoke_table_entry_t *entry;
+    const char *str;                    // Registration path / name (owned by the program)
+    const char *type_name;              // Registry type name (owned by the program)
+    cJSON *node;                        // JSON operand inside the program's copy of the spec
+} prog_op_t;
+
+#define PROGRAM_MAX_SLOTS 32
+
+struct lvgl_json_program_s {
+    prog_op_t *ops;
+    uint32_t op_count;
+    uint32_t op_capacity;
+    invoke_value_t *values;             // Pre-unmarshalled call arguments
+    uint32_t value_count;
+    uint32_t value_capacity;
+    cJSON *spec;                        // Private copy of the compiled spec (NULL for templates)
+    cJSON *strings;                     // Owned strings and unescaped constant copies
+    bool is_template;                   // Component template: paths are relative to the instance
+    const char *slot_names[PROGRAM_MAX_SLOTS]; // Template '$' variables, bound when an instance runs
+    uint32_t slot_count;
+};
+
+// Nesting limit of the interpreter stacks. Deeper subtrees are compiled to PROG_OP_RENDER_JSON.
+#define PROGRAM_MAX_DEPTH 32
+
+typedef struct {
+    const char *id;
+    cJSON *root;
+} prog_component_t;
+
+typedef struct {
+    lvgl_json_program_t *prog;
+    int entity_depth;
+    int frame_depth;
+    int context_depth;
+    prog_component_t *components;       // Components defined so far in the spec, in document order
+    int component_count;
+    int component_capacity;
+    bool bind_slots;                    // Compiling a template: '$' arguments at the instance's context become slots
+    uint32_t path_ops;                  // Emitted instructions that use a registry path
+    bool out_of_memory;
+#if LVGL_JSON_STYLE_SHARING
+    style_share_batch_t *style_batch;   // Constant style properties of the node being compiled
+#endif
+} prog_compiler_t;
+
+static prog_op_t g_prog_scratch_op; // Absorbs writes after an allocation failure
+
+static prog_op_t* prog_emit(prog_compiler_t *c, uint8_t opcode, cJSON *node) {
+    lvgl_json_program_t *p = c->prog;
+    if (p->op_count == p->op_capacity) {
+        uint32_t new_capacity = p->op_capacity ? p->op_capacity * 2 : 64;
+        prog_op_t *ops = (prog_op_t *)mem_realloc(LVGL_JSON_MEM_TEMPLATES, p->ops, p->op_capacity * sizeof(prog_op_t), new_capacity * sizeof(prog_op_t));
+        if (!ops) {
+            c->out_of_memory = true;
+            memset(&g_prog_scratch_op, 0, sizeof(g_prog_scratch_op));
+            return &g_prog_scratch_op;
+        }
+        p->ops = ops;
+        p->op_capacity = new_capacity;
+    }
+    prog_op_t *op = &p->ops[p->op_count++];
+    memset(op, 0, sizeof(*op));
+    op->op = opcode;
+    op->node = node;
+    if (opcode == PROG_OP_REGISTER || opcode == PROG_OP_CREATE_MANAGED || opcode == PROG_OP_RENDER_JSON) c->path_ops++;
+    return op;
+}
+
+// Reserves `count` zeroed value slots and returns the index of the first one.
+static uint32_t prog_alloc_values(prog_compiler_t *c, uint32_t count) {
+    lvgl_json_program_t *p = c->prog;
+    if (p->value_count + count > p->value_capacity) {
+        uint32_t new_capacity = p->value_capacity ? p->value_capacity * 2 : 64;
+        while (new_capacity < p->value_count + count) new_capacity *= 2;
+        invoke_value_t *values = (invoke_value_t *)mem_realloc(LVGL_JSON_MEM_TEMPLATES, p->values, p->value_capacity * sizeof(invoke_value_t), new_capacity * sizeof(invoke_value_t));
+        if (!values) {
+            c->out_of_memory = true;
+            return UINT32_MAX;
+        }
+        p->values = values;
+        p->value_capacity = new_capacity;
+    }
+    uint32_t first = p->value_count;
+    memset(&p->values[first], 0, count * sizeof(invoke_value_t));
+    p->value_count += count;
+    return first;
+}
+
+static const char* prog_add_string(prog_compiler_t *c, const char *str) {
+    cJSON *item = cJSON_CreateString(str ? str : "");
+    if (!item) {
+        c->out_of_memory = true;
+        return "";
+    }
+    cJSON_AddItemToArray(c->prog->strings, item);
+    return item->valuestring;
+}
+
+// Joins "prefix:segment" like render_json_node() does and keeps the result with the program.
+static const char* prog_add_path(prog_compiler_t *c, const char *prefix, const char *segment) {
+    if (!segment || !segment[0]) return prefix ? prefix : "";
+    char buf[REGISTRY_PATH_BUF_SIZE];
+    char *path = registry_path_join(buf, prefix, segment);
+    const char *kept = prog_add_string(c, path);
+    registry_path_free(path, buf);
+    return kept;
+}
+
+static void prog_add_component(prog_compiler_t *c, const char *id, cJSON *root) {
+    if (c->component_count == c->component_capacity) {
+        int new_capacity = c->component_capacity ? c->component_capacity * 2 : 8;
+        prog_component_t *components = (prog_component_t *)mem_realloc(LVGL_JSON_MEM_TEMPORARY, c->components, c->component_capacity * sizeof(prog_component_t), new_capacity * sizeof(prog_component_t));
+        if (!components) {
+            c->out_of_memory = true;
+            return;
+        }
+        c->components = components;
+        c->component_capacity = new_capacity;
+    }
+    c->components[c->component_count].id = id;
+    c->components[c->component_count].root = root;
+    c->component_count++;
+}
+
+static cJSON* prog_find_component(prog_compiler_t *c, const char *id) {
+    // Latest definition wins, like re-registering the id at render time.
+    for (int i = c->component_count - 1; i >= 0; --i) {
+        if (strcmp(c->components[i].id, id) == 0) return c->components[i].root;
+    }
+    return NULL;
+}
+
+// True if `item` unmarshals the same way whenever the program runs.
+static bool prog_value_is_constant(const cJSON *item) {
+    if (cJSON_IsNumber(item) || cJSON_IsBool(item)) return true;
+    if (!cJSON_IsString(item) || !item->valuestring) return false;
+    char first = item->valuestring[0];
+    return first != '@' && first != '$' && first != '!';
+}
+
+// True for a constant flag list (["LV_PART_INDICATOR", "LV_STATE_PRESSED"]) passed to an
+// integer or enum argument; unmarshal_value() ORs it into one value.
+static bool prog_flags_are_constant(const cJSON *item, uint8_t type_id) {
+    if (!cJSON_IsArray(item) || !((type_id & TYPE_ID_ENUM_BIT) || type_id_is_integer(type_id & ~TYPE_ID_ENUM_BIT))) return false;
+    for (const cJSON *flag = item->child; flag; flag = flag->next) {
+        if (!prog_value_is_constant(flag) && !prog_flags_are_constant(flag, type_id)) return false;
+    }
+    return true;
+}
+
+// Slot of a '$variable' value in a template, or -1 if `item` has to be unmarshalled from JSON.
+// Only values outside of nested 'context' blocks are slots, as those may shadow the variable.
+static int prog_slot_index(prog_compiler_t *c, const cJSON *item) {
+    if (!c->bind_slots || c->context_depth > 0 || !cJSON_IsString(item) || !item->valuestring) return -1;
+    const char *str = item->valuestring;
+    size_t len = strlen(str);
+    // Same cases as unmarshal_value(): "$...$" is an escaped literal, "...%" a percentage
+    if (len < 2 || str[0] != '$' || str[len - 1] == '$' || str[len - 1] == '%') return -1;
+    lvgl_json_program_t *p = c->prog;
+    for (uint32_t i = 0; i < p->slot_count; ++i) {
+        if (strcmp(p->slot_names[i], str + 1) == 0) return (int)i;
+    }
+    if (p->slot_count == PROGRAM_MAX_SLOTS) return -1;
+    p->slot_names[p->slot_count] = prog_add_string(c, str + 1);
+    return (int)p->slot_count++;
+}
+
+static bool prog_compile_node(prog_compiler_t *c, cJSON *node, const char *named_path_prefix);
+
+static bool prog_compile_attributes(
+    prog_compiler_t *c,
+    cJSON *attributes_json_obj,
+    const char *target_actual_type_str,
+    const char *target_create_type_str,
+    bool target_is_widget,
+    const char *path_prefix_for_named_and_children,
+    const char *default_type_name_for_registry_if_named
+);
+
+// Emits a setter call. Arguments are unmarshalled now unless one of them depends on run time state.
+static bool prog_compile_setter(prog_compiler_t *c, cJSON *prop_item, const char *prop_name,
+                                const char *target_actual_type_str, const char *target_create_type_str, bool target_is_widget) {
+    bool append_default_selector = false;
+    const invoke_table_entry_t *setter_entry = resolve_setter(target_actual_type_str, prop_name, target_is_widget, &append_default_selector);
+    if (!setter_entry) {
+        LOG_WARN_JSON(prop_item, "No setter/invokable found for property '%s' on type '%s' (create type '%s').", prop_name, target_actual_type_str, target_create_type_str);
+        return true;
+    }
+
+    invoke_args_t prop_args;
+    invoke_args_init(&prop_args, prop_item);
+    if (append_default_selector && prop_args.count == 1) {
+        invoke_args_append(&prop_args, &g_default_selector_json);
+    }
+
+    bool constant = setter_entry->call && prop_args.count == setter_entry->arity - setter_entry->first_json_arg;
+    uint32_t slot_args = 0; // Bitmask of arguments bound from template slots
+    for (int i = 0; constant && i < prop_args.count; ++i) {
+        if (prog_value_is_constant(prop_args.items[i])) continue;
+        if (prog_flags_are_constant(prop_args.items[i], setter_entry->arg_type_ids[setter_entry->first_json_arg + i])) continue;
+        int slot = (i < PROGRAM_MAX_CALL_ARGS) ? prog_slot_index(c, prop_args.items[i]) : -1;
+        if (slot < 0) constant = false;
+        else slot_args |= 1u << i;
+    }
+
+    if (constant) {
+        uint32_t first_value = prop_args.count ? prog_alloc_values(c, (uint32_t)prop_args.count) : 0;
+        if (first_value == UINT32_MAX) return true;
+        for (int i = 0; constant && i < prop_args.count; ++i) {
+            cJSON *arg = prop_args.items[i];
+            if (slot_args & (1u << i)) {
+                c->prog->values[first_value + i].i = prog_slot_index(c, arg);
+                continue;
+            }
+            if (json_string_unescapes_in_place(arg)) {
+                // Unescape a private copy; the resulting string is owned by the program.
+                cJSON *copy = cJSON_Duplicate(arg, true);
+                if (!copy) { c->out_of_memory = true; return true; }
+                cJSON_AddItemToArray(c->prog->strings, copy);
+                arg = copy;
+            }
+            int c_index = setter_entry->first_json_arg + i;
+            constant = unmarshal_value(arg, setter_entry->arg_type_ids[c_index], setter_entry->arg_types[c_index], &c->prog->values[first_value + i], NULL);
+        }
+#if LVGL_JSON_STYLE_SHARING
+        if (constant && !slot_args && g_style_share_enabled && target_is_widget && prop_args.count == 2 &&
+            style_share_collect(&c->style_batch, setter_entry, &c->prog->values[first_value])) {
+            c->prog->value_count = first_value; // Copied into the batch
+            return true;
+        }
+#endif
+        if (constant) {
+#if LVGL_JSON_STYLE_SHARING
+            if (g_style_share_enabled && target_is_widget) style_share_mark_local(&c->style_batch, setter_entry);
+#endif
+            prog_op_t *op = prog_emit(c, slot_args ? PROG_OP_CALL_SLOTS : PROG_OP_CALL, prop_item);
+            op->entry = setter_entry;
+            op->value_index = first_value;
+            op->jump = slot_args;
+            op->flags = append_default_selector ? PROG_FLAG_DEFAULT_SELECTOR : 0;
+            return true;
+        }
+        // Leave the failing argument to the JSON invoker so errors are reported when the program runs.
+        c->prog->value_count = first_value;
+    }
+
+#if LVGL_JSON_STYLE_SHARING
+    if (g_style_share_enabled && target_is_widget) style_share_mark_local(&c->style_batch, setter_entry);
+#endif
+    prog_op_t *op = prog_emit(c, PROG_OP_INVOKE_JSON, prop_item);
+    op->entry = setter_entry;
+    op->flags = append_default_selector ? PROG_FLAG_DEFAULT_SELECTOR : 0;
+    return true;
+}
+
+static bool prog_compile_attributes_body(
+    prog_compiler_t *c,
+    cJSON *attributes_json_obj,
+    const char *target_actual_type_str,
+    const char *target_create_type_str,
+    bool target_is_widget,
+    const char *path_prefix_for_named_and_children,
+    const char *default_type_name_for_registry_if_named
+) {
+    if (!attributes_json_obj || !cJSON_IsObject(attributes_json_obj)) {
+        return false;
+    }
+
+    const char *current_children_base_path = path_prefix_for_named_and_children ? path_prefix_for_named_and_children : "";
+    bool children_base_is_bound = false; // Set by a 'named' slot; the children's paths are then only known when run
+
+    cJSON *prop_item = NULL;
+    for (prop_item = attributes_json_obj->child; prop_item != NULL; prop_item = prop_item->next) {
+        const char *prop_name = prop_item->string;
+        if (!prop_name) continue;
+
+        if (strcmp(prop_name, "type") == 0 || strcmp(prop_name, "id") == 0 || strcmp(prop_name, "context") == 0 ||
+            strcmp(prop_name, "lazy") == 0) {
+            continue;
+        }
+        if (strcmp(target_actual_type_str, "grid") == 0 && (strcmp(prop_name, "cols") == 0 || strcmp(prop_name, "rows") == 0)) {
+            continue;
+        }
+        if (strcmp(prop_name, "do") == 0 && strcmp(target_actual_type_str, "with") != 0) {
+            LOG_WARN_JSON(prop_item, "Skipping unexpected 'do' attribute key '%s' during general attribute application for type '%s'.", prop_name, target_actual_type_str);
+            continue;
+        }
+
+        if (strcmp(prop_name, "named") == 0 && cJSON_IsString(prop_item)) {
+            if (children_base_is_bound) return false;
+            int slot = prog_slot_index(c, prop_item);
+            if (slot >= 0 && default_type_name_for_registry_if_named && default_type_name_for_registry_if_named[0]) {
+                prog_op_t *op = prog_emit(c, PROG_OP_REGISTER, prop_item);
+                op->flags = PROG_FLAG_NAME_SLOT;
+                op->value_index = (uint32_t)slot;
+                op->str = prog_add_string(c, path_prefix_for_named_and_children);
+                op->type_name = prog_add_string(c, default_type_name_for_registry_if_named);
+                children_base_is_bound = true;
+                continue;
+            }
+            // Names taken from other run time values are not compiled.
+            if (!prog_value_is_constant(prop_item) || json_string_unescapes_in_place(prop_item)) return false;
+            const char *named_value_str = prop_item->valuestring;
+            if (default_type_name_for_registry_if_named && default_type_name_for_registry_if_named[0]) {
+                prog_op_t *op = prog_emit(c, PROG_OP_REGISTER, prop_item);
+                op->str = prog_add_path(c, path_prefix_for_named_and_children, named_value_str);
+                op->type_name = prog_add_string(c, default_type_name_for_registry_if_named);
+                current_children_base_path = op->str;
+            } else {
+                LOG_WARN_JSON(prop_item, "'named' attribute used, but no valid type_name_for_registry provided for '%s'. Entity not registered by this 'named' attribute.", named_value_str);
+            }
+            continue;
+        }
+
+        if (strcmp(prop_name, "children") == 0) {
+            if (!cJSON_IsArray(prop_item)) {
+                LOG_ERR_JSON(prop_item, "'children' property must be an array.");
+                continue;
+            }
+            if (!target_is_widget) {
+                LOG_ERR_JSON(prop_item, "'children' attribute found, but target entity is not a widget or parent_for_children_attr is NULL. Cannot add children.");
+                continue;
+            }
+            // Lazy children are deferred by the JSON renderer
+            if (c->frame_depth >= PROGRAM_MAX_DEPTH - 1 || lazy_requested(attributes_json_obj)) return false;
+            uint32_t path_ops_mark = c->path_ops;
+            uint32_t begin_index = c->prog->op_count;
+            prog_emit(c, PROG_OP_CHILDREN_BEGIN, prop_item);
+            c->frame_depth++;
+            cJSON *child_node_json = NULL;
+            cJSON_ArrayForEach(child_node_json, prop_item) {
+                if (!prog_compile_node(c, child_node_json, current_children_base_path)) return false;
+                prog_emit(c, PROG_OP_POP, NULL);
+            }
+            c->frame_depth--;
+            // Below a name bound from a slot, paths would have to be built when run
+            if (children_base_is_bound && c->path_ops != path_ops_mark) return false;
+            uint32_t end_index = c->prog->op_count;
+            prog_emit(c, PROG_OP_CHILDREN_END, prop_item);
+            if (!c->out_of_memory) c->prog->ops[begin_index].jump = end_index;
+            continue;
+        }
+
+        if (strcmp(prop_name, "with") == 0 && cJSON_IsObject(prop_item)) {
+            cJSON *obj_to_run_with_json = cJSON_GetObjectItemCaseSensitive(prop_item, "obj");
+            cJSON *do_block_for_with_json = cJSON_GetObjectItemCaseSensitive(prop_item, "do");
+            if (!obj_to_run_with_json) {
+                LOG_ERR_JSON(prop_item, "'with' block is missing 'obj' attribute. Skipping.");
+                continue;
+            }
+            if (!do_block_for_with_json || !cJSON_IsObject(do_block_for_with_json)) {
+                LOG_ERR_JSON(prop_item, "'with' block is missing 'do' object or it's not an object. Skipping.");
+                continue;
+            }
+            if (c->entity_depth >= PROGRAM_MAX_DEPTH - 1) return false;
+            uint32_t with_index = c->prog->op_count;
+            prog_emit(c, PROG_OP_WITH, obj_to_run_with_json);
+            c->entity_depth++;
+            if (!prog_compile_attributes(c, do_block_for_with_json, "obj", "obj", true, path_prefix_for_named_and_children, "lv_obj_t")) return false;
+            prog_emit(c, PROG_OP_POP, NULL);
+            c->entity_depth--;
+            if (!c->out_of_memory) c->prog->ops[with_index].jump = c->prog->op_count;
+            continue;
+        }
+
+        if (!prog_compile_setter(c, prop_item, prop_name, target_actual_type_str, target_create_type_str, target_is_widget)) return false;
+    }
+    return true;
+}
+
+#if LVGL_JSON_STYLE_SHARING
+// Emits the style properties collected for the top entity, one shared style per selector.
+static void prog_emit_shared_styles(prog_compiler_t *c, const style_share_batch_t *batch) {
+    style_share_prop_t group[STYLE_SHARE_MAX_PROPS];
+    for (uint32_t i = 0; batch && i < batch->count; ++i) {
+        uint32_t count = style_share_group(batch, i, group);
+        if (!count) continue;
+        uint32_t first_value = prog_alloc_values(c, 1 + 2 * count);
+        if (first_value == UINT32_MAX) return;
+        invoke_value_t *values = &c->prog->values[first_value];
+        values[0].i = batch->selectors[i];
+        for (uint32_t j = 0; j < count; ++j) {
+            values[1 + 2 * j].p = (void *)group[j].entry;
+            values[2 + 2 * j] = group[j].value;
+        }
+        prog_op_t *op = prog_emit(c, PROG_OP_SHARED_STYLE, NULL);
+        op->value_index = first_value;
+        op->jump = count;
+    }
+}
+#endif
+
+// Mirrors apply_setters_and_attributes(). Returns false if the owning node cannot be compiled.
+static bool prog_compile_attributes(
+    prog_compiler_t *c,
+    cJSON *attributes_json_obj,
+    const char *target_actual_type_str,
+    const char *target_create_type_str,
+    bool target_is_widget,
+    const char *path_prefix_for_named_and_children,
+    const char *default_type_name_for_registry_if_named
+) {
+#if LVGL_JSON_STYLE_SHARING
+    style_share_batch_t *saved_batch = c->style_batch;
+    c->style_batch = NULL;
+#endif
+    bool ok = prog_compile_attributes_body(c, attributes_json_obj, target_actual_type_str, target_create_type_str, target_is_widget,
+                                           path_prefix_for_named_and_children, default_type_name_for_registry_if_named);
+#if LVGL_JSON_STYLE_SHARING
+    if (ok) prog_emit_shared_styles(c, c->style_batch);
+    style_share_batch_release(c->style_batch);
+    c->style_batch = saved_batch;
+#endif
+    return ok;
+}
+
+// Mirrors render_json_node(). Returns false if the node has to be rendered from JSON at run time.
+static bool prog_try_compile_node(prog_compiler_t *c, cJSON *node, const char *named_path_prefix) {
+    if (!cJSON_IsObject(node)) return false;
+    if (c->entity_depth >= PROGRAM_MAX_DEPTH - 2 || c->context_depth >= PROGRAM_MAX_DEPTH - 2) return false;
+
+    cJSON *type_item = cJSON_GetObjectItemCaseSensitive(node, "type");
+    const char *type_str = "obj";
+    if (type_item && cJSON_IsString(type_item)) {
+        type_str = type_item->valuestring;
+    }
+
+    if (strcmp(type_str, "component") == 0) {
+        cJSON *id_item_comp = cJSON_GetObjectItemCaseSensitive(node, "id");
+        cJSON *root_item_comp = cJSON_GetObjectItemCaseSensitive(node, "root");
+        if (!(id_item_comp && cJSON_IsString(id_item_comp) && id_item_comp->valuestring && id_item_comp->valuestring[0] == '@' &&
+              root_item_comp && cJSON_IsObject(root_item_comp))) {
+            return false;
+        }
+        prog_op_t *op = prog_emit(c, PROG_OP_REGISTER_COMPONENT, root_item_comp);
+        op->str = id_item_comp->valuestring + 1;
+        prog_add_component(c, op->str, root_item_comp);
+        c->entity_depth++;
+        return true;
+    }
+
+    if (strcmp(type_str, "use-view") == 0) {
+        cJSON *id_item_use_view = cJSON_GetObjectItemCaseSensitive(node, "id");
+        if (!(id_item_use_view && cJSON_IsString(id_item_use_view) && id_item_use_view->valuestring && id_item_use_view->valuestring[0] == '@')) {
+            return false;
+        }
+        // Only components defined earlier in this spec are inlined; others are looked up at run time.
+        cJSON *component_root_json_node = prog_find_component(c, id_item_use_view->valuestring + 1);
+        if (!component_root_json_node) return false;
+
+        const char *comp_root_actual_type_str = "obj";
+        cJSON *comp_root_type_item = cJSON_GetObjectItemCaseSensitive(component_root_json_node, "type");
+        if (comp_root_type_item && cJSON_IsString(comp_root_type_item)) {
+            comp_root_actual_type_str = comp_root_type_item->valuestring;
+        }
+        if (strcmp(comp_root_actual_type_str, "component") == 0 || strcmp(comp_root_actual_type_str, "use-view") == 0 ||
+            strcmp(comp_root_actual_type_str, "context") == 0) {
+            return false;
+        }
+
+        cJSON *context_for_view_item = cJSON_GetObjectItemCaseSensitive(node, "context");
+        bool view_context_set_locally = context_for_view_item && cJSON_IsObject(context_for_view_item);
+        if (view_context_set_locally) {
+            prog_emit(c, PROG_OP_PUSH_CONTEXT, context_for_view_item);
+            c->context_depth++;
+        }
+
+        if (!prog_compile_node(c, component_root_json_node, named_path_prefix)) return false;
+
+        cJSON *do_attrs_json = cJSON_GetObjectItemCaseSensitive(node, "do");
+        if (do_attrs_json && cJSON_IsObject(do_attrs_json)) {
+            const char *comp_root_create_type_str = (strcmp(comp_root_actual_type_str, "grid") == 0) ? "obj" : comp_root_actual_type_str;
+            bool is_comp_root_widget = true;
+            char comp_root_registry_type_name[64] = "lv_obj_t";
+            if (strcmp(comp_root_actual_type_str, "style") == 0) {
+                is_comp_root_widget = false;
+                snprintf(comp_root_registry_type_name, sizeof(comp_root_registry_type_name), "lv_style_t");
+            } else {
+                snprintf(comp_root_registry_type_name, sizeof(comp_root_registry_type_name), "lv_%s_t", comp_root_create_type_str);
+            }
+
+            const char *comp_root_id_val = NULL;
+            cJSON *comp_root_id_item = cJSON_GetObjectItemCaseSensitive(component_root_json_node, "id");
+            if (comp_root_id_item && cJSON_IsString(comp_root_id_item) && comp_root_id_item->valuestring[0] == '@') {
+                comp_root_id_val = comp_root_id_item->valuestring + 1;
+            }
+            const char *path_for_do_block_context = prog_add_path(c, named_path_prefix, comp_root_id_val);
+
+            if (!prog_compile_attributes(c, do_attrs_json, comp_root_actual_type_str, comp_root_create_type_str, is_comp_root_widget,
+                                         path_for_do_block_context, comp_root_registry_type_name)) {
+                return false;
+            }
+        }
+
+        if (view_context_set_locally) {
+            prog_emit(c, PROG_OP_POP_CONTEXT, NULL);
+            c->context_depth--;
+        }
+        return true;
+    }
+
+    if (strcmp(type_str, "virtual-list") == 0) return false; // Rows are created while scrolling
+    if (strcmp(type_str, "for-each") == 0) return false;     // Items are only known when it runs; it compiles its body itself
+
+    if (strcmp(type_str, "context") == 0) {
+        cJSON *values_item = cJSON_GetObjectItemCaseSensitive(node, "values");
+        cJSON *for_item = cJSON_GetObjectItemCaseSensitive(node, "for");
+        if (!(values_item && cJSON_IsObject(values_item) && for_item && cJSON_IsObject(for_item))) {
+            return false;
+        }
+        prog_emit(c, PROG_OP_PUSH_CONTEXT, values_item);
+        c->context_depth++;
+        if (!prog_compile_node(c, for_item, named_path_prefix)) return false;
+        prog_emit(c, PROG_OP_POP_CONTEXT, NULL);
+        c->context_depth--;
+        return true;
+    }
+
+    cJSON *context_property_on_this_node = cJSON_GetObjectItemCaseSensitive(node, "context");
+    bool context_was_locally_changed_by_this_node = context_property_on_this_node && cJSON_IsObject(context_property_on_this_node);
+    if (context_was_locally_changed_by_this_node) {
+        prog_emit(c, PROG_OP_PUSH_CONTEXT, context_property_on_this_node);
+        c->context_depth++;
+    }
+
+    // Path for this node, built exactly like render_json_node() does
+    cJSON *id_item = cJSON_GetObjectItemCaseSensitive(node, "id");
+    const char *id_str_val = NULL;
+    if (id_item && cJSON_IsString(id_item) && id_item->valuestring && id_item->valuestring[0] == '@') {
+        id_str_val = id_item->valuestring + 1;
+    } else if (id_item && cJSON_IsString(id_item)) {
+        LOG_WARN_JSON(id_item, "Render Warning: 'id' property '%s' should start with '@' for registration/path construction. Treating as non-identifying.", id_item->valuestring);
+    }
+
+    const char *effective_path_for_node_and_children = prog_add_path(c, named_path_prefix, id_str_val);
+
+    bool is_widget = true;
+    char type_name_for_registry_buf[64] = "lv_obj_t";
+    const char *actual_type_str_for_node = type_str;
+    const char *create_type_str_for_node = type_str;
+    if (strcmp(actual_type_str_for_node, "grid") == 0) {
+        create_type_str_for_node = "obj";
+    }
+
+    int managed_index = -1;
+    for (int i = 0; i < PROG_MANAGED_TYPE_COUNT; ++i) {
+        if (strcmp(actual_type_str_for_node, g_prog_managed_types[i]) == 0) { managed_index = i; break; }
+    }
+
+    if (managed_index >= 0) {
+        const char *name_for_custom_creator = (effective_path_for_node_and_children[0] != '\\0') ? effective_path_for_node_and_children : NULL;
+        if (!name_for_custom_creator && id_str_val) name_for_custom_creator = id_str_val;
+        if (!name_for_custom_creator) return false;
+        prog_op_t *op = prog_emit(c, PROG_OP_CREATE_MANAGED, node);
+        op->value_index = (uint32_t)managed_index;
+        op->str = prog_add_string(c, name_for_custom_creator);
+        is_widget = false;
+        snprintf(type_name_for_registry_buf, sizeof(type_name_for_registry_buf), "%s", g_prog_managed_registry_types[managed_index]);
+    } else if (strcmp(actual_type_str_for_node, "with") == 0) {
+        prog_emit(c, PROG_OP_PUSH_PARENT, node);
+        actual_type_str_for_node = "obj";
+        create_type_str_for_node = "obj";
+    } else {
+        char create_func_name[64];
+        snprintf(create_func_name, sizeof(create_func_name), "lv_%s_create", create_type_str_for_node);
+        const invoke_table_entry_t *create_entry = find_invoke_entry(create_func_name);
+        if (!create_entry || !create_entry->call) return false;
+        prog_op_t *op = prog_emit(c, PROG_OP_CREATE, node);
+        op->entry = create_entry;
+
+        snprintf(type_name_for_registry_buf, sizeof(type_name_for_registry_buf), "lv_%s_t", create_type_str_for_node);
+        if (id_str_val && id_str_val[0] && effective_path_for_node_and_children[0] != '\\0') {
+            prog_op_t *reg_op = prog_emit(c, PROG_OP_REGISTER, node);
+            reg_op->str = effective_path_for_node_and_children;
+            reg_op->type_name = prog_add_string(c, type_name_for_registry_buf);
+        }
+    }
+    c->entity_depth++;
+
+    if (is_widget && strcmp(actual_type_str_for_node, "grid") == 0) {
+        prog_emit(c, PROG_OP_GRID, node);
+    }
+
+    if (!prog_compile_attributes(c, node, actual_type_str_for_node, create_type_str_for_node, is_widget,
+                                 effective_path_for_node_and_children, type_name_for_registry_buf)) {
+        return false;
+    }
+
+    if (context_was_locally_changed_by_this_node) {
+        prog_emit(c, PROG_OP_POP_CONTEXT, NULL);
+        c->context_depth--;
+    }
+    return true;
+}
+
+// Compiles one node so that it leaves exactly one entity on the interpreter stack.
+static bool prog_compile_node(prog_compiler_t *c, cJSON *node, const char *named_path_prefix) {
+    uint32_t op_mark = c->prog->op_count;
+    uint32_t value_mark = c->prog->value_count;
+    int entity_mark = c->entity_depth;
+    int frame_mark = c->frame_depth;
+    int context_mark = c->context_depth;
+
+    if (prog_try_compile_node(c, node, named_path_prefix)) {
+        return !c->out_of_memory;
+    }
+
+    // Not compilable (run time lookup, invalid node, too deep): render this subtree from JSON.
+    c->prog->op_count = op_mark;
+    c->prog->value_count = value_mark;
+    c->entity_depth = entity_mark;
+    c->frame_depth = frame_mark;
+    c->context_depth = context_mark;
+    prog_op_t *op = prog_emit(c, PROG_OP_RENDER_JSON, node);
+    op->str = named_path_prefix ? prog_add_string(c, named_path_prefix) : NULL;
+    c->entity_depth++;
+    return !c->out_of_memory;
+}
+
+void lvgl_json_free_program(lvgl_json_program_t *program) {
+    if (!program) return;
+    mem_free(LVGL_JSON_MEM_TEMPLATES, program->ops, program->op_capacity * sizeof(prog_op_t));
+    mem_free(LVGL_JSON_MEM_TEMPLATES, program->values, program->value_capacity * sizeof(invoke_value_t));
+    cJSON_Delete(program->spec);
+    cJSON_Delete(program->strings);
+    mem_free(LVGL_JSON_MEM_TEMPLATES, program, sizeof(*program));
+}
+
+lvgl_json_program_t* lvgl_json_compile_ui(cJSON *root_json) {
+    if (!root_json) {
+        LOG_ERR("Compile Error: root_json is NULL.");
+        return NULL;
+    }
+    if (!cJSON_IsArray(root_json) && !cJSON_IsObject(root_json)) {
+        LOG_ERR_JSON(root_json, "Compile Error: root_json must be a JSON object or array.");
+        return NULL;
+    }
+
+    lvgl_json_program_t *program = (lvgl_json_program_t *)mem_alloc(LVGL_JSON_MEM_TEMPLATES, sizeof(lvgl_json_program_t));
+    if (!program) {
+        LOG_ERR("Compile Error: Failed to allocate program.");
+        return NULL;
+    }
+    memset(program, 0, sizeof(*program));
+    program->spec = cJSON_Duplicate(root_json, true);
+    program->strings = cJSON_CreateArray();
+
+    prog_compiler_t compiler;
+    memset(&compiler, 0, sizeof(compiler));
+    compiler.prog = program;
+    compiler.out_of_memory = !program->spec || !program->strings;
+
+    if (!compiler.out_of_memory) {
+        if (cJSON_IsArray(program->spec)) {
+            cJSON *node_in_array = NULL;
+            cJSON_ArrayForEach(node_in_array, program->spec) {
+                if (!prog_compile_node(&compiler, node_in_array, NULL)) break;
+                prog_emit(&compiler, PROG_OP_POP, NULL);
+                compiler.entity_depth--;
+            }
+        } else if (prog_compile_node(&compiler, program->spec, NULL)) {
+            prog_emit(&compiler, PROG_OP_POP, NULL);
+            compiler.entity_depth--;
+        }
+        prog_emit(&compiler, PROG_OP_END, NULL);
+    }
+    mem_free(LVGL_JSON_MEM_TEMPORARY, compiler.components, compiler.component_capacity * sizeof(prog_component_t));
+
+    if (compiler.out_of_memory) {
+        LOG_ERR("Compile Error: Out of memory while compiling UI program.");
+        lvgl_json_free_program(program);
+        return NULL;
+    }
+    LOG_INFO("Compiled UI program: %u instructions, %u constant argument values.", (unsigned)program->op_count, (unsigned)program->value_count);
+    return program;
+}
+
+// Compiles a component root (owned by the caller, see component_def_t) into a template.
+// Returns NULL if nothing of it can be compiled; use-view then renders the JSON.
+static lvgl_json_program_t* prog_compile_template(cJSON *component_root) {
+    lvgl_json_program_t *program = (lvgl_json_program_t *)mem_alloc(LVGL_JSON_MEM_TEMPLATES, sizeof(lvgl_json_program_t));
+    if (!program) return NULL;
+    memset(program, 0, sizeof(*program));
+    program->is_template = true;
+    program->strings = cJSON_CreateArray();
+
+    prog_compiler_t compiler;
+    memset(&compiler, 0, sizeof(compiler));
+    compiler.prog = program;
+    compiler.bind_slots = true;
+    compiler.out_of_memory = !program->strings;
+    if (!compiler.out_of_memory && prog_compile_node(&compiler, component_root, NULL)) {
+        prog_emit(&compiler, PROG_OP_POP, NULL);
+        prog_emit(&compiler, PROG_OP_END, NULL);
+    }
+    mem_free(LVGL_JSON_MEM_TEMPORARY, compiler.components, compiler.component_capacity * sizeof(prog_component_t));
+
+    if (compiler.out_of_memory || program->ops[0].op == PROG_OP_RENDER_JSON) {
+        lvgl_json_free_program(program);
+        return NULL;
+    }
+    LOG_INFO("Compiled component template: %u instructions, %u slots.", (unsigned)program->op_count, (unsigned)program->slot_count);
+    return program;
+}
+
+// Joins a template's relative path onto the instance prefix; plain programs use `path` as is.
+static const char* prog_instance_path(char *buf, const char *instance_prefix, const char *path) {
+    if (!instance_prefix || !instance_prefix[0]) return path;
+    return registry_path_join(buf, instance_prefix, path);
+}
+
+static void prog_instance_path_free(const char *instance_path, char *buf, const char *path) {
+    if (instance_path != path) registry_path_free((char *)instance_path, buf);
+}
+
+static void prog_invoke_json(const prog_op_t *op, void *target) {
+    cJSON *scalar_copy = NULL;
+    cJSON *prop_value = op->node;
+    if (!cJSON_IsArray(op->node) && json_string_unescapes_in_place(op->node)) {
+        scalar_copy = cJSON_Duplicate(op->node, true);
+        if (!scalar_copy) {
+            LOG_ERR_JSON(op->node, "Failed to copy value for property '%s'", op->node->string);
+            return;
+        }
+        RENDER_STAT_INC(json_allocs);
+        prop_value = scalar_copy;
+    }
+    invoke_args_t prop_args;
+    invoke_args_init(&prop_args, prop_value);
+    if ((op->flags & PROG_FLAG_DEFAULT_SELECTOR) && prop_args.count == 1) {
+        invoke_args_append(&prop_args, &g_default_selector_json);
+    }
+    PROFILE_SPAN_BEGIN(span);
+    bool set = op->entry->invoke(op->entry, target, NULL, &prop_args);
+    PROFILE_SPAN_END(span, PROFILE_CAT_INVOKE, op->entry->name, op->node->string);
+    if (!set) {
+        LOG_ERR_JSON(op->node, "Failed to set property '%s' using '%s' on entity %p.", op->node->string, op->entry->name, target);
+    }
+    if (scalar_copy) cJSON_Delete(scalar_copy);
+}
+
+typedef struct {
+    lv_obj_t *parent;       // Parent for nodes created in this children list
+    uint32_t end_pc;        // Where to continue if one of them fails
+    int entity_top;
+    int context_top;
+} prog_frame_t;
+
+// Runs `program` below `effective_parent`. For templates, `instance_prefix` is the path the
+// instance is rendered under and `*template_root` receives the component root entity.
+static bool prog_execute(const lvgl_json_program_t *program, lv_obj_t *effective_parent, const char *instance_prefix, void **template_root) {
+    // Template slots: one scope chain lookup per variable and instance
+    cJSON *slots[PROGRAM_MAX_SLOTS];
+    render_scope_t *slot_scopes[PROGRAM_MAX_SLOTS];
+    for (uint32_t i = 0; i < program->slot_count; ++i) {
+        slot_scopes[i] = NULL;
+        slots[i] = context_lookup(program->slot_names[i], &slot_scopes[i]);
+    }
+
+    void *entities[PROGRAM_MAX_DEPTH];
+    render_scope_t scopes[PROGRAM_MAX_DEPTH];
+    prog_frame_t frames[PROGRAM_MAX_DEPTH];
+    int entity_top = 0;
+    int context_top = 0;
+    int frame_top = 0;
+    frames[0].parent = effective_parent;
+    frames[0].end_pc = program->op_count - 1; // PROG_OP_END
+    frames[0].entity_top = 0;
+    frames[0].context_top = 0;
+
+    bool overall_success = true;
+    const prog_op_t *failed_op = NULL;
+    uint32_t pc = 0;
+    render_pass_begin();
+
+    while (pc < program->op_count) {
+        const prog_op_t *op = &program->ops[pc++];
+        switch (op->op) {
+            case PROG_OP_CREATE: {
+                lv_obj_t *new_widget = NULL;
+                PROFILE_SPAN_BEGIN(span);
+                bool created = op->entry->call(op->entry, (void*)frames[frame_top].parent, &new_widget, NULL);
+                PROFILE_SPAN_END(span, PROFILE_CAT_INVOKE, op->entry->name, NULL);
+                if (!created || !new_widget) {
+                    LOG_ERR_JSON(op->node, "Render Error: %s failed.", op->entry->name);
+                    goto node_failed;
+                }
+                mem_count_widget(op->entry->name);
+                entities[entity_top++] = new_widget;
+                break;
+            }
+            case PROG_OP_CREATE_MANAGED: {
+                char path_buf[REGISTRY_PATH_BUF_SIZE];
+                const char *name = prog_instance_path(path_buf, instance_prefix, op->str);
+                void *created_entity = prog_create_managed(op->value_index, name);
+                if (!created_entity) {
+                    LOG_ERR_JSON(op->node, "Render Error: Custom creator for name '%s' returned NULL.", name);
+                }
+                prog_instance_path_free(name, path_buf, op->str);
+                if (!created_entity) goto node_failed;
+                entities[entity_top++] = created_entity;
+                break;
+            }
+            case PROG_OP_PUSH_PARENT:
+                entities[entity_top++] = frames[frame_top].parent;
+                break;
+            case PROG_OP_WITH: {
+                lv_obj_t *with_target_obj = NULL;
+                cJSON *obj_copy = json_string_unescapes_in_place(op->node) ? cJSON_Duplicate(op->node, true) : NULL;
+                bool resolved = unmarshal_value(obj_copy ? obj_copy : op->node, TYPE_ID_OBJ_PTR, "lv_obj_t *", &with_target_obj, entities[entity_top - 1]);
+                if (obj_copy) cJSON_Delete(obj_copy);
+                if (!resolved || !with_target_obj) {
+                    if (!resolved) {
+                        LOG_ERR_JSON(op->node, "Failed to unmarshal 'obj' for 'with' block. Skipping 'with'.");
+                    } else {
+                        LOG_ERR_JSON(op->node, "'obj' for 'with' block resolved to NULL. Skipping 'with'.");
+                    }
+                    pc = op->jump;
+                    break;
+                }
+                entities[entity_top++] = with_target_obj;
+                break;
+            }
+            case PROG_OP_POP:
+                entity_top--;
+                if (template_root && frame_top == 0) *template_root = entities[entity_top];
+                break;
+            case PROG_OP_REGISTER: {
+                char path_buf[REGISTRY_PATH_BUF_SIZE];
+                const char *path = prog_instance_path(path_buf, instance_prefix, op->str);
+                if (op->flags & PROG_FLAG_NAME_SLOT) {
+                    // An unbound slot reports the missing variable through the usual context lookup
+                    cJSON *bound = slots[op->value_index];
+                    char *named_value_str = NULL;
+                    bool resolved = bound ? context_unmarshal_value(bound, slot_scopes[op->value_index], TYPE_ID_STRING, "char *", &named_value_str)
+                                          : unmarshal_value(op->node, TYPE_ID_STRING, "char *", &named_value_str, entities[entity_top - 1]);
+                    if (resolved) {
+                        char named_buf[REGISTRY_PATH_BUF_SIZE];
+                        char *named_path = registry_path_join(named_buf, path, named_value_str);
+                        lvgl_json_register_ptr(named_path, op->type_name, entities[entity_top - 1]);
+                        LOG_INFO("Registered entity %p as '%s' (type %s) via 'named' attribute.", entities[entity_top - 1], named_path, op->type_name);
+                        registry_path_free(named_path, named_buf);
+                    } else {
+                        LOG_ERR_JSON(op->node, "Failed to resolve 'named' property value string: '%s'", op->node->valuestring);
+                    }
+                } else {
+                    lvgl_json_register_ptr(path, op->type_name, entities[entity_top - 1]);
+                }
+                prog_instance_path_free(path, path_buf, op->str);
+                break;
+            }
+            case PROG_OP_GRID:
+                apply_grid_layout(op->node, (lv_obj_t*)entities[entity_top - 1]);
+                break;
+            case PROG_OP_CALL: {
+                RENDER_STAT_INC(properties_set);
+                PROFILE_SPAN_BEGIN(span);
+                bool set = op->entry->call(op->entry, entities[entity_top - 1], NULL, &program->values[op->value_index]);
+                PROFILE_SPAN_END(span, PROFILE_CAT_INVOKE, op->entry->name, op->node->string);
+                if (!set) {
+                    LOG_ERR_JSON(op->node, "Failed to set property '%s' using '%s' on entity %p.", op->node->string, op->entry->name, entities[entity_top - 1]);
+                }
+                break;
+            }
+            case PROG_OP_CALL_SLOTS: {
+                RENDER_STAT_INC(properties_set);
+                int arg_count = op->entry->arity - op->entry->first_json_arg;
+                invoke_value_t values[PROGRAM_MAX_CALL_ARGS];
+                memcpy(values, &program->values[op->value_index], (size_t)arg_count * sizeof(invoke_value_t));
+                bool bound = true;
+                for (int i = 0; bound && i < arg_count; ++i) {
+                    if (!(op->jump & (1u << i))) continue;
+                    int32_t slot = program->values[op->value_index + i].i;
+                    int c_index = op->entry->first_json_arg + i;
+                    memset(&values[i], 0, sizeof(values[i]));
+                    bound = slots[slot] && context_unmarshal_value(slots[slot], slot_scopes[slot], op->entry->arg_type_ids[c_index], op->entry->arg_types[c_index], &values[i]);
+                }
+                if (!bound) {
+                    // Missing or unusable variable: the JSON path reports it like an unbound '$' value
+                    prog_invoke_json(op, entities[entity_top - 1]);
+                    break;
+                }
+                PROFILE_SPAN_BEGIN(span);
+                bool set = op->entry->call(op->entry, entities[entity_top - 1], NULL, values);
+                PROFILE_SPAN_END(span, PROFILE_CAT_INVOKE, op->entry->name, op->node->string);
+                if (!set) {
+                    LOG_ERR_JSON(op->node, "Failed to set property '%s' using '%s' on entity %p.", op->node->string, op->entry->name, entities[entity_top - 1]);
+                }
+                break;
+            }
+            case PROG_OP_INVOKE_JSON:
+                RENDER_STAT_INC(properties_set);
+                prog_invoke_json(op, entities[entity_top - 1]);
+                break;
+#if LVGL_JSON_STYLE_SHARING
+            case PROG_OP_SHARED_STYLE: {
+                style_share_prop_t props[STYLE_SHARE_MAX_PROPS];
+                const invoke_value_t *values = &program->values[op->value_index];
+                for (uint32_t i = 0; i < op->jump; ++i) {
+                    props[i].entry = (const invoke_table_entry_t *)values[1 + 2 * i].p;
+                    props[i].value = values[2 + 2 * i];
+                }
+                g_render_stats.properties_set += op->jump;
+                style_share_add((lv_obj_t *)entities[entity_top - 1], props, op->jump, (uint32_t)values[0].i);
+                break;
+            }
+#endif
+            case PROG_OP_PUSH_CONTEXT:
+                push_context(&scopes[context_top++], op->node);
+                break;
+            case PROG_OP_POP_CONTEXT:
+                set_current_context(scopes[--context_top].parent);
+                break;
+            case PROG_OP_CHILDREN_BEGIN:
+                frame_top++;
+                frames[frame_top].parent = (lv_obj_t*)entities[entity_top - 1];
+                frames[frame_top].end_pc = op->jump;
+                frames[frame_top].entity_top = entity_top;
+                frames[frame_top].context_top = context_top;
+                break;
+            case PROG_OP_CHILDREN_END:
+            case PROG_OP_END:
+                // Normally balanced already; after a failure this unwinds the failed node.
+                entity_top = frames[frame_top].entity_top;
+                while (context_top > frames[frame_top].context_top) {
+                    set_current_context(scopes[--context_top].parent);
+                }
+                if (failed_op) {
+                    if (op->op == PROG_OP_END && program->is_template) {
+                        overall_success = false; // The component root failed; use-view reports it
+                    } else if (op->op == PROG_OP_END) {
+                        LOG_ERR_JSON(failed_op->node, "Render Error: Failed to render top-level node. Aborting.");
+                        overall_success = false;
+                    } else {
+                        LOG_ERR_JSON(failed_op->node, "Failed to render child node from 'children' attribute. Aborting siblings for this 'children' array.");
+                    }
+                    failed_op = NULL;
+                }
+                if (op->op == PROG_OP_END) {
+                    pc = program->op_count;
+                } else {
+                    frame_top--;
+                }
+                break;
+            case PROG_OP_REGISTER_COMPONENT:
+                if (!component_define(op->str, op->node)) {
+                    LOG_ERR_JSON(op->node, "Component Error: Failed to duplicate root for component '%s'", op->str);
+                    goto node_failed;
+                }
+                entities[entity_top++] = (void*)1;
+                break;
+            case PROG_OP_RENDER_JSON: {
+                char path_buf[REGISTRY_PATH_BUF_SIZE];
+                const char *prefix = op->str;
+                if (instance_prefix && instance_prefix[0]) prefix = registry_path_join(path_buf, instance_prefix, op->str);
+                void *entity = render_json_node(op->node, frames[frame_top].parent, prefix);
+                if (prefix != op->str) registry_path_free((char *)prefix, path_buf);
+                if (!entity) goto node_failed;
+                entities[entity_top++] = entity;
+                break;
+            }
+            default:
+                LOG_ERR("Run Error: Invalid opcode %d at %u.", op->op, (unsigned)(pc - 1));
+                render_pass_end();
+                return false;
+        }
+        continue;
+
+    node_failed:
+        // Skip the rest of the enclosing children list (or the whole UI at top level).
+        failed_op = op;
+        pc = frames[frame_top].end_pc;
+    }
+    render_pass_end();
+    return overall_success;
+}
+
+static void* prog_run_template(const lvgl_json_program_t *template_program, lv_obj_t *parent, const char *instance_prefix) {
+    void *component_root_entity = NULL;
+    if (!prog_execute(template_program, parent, instance_prefix, &component_root_entity)) return NULL;
+    return component_root_entity;
+}
+
+bool lvgl_json_run_program(const lvgl_json_program_t *program, lv_obj_t *implicit_root_parent) {
+    if (!program || !program->ops || program->op_count == 0) {
+        LOG_ERR("Run Error: program is NULL or empty.");
+        return false;
+    }
+    lv_obj_t *effective_parent = implicit_root_parent;
+    if (!effective_parent) {
+        LOG_WARN("Render Warning: implicit_root_parent is NULL. Using lv_screen_active().");
+        effective_parent = lv_screen_active();
+        if (!effective_parent) {
+            LOG_ERR("Render Error: Cannot get active screen.");
+            return false;
+        }
+    }
+
+    bool overall_success = prog_execute(program, effective_parent, NULL, NULL);
+    if (!overall_success) {
+        LOG_ERR("UI Rendering failed.");
+    } else {
+        LOG_INFO("UI Rendering completed successfully.");
+    }
+    return overall_success;
+}
+"""
+    return c_code
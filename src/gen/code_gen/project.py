@@ -0,0 +1,476 @@
+# code_gen/project.py
+import logging
+
+logger = logging.getLogger(__name__)
+
+
+def generate_project_code():
+    """
+    Generates projects: UI specs split over files joined with top-level {"import": "path"} nodes.
+    Files are JSON, or YAML if named *.yaml or *.yml.
+
+    Every load reads and hashes each file (64 bit, a word at a time). A file whose hash did not change keeps
+    its parsed tree; a changed or new one is loaded from its binary artifact in the cache directory
+    if there is one (named after the hash, the parser and LVGL_JSON_GENERATOR_VERSION), otherwise parsed, and
+    its artifact written. The linked spec is an array of references to the top-level nodes of all
+    files, so linking copies nothing. Trees replaced by a load are retired rather than freed: the
+    previous spec (e.g. held by a live UI until it has compared it with the new one) still points
+    into them.
+    """
+    return r"""
+// --- Projects (multi-file specs) ---
+
+#if LVGL_JSON_USE_PROJECT
+
+typedef struct project_tree_s {
+    struct project_tree_s *next;    // Retired trees
+    cJSON *root;
+    cJSON *json;                    // Parsed tree (owned), NULL for an artifact view
+    size_t json_bytes;              // Accounted size of json
+    void *artifact;                 // Cached binary artifact the view points into
+    size_t artifact_size;
+    cJSON *view;                    // lvjb_view_create() of artifact
+    size_t view_size;
+    uint32_t retired_at;            // Successful loads when the tree was replaced
+} project_tree_t;
+
+typedef struct {
+    char *path;                     // Normalized, owned
+    size_t path_size;
+    uint64_t hash;                  // Content hash of the file `tree` was loaded from
+    project_tree_t *tree;
+    uint32_t linked_at;             // Load that last linked the file
+} project_file_t;
+
+struct lvgl_json_project_s {
+    lvgl_json_project_io_t io;
+    char *artifact_path;            // "<cache_dir>/", artifact names are written after it; NULL = no cache
+    size_t artifact_path_size;
+    size_t cache_dir_len;
+    project_file_t *files;
+    uint32_t file_count;
+    uint32_t file_capacity;
+    project_tree_t *retired;
+    uint32_t loads;                 // Load attempts
+    uint32_t successes;             // Loads that returned a spec
+    lvgl_json_project_stats_t *stats; // Of the running load
+};
+
+static int32_t project_stdio_size(const char *path, void *user_data) {
+    (void)user_data;
+    FILE *fp = fopen(path, "rb");
+    if (!fp) return -1;
+    long size = (fseek(fp, 0, SEEK_END) == 0) ? ftell(fp) : -1;
+    fclose(fp);
+    return (size < 0 || size > INT32_MAX) ? -1 : (int32_t)size;
+}
+
+static bool project_stdio_read(const char *path, void *buf, size_t len, void *user_data) {
+    (void)user_data;
+    FILE *fp = fopen(path, "rb");
+    if (!fp) return false;
+    bool ok = fread(buf, 1, len, fp) == len;
+    fclose(fp);
+    return ok;
+}
+
+// Writes to a temporary name first so a concurrent load never reads a partial artifact.
+static bool project_stdio_write(const char *path, const void *data, size_t len, void *user_data) {
+    (void)user_data;
+    size_t tmp_size = strlen(path) + sizeof(".tmp");
+    char *tmp_path = (char *)mem_alloc(LVGL_JSON_MEM_TEMPORARY, tmp_size);
+    if (!tmp_path) return false;
+    int written = snprintf(tmp_path, tmp_size, "%s.tmp", path);
+    FILE *fp = (written >= 0 && (size_t)written < tmp_size) ? fopen(tmp_path, "wb") : NULL;
+    bool ok = fp != NULL;
+    if (fp) {
+        ok = fwrite(data, 1, len, fp) == len;
+        ok = (fclose(fp) == 0) && ok;
+        if (ok) ok = rename(tmp_path, path) == 0;
+        if (!ok) remove(tmp_path);
+    }
+    mem_free(LVGL_JSON_MEM_TEMPORARY, tmp_path, tmp_size);
+    return ok;
+}
+
+// Content hash, 8 bytes per step: multiply spreads each word upwards, the shift back down.
+static uint64_t project_hash(const char *data, size_t len) {
+    uint64_t hash = 0xcbf29ce484222325ull ^ (uint64_t)len;
+    size_t i = 0;
+    for (; i + 8 <= len; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, sizeof(word));
+        hash = (hash ^ word) * 0x9e3779b97f4a7c15ull;
+        hash ^= hash >> 29;
+    }
+    for (; i < len; ++i) hash = (hash ^ (uint8_t)data[i]) * 0x100000001b3ull;
+    hash ^= hash >> 32;
+    hash *= 0xd6e8feb86659fd93ull;
+    return hash ^ (hash >> 32);
+}
+
+// Lexically drops "." segments and "dir/.." pairs so each file has one name.
+static void project_normalize_path(char *path) {
+    char *out = path;
+    const char *in = path;
+    if (*in == '/') {
+        *out++ = '/';
+        while (*in == '/') in++;
+    }
+    char *base = out;
+    while (*in) {
+        const char *end = strchr(in, '/');
+        if (!end) end = in + strlen(in);
+        size_t n = (size_t)(end - in);
+        if (n == 2 && in[0] == '.' && in[1] == '.') {
+            char *segment = out;
+            while (segment > base && segment[-1] != '/') segment--;
+            bool parent_known = out > base && !(out - segment == 2 && segment[0] == '.' && segment[1] == '.');
+            if (parent_known) {
+                out = segment > base ? segment - 1 : base;
+            } else {
+                if (out > base) *out++ = '/';
+                *out++ = '.';
+                *out++ = '.';
+            }
+        } else if (n > 0 && !(n == 1 && in[0] == '.')) {
+            if (out > base) *out++ = '/';
+            memmove(out, in, n);
+            out += n;
+        }
+        in = *end ? end + 1 : end;
+    }
+    *out = '\0';
+}
+
+// `path` joined to the directory of `importer` (none for the root file), normalized.
+static char* project_resolve_path(const char *importer, const char *path, size_t *size) {
+    size_t dir_len = 0;
+    if (importer && path[0] != '/') {
+        const char *slash = strrchr(importer, '/');
+        if (slash) dir_len = (size_t)(slash - importer) + 1;
+    }
+    *size = dir_len + strlen(path) + 1;
+    char *resolved = (char *)mem_alloc(LVGL_JSON_MEM_OTHER, *size);
+    if (!resolved) return NULL;
+    if (dir_len) memcpy(resolved, importer, dir_len);
+    memcpy(resolved + dir_len, path, *size - dir_len);
+    project_normalize_path(resolved);
+    return resolved;
+}
+
+// Reads a whole file plus a terminating NUL; *size is the size of the returned allocation.
+static char* project_read(lvgl_json_project_t *project, const char *path, uint8_t cat, size_t *len, size_t *size) {
+    int32_t file_size = project->io.size(path, project->io.user_data);
+    if (file_size < 0) return NULL;
+    *size = (size_t)file_size + 1;
+    char *data = (char *)mem_alloc(cat, *size);
+    if (!data) return NULL;
+    if (file_size > 0 && !project->io.read(path, data, (size_t)file_size, project->io.user_data)) {
+        mem_free(cat, data, *size);
+        return NULL;
+    }
+    data[file_size] = '\0';
+    *len = (size_t)file_size;
+    project->stats->bytes_read += (uint32_t)file_size;
+    return data;
+}
+
+static void project_tree_free(project_tree_t *tree) {
+    if (!tree) return;
+    if (tree->json) {
+        mem_unaccount(LVGL_JSON_MEM_OTHER, tree->json_bytes);
+        cJSON_Delete(tree->json);
+    }
+    if (tree->view) lvjb_view_free(tree->view, tree->view_size);
+    mem_free(LVGL_JSON_MEM_OTHER, tree->artifact, tree->artifact_size);
+    mem_free(LVGL_JSON_MEM_OTHER, tree, sizeof(*tree));
+}
+
+static void project_retire(lvgl_json_project_t *project, project_tree_t *tree) {
+    if (!tree) return;
+    tree->retired_at = project->successes;
+    tree->next = project->retired;
+    project->retired = tree;
+}
+
+// Frees retired trees no spec returned so far can point into any more (all of them if `all`).
+static void project_free_retired(lvgl_json_project_t *project, bool all) {
+    project_tree_t **link = &project->retired;
+    while (*link) {
+        project_tree_t *tree = *link;
+        if (all || tree->retired_at < project->successes) {
+            *link = tree->next;
+            project_tree_free(tree);
+        } else {
+            link = &tree->next;
+        }
+    }
+}
+
+static bool project_is_yaml(const char *path) {
+    const char *ext = strrchr(path, '.');
+    return ext && (strcmp(ext, ".yaml") == 0 || strcmp(ext, ".yml") == 0);
+}
+
+// Name of the artifact of content `hash` read by the parser of `source`, valid until the next call.
+// The same bytes parse differently as YAML and as JSON, so the parser is part of the name.
+static const char* project_artifact_path(lvgl_json_project_t *project, uint64_t hash, const char *source) {
+    snprintf(project->artifact_path + project->cache_dir_len, project->artifact_path_size - project->cache_dir_len,
+             "%08lx%08lx-%s-%s.lvjb", (unsigned long)(hash >> 32), (unsigned long)(hash & 0xFFFFFFFFu),
+             project_is_yaml(source) ? "yaml" : "json", LVGL_JSON_GENERATOR_VERSION);
+    return project->artifact_path;
+}
+
+static project_tree_t* project_tree_from_cache(lvgl_json_project_t *project, uint64_t hash, const char *source) {
+    if (!project->artifact_path) return NULL;
+    const char *path = project_artifact_path(project, hash, source);
+    size_t len = 0, size = 0;
+    char *artifact = project_read(project, path, LVGL_JSON_MEM_OTHER, &len, &size);
+    if (!artifact) return NULL;
+    project_tree_t *tree = (project_tree_t *)mem_alloc(LVGL_JSON_MEM_OTHER, sizeof(project_tree_t));
+    if (tree) {
+        memset(tree, 0, sizeof(*tree));
+        tree->artifact = artifact;
+        tree->artifact_size = size;
+        tree->view = lvjb_view_create(artifact, len, true, &tree->view_size);
+        tree->root = tree->view;
+    }
+    if (!tree || !tree->view) {
+        // A damaged artifact is parsed again and replaced
+        if (tree) LOG_WARN("Project Warning: Ignoring cached artifact '%s'.", path);
+        mem_free(LVGL_JSON_MEM_OTHER, artifact, size);
+        mem_free(LVGL_JSON_MEM_OTHER, tree, sizeof(*tree));
+        return NULL;
+    }
+    return tree;
+}
+
+// *shared is set if the tree shares nodes (YAML aliases).
+static project_tree_t* project_tree_parse(const char *path, const char *text, size_t len, bool *shared) {
+    cJSON *json;
+    uint32_t aliases = 0;
+    if (project_is_yaml(path)) {
+#if LVGL_JSON_USE_YAML
+        json = yaml_parse(text, len, &aliases);
+        if (!json) {
+            LOG_ERR("Project Error: Failed to parse '%s'.", path);
+            return NULL;
+        }
+#else
+        (void)len;
+        LOG_ERR("Project Error: Cannot parse '%s', YAML is compiled out (LVGL_JSON_USE_YAML).", path);
+        return NULL;
+#endif
+    } else if ((json = cJSON_Parse(text)) == NULL) {
+        const char *error = cJSON_GetErrorPtr();
+        unsigned line = 1;
+        for (const char *c = text; error && c < error && *c; ++c) line += (*c == '\n');
+        LOG_ERR("Project Error: Failed to parse '%s' at line %u near: %.32s", path, line, error ? error : "?");
+        return NULL;
+    }
+    *shared = (aliases > 0);
+    project_tree_t *tree = (project_tree_t *)mem_alloc(LVGL_JSON_MEM_OTHER, sizeof(project_tree_t));
+    if (!tree) {
+        cJSON_Delete(json);
+        return NULL;
+    }
+    memset(tree, 0, sizeof(*tree));
+    tree->root = tree->json = json;
+    tree->json_bytes = mem_json_bytes(json);
+    mem_account(LVGL_JSON_MEM_OTHER, tree->json_bytes);
+    return tree;
+}
+
+static void project_cache_store(lvgl_json_project_t *project, uint64_t hash, const char *source, const cJSON *root) {
+    if (!project->artifact_path || !project->io.write) return;
+    size_t len = 0;
+    void *artifact = lvgl_json_encode_binary(root, &len);
+    if (!artifact) return;
+    const char *path = project_artifact_path(project, hash, source);
+    if (!project->io.write(path, artifact, len, project->io.user_data)) {
+        LOG_WARN("Project Warning: Failed to write cached artifact '%s'.", path);
+    }
+    LV_FREE(artifact);
+}
+
+// Brings the tree of `file` up to date with its content.
+static bool project_update(lvgl_json_project_t *project, project_file_t *file, const char *importer) {
+    size_t len = 0, size = 0;
+    char *text = project_read(project, file->path, LVGL_JSON_MEM_TEMPORARY, &len, &size);
+    if (!text) {
+        if (importer) LOG_ERR("Project Error: Cannot read '%s', imported by '%s'.", file->path, importer);
+        else LOG_ERR("Project Error: Cannot read '%s'.", file->path);
+        return false;
+    }
+    uint64_t hash = project_hash(text, len);
+    project_tree_t *tree = NULL;
+    bool shared = false;
+    if (file->tree && file->hash == hash) {
+        project->stats->files_reused++;
+    } else if ((tree = project_tree_from_cache(project, hash, file->path)) != NULL) {
+        project->stats->files_cached++;
+    } else if ((tree = project_tree_parse(file->path, text, len, &shared)) != NULL) {
+        project->stats->files_parsed++;
+        // An artifact would hold copies of the nodes a YAML file shares through aliases
+        if (!shared) project_cache_store(project, hash, file->path, tree->root);
+    }
+    mem_free(LVGL_JSON_MEM_TEMPORARY, text, size);
+    if (tree) {
+        project_retire(project, file->tree);
+        file->tree = tree;
+        file->hash = hash;
+    }
+    return file->tree && file->hash == hash;
+}
+
+static project_file_t* project_file(lvgl_json_project_t *project, char *path, size_t path_size) {
+    for (uint32_t i = 0; i < project->file_count; ++i) {
+        if (strcmp(project->files[i].path, path) == 0) {
+            mem_free(LVGL_JSON_MEM_OTHER, path, path_size);
+            return &project->files[i];
+        }
+    }
+    if (project->file_count == project->file_capacity) {
+        uint32_t capacity = project->file_capacity ? project->file_capacity * 2 : 8;
+        project_file_t *files = (project_file_t *)mem_alloc(LVGL_JSON_MEM_OTHER, capacity * sizeof(project_file_t));
+        if (!files) {
+            mem_free(LVGL_JSON_MEM_OTHER, path, path_size);
+            return NULL;
+        }
+        if (project->file_count) memcpy(files, project->files, project->file_count * sizeof(project_file_t));
+        mem_free(LVGL_JSON_MEM_OTHER, project->files, project->file_capacity * sizeof(project_file_t));
+        project->files = files;
+        project->file_capacity = capacity;
+    }
+    project_file_t *file = &project->files[project->file_count++];
+    memset(file, 0, sizeof(*file));
+    file->path = path;
+    file->path_size = path_size;
+    return file;
+}
+
+// Links the top-level nodes of file `path` (owned, normalized) into `spec`, imports in their place.
+static bool project_link(lvgl_json_project_t *project, char *path, size_t path_size, const char *importer, cJSON *spec) {
+    project_file_t *file = project_file(project, path, path_size);
+    if (!file) {
+        LOG_ERR("Project Error: Out of memory adding a file.");
+        return false;
+    }
+    if (file->linked_at == project->loads) return true; // Linked where it was first imported
+    file->linked_at = project->loads;
+    if (!project_update(project, file, importer)) return false;
+
+    // `files` may grow while imports are linked; path and tree stay put
+    const char *file_path = file->path;
+    cJSON *root = file->tree->root;
+    if (!cJSON_IsArray(root) && !cJSON_IsObject(root)) {
+        LOG_ERR("Project Error: '%s' must hold an array of nodes or a single node.", file_path);
+        return false;
+    }
+    for (cJSON *node = cJSON_IsArray(root) ? root->child : root; node; node = node->next) {
+        cJSON *import = cJSON_IsObject(node) ? cJSON_GetObjectItemCaseSensitive(node, "import") : NULL;
+        if (!import) {
+            if (!cJSON_AddItemReferenceToArray(spec, node)) {
+                LOG_ERR("Project Error: Out of memory linking '%s'.", file_path);
+                return false;
+            }
+            continue;
+        }
+        if (!cJSON_IsString(import) || !import->valuestring[0]) {
+            LOG_ERR_JSON(node, "Project Error: 'import' must be the path of a file.");
+            return false;
+        }
+        size_t import_size = 0;
+        char *import_path = project_resolve_path(file_path, import->valuestring, &import_size);
+        if (!import_path || !project_link(project, import_path, import_size, file_path, spec)) return false;
+    }
+    return true;
+}
+
+lvgl_json_project_t *lvgl_json_project_create(const lvgl_json_project_io_t *io, const char *cache_dir) {
+    lvgl_json_project_t *project = (lvgl_json_project_t *)mem_alloc(LVGL_JSON_MEM_OTHER, sizeof(lvgl_json_project_t));
+    if (!project) return NULL;
+    memset(project, 0, sizeof(*project));
+    if (io) {
+        project->io = *io;
+    } else {
+        project->io.size = project_stdio_size;
+        project->io.read = project_stdio_read;
+        project->io.write = project_stdio_write;
+    }
+    if (cache_dir && cache_dir[0]) {
+        project->cache_dir_len = strlen(cache_dir) + 1;
+        project->artifact_path_size = project->cache_dir_len + sizeof(LVGL_JSON_GENERATOR_VERSION) + 29; // "<hash>-<parser>-<version>.lvjb"
+        project->artifact_path = (char *)mem_alloc(LVGL_JSON_MEM_OTHER, project->artifact_path_size);
+        if (!project->artifact_path) {
+            mem_free(LVGL_JSON_MEM_OTHER, project, sizeof(*project));
+            return NULL;
+        }
+        memcpy(project->artifact_path, cache_dir, project->cache_dir_len - 1);
+        project->artifact_path[project->cache_dir_len - 1] = '/';
+    }
+    return project;
+}
+
+cJSON *lvgl_json_project_load(lvgl_json_project_t *project, const char *path, lvgl_json_project_stats_t *stats) {
+    lvgl_json_project_stats_t local_stats;
+    if (!stats) stats = &local_stats;
+    memset(stats, 0, sizeof(*stats));
+    if (!project || !path || !path[0]) return NULL;
+
+    project_free_retired(project, false);
+    project->loads++;
+    project->stats = stats;
+    render_arena_suspend(); // Trees and the spec outlive any render pass
+    cJSON *spec = cJSON_CreateArray();
+    size_t root_size = 0;
+    char *root_path = spec ? project_resolve_path(NULL, path, &root_size) : NULL;
+    bool ok = root_path && project_link(project, root_path, root_size, NULL, spec);
+    render_arena_resume();
+    project->stats = NULL;
+
+    // Files no longer imported are dropped
+    uint32_t kept = 0;
+    for (uint32_t i = 0; i < project->file_count; ++i) {
+        project_file_t *file = &project->files[i];
+        if (file->linked_at == project->loads) {
+            project->files[kept++] = *file;
+        } else {
+            project_retire(project, file->tree);
+            mem_free(LVGL_JSON_MEM_OTHER, file->path, file->path_size);
+        }
+    }
+    project->file_count = kept;
+    stats->files = kept;
+
+    if (!ok) {
+        cJSON_Delete(spec);
+        return NULL;
+    }
+    project->successes++;
+    return spec;
+}
+
+uint32_t lvgl_json_project_file_count(const lvgl_json_project_t *project) {
+    return project ? project->file_count : 0;
+}
+
+const char *lvgl_json_project_file_path(const lvgl_json_project_t *project, uint32_t index) {
+    return (project && index < project->file_count) ? project->files[index].path : NULL;
+}
+
+void lvgl_json_project_free(lvgl_json_project_t *project) {
+    if (!project) return;
+    for (uint32_t i = 0; i < project->file_count; ++i) {
+        project_tree_free(project->files[i].tree);
+        mem_free(LVGL_JSON_MEM_OTHER, project->files[i].path, project->files[i].path_size);
+    }
+    project_free_retired(project, true);
+    mem_free(LVGL_JSON_MEM_OTHER, project->files, project->file_capacity * sizeof(project_file_t));
+    mem_free(LVGL_JSON_MEM_OTHER, project->artifact_path, project->artifact_path_size);
+    mem_free(LVGL_JSON_MEM_OTHER, project, sizeof(*project));
+}
+
+#endif // LVGL_JSON_USE_PROJECT
+"""
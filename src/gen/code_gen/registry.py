@@ -6,149 +6,513 @@ logger = logging.getLogger(__name__)
 
 # Simple registry config
 MAX_REGISTRY_SIZE = 100 # For static array implementation
-MAX_STATIC_STRS = 32 # For static string array implementation
+
+# Interned strings for registry names, type names and static ('!') strings. Each distinct string
+# is stored once with a count of registry references; type names compare by pointer.
+STRING_POOL_C = """// Interned String Pool
+typedef struct {
+    uint32_t hash;
+    uint32_t refs;       // Registry entries using the string (as name or type name)
+    bool is_static;      // Handed out by lvgl_json_register_str(), held until the UI is cleared
+    char str[];
+} interned_str_t;
+
+#define STR_POOL_MIN_CAPACITY 64
+#define STR_POOL_ENTRY(s) ((interned_str_t *)((char *)(s) - offsetof(interned_str_t, str)))
+
+static interned_str_t **g_str_pool = NULL; // Open addressing, linear probing
+static uint32_t g_str_pool_capacity = 0;    // Power of two
+static uint32_t g_str_pool_count = 0;
+static size_t g_str_pool_bytes = 0;         // Interned strings, excluding the table
+
+// djb2 of similar names (btn1, btn2, ...) is nearly sequential, which makes linear probing
+// build long runs; the final mix (murmur3 fmix32) spreads them over the table.
+static uint32_t hash_finalize(uint32_t h) {
+    h ^= h >> 16; h *= 0x85ebca6bu;
+    h ^= h >> 13; h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+static uint32_t str_pool_hash(const char *s, size_t len) {
+    uint32_t h = 5381;
+    for (size_t i = 0; i < len; ++i) h = ((h << 5) + h) + (uint8_t)s[i]; /* djb2 */
+    return hash_finalize(h);
+}
+
+// Returns the slot holding the string, or the empty slot where it would go.
+static uint32_t str_pool_slot(const char *s, size_t len, uint32_t hash) {
+    uint32_t mask = g_str_pool_capacity - 1;
+    uint32_t i = hash & mask;
+    while (g_str_pool[i]) {
+        interned_str_t *e = g_str_pool[i];
+        if (e->hash == hash && strncmp(e->str, s, len) == 0 && e->str[len] == '\\0') break;
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+static bool str_pool_resize(uint32_t capacity) {
+    interned_str_t **slots = (interned_str_t **)mem_alloc(LVGL_JSON_MEM_STRINGS, capacity * sizeof(interned_str_t *));
+    if (!slots) return false;
+    RENDER_STAT_INC(heap_allocs);
+    memset(slots, 0, capacity * sizeof(interned_str_t *));
+    interned_str_t **old = g_str_pool;
+    uint32_t old_capacity = g_str_pool_capacity;
+    g_str_pool = slots;
+    g_str_pool_capacity = capacity;
+    g_str_pool_count = 0;
+    for (uint32_t i = 0; i < old_capacity; ++i) {
+        interned_str_t *e = old[i];
+        if (!e) continue;
+        if (e->refs == 0 && !e->is_static) { // Dropped by lvgl_json_register_str_clear()
+            size_t size = sizeof(interned_str_t) + strlen(e->str) + 1;
+            g_str_pool_bytes -= size;
+            mem_free(LVGL_JSON_MEM_STRINGS, e, size);
+            continue;
+        }
+        uint32_t mask = capacity - 1, j = e->hash & mask;
+        while (slots[j]) j = (j + 1) & mask;
+        slots[j] = e;
+        g_str_pool_count++;
+    }
+    mem_free(LVGL_JSON_MEM_STRINGS, old, old_capacity * sizeof(interned_str_t *));
+    return true;
+}
+
+// Returns the pooled copy of s[0..len) or NULL if it was never interned.
+static const char* str_pool_lookup(const char *s, size_t len) {
+    if (!g_str_pool) return NULL;
+    interned_str_t *e = g_str_pool[str_pool_slot(s, len, str_pool_hash(s, len))];
+    return e ? e->str : NULL;
+}
+
+// Interns s[0..len), which need not be NUL-terminated.
+static const char* str_pool_intern(const char *s, size_t len) {
+    uint32_t hash = str_pool_hash(s, len);
+    if (!g_str_pool && !str_pool_resize(STR_POOL_MIN_CAPACITY)) return NULL;
+    uint32_t i = str_pool_slot(s, len, hash);
+    if (g_str_pool[i]) return g_str_pool[i]->str;
+    if ((g_str_pool_count + 1) * 4 > g_str_pool_capacity * 3) {
+        if (!str_pool_resize(g_str_pool_capacity * 2)) return NULL;
+        i = str_pool_slot(s, len, hash);
+    }
+    interned_str_t *e = (interned_str_t *)mem_alloc(LVGL_JSON_MEM_STRINGS, sizeof(interned_str_t) + len + 1);
+    if (!e) return NULL;
+    RENDER_STAT_INC(heap_allocs);
+    e->hash = hash;
+    e->refs = 0;
+    e->is_static = false;
+    memcpy(e->str, s, len);
+    e->str[len] = '\\0';
+    g_str_pool[i] = e;
+    g_str_pool_count++;
+    g_str_pool_bytes += sizeof(interned_str_t) + len + 1;
+    return e->str;
+}
+
+static void str_pool_remove(interned_str_t *e) {
+    uint32_t mask = g_str_pool_capacity - 1;
+    uint32_t i = e->hash & mask;
+    while (g_str_pool[i] != e) i = (i + 1) & mask;
+    // Backward shift deletion keeps probe sequences intact without tombstones
+    uint32_t j = i;
+    for (;;) {
+        j = (j + 1) & mask;
+        interned_str_t *next = g_str_pool[j];
+        if (!next) break;
+        uint32_t home = next->hash & mask;
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            g_str_pool[i] = next;
+            i = j;
+        }
+    }
+    g_str_pool[i] = NULL;
+    g_str_pool_count--;
+    size_t size = sizeof(interned_str_t) + strlen(e->str) + 1;
+    g_str_pool_bytes -= size;
+    mem_free(LVGL_JSON_MEM_STRINGS, e, size);
+}
+
+static const char* str_pool_retain(const char *s, size_t len) {
+    const char *pooled = str_pool_intern(s, len);
+    if (pooled) STR_POOL_ENTRY(pooled)->refs++;
+    return pooled;
+}
+
+static void str_pool_release(const char *pooled) {
+    if (!pooled) return;
+    interned_str_t *e = STR_POOL_ENTRY(pooled);
+    if (--e->refs == 0 && !e->is_static) str_pool_remove(e);
+}
+
+char *lvgl_json_register_str(const char *name) {
+    if (!name) return NULL;
+    const char *pooled = str_pool_intern(name, strlen(name));
+    if (!pooled) {
+        LOG_ERR("Registry Error: Failed to intern static str '%s'.", name);
+        return NULL;
+    }
+    interned_str_t *e = STR_POOL_ENTRY(pooled);
+    if (!e->is_static) {
+        e->is_static = true;
+        LOG_INFO("Registered static str '%s'", name);
+    }
+    return e->str;
+}
+
+static void str_pool_unmark_static(void) {
+    for (uint32_t i = 0; i < g_str_pool_capacity; ++i) {
+        if (g_str_pool[i]) g_str_pool[i]->is_static = false;
+    }
+}
+
+// Frees the strings that are neither static nor used by the registry.
+static void str_pool_compact(void) {
+    if (g_str_pool && !str_pool_resize(g_str_pool_capacity)) {
+        LOG_ERR("Registry Error: Failed to compact the string pool.");
+    }
+}
+
+// Drops the static strings of the previous UI; strings still used by the registry are kept.
+void lvgl_json_register_str_clear() {
+    str_pool_unmark_static();
+    str_pool_compact();
+}
+"""
+
+# Pointer registry: one open-addressing table of inline entries (no per-entry allocation) that
+# doubles at 75% load. Entries keep the name hash so probes rarely touch the name itself.
+# Names are also a path index: "a:b:c" is linked below "a:b" (created as a placeholder entry if
+# it was never registered), so subtrees can be enumerated and removed without a full scan.
+REGISTRY_MAP_C = """// Open Addressing Hash Map Registry with Path Index
+#define REGISTRY_MIN_CAPACITY 64
+#define REGISTRY_PATH_SEPARATOR ':'
+
+typedef struct {
+    const char *name;         // Interned full path, NULL = empty slot
+    const char *type_name;    // Interned, compared by pointer; NULL for placeholders
+    void *ptr;                // NULL for placeholders (path nodes that were never registered)
+    const char *parent;       // Links by interned name, so entries can move when the table grows
+    const char *first_child;
+    const char *next_sibling;
+    const char *prev_sibling;
+    uint32_t hash;
+    bool auto_free;
+} registry_entry_t;
+
+static registry_entry_t *g_registry = NULL;
+static uint32_t g_registry_capacity = 0; // Power of two
+static uint32_t g_registry_count = 0;    // Including placeholders
+
+// Hash of the key head[0..head_len) + ':' + tail, equal to str_pool_hash() of the joined name.
+// Either part may be missing (head_len 0, tail NULL).
+static uint32_t registry_hash(const char *head, size_t head_len, const char *tail) {
+    uint32_t h = 5381;
+    for (size_t i = 0; i < head_len; ++i) h = ((h << 5) + h) + (uint8_t)head[i];
+    if (tail) {
+        if (head_len) h = ((h << 5) + h) + REGISTRY_PATH_SEPARATOR;
+        while (*tail) h = ((h << 5) + h) + (uint8_t)*tail++;
+    }
+    return hash_finalize(h);
+}
+
+static bool registry_key_equals(const char *name, const char *head, size_t head_len, const char *tail) {
+    if (head_len) {
+        if (strncmp(name, head, head_len) != 0) return false;
+        name += head_len;
+        if (!tail) return *name == '\\0';
+        if (*name++ != REGISTRY_PATH_SEPARATOR) return false;
+    }
+    return strcmp(name, tail) == 0;
+}
+
+// Returns the slot holding the key, or the empty slot where it would go.
+static uint32_t registry_slot(const char *head, size_t head_len, const char *tail, uint32_t hash) {
+    uint32_t mask = g_registry_capacity - 1;
+    uint32_t i = hash & mask;
+    while (g_registry[i].name) {
+        if (g_registry[i].hash == hash && registry_key_equals(g_registry[i].name, head, head_len, tail)) break;
+        i = (i + 1) & mask;
+    }
+    return i;
+}
+
+// Entry of an interned name that is known to be registered (e.g. a link).
+static registry_entry_t* registry_get(const char *pooled) {
+    uint32_t mask = g_registry_capacity - 1;
+    uint32_t i = STR_POOL_ENTRY(pooled)->hash & mask; // Same hash as registry_hash()
+    while (g_registry[i].name != pooled) i = (i + 1) & mask;
+    return &g_registry[i];
+}
+
+static bool registry_resize(uint32_t capacity) {
+    registry_entry_t *table = (registry_entry_t *)mem_alloc(LVGL_JSON_MEM_REGISTRY, capacity * sizeof(registry_entry_t));
+    if (!table) return false;
+    RENDER_STAT_INC(heap_allocs);
+    memset(table, 0, capacity * sizeof(registry_entry_t));
+    registry_entry_t *old = g_registry;
+    uint32_t old_capacity = g_registry_capacity;
+    for (uint32_t i = 0; i < old_capacity; ++i) {
+        if (!old[i].name) continue;
+        uint32_t mask = capacity - 1, j = old[i].hash & mask;
+        while (table[j].name) j = (j + 1) & mask;
+        table[j] = old[i];
+    }
+    mem_free(LVGL_JSON_MEM_REGISTRY, old, old_capacity * sizeof(registry_entry_t));
+    g_registry = table;
+    g_registry_capacity = capacity;
+    return true;
+}
+
+// Returns the entry for name[0..len), creating it and any missing ancestors as placeholders.
+// The returned pointer is valid until the next insertion.
+static registry_entry_t* registry_ensure(const char *name, size_t len) {
+    uint32_t hash = registry_hash(name, len, NULL);
+    uint32_t i = registry_slot(name, len, NULL, hash);
+    if (g_registry[i].name) return &g_registry[i];
+
+    // "a:b:c" hangs below "a:b"; names without a separator (or starting with one) are roots.
+    const char *parent_name = NULL;
+    size_t parent_len = len;
+    while (parent_len > 0 && name[parent_len - 1] != REGISTRY_PATH_SEPARATOR) parent_len--;
+    if (parent_len > 1) {
+        registry_entry_t *parent = registry_ensure(name, parent_len - 1);
+        if (!parent) return NULL;
+        parent_name = parent->name;
+    }
+
+    if ((g_registry_count + 1) * 4 > g_registry_capacity * 3 && !registry_resize(g_registry_capacity * 2)) return NULL;
+    const char *pooled = str_pool_retain(name, len);
+    if (!pooled) return NULL;
+    registry_entry_t *entry = &g_registry[registry_slot(name, len, NULL, hash)];
+    memset(entry, 0, sizeof(*entry));
+    entry->name = pooled;
+    entry->hash = hash;
+    entry->parent = parent_name;
+    if (parent_name) {
+        registry_entry_t *parent = registry_get(parent_name);
+        entry->next_sibling = parent->first_child;
+        if (parent->first_child) registry_get(parent->first_child)->prev_sibling = pooled;
+        parent->first_child = pooled;
+    }
+    g_registry_count++;
+    return entry;
+}
+
+void lvgl_json_register_ptr(const char *name, const char *type_name, void *ptr) {
+    if (!name || !type_name || !ptr) return;
+    if (!g_registry && !registry_resize(REGISTRY_MIN_CAPACITY)) { LOG_ERR("Registry Error: Failed to allocate memory"); return; }
+    registry_entry_t *entry = registry_ensure(name, strlen(name));
+    if (!entry) { LOG_ERR("Registry Error: Failed to allocate memory"); return; }
+    const char *pooled_type_name = str_pool_retain(type_name, strlen(type_name));
+    if (!pooled_type_name) { LOG_ERR("Registry Error: Failed to intern type_name"); return; }
+    bool is_update = entry->ptr != NULL; // A placeholder being filled in is a new registration
+    if (is_update) {
+        LOG_WARN("Registry Warning: Name '%s' already registered. Updating pointer and type.", name);
+        if (entry->auto_free) { lv_free(entry->ptr); }
+    }
+    str_pool_release(entry->type_name);
+    entry->type_name = pooled_type_name;
+    entry->ptr = ptr;
+    entry->auto_free = false;
+    if (is_update) return;
+     LOG_INFO("Registered pointer '%s' with type '%s'", name, type_name);
+}
+
+static void* registry_checked_ptr(const registry_entry_t *entry, const char *expected_type_name) {
+    if (!entry->name || !entry->ptr) return NULL;
+    // Type check
+    if (expected_type_name == NULL) return entry->ptr; // Wildcard
+    // Smart type comparison: if expected is 'type *', compare with 'type'.
+    // Stored type names are interned, so a type that was never interned cannot match.
+    size_t expected_len = strlen(expected_type_name);
+    if (expected_len > 0 && expected_type_name[expected_len - 1] == '*') {
+         expected_len--;
+         if (expected_len > 0 && expected_type_name[expected_len - 1] == ' ') expected_len--;
+    }
+    if (entry->type_name == str_pool_lookup(expected_type_name, expected_len)) {
+         return entry->ptr;
+    }
+    LOG_WARN("Registry: Found entry '%s', but type mismatch. Expected compatible with '%s', got '%s'.", entry->name, expected_type_name, entry->type_name);
+    return NULL; // Type mismatch for the found name
+}
+
+void* lvgl_json_get_registered_ptr(const char *name, const char *expected_type_name) {
+    if (!name || !g_registry) return NULL;
+    return registry_checked_ptr(&g_registry[registry_slot(NULL, 0, name, registry_hash(NULL, 0, name))], expected_type_name);
+}
+
+lvgl_json_path_t lvgl_json_registry_find_path(const char *path) {
+    if (!path || !path[0] || !g_registry) return NULL;
+    const registry_entry_t *entry = &g_registry[registry_slot(NULL, 0, path, registry_hash(NULL, 0, path))];
+    return entry->name;
+}
+
+void* lvgl_json_get_registered_ptr_at(lvgl_json_path_t base, const char *relative_path, const char *expected_type_name) {
+    if (!relative_path || !g_registry) return NULL;
+    size_t base_len = base ? strlen(base) : 0;
+    uint32_t hash = registry_hash(base, base_len, relative_path);
+    return registry_checked_ptr(&g_registry[registry_slot(base, base_len, relative_path, hash)], expected_type_name);
+}
+
+// Depth-first walk below (and including) `pooled`; returns false once the callback stops it.
+static bool registry_visit(const char *pooled, lvgl_json_registry_visit_cb_t cb, void *user_data, size_t *visited) {
+    const registry_entry_t *entry = registry_get(pooled);
+    if (entry->ptr) {
+        (*visited)++;
+        if (!cb(entry->name, entry->type_name, entry->ptr, user_data)) return false;
+    }
+    for (const char *child = entry->first_child; child; child = registry_get(child)->next_sibling) {
+        if (!registry_visit(child, cb, user_data, visited)) return false;
+    }
+    return true;
+}
+
+size_t lvgl_json_registry_enumerate(const char *path, lvgl_json_registry_visit_cb_t cb, void *user_data) {
+    size_t visited = 0;
+    if (!cb || !g_registry) return 0;
+    if (!path || !path[0]) {
+        for (uint32_t i = 0; i < g_registry_capacity; ++i) {
+            if (!g_registry[i].name || g_registry[i].parent) continue; // Roots only, the rest is visited below them
+            if (!registry_visit(g_registry[i].name, cb, user_data, &visited)) break;
+        }
+        return visited;
+    }
+    lvgl_json_path_t root = lvgl_json_registry_find_path(path);
+    if (root) registry_visit(root, cb, user_data, &visited);
+    return visited;
+}
+
+// Removes an entry and its subtree; children are taken out first so that links stay valid.
+static size_t registry_remove_tree(const char *pooled) {
+    size_t removed = 0;
+    const char *child;
+    while ((child = registry_get(pooled)->first_child) != NULL) removed += registry_remove_tree(child);
+
+    registry_entry_t *entry = registry_get(pooled);
+    if (entry->prev_sibling) registry_get(entry->prev_sibling)->next_sibling = entry->next_sibling;
+    else if (entry->parent) registry_get(entry->parent)->first_child = entry->next_sibling;
+    if (entry->next_sibling) registry_get(entry->next_sibling)->prev_sibling = entry->prev_sibling;
+    if (entry->ptr) {
+        removed++;
+        if (entry->auto_free) lv_free(entry->ptr);
+    }
+    const char *type_name = entry->type_name;
+
+    // Backward shift deletion keeps probe sequences intact without tombstones
+    uint32_t mask = g_registry_capacity - 1;
+    uint32_t i = (uint32_t)(entry - g_registry), j = i;
+    for (;;) {
+        j = (j + 1) & mask;
+        if (!g_registry[j].name) break;
+        uint32_t home = g_registry[j].hash & mask;
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            g_registry[i] = g_registry[j];
+            i = j;
+        }
+    }
+    memset(&g_registry[i], 0, sizeof(registry_entry_t));
+    g_registry_count--;
+    str_pool_release(type_name);
+    str_pool_release(pooled);
+    return removed;
+}
+
+size_t lvgl_json_registry_remove(const char *path) {
+    lvgl_json_path_t root = lvgl_json_registry_find_path(path);
+    if (!root) return 0;
+    const char *parent = registry_get(root)->parent; // Interned by its own entry, outlives the removal
+    size_t removed = registry_remove_tree(root);
+    // Prune the placeholder ancestors that only existed for this subtree, so repeated
+    // register/remove cycles (live edits) don't grow the table.
+    while (parent) {
+        const registry_entry_t *entry = registry_get(parent);
+        if (entry->ptr || entry->first_child) break;
+        const char *next = entry->parent;
+        registry_remove_tree(parent);
+        parent = next;
+    }
+    LOG_INFO("Registry: Removed %u entries under '%s'.", (unsigned)removed, path);
+    return removed;
+}
+
+void lvgl_json_registry_clear() {
+    for (uint32_t i = 0; i < g_registry_capacity; ++i) {
+        if (!g_registry[i].name) continue;
+        str_pool_release(g_registry[i].type_name);
+        str_pool_release(g_registry[i].name);
+    }
+    mem_free(LVGL_JSON_MEM_REGISTRY, g_registry, g_registry_capacity * sizeof(registry_entry_t));
+    g_registry = NULL;
+    g_registry_capacity = 0;
+    g_registry_count = 0;
+     LOG_INFO("Pointer registry cleared.");
+}
+
+void lvgl_json_registry_stats(lvgl_json_registry_stats_t *out) {
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    out->capacity = g_registry_capacity;
+    uint32_t mask = g_registry_capacity - 1;
+    uint64_t probe_total = 0;
+    for (uint32_t i = 0; i < g_registry_capacity; ++i) {
+        if (!g_registry[i].name) continue;
+        if (g_registry[i].ptr) out->count++;
+        else out->placeholder_count++;
+        uint32_t probe_len = ((i - g_registry[i].hash) & mask) + 1;
+        probe_total += probe_len;
+        if (probe_len > out->max_probe_len) out->max_probe_len = probe_len;
+    }
+    out->avg_probe_len = g_registry_count ? (float)probe_total / (float)g_registry_count : 0.0f;
+    out->table_bytes = g_registry_capacity * sizeof(registry_entry_t);
+    out->string_bytes = g_str_pool_bytes + g_str_pool_capacity * sizeof(interned_str_t *);
+}
+
+// --- Registry Paths ---
+#define REGISTRY_PATH_BUF_SIZE 128
+
+// Joins "prefix:segment" (either may be NULL or empty). The path is written to `buf`
+// (REGISTRY_PATH_BUF_SIZE bytes) when it fits, otherwise to render scratch memory, so its
+// length is not limited; release it with registry_path_free().
+static char* registry_path_join(char *buf, const char *prefix, const char *segment) {
+    size_t prefix_len = prefix ? strlen(prefix) : 0;
+    size_t segment_len = segment ? strlen(segment) : 0;
+    size_t sep_len = (prefix_len && segment_len) ? 1 : 0;
+    size_t len = prefix_len + sep_len + segment_len;
+    char *path = buf;
+    if (len >= REGISTRY_PATH_BUF_SIZE) {
+        path = (char *)render_scratch_alloc(len + 1);
+        if (!path) {
+            LOG_ERR("Registry Error: Failed to allocate a path of %u bytes.", (unsigned)len);
+            buf[0] = '\\0';
+            return buf;
+        }
+    }
+    if (prefix_len) memcpy(path, prefix, prefix_len);
+    if (sep_len) path[prefix_len] = REGISTRY_PATH_SEPARATOR;
+    if (segment_len) memcpy(path + prefix_len + sep_len, segment, segment_len);
+    path[len] = '\\0';
+    return path;
+}
+
+static void registry_path_free(char *path, char *buf) {
+    if (path && path != buf) render_scratch_free(path, strlen(path) + 1);
+}
+"""
+
 
 def generate_registry(use_hash_map=True):
     """Generates the C code for the named pointer registry."""
     c_code = "// --- Pointer Registry ---\n\n"
     c_code += "#include <string.h>\n"
+    c_code += "#include <stddef.h>\n" # offsetof
     c_code += "#include <stdlib.h>\n\n" # For malloc/free if needed
 
-  # Simple static array registry
-    c_code += f"#define MAX_STATIC_STRS {MAX_STATIC_STRS}\n"
-    c_code += "static char * g_static_strs[MAX_STATIC_STRS];\n"
-    c_code += "static int g_static_strs_count = 0;\n\n"
-    c_code += "// Simple Static Array Registry\n"
-    c_code += "char *lvgl_json_register_str(const char *name) {\n"
-    c_code += "    if (!name) return NULL;\n"
-    c_code += "    // Check if name already exists (update)\n"
-    c_code += "    for (int i = 0; i < g_static_strs_count; ++i) {\n"
-    c_code += "        if (g_static_strs[i] && strcmp(g_static_strs[i], name) == 0) {\n"
-    c_code += "            return g_static_strs[i];\n"
-    c_code += "        }\n"
-    c_code += "    }\n"
-    c_code += "    // Add new entry if space available\n"
-    c_code += f"    if (g_static_strs_count < MAX_STATIC_STRS) {{\n"
-    c_code += "        g_static_strs[g_static_strs_count] = strdup(name);\n"
-    c_code += "        LOG_INFO(\"Registered static str '%s'\", name);\n"
-    c_code += "        return g_static_strs[g_static_strs_count++];\n"
-    c_code += "    } else {\n"
-    c_code += "        LOG_ERR(\"Registry Error: Maximum number of static strings (%d) exceeded.\", MAX_STATIC_STRS);\n"
-    c_code += "        return NULL;\n"
-    c_code += "    }\n"
-    c_code += "}\n\n"
-    c_code += "void lvgl_json_register_str_clear() {\n"
-    c_code += "    for (int i = 0; i < g_static_strs_count; ++i) {\n"
-    c_code += "        free(g_static_strs[i]);\n"
-    c_code += "    }\n"
-    c_code += "    g_static_strs_count = 0;\n"
-    c_code += "}\n\n"
+    c_code += STRING_POOL_C
 
     if use_hash_map:
-        # Basic hash map implementation needed here (or use external C lib)
-        c_code += "// Basic Hash Map Registry (Placeholder - requires implementation)\n"
-        c_code += "#define HASH_MAP_SIZE 256\n"
-        c_code += "typedef struct registry_entry {\n"
-        c_code += "    char *name;\n"
-        c_code += "    char *type_name; // Added for type safety\n"
-        c_code += "    void *ptr;\n"
-        c_code += "    bool auto_free;\n"
-        c_code += "    struct registry_entry *next;\n"
-        c_code += "} registry_entry_t;\n\n"
-        c_code += "static registry_entry_t* g_registry_map[HASH_MAP_SIZE] = {0};\n\n"
-        c_code += "static unsigned int hash(const char *str) {\n"
-        c_code += "    unsigned long hash = 5381;\n"
-        c_code += "    int c;\n"
-        c_code += "    while ((c = *str++)) hash = ((hash << 5) + hash) + c; /* djb2 */\n"
-        c_code += "    return hash % HASH_MAP_SIZE;\n"
-        c_code += "}\n\n"
-        c_code += "void lvgl_json_register_ptr(const char *name, const char *type_name, void *ptr) {\n"
-        c_code += "    if (!name || !type_name || !ptr) return;\n"
-        c_code += "    unsigned int index = hash(name);\n"
-        c_code += "    // Check if name already exists (update or handle error?)\n"
-        c_code += "    registry_entry_t *entry = g_registry_map[index];\n"
-        c_code += "    while(entry) {\n"
-        c_code += "        if(strcmp(entry->name, name) == 0) {\n"
-        c_code += "             LOG_WARN(\"Registry Warning: Name '%s' already registered. Updating pointer and type.\", name);\n"
-        c_code += "             free(entry->type_name); // Free old type_name\n"
-        c_code += "             entry->type_name = lv_strdup(type_name);\n"
-        c_code += "             if (!entry->type_name) { LOG_ERR(\"Registry Error: Failed to duplicate type_name for update\"); /* What to do? Original ptr is kept */ return; }\n" # ADDED LINE
-        c_code += "             if (entry->auto_free) { lv_free(entry->ptr); }\n"
-        c_code += "             entry->ptr = ptr; // Update existing entry\n"
-        c_code += "             return;\n"
-        c_code += "        }\n"
-        c_code += "        entry = entry->next;\n"
-        c_code += "    }\n"
-        c_code += "    // Add new entry\n"
-        c_code += "    registry_entry_t *new_entry = (registry_entry_t *)LV_MALLOC(sizeof(registry_entry_t));\n"
-        c_code += "    if (!new_entry) { LOG_ERR(\"Registry Error: Failed to allocate memory\"); return; }\n"
-        c_code += "    new_entry->name = lv_strdup(name);\n"
-        c_code += "    if (!new_entry->name) { LV_FREE(new_entry); LOG_ERR(\"Registry Error: Failed to duplicate name\"); return; }\n"
-        c_code += "    new_entry->type_name = lv_strdup(type_name);\n" # ADDED LINE
-        c_code += "    if (!new_entry->type_name) { LV_FREE(new_entry->name); LV_FREE(new_entry); LOG_ERR(\"Registry Error: Failed to duplicate type_name\"); return; }\n" # ADDED LINE
-        c_code += "    new_entry->ptr = ptr;\n"
-        c_code += "    new_entry->next = g_registry_map[index];\n"
-        c_code += "    g_registry_map[index] = new_entry;\n"
-        c_code += "     LOG_INFO(\"Registered pointer '%s' with type '%s'\", name, type_name);\n" # MODIFIED LOG
-        c_code += "}\n\n"
-
-        c_code += "void* lvgl_json_get_registered_ptr(const char *name, const char *expected_type_name) {\n" # MODIFIED SIGNATURE
-        c_code += "    if (!name) return NULL;\n"
-        c_code += "    unsigned int index = hash(name);\n"
-        c_code += "    registry_entry_t *entry = g_registry_map[index];\n"
-        c_code += "    while (entry != NULL) {\n"
-        c_code += "        if (strcmp(entry->name, name) == 0) {\n"
-        c_code += "            // Type check\n"
-        c_code += "            if (expected_type_name == NULL || entry->type_name == NULL) { // Wildcard or error in registration\n"
-        c_code += "                 if(expected_type_name != NULL && entry->type_name == NULL) LOG_WARN(\"Registry: Entry '%s' has no type_name.\", name);\n"
-        c_code += "                 return entry->ptr; // No type check possible or requested\n"
-        c_code += "            }\n"
-        c_code += "            // Smart type comparison: if expected is 'type*', compare with 'type'\n"
-        c_code += "            size_t expected_len = strlen(expected_type_name);\n"
-        c_code += "            bool types_match = false;\n"
-        c_code += "            if (expected_len > 0 && expected_type_name[expected_len - 1] == '*') {\n"
-        c_code += "                 // Expected a pointer type like 'lv_style_t *', compare base 'lv_style_t'\n"
-        c_code += "                 // Need to be careful with 'const char **' vs 'const char *'\n"
-        c_code += "                 // Simple check: compare entry->type_name with expected_type_name minus the last '*'\n"
-        c_code += "                 // This assumes stored type_name is always the base type (e.g., \"lv_style_t\")\n"
-        c_code += "                 char base_expected_type[256]; // Assume type names are not excessively long\n"
-        c_code += "                 if (expected_len -1 < sizeof(base_expected_type)) {\n"
-        c_code += "                    strncpy(base_expected_type, expected_type_name, expected_len -1);\n"
-        c_code += "                    base_expected_type[expected_len -1] = '\\0';\n"
-        c_code += "                    // Trim trailing space if it was 'lv_style_t *'\n"
-        c_code += "                    if(expected_len > 1 && base_expected_type[expected_len - 2] == ' ') base_expected_type[expected_len - 2] = '\\0';\n"
-        c_code += "                    types_match = (strcmp(entry->type_name, base_expected_type) == 0);\n"
-        c_code += "                 }\n"
-        c_code += "            } else {\n"
-        c_code += "                 // Expected a non-pointer type or already a base type, direct compare\n"
-        c_code += "                 types_match = (strcmp(entry->type_name, expected_type_name) == 0);\n"
-        c_code += "            }\n\n"
-        c_code += "            if (types_match) {\n"
-        c_code += "                 return entry->ptr;\n"
-        c_code += "            } else {\n"
-        c_code += "                 LOG_WARN(\"Registry: Found entry '%s', but type mismatch. Expected compatible with '%s', got '%s'.\", name, expected_type_name, entry->type_name);\n"
-        c_code += "                 return NULL; // Type mismatch for the found name\n"
-        c_code += "            }\n"
-        c_code += "        }\n"
-        c_code += "        entry = entry->next;\n"
-        c_code += "    }\n"
-        c_code += "    return NULL;\n"
-        c_code += "}\n\n"
-
-        c_code += "void lvgl_json_registry_clear() {\n"
-        c_code += "    for(int i = 0; i < HASH_MAP_SIZE; ++i) {\n"
-        c_code += "        registry_entry_t *entry = g_registry_map[i];\n"
-        c_code += "        while(entry) {\n"
-        c_code += "             registry_entry_t *next = entry->next;\n"
-        c_code += "             LV_FREE(entry->type_name);\n"
-        c_code += "             LV_FREE(entry->name);\n"
-        c_code += "             LV_FREE(entry);\n"
-        c_code += "             entry = next;\n"
-        c_code += "        }\n"
-        c_code += "        g_registry_map[i] = NULL;\n"
-        c_code += "    }\n"
-        c_code += "     LOG_INFO(\"Pointer registry cleared.\");\n"
-        c_code += "}\n\n"
+        c_code += REGISTRY_MAP_C
 
     else:
         # Simple static array registry
@@ -266,7 +630,9 @@ def generate_custom_creators(init_functions, api_info):
         c_code += f"    }}\n"
         c_code += f"    LOG_INFO(\"Creating managed {c_type_str} with name '%s'\", name);\n"
         # Allocate memory for the struct
-        c_code += f"    {c_type_str} *new_obj = ({c_type_str}*)LV_MALLOC(sizeof({c_type_str}));\n"
+        mem_category = "LVGL_JSON_MEM_STYLES" if c_type_str == "lv_style_t" else "LVGL_JSON_MEM_OTHER"
+        c_code += f"    {c_type_str} *new_obj = ({c_type_str}*)mem_alloc({mem_category}, sizeof({c_type_str}));\n"
+        c_code += f"    RENDER_STAT_INC(heap_allocs);\n"
         c_code += f"    if (!new_obj) {{\n"
         c_code += f"        LOG_ERR(\"{creator_func_name}: Failed to allocate memory for {c_type_str}.\");\n"
         c_code += f"        return NULL;\n"
@@ -14,13 +14,24 @@ def generate_renderer(custom_creators_map):
     c_code += "extern data_binding_registry_t* REGISTRY; // Global registry for actions and data bindings\n\n"
     c_code += "// Forward declarations\n"
     c_code += "static void* render_json_node(cJSON *node, lv_obj_t *parent, const char *named_path_prefix);\n" # Return void*
+    c_code += "typedef struct live_map_s live_map_t;\n"
+    c_code += "static live_map_t *g_live_capture = NULL; // Set while a live UI renders (see lvgl_json_live_ui_update())\n"
+    c_code += "static void live_map_capture(const cJSON *node, lv_obj_t *obj, const char *actual_type, const char *create_type, const char *path, bool registered);\n"
+    c_code += "static void live_map_capture_with(const cJSON *with, lv_obj_t *target, const char *path);\n"
     c_code += "static bool apply_setters_and_attributes(cJSON *attributes_json_obj, void *target_entity, const char *target_actual_type_str, const char *target_create_type_str, bool target_is_widget, lv_obj_t *parent_for_children_attr, const char *path_prefix_for_named_and_children, const char *default_type_name_for_registry_if_named);\n"
+    c_code += "static bool lazy_requested(cJSON *attributes);\n"
+    c_code += "static bool lazy_defer(lv_obj_t *container, cJSON *children, const char *path);\n"
+    c_code += "static void* vlist_render(cJSON *node, lv_obj_t *parent, const char *named_path_prefix);\n"
+    c_code += "static void* repeat_render(cJSON *node, lv_obj_t *parent, const char *named_path_prefix);\n"
+    c_code += "#if LVGL_JSON_USE_SLICING\n"
+    c_code += "static bool g_slice_defer = false; // Set while lvgl_json_render_step() renders a node\n"
+    c_code += "static bool slice_defer_children(cJSON *attributes, lv_obj_t *parent, cJSON *children, const char *path);\n"
+    c_code += "static void* slice_defer_repeat(cJSON *node, lv_obj_t *parent, const char *named_path_prefix);\n"
+    c_code += "#endif\n"
     c_code += "static const invoke_table_entry_t* find_invoke_entry(const char *name);\n"
-    c_code += "static bool unmarshal_value(cJSON *json_value, const char *expected_c_type, void *dest, void *implicit_parent);\n"
+    c_code += "static bool unmarshal_value(cJSON *json_value, uint8_t type_id, const char *expected_c_type, void *dest, void *implicit_parent);\n"
     c_code += "extern void* lvgl_json_get_registered_ptr(const char *name, const char *expected_type_name);\n"
     c_code += "extern void lvgl_json_register_ptr(const char *name, const char *type_name, void *ptr);\n"
-    c_code += "static void set_current_context(cJSON* new_context);\n"
-    c_code += "static cJSON* get_current_context(void); // Already declared in source template, but good for clarity\n"
 
 
     # Include custom creator function prototypes
@@ -29,9 +40,172 @@ def generate_renderer(custom_creators_map):
          c_code += f"extern {c_type}* {creator_func}(const char *name);\n"
     c_code += "\n"
 
+    # Setter resolution cache used by apply_setters_and_attributes
+    c_code += """
+// --- Setter Resolution Cache ---
+// Resolving a property walks a chain of candidate names (lv_<type>_set_<prop>, lv_<type>_<prop>,
+// lv_obj_set_<prop>, lv_obj_<prop>, lv_obj_set_style_<prop> / lv_style_..., verbatim). The outcome
+// only depends on (target type, property, is_widget), so it is resolved once and cached here,
+// including misses and whether the default LV_PART_MAIN selector has to be appended.
+#define SETTER_CACHE_SIZE 256 // Must be a power of two
+
+typedef struct {
+    const char *type;                   // Interned, NULL = empty slot
+    const char *prop;                   // Interned
+    uint32_t hash;
+    bool is_widget;
+    bool append_default_selector;       // Style setter taking a selector as third argument
+    const invoke_table_entry_t *entry;  // NULL = cached miss
+} setter_cache_entry_t;
+
+static setter_cache_entry_t g_setter_cache[SETTER_CACHE_SIZE];
+
+static uint32_t setter_cache_hash(const char *type_str, const char *prop_name, bool is_widget) {
+    uint32_t hash = 5381;
+    unsigned char c;
+    while ((c = (unsigned char)*type_str++)) hash = ((hash << 5) + hash) + c;
+    hash = ((hash << 5) + hash) + (is_widget ? '.' : ':');
+    while ((c = (unsigned char)*prop_name++)) hash = ((hash << 5) + hash) + c;
+    return hash;
+}
+
+static bool setter_cache_key_matches(const setter_cache_entry_t *e, uint32_t hash, const char *type_str, const char *prop_name, bool is_widget) {
+    if (e->hash != hash || e->is_widget != is_widget) return false;
+    return strcmp(e->type, type_str) == 0 && strcmp(e->prop, prop_name) == 0;
+}
+
+void lvgl_json_setter_cache_clear(void) {
+    for (uint32_t i = 0; i < SETTER_CACHE_SIZE; ++i) {
+        str_pool_release(g_setter_cache[i].type);
+        str_pool_release(g_setter_cache[i].prop);
+    }
+    memset(g_setter_cache, 0, sizeof(g_setter_cache));
+}
+
+// The uncached fallback chain.
+static const invoke_table_entry_t* resolve_setter_uncached(const char *type_str, const char *prop_name, bool is_widget, bool *append_default_selector) {
+    char setter_name_buf[128];
+    const invoke_table_entry_t* setter_entry = NULL;
+    *append_default_selector = false;
+
+    // 1. Try specific type: lv_<type_str>_set_<prop_name>
+    if (type_str[0]) {
+        snprintf(setter_name_buf, sizeof(setter_name_buf), "lv_%s_set_%s", type_str, prop_name);
+        setter_entry = find_invoke_entry(setter_name_buf);
+    }
+
+    // 2. Try specific type (short form): lv_<type_str>_<prop_name>
+    if (!setter_entry && type_str[0]) {
+        snprintf(setter_name_buf, sizeof(setter_name_buf), "lv_%s_%s", type_str, prop_name);
+        setter_entry = find_invoke_entry(setter_name_buf);
+    }
+
+    if (is_widget) {
+        // 3. Try generic obj: lv_obj_set_<prop_name>
+        if (!setter_entry) {
+            snprintf(setter_name_buf, sizeof(setter_name_buf), "lv_obj_set_%s", prop_name);
+            setter_entry = find_invoke_entry(setter_name_buf);
+        }
+        // 4. Try generic obj (short form): lv_obj_<prop_name>
+        if (!setter_entry) {
+            snprintf(setter_name_buf, sizeof(setter_name_buf), "lv_obj_%s", prop_name);
+            setter_entry = find_invoke_entry(setter_name_buf);
+        }
+        // 5. Try style property: lv_obj_set_style_<prop_name>
+        if (!setter_entry) {
+            snprintf(setter_name_buf, sizeof(setter_name_buf), "lv_obj_set_style_%s", prop_name);
+            setter_entry = find_invoke_entry(setter_name_buf);
+            if (setter_entry &&
+                setter_entry->arity > 2 && // obj, value, selector
+                (setter_entry->arg_type_ids[2] == TYPE_ID_UINT32 || setter_entry->arg_type_ids[2] == TYPE_ID_INT)) { // lv_style_selector_t
+                *append_default_selector = true;
+            }
+        }
+    } else if (strcmp(type_str, "style") == 0) { // Fallbacks for styles
+        // 3b. Try lv_style_set_<prop_name>
+        if (!setter_entry) {
+            snprintf(setter_name_buf, sizeof(setter_name_buf), "lv_style_set_%s", prop_name);
+            setter_entry = find_invoke_entry(setter_name_buf);
+        }
+        // 4b. Try lv_style_<prop_name>
+        if (!setter_entry) {
+            snprintf(setter_name_buf, sizeof(setter_name_buf), "lv_style_%s", prop_name);
+            setter_entry = find_invoke_entry(setter_name_buf);
+        }
+    }
+
+    // 6. Try verbatim name (for direct function calls, less common for setters)
+    if (!setter_entry) {
+        setter_entry = find_invoke_entry(prop_name);
+    }
+    return setter_entry;
+}
+
+// Resolves the invoke table entry used to set `prop_name` on an entity of type `type_str`.
+static const invoke_table_entry_t* resolve_setter(const char *type_str, const char *prop_name, bool is_widget, bool *append_default_selector) {
+    if (!type_str) type_str = "";
+    uint32_t hash = setter_cache_hash(type_str, prop_name, is_widget);
+    uint32_t mask = SETTER_CACHE_SIZE - 1;
+
+    for (uint32_t i = 0; i < SETTER_CACHE_SIZE; ++i) {
+        setter_cache_entry_t *e = &g_setter_cache[(hash + i) & mask];
+        if (!e->type) {
+            // Not cached yet: resolve and claim this slot.
+            const invoke_table_entry_t *entry = resolve_setter_uncached(type_str, prop_name, is_widget, append_default_selector);
+            const char *type = str_pool_retain(type_str, strlen(type_str));
+            const char *prop = str_pool_retain(prop_name, strlen(prop_name));
+            if (type && prop) {
+                e->type = type;
+                e->prop = prop;
+                e->hash = hash;
+                e->is_widget = is_widget;
+                e->append_default_selector = *append_default_selector;
+                e->entry = entry;
+            } else {
+                str_pool_release(type);
+                str_pool_release(prop);
+            }
+            return entry;
+        }
+        if (setter_cache_key_matches(e, hash, type_str, prop_name, is_widget)) {
+            *append_default_selector = e->append_default_selector;
+            return e->entry;
+        }
+    }
+
+    // Cache full: resolve without caching.
+    return resolve_setter_uncached(type_str, prop_name, is_widget, append_default_selector);
+}
+
+// Shared, never-freed argument appended as the default style selector.
+static cJSON g_default_selector_json = { .type = cJSON_Number, .valueint = LV_PART_MAIN, .valuedouble = LV_PART_MAIN };
+
+// True for strings that unmarshal_value() shortens in place when unescaping them:
+// a trailing "%%" or a '@', '!' or '$' prefix repeated as suffix (e.g. "$literal$").
+static bool json_string_unescapes_in_place(const cJSON *item) {
+    if (!cJSON_IsString(item) || !item->valuestring) return false;
+    const char *str = item->valuestring;
+    size_t len = strlen(str);
+    if (len == 0) return false;
+    if (len > 2 && str[len - 1] == '%' && str[len - 2] == '%') return true;
+    return (str[0] == '@' || str[0] == '!' || str[0] == '$') && str[len - 1] == str[0];
+}
+
+"""
+
     # apply_setters_and_attributes function
     c_code += """
-static bool apply_setters_and_attributes(
+static bool apply_setters_and_attributes_body(cJSON *attributes_json_obj, void *target_entity, const char *target_actual_type_str, const char *target_create_type_str, bool target_is_widget, lv_obj_t *explicit_parent_for_children_attr, const char *path_prefix_for_named_and_children, const char *default_type_name_for_registry_if_named);
+
+static bool apply_setters_and_attributes(cJSON *attributes_json_obj, void *target_entity, const char *target_actual_type_str, const char *target_create_type_str, bool target_is_widget, lv_obj_t *explicit_parent_for_children_attr, const char *path_prefix_for_named_and_children, const char *default_type_name_for_registry_if_named) {
+    PROFILE_SPAN_BEGIN(span);
+    bool ok = apply_setters_and_attributes_body(attributes_json_obj, target_entity, target_actual_type_str, target_create_type_str, target_is_widget,
+                                                explicit_parent_for_children_attr, path_prefix_for_named_and_children, default_type_name_for_registry_if_named);
+    PROFILE_SPAN_END(span, PROFILE_CAT_ATTRIBUTES, "attributes", NULL);
+    return ok;
+}
+
+static bool apply_setters_and_attributes_body(
     cJSON *attributes_json_obj,
     void *target_entity,
     const char *target_actual_type_str, // e.g., "button", "style", "obj" (real type of target_entity)
@@ -50,13 +224,13 @@ static bool apply_setters_and_attributes(
         path_prefix_for_named_and_children ? path_prefix_for_named_and_children : "NULL",
         target_entity, target_actual_type_str, target_create_type_str);
 
-    char current_children_base_path[256];
-    if (path_prefix_for_named_and_children) {
-        strncpy(current_children_base_path, path_prefix_for_named_and_children, sizeof(current_children_base_path) - 1);
-        current_children_base_path[sizeof(current_children_base_path) - 1] = '\\0';
-    } else {
-        current_children_base_path[0] = '\\0';
-    }
+    const char *current_children_base_path = path_prefix_for_named_and_children ? path_prefix_for_named_and_children : "";
+    char named_path_buf[REGISTRY_PATH_BUF_SIZE];
+    char *named_path = NULL; // Path registered by a 'named' attribute
+#if LVGL_JSON_STYLE_SHARING
+    style_share_batch_t *style_batch = NULL; // Style properties added as shared styles at the end
+    bool share_styles = g_style_share_enabled && target_is_widget;
+#endif
 
     cJSON *prop_item = NULL;
     for (prop_item = attributes_json_obj->child; prop_item != NULL; prop_item = prop_item->next) {
@@ -64,7 +238,8 @@ static bool apply_setters_and_attributes(
         if (!prop_name) continue;
 
         // Attributes handled by render_json_node's main logic or specific setup
-        if (strcmp(prop_name, "type") == 0 || strcmp(prop_name, "id") == 0 || strcmp(prop_name, "context") == 0) {
+        if (strcmp(prop_name, "type") == 0 || strcmp(prop_name, "id") == 0 || strcmp(prop_name, "context") == 0 ||
+            strcmp(prop_name, "lazy") == 0) {
             continue;
         }
         if (strcmp(target_actual_type_str, "grid") == 0 && (strcmp(prop_name, "cols") == 0 || strcmp(prop_name, "rows") == 0)) {
@@ -87,7 +262,7 @@ static bool apply_setters_and_attributes(
                 if (cJSON_IsString(prop_item)) {
                     char* action_val_str = NULL;
                     // Use unmarshal_value to resolve potential context variables like $action_name
-                    if (unmarshal_value(prop_item, "char *", &action_val_str, target_entity)) {
+                    if (unmarshal_value(prop_item, TYPE_ID_STRING, "char *", &action_val_str, target_entity)) {
                         if (REGISTRY) {
                             lv_event_cb_t evt_cb = action_registry_get_handler_s(REGISTRY, action_val_str);
                             if (evt_cb) {
@@ -120,8 +295,8 @@ static bool apply_setters_and_attributes(
                         char* obs_value_str = NULL;
                         char* obs_format_str = NULL;
                         // Use unmarshal_value to resolve potential context variables
-                        bool val_ok = unmarshal_value(obs_value_item, "char *", &obs_value_str, target_entity);
-                        bool fmt_ok = unmarshal_value(obs_format_item, "char *", &obs_format_str, target_entity);
+                        bool val_ok = unmarshal_value(obs_value_item, TYPE_ID_STRING, "char *", &obs_value_str, target_entity);
+                        bool fmt_ok = unmarshal_value(obs_format_item, TYPE_ID_STRING, "char *", &obs_format_str, target_entity);
                         if (val_ok && fmt_ok && obs_value_str && obs_format_str) {
                             if (REGISTRY) {
                                 data_binding_register_widget_s(REGISTRY, obs_value_str, (lv_obj_t*)target_entity, obs_format_str);
@@ -145,20 +320,14 @@ static bool apply_setters_and_attributes(
 
         if (strcmp(prop_name, "named") == 0 && cJSON_IsString(prop_item)) {
             char *named_value_str = NULL;
-            if (unmarshal_value(prop_item, "char *", &named_value_str, target_entity)) {
-                char full_named_path_buf[256] = {0};
-                if (path_prefix_for_named_and_children && path_prefix_for_named_and_children[0] != '\\0') {
-                    snprintf(full_named_path_buf, sizeof(full_named_path_buf) - 1, "%s:%s", path_prefix_for_named_and_children, named_value_str);
-                } else {
-                    strncpy(full_named_path_buf, named_value_str, sizeof(full_named_path_buf) - 1);
-                }
-                
+            if (unmarshal_value(prop_item, TYPE_ID_STRING, "char *", &named_value_str, target_entity)) {
                 if (default_type_name_for_registry_if_named && default_type_name_for_registry_if_named[0]) {
-                     lvgl_json_register_ptr(full_named_path_buf, default_type_name_for_registry_if_named, target_entity);
-                     LOG_INFO("Registered entity %p as '%s' (type %s) via 'named' attribute.", target_entity, full_named_path_buf, default_type_name_for_registry_if_named);
+                     registry_path_free(named_path, named_path_buf);
+                     named_path = registry_path_join(named_path_buf, path_prefix_for_named_and_children, named_value_str);
+                     lvgl_json_register_ptr(named_path, default_type_name_for_registry_if_named, target_entity);
+                     LOG_INFO("Registered entity %p as '%s' (type %s) via 'named' attribute.", target_entity, named_path, default_type_name_for_registry_if_named);
                      // Update current_children_base_path for subsequent children within this attribute set
-                     strncpy(current_children_base_path, full_named_path_buf, sizeof(current_children_base_path) - 1);
-                     current_children_base_path[sizeof(current_children_base_path) - 1] = '\\0';
+                     current_children_base_path = named_path;
                 } else {
                     LOG_WARN_JSON(prop_item, "'named' attribute used, but no valid type_name_for_registry provided for '%s'. Entity %p not registered by this 'named' attribute.", named_value_str, target_entity);
                 }
@@ -178,6 +347,15 @@ static bool apply_setters_and_attributes(
                 LOG_ERR_JSON(prop_item, "'children' attribute found, but target entity is not a widget or parent_for_children_attr is NULL. Cannot add children.");
                 continue;
             }
+            if (lazy_requested(attributes_json_obj) && lazy_defer(explicit_parent_for_children_attr, prop_item, current_children_base_path)) {
+                continue; // Rendered when the container is first shown
+            }
+#if LVGL_JSON_USE_SLICING
+            // Last attribute only: anything after "children" may expect them to exist
+            if (g_slice_defer && !prop_item->next && slice_defer_children(attributes_json_obj, explicit_parent_for_children_attr, prop_item, current_children_base_path)) {
+                continue; // Rendered by later lvgl_json_render_step() calls
+            }
+#endif
             LOG_DEBUG("Processing 'children' for entity %p under path prefix '%s'", target_entity, current_children_base_path);
             cJSON *child_node_json = NULL;
             cJSON_ArrayForEach(child_node_json, prop_item) {
@@ -205,7 +383,7 @@ static bool apply_setters_and_attributes(
             }
 
             lv_obj_t *with_target_obj = NULL;
-            if (!unmarshal_value(obj_to_run_with_json, "lv_obj_t *", &with_target_obj, target_entity)) { // Pass current target_entity as implicit_parent for context in unmarshal
+            if (!unmarshal_value(obj_to_run_with_json, TYPE_ID_OBJ_PTR, "lv_obj_t *", &with_target_obj, target_entity)) { // Pass current target_entity as implicit_parent for context in unmarshal
                 LOG_ERR_JSON(obj_to_run_with_json, "Failed to unmarshal 'obj' for 'with' block. Skipping 'with'.");
                 continue;
             }
@@ -215,6 +393,9 @@ static bool apply_setters_and_attributes(
             }
             
             LOG_INFO("Applying 'with.do' attributes to target %p (resolved from 'with.obj')", with_target_obj);
+            if (g_live_capture) {
+                live_map_capture_with(prop_item, with_target_obj, path_prefix_for_named_and_children);
+            }
             // For 'with.do', the target is the resolved 'with_target_obj'. Assume it's an 'obj' type.
             // The named path context for children/named inside this 'do' block should be the same as the 'with' block's context.
             // The 'default_type_name_for_registry_if_named' for 'with_target_obj' is "lv_obj_t".
@@ -236,100 +417,218 @@ static bool apply_setters_and_attributes(
 
 
         // --- Standard Setter Logic ---
-        cJSON *prop_args_array = prop_item;
-        bool temp_array_created = false;
-        if (!cJSON_IsArray(prop_item)) {
-            prop_args_array = cJSON_CreateArray();
-            if (prop_args_array) {
-                cJSON_AddItemToArray(prop_args_array, cJSON_Duplicate(prop_item, true));
-                temp_array_created = true;
-            } else {
-                LOG_ERR_JSON(prop_item, "Failed to create temporary array for property '%s'", prop_name);
+        // Arguments are passed as a view over the existing JSON nodes. Only scalar strings that
+        // unmarshal_value() would unescape in place are copied, so reused JSON (e.g. component
+        // definitions) is not modified.
+        cJSON *scalar_copy = NULL;
+        cJSON *prop_value = prop_item;
+        if (!cJSON_IsArray(prop_item) && json_string_unescapes_in_place(prop_item)) {
+            scalar_copy = cJSON_Duplicate(prop_item, true);
+            if (!scalar_copy) {
+                LOG_ERR_JSON(prop_item, "Failed to copy value for property '%s'", prop_name);
                 continue;
             }
+            RENDER_STAT_INC(json_allocs);
+            prop_value = scalar_copy;
         }
-
-        char setter_name_buf[128];
-        const invoke_table_entry_t* setter_entry = NULL;
-
-        // 1. Try specific type: lv_<target_actual_type_str>_set_<prop_name>
-        if (target_actual_type_str && target_actual_type_str[0]) {
-            snprintf(setter_name_buf, sizeof(setter_name_buf), "lv_%s_set_%s", target_actual_type_str, prop_name);
-            setter_entry = find_invoke_entry(setter_name_buf);
-        }
-
-        // 2. Try specific type (short form): lv_<target_actual_type_str>_<prop_name>
-        if (!setter_entry && target_actual_type_str && target_actual_type_str[0]) {
-            snprintf(setter_name_buf, sizeof(setter_name_buf), "lv_%s_%s", target_actual_type_str, prop_name);
-            setter_entry = find_invoke_entry(setter_name_buf);
-        }
-        
-        // Fallbacks for widgets (using target_create_type_str for consistency, e.g. "obj" for "grid")
-        if (target_is_widget) {
-            // 3. Try generic obj: lv_obj_set_<prop_name>
-            if (!setter_entry) {
-                snprintf(setter_name_buf, sizeof(setter_name_buf), "lv_obj_set_%s", prop_name);
-                setter_entry = find_invoke_entry(setter_name_buf);
-            }
-            // 4. Try generic obj (short form): lv_obj_<prop_name>
-            if (!setter_entry) {
-                snprintf(setter_name_buf, sizeof(setter_name_buf), "lv_obj_%s", prop_name);
-                setter_entry = find_invoke_entry(setter_name_buf);
-            }
-            // 5. Try style property: lv_obj_set_style_<prop_name>
-            if (!setter_entry) {
-                snprintf(setter_name_buf, sizeof(setter_name_buf), "lv_obj_set_style_%s", prop_name);
-                setter_entry = find_invoke_entry(setter_name_buf);
-                size_t arg_count = 0; for (arg_count = 0; setter_entry && setter_entry->arg_types[arg_count] != NULL; ++arg_count);
-                if (setter_entry && 
-                    arg_count > 2 && // obj, value, selector
-                    setter_entry->arg_types[2] != NULL &&
-                    (strcmp(setter_entry->arg_types[2], "lv_style_selector_t") == 0 || strcmp(setter_entry->arg_types[2], "int") == 0 || strcmp(setter_entry->arg_types[2], "uint32_t") == 0) &&
-                    cJSON_GetArraySize(prop_args_array) == 1) {
-                    LOG_DEBUG("Adding default selector LV_PART_MAIN (0) for style property '%s' on %s", prop_name, target_actual_type_str);
-                    cJSON_AddItemToArray(prop_args_array, cJSON_CreateNumber(LV_PART_MAIN));
-                }
-            }
-        } else if (strcmp(target_actual_type_str, "style") == 0) { // Fallbacks for styles
-            // 3b. Try lv_style_set_<prop_name>
-            if (!setter_entry) {
-                snprintf(setter_name_buf, sizeof(setter_name_buf), "lv_style_set_%s", prop_name);
-                setter_entry = find_invoke_entry(setter_name_buf);
-            }
-            // 4b. Try lv_style_<prop_name>
-            if (!setter_entry) {
-                snprintf(setter_name_buf, sizeof(setter_name_buf), "lv_style_%s", prop_name);
-                setter_entry = find_invoke_entry(setter_name_buf);
-            }
-        }
-
-        // 6. Try verbatim name (for direct function calls, less common for setters)
-        if (!setter_entry) {
-            setter_entry = find_invoke_entry(prop_name);
+        invoke_args_t prop_args;
+        invoke_args_init(&prop_args, prop_value);
+
+        bool append_default_selector = false;
+        const invoke_table_entry_t* setter_entry = resolve_setter(target_actual_type_str, prop_name, target_is_widget, &append_default_selector);
+        if (setter_entry && append_default_selector && prop_args.count == 1) {
+            LOG_DEBUG("Adding default selector LV_PART_MAIN (0) for style property '%s' on %s", prop_name, target_actual_type_str);
+            invoke_args_append(&prop_args, &g_default_selector_json);
         }
 
         if (!setter_entry) {
-            LOG_WARN_JSON(prop_args_array, "No setter/invokable found for property '%s' on type '%s' (create type '%s').", prop_name, target_actual_type_str, target_create_type_str);
+            LOG_WARN_JSON(prop_item, "No setter/invokable found for property '%s' on type '%s' (create type '%s').", prop_name, target_actual_type_str, target_create_type_str);
+#if LVGL_JSON_STYLE_SHARING
+        } else if (share_styles && style_share_collect_json(&style_batch, setter_entry, &prop_args, target_entity)) {
+            RENDER_STAT_INC(properties_set);
+#endif
         } else {
-            if (!setter_entry->invoke(setter_entry, target_entity, NULL, prop_args_array)) {
-                LOG_ERR_JSON(prop_args_array, "Failed to set property '%s' using '%s' on entity %p.", prop_name, setter_entry->name, target_entity);
+            RENDER_STAT_INC(properties_set);
+            PROFILE_SPAN_BEGIN(setter_span);
+            bool set = setter_entry->invoke(setter_entry, target_entity, NULL, &prop_args);
+            PROFILE_SPAN_END(setter_span, PROFILE_CAT_INVOKE, setter_entry->name, prop_name);
+            if (!set) {
+                LOG_ERR_JSON(prop_item, "Failed to set property '%s' using '%s' on entity %p.", prop_name, setter_entry->name, target_entity);
                 // Potentially return false or handle error more strictly
             } else {
                  LOG_DEBUG("Successfully applied property '%s' using '%s' to entity %p", prop_name, setter_entry->name, target_entity);
             }
         }
 
-        if (temp_array_created) {
-            cJSON_Delete(prop_args_array);
+        if (scalar_copy) {
+            cJSON_Delete(scalar_copy);
         }
     } // End for loop over attributes
 
+#if LVGL_JSON_STYLE_SHARING
+    style_share_flush(style_batch, (lv_obj_t *)target_entity);
+#endif
+    registry_path_free(named_path, named_path_buf);
     return true; // Indicate success
 }
+"""
+
+    # Grid layout setup, shared by render_json_node and compiled programs
+    c_code += """
+// Builds the column/row descriptor arrays from a grid node's "cols"/"rows" and applies them.
+static void apply_grid_layout(cJSON *node, lv_obj_t *grid_obj) {
+    cJSON *cols_item_json = cJSON_GetObjectItemCaseSensitive(node, "cols");
+    cJSON *rows_item_json = cJSON_GetObjectItemCaseSensitive(node, "rows");
+
+    int32_t* col_dsc_array = NULL;
+    int32_t* row_dsc_array = NULL;
+    size_t col_dsc_bytes = 0, row_dsc_bytes = 0;
+    bool grid_setup_ok = true;
+
+    if (cols_item_json && cJSON_IsArray(cols_item_json)) {
+        int num_cols = cJSON_GetArraySize(cols_item_json);
+        col_dsc_bytes = sizeof(int32_t) * (num_cols + 1);
+        col_dsc_array = (int32_t*)mem_alloc(LVGL_JSON_MEM_GRID, col_dsc_bytes);
+        if (col_dsc_array) {
+            RENDER_STAT_INC(heap_allocs);
+            for (int i = 0; i < num_cols; i++) {
+                cJSON *val_item = cJSON_GetArrayItem(cols_item_json, i);
+                if (!unmarshal_value(val_item, TYPE_ID_INT32, "int32_t", &col_dsc_array[i], grid_obj)) { 
+                    LOG_ERR_JSON(val_item, "Grid Error: Failed to parse 'cols' array item %d as int32_t.", i);
+                    mem_free(LVGL_JSON_MEM_GRID, col_dsc_array, col_dsc_bytes); col_dsc_array = NULL; grid_setup_ok = false;
+                    break;
+                }
+            }
+            if (col_dsc_array) col_dsc_array[num_cols] = LV_GRID_TEMPLATE_LAST;
+        } else {
+            LOG_ERR("Grid Error: Failed to allocate memory for column descriptors.");
+            grid_setup_ok = false;
+        }
+    } else { 
+        LOG_ERR_JSON(node, "Grid Error: 'cols' array is missing or not an array for grid type.");
+        grid_setup_ok = false;
+    }
+
+    if (grid_setup_ok && rows_item_json && cJSON_IsArray(rows_item_json)) {
+        int num_rows = cJSON_GetArraySize(rows_item_json);
+        row_dsc_bytes = sizeof(int32_t) * (num_rows + 1);
+        row_dsc_array = (int32_t*)mem_alloc(LVGL_JSON_MEM_GRID, row_dsc_bytes);
+        if (row_dsc_array) {
+            RENDER_STAT_INC(heap_allocs);
+            for (int i = 0; i < num_rows; i++) {
+                cJSON *val_item = cJSON_GetArrayItem(rows_item_json, i);
+                if (!unmarshal_value(val_item, TYPE_ID_INT32, "int32_t", &row_dsc_array[i], grid_obj)) { 
+                    LOG_ERR_JSON(val_item, "Grid Error: Failed to parse 'rows' array item %d as int32_t.", i);
+                    mem_free(LVGL_JSON_MEM_GRID, row_dsc_array, row_dsc_bytes); row_dsc_array = NULL; grid_setup_ok = false;
+                    break;
+                }
+            }
+            if (row_dsc_array) row_dsc_array[num_rows] = LV_GRID_TEMPLATE_LAST;
+        } else {
+            LOG_ERR("Grid Error: Failed to allocate memory for row descriptors.");
+            grid_setup_ok = false;
+        }
+    } else if (grid_setup_ok) { 
+         LOG_ERR_JSON(node, "Grid Error: 'rows' array is missing or not an array for grid type.");
+         grid_setup_ok = false;
+    }
+
+    if (grid_setup_ok && col_dsc_array && row_dsc_array) {
+        // Register arrays for potential later retrieval/management if needed, though LVGL copies them.
+        // This registration is mostly for debugging or advanced scenarios.
+        char temp_name_buf[64]; 
+        snprintf(temp_name_buf, sizeof(temp_name_buf), "grid_col_dsc_%p", (void*)grid_obj);
+        lvgl_json_register_ptr(temp_name_buf, "lv_coord_array_temp", (void*)col_dsc_array); 
+        snprintf(temp_name_buf, sizeof(temp_name_buf), "grid_row_dsc_%p", (void*)grid_obj);
+        lvgl_json_register_ptr(temp_name_buf, "lv_coord_array_temp", (void*)row_dsc_array); 
+        
+        lv_obj_set_grid_dsc_array(grid_obj, col_dsc_array, row_dsc_array);
+    } else {
+        mem_free(LVGL_JSON_MEM_GRID, col_dsc_array, col_dsc_bytes);
+        mem_free(LVGL_JSON_MEM_GRID, row_dsc_array, row_dsc_bytes);
+        LOG_ERR_JSON(node, "Grid Error: Failed to set up complete grid descriptors. Grid layout will not apply.");
+    }
+}
+"""
+
+    # Component definitions and their compiled templates
+    c_code += """
+// --- Components ---
+// A 'component' keeps a private copy of its root. The first 'use-view' compiles it into a
+// template program (prog_compile_template()); instances then replay the template with the
+// '$' variables of their context bound to slots instead of walking the JSON again.
+typedef struct {
+    cJSON *root;
+    lvgl_json_program_t *template_program; // NULL until first used, or if nothing could be compiled
+    bool template_compiled;
+} component_def_t;
+
+static lvgl_json_program_t* prog_compile_template(cJSON *component_root);
+static void* prog_run_template(const lvgl_json_program_t *template_program, lv_obj_t *parent, const char *instance_prefix);
+static void live_map_capture_view(const cJSON *node, const component_def_t *component, const char *named_path_prefix, void *root);
+
+static bool component_define(const char *id, cJSON *root) {
+    render_arena_suspend(); // Component definitions outlive the render pass
+    component_def_t *component = (component_def_t *)mem_alloc(LVGL_JSON_MEM_TEMPLATES, sizeof(component_def_t));
+    cJSON *duplicated_root = component ? cJSON_Duplicate(root, true) : NULL;
+    render_arena_resume();
+    if (!duplicated_root) {
+        mem_free(LVGL_JSON_MEM_TEMPLATES, component, sizeof(component_def_t));
+        return false;
+    }
+    RENDER_STAT_INC(heap_allocs);
+    RENDER_STAT_INC(json_allocs);
+    mem_account(LVGL_JSON_MEM_TEMPLATES, mem_json_bytes(duplicated_root));
+    component->root = duplicated_root;
+    component->template_program = NULL;
+    component->template_compiled = false;
+    lvgl_json_register_ptr(id, "component_def", (void*)component);
+    return true;
+}
+
+static void* component_instantiate(component_def_t *component, lv_obj_t *parent, const char *named_path_prefix) {
+    if (!component->template_compiled) {
+        component->template_compiled = true;
+        render_arena_suspend();
+        component->template_program = prog_compile_template(component->root);
+        render_arena_resume();
+    }
+    if (!component->template_program) {
+        return render_json_node(component->root, parent, named_path_prefix);
+    }
+    return prog_run_template(component->template_program, parent, named_path_prefix);
+}
 """
 
     # Main recursive rendering function
-    c_code += "static void* render_json_node(cJSON *node, lv_obj_t *parent, const char *named_path_prefix) {\n"
+    c_code += """
+static void* render_json_node_body(cJSON *node, lv_obj_t *parent, const char *named_path_prefix);
+
+static void* render_json_node(cJSON *node, lv_obj_t *parent, const char *named_path_prefix) {
+#if LVGL_JSON_LOG_SINK_RING
+    // Records logged while rendering carry the id of the innermost node
+    const cJSON *saved_log_node = g_log_render_node;
+    g_log_render_node = node;
+#endif
+#if LVGL_JSON_PROFILE
+    // Events recorded while rendering carry the source path and type of the innermost node
+    bool profiled = g_profile.active;
+    if (profiled) profile_node_enter(node);
+#endif
+    PROFILE_SPAN_BEGIN(span);
+    void *entity = render_json_node_body(node, parent, named_path_prefix);
+    PROFILE_SPAN_END(span, PROFILE_CAT_NODE, NULL, NULL);
+#if LVGL_JSON_PROFILE
+    if (profiled) profile_node_leave();
+#endif
+#if LVGL_JSON_LOG_SINK_RING
+    g_log_render_node = saved_log_node;
+#endif
+    return entity;
+}
+
+"""
+    c_code += "static void* render_json_node_body(cJSON *node, lv_obj_t *parent, const char *named_path_prefix) {\n"
     c_code += "    if (!cJSON_IsObject(node)) {\n"
     c_code += "        LOG_ERR(\"Render Error: Expected JSON object for UI node.\");\n"
     c_code += "        return NULL;\n"
@@ -337,7 +636,8 @@ static bool apply_setters_and_attributes(
 
     c_code += """
     // --- Context management: Save context active at the start of this node's processing ---
-    cJSON* original_context_for_this_node_call = get_current_context();
+    render_scope_t* original_context_for_this_node_call = get_current_context();
+    render_scope_t context_scope; // Frame for this node's context, use-view context or 'values'
     bool context_was_locally_changed_by_this_node = false;
 
     // --- Handle special node types: component definition, use-view, context wrapper ---
@@ -345,6 +645,9 @@ static bool apply_setters_and_attributes(
     const char *type_str = "obj"; // Default type
     if (type_item && cJSON_IsString(type_item)) {
         type_str = type_item->valuestring;
+    } else if (cJSON_GetObjectItemCaseSensitive(node, "import")) {
+        LOG_WARN_JSON(node, "Import Warning: Skipped; 'import' nodes are linked by lvgl_json_project_load() and only at the top level.");
+        return (void*)1;
     }
 
 
@@ -355,9 +658,7 @@ static bool apply_setters_and_attributes(
             root_item_comp && cJSON_IsObject(root_item_comp)) {
             
             const char *comp_id_str = id_item_comp->valuestring + 1; // Skip '@'
-            cJSON *duplicated_root = cJSON_Duplicate(root_item_comp, true);
-            if (duplicated_root) {
-                lvgl_json_register_ptr(comp_id_str, "component_json_node", (void*)duplicated_root);
+            if (component_define(comp_id_str, root_item_comp)) {
                 return (void*)1; // Success, non-NULL arbitrary pointer
             } else {
                 LOG_ERR_JSON(node, "Component Error: Failed to duplicate root for component '%s'", comp_id_str);
@@ -372,23 +673,27 @@ static bool apply_setters_and_attributes(
         cJSON *id_item_use_view = cJSON_GetObjectItemCaseSensitive(node, "id");
         if (id_item_use_view && cJSON_IsString(id_item_use_view) && id_item_use_view->valuestring && id_item_use_view->valuestring[0] == '@') {
             const char *view_id_str = id_item_use_view->valuestring + 1; // Skip '@'
-            cJSON *component_root_json_node = (cJSON*)lvgl_json_get_registered_ptr(view_id_str, "component_json_node");
+            component_def_t *component = (component_def_t*)lvgl_json_get_registered_ptr(view_id_str, "component_def");
 
-            if (component_root_json_node) {
+            if (component) {
+                cJSON *component_root_json_node = component->root;
                 LOG_INFO("Using view '%s', named_path_prefix for component render: '%s'", view_id_str, named_path_prefix ? named_path_prefix : "ROOT");
                 
                 cJSON* context_for_view_item = cJSON_GetObjectItemCaseSensitive(node, "context");
                 if (context_for_view_item && cJSON_IsObject(context_for_view_item)) {
-                    set_current_context(context_for_view_item); 
+                    push_context(&context_scope, context_for_view_item);
                     view_context_set_locally = true;
                 }
                 
                 // Render the component's root node. It will be parented to `parent` of `use-view`.
                 // The `named_path_prefix` for the component instance is the same as the use-view's.
                 // If the component_root_json_node has an `id`, it will be registered relative to this `named_path_prefix`.
-                void* component_root_entity = render_json_node(component_root_json_node, parent, named_path_prefix);
+                void* component_root_entity = component_instantiate(component, parent, named_path_prefix);
+                if (g_live_capture && component_root_entity) {
+                    live_map_capture_view(node, component, named_path_prefix, component_root_entity);
+                }
                 
-                // After render_json_node returns, context is restored to what it was BEFORE component_root_json_node
+                // After the instance is rendered, context is restored to what it was BEFORE component_root_json_node
                 // was processed. This would be the context set by use-view's "context" or inherited.
 
                 cJSON *do_attrs_json = cJSON_GetObjectItemCaseSensitive(node, "do");
@@ -415,22 +720,16 @@ static bool apply_setters_and_attributes(
 
                     // Determine the path prefix for "named" and "children" inside the "do" block.
                     // This path should be relative to the component root's own identity.
-                    char path_for_do_block_context[256];
-                    path_for_do_block_context[0] = '\\0';
                     const char* base_for_do_path = named_path_prefix; // Path context of the use-view instantiation
+                    const char* comp_root_id_val = NULL;
 
                     cJSON* comp_root_id_item = cJSON_GetObjectItemCaseSensitive(component_root_json_node, "id");
                     if (comp_root_id_item && cJSON_IsString(comp_root_id_item) && comp_root_id_item->valuestring[0] == '@') {
-                        const char* comp_root_id_val = comp_root_id_item->valuestring + 1;
-                        if (base_for_do_path && base_for_do_path[0]) {
-                            snprintf(path_for_do_block_context, sizeof(path_for_do_block_context)-1, "%s:%s", base_for_do_path, comp_root_id_val);
-                        } else {
-                            strncpy(path_for_do_block_context, comp_root_id_val, sizeof(path_for_do_block_context)-1);
-                        }
-                    } else if (base_for_do_path) {
-                         strncpy(path_for_do_block_context, base_for_do_path, sizeof(path_for_do_block_context)-1);
+                        comp_root_id_val = comp_root_id_item->valuestring + 1;
                     }
-                    // else path_for_do_block_context remains empty (root)
+                    // Empty (root) if there is neither a base path nor a root id
+                    char do_path_buf[REGISTRY_PATH_BUF_SIZE];
+                    char *path_for_do_block_context = registry_path_join(do_path_buf, base_for_do_path, comp_root_id_val);
 
                     apply_setters_and_attributes(
                         do_attrs_json,
@@ -442,6 +741,7 @@ static bool apply_setters_and_attributes(
                         path_for_do_block_context, // Path context for "named"/"children" in DO block
                         comp_root_registry_type_name
                     );
+                    registry_path_free(path_for_do_block_context, do_path_buf);
                 }
 
                 if (view_context_set_locally) {
@@ -449,7 +749,7 @@ static bool apply_setters_and_attributes(
                 }
                 return component_root_entity; 
 
-            } else { // component_root_json_node not found
+            } else { // component not found
                 LOG_WARN_JSON(node, "Use-View Error: Component '%s' not found or type error. Creating fallback label.", view_id_str);
                 lv_obj_t *fallback_label = lv_label_create(parent);
                 if(fallback_label) {
@@ -471,7 +771,7 @@ static bool apply_setters_and_attributes(
         cJSON *for_item = cJSON_GetObjectItemCaseSensitive(node, "for");
 
         if (values_item && cJSON_IsObject(values_item) && for_item && cJSON_IsObject(for_item)) {
-            set_current_context(values_item); 
+            push_context(&context_scope, values_item);
             // The `named_path_prefix` is passed through to the `for_item`.
             void* result_entity = render_json_node(for_item, parent, named_path_prefix); 
             set_current_context(original_context_for_this_node_call); 
@@ -480,12 +780,18 @@ static bool apply_setters_and_attributes(
             LOG_ERR_JSON(node, "'context' type node Error: Requires 'values' (object) and 'for' (object) properties.");
             return NULL;
         }
+    } else if (strcmp(type_str, "virtual-list") == 0) {
+        return vlist_render(node, parent, named_path_prefix);
+    } else if (strcmp(type_str, "for-each") == 0) {
+        return repeat_render(node, parent, named_path_prefix);
     }
 
     // --- If not a special type handled above, proceed with generic node processing ---
     cJSON* context_property_on_this_node = cJSON_GetObjectItemCaseSensitive(node, "context");
-    if (context_property_on_this_node && cJSON_IsObject(context_property_on_this_node)) {
-        set_current_context(context_property_on_this_node);
+    // The stream renderer may have pushed this node's context already
+    if (context_property_on_this_node && cJSON_IsObject(context_property_on_this_node) &&
+        !(original_context_for_this_node_call && original_context_for_this_node_call->values == context_property_on_this_node)) {
+        push_context(&context_scope, context_property_on_this_node);
         context_was_locally_changed_by_this_node = true;
     }
 """
@@ -493,26 +799,15 @@ static bool apply_setters_and_attributes(
     c_code += "    // 1. Determine Object ID for registration and path construction\n"
     c_code += "    cJSON *id_item = cJSON_GetObjectItemCaseSensitive(node, \"id\");\n"
     c_code += "    const char *id_str_val = NULL;\n"
-    c_code += "    char current_node_path_segment[128] = {0}; // Segment this node adds to the path\n"
     c_code += "    if (id_item && cJSON_IsString(id_item) && id_item->valuestring && id_item->valuestring[0] == '@') {\n"
-    c_code += "        id_str_val = id_item->valuestring + 1;\n"
-    c_code += "        strncpy(current_node_path_segment, id_str_val, sizeof(current_node_path_segment) -1);\n"
+    c_code += "        id_str_val = id_item->valuestring + 1; // Segment this node adds to the path\n"
     c_code += "    } else if (id_item && cJSON_IsString(id_item)) {\n"
     c_code += "        LOG_WARN_JSON(id_item, \"Render Warning: 'id' property '%s' should start with '@' for registration/path construction. Treating as non-identifying.\", id_item->valuestring);\n"
     c_code += "    }\n\n"
 
     c_code += "    // Construct full path for this node, to be used for its registration and as prefix for its children/named attributes\n"
-    c_code += "    char effective_path_for_node_and_children[256];\n"
-    c_code += "    if (named_path_prefix && named_path_prefix[0] != '\\0') {\n"
-    c_code += "        if (current_node_path_segment[0] != '\\0') {\n"
-    c_code += "            snprintf(effective_path_for_node_and_children, sizeof(effective_path_for_node_and_children)-1, \"%s:%s\", named_path_prefix, current_node_path_segment);\n"
-    c_code += "        } else {\n"
-    c_code += "            strncpy(effective_path_for_node_and_children, named_path_prefix, sizeof(effective_path_for_node_and_children)-1);\n"
-    c_code += "        }\n"
-    c_code += "    } else {\n"
-    c_code += "        strncpy(effective_path_for_node_and_children, current_node_path_segment, sizeof(effective_path_for_node_and_children)-1);\n"
-    c_code += "    }\n"
-    c_code += "    effective_path_for_node_and_children[sizeof(effective_path_for_node_and_children)-1] = '\\0';\n\n"
+    c_code += "    char effective_path_buf[REGISTRY_PATH_BUF_SIZE];\n"
+    c_code += "    char *effective_path_for_node_and_children = registry_path_join(effective_path_buf, named_path_prefix, id_str_val);\n\n"
 
 
     c_code += "    // 2. Create the LVGL Object / Resource\n"
@@ -546,12 +841,14 @@ static bool apply_setters_and_attributes(
         c_code += f"        if (!name_for_custom_creator) {{ \n"
         c_code += "            LOG_ERR_JSON(node, \"Render Error: Type '%s' requires an 'id' to form a registration name, but no id found or path is empty.\", actual_type_str_for_node);\n"
         c_code += "            if (context_was_locally_changed_by_this_node) set_current_context(original_context_for_this_node_call);\n"
+        c_code += "            registry_path_free(effective_path_for_node_and_children, effective_path_buf);\n"
         c_code += "            return NULL;\n"
         c_code += f"        }}\n"
         c_code += f"        created_entity = (void*){creator_func}(name_for_custom_creator);\n"
         c_code += f"        if (!created_entity) {{ \n"
         c_code += "             LOG_ERR_JSON(node, \"Render Error: Custom creator %s for name '%s' returned NULL.\", \"{creator_func}\", name_for_custom_creator);\n"
         c_code += "             if (context_was_locally_changed_by_this_node) set_current_context(original_context_for_this_node_call);\n"
+        c_code += "             registry_path_free(effective_path_for_node_and_children, effective_path_buf);\n"
         c_code += "             return NULL; \n"
         c_code += "        }\n"
         c_code += f"        is_widget = false;\n" # Custom creators are typically for non-widget resources like styles
@@ -586,22 +883,32 @@ static bool apply_setters_and_attributes(
     c_code += "        if (!create_entry) {\n"
     c_code += "            LOG_ERR_JSON(node, \"Render Error: Create function '%s' not found for type '%s' (create type '%s').\", create_func_name, actual_type_str_for_node, create_type_str_for_node);\n"
     c_code += "            if (context_was_locally_changed_by_this_node) set_current_context(original_context_for_this_node_call);\n"
+    c_code += "            registry_path_free(effective_path_for_node_and_children, effective_path_buf);\n"
     c_code += "            return NULL;\n"
     c_code += "        }\n\n"
     c_code += "        lv_obj_t* new_widget = NULL;\n"
     c_code += "        // First arg to creator is parent. Creator returns void*, but we expect lv_obj_t** for widget creators via invoke. \n"
-    c_code += "        if (!create_entry->invoke(create_entry, (void*)parent, &new_widget, NULL)) { \n"
+    c_code += "        PROFILE_SPAN_BEGIN(create_span);\n"
+    c_code += "        bool created = create_entry->invoke(create_entry, (void*)parent, &new_widget, NULL);\n"
+    c_code += "        PROFILE_SPAN_END(create_span, PROFILE_CAT_INVOKE, create_entry->name, NULL);\n"
+    c_code += "        if (!created) { \n"
     c_code += "            LOG_ERR_JSON(node, \"Render Error: Failed to invoke %s.\", create_func_name);\n"
     c_code += "            if (context_was_locally_changed_by_this_node) set_current_context(original_context_for_this_node_call);\n"
+    c_code += "            registry_path_free(effective_path_for_node_and_children, effective_path_buf);\n"
     c_code += "            return NULL;\n"
     c_code += "        }\n"
     c_code += "        if (!new_widget) { \n"
     c_code += "             LOG_ERR_JSON(node, \"Render Error: %s returned NULL.\", create_func_name); \n"
     c_code += "             if (context_was_locally_changed_by_this_node) set_current_context(original_context_for_this_node_call);\n"
+    c_code += "             registry_path_free(effective_path_for_node_and_children, effective_path_buf);\n"
     c_code += "             return NULL; \n"
     c_code += "        }\n"
     c_code += "        created_entity = (void*)new_widget;\n"
-    c_code += "        is_widget = true;\n\n"
+    c_code += "        is_widget = true;\n"
+    c_code += "        mem_count_widget(create_entry->name);\n\n"
+    c_code += "        if (g_live_capture) {\n"
+    c_code += "            live_map_capture(node, new_widget, actual_type_str_for_node, create_type_str_for_node, effective_path_for_node_and_children, id_str_val && id_str_val[0]);\n"
+    c_code += "        }\n\n"
     c_code += "        // Determine type for registry (e.g., lv_button_t, lv_obj_t)\n"
     c_code += "        snprintf(type_name_for_registry_buf, sizeof(type_name_for_registry_buf), \"lv_%s_t\", create_type_str_for_node);\n"
     c_code += "        if (id_str_val && id_str_val[0] && effective_path_for_node_and_children[0] != '\\0') {\n"
@@ -613,78 +920,9 @@ static bool apply_setters_and_attributes(
     c_code += "    }\n"
     c_code += "\n"
 
-    grid_setup_c_code = """
-    if (created_entity && is_widget && strcmp(actual_type_str_for_node, "grid") == 0) { 
-        lv_obj_t* grid_obj = (lv_obj_t*)created_entity;
-        cJSON *cols_item_json = cJSON_GetObjectItemCaseSensitive(node, "cols");
-        cJSON *rows_item_json = cJSON_GetObjectItemCaseSensitive(node, "rows");
-
-        int32_t* col_dsc_array = NULL;
-        int32_t* row_dsc_array = NULL;
-        bool grid_setup_ok = true;
-
-        if (cols_item_json && cJSON_IsArray(cols_item_json)) {
-            int num_cols = cJSON_GetArraySize(cols_item_json);
-            col_dsc_array = (int32_t*)LV_MALLOC(sizeof(int32_t) * (num_cols + 1));
-            if (col_dsc_array) {
-                for (int i = 0; i < num_cols; i++) {
-                    cJSON *val_item = cJSON_GetArrayItem(cols_item_json, i);
-                    if (!unmarshal_value(val_item, "int32_t", &col_dsc_array[i], created_entity)) { 
-                        LOG_ERR_JSON(val_item, "Grid Error: Failed to parse 'cols' array item %d as int32_t.", i);
-                        LV_FREE(col_dsc_array); col_dsc_array = NULL; grid_setup_ok = false;
-                        break;
-                    }
-                }
-                if (col_dsc_array) col_dsc_array[num_cols] = LV_GRID_TEMPLATE_LAST;
-            } else {
-                LOG_ERR("Grid Error: Failed to allocate memory for column descriptors.");
-                grid_setup_ok = false;
-            }
-        } else { 
-            LOG_ERR_JSON(node, "Grid Error: 'cols' array is missing or not an array for grid type.");
-            grid_setup_ok = false;
-        }
-
-        if (grid_setup_ok && rows_item_json && cJSON_IsArray(rows_item_json)) {
-            int num_rows = cJSON_GetArraySize(rows_item_json);
-            row_dsc_array = (int32_t*)LV_MALLOC(sizeof(int32_t) * (num_rows + 1));
-            if (row_dsc_array) {
-                for (int i = 0; i < num_rows; i++) {
-                    cJSON *val_item = cJSON_GetArrayItem(rows_item_json, i);
-                    if (!unmarshal_value(val_item, "int32_t", &row_dsc_array[i], created_entity)) { 
-                        LOG_ERR_JSON(val_item, "Grid Error: Failed to parse 'rows' array item %d as int32_t.", i);
-                        LV_FREE(row_dsc_array); row_dsc_array = NULL; grid_setup_ok = false;
-                        break;
-                    }
-                }
-                if (row_dsc_array) row_dsc_array[num_rows] = LV_GRID_TEMPLATE_LAST;
-            } else {
-                LOG_ERR("Grid Error: Failed to allocate memory for row descriptors.");
-                grid_setup_ok = false;
-            }
-        } else if (grid_setup_ok) { 
-             LOG_ERR_JSON(node, "Grid Error: 'rows' array is missing or not an array for grid type.");
-             grid_setup_ok = false;
-        }
-
-        if (grid_setup_ok && col_dsc_array && row_dsc_array) {
-            // Register arrays for potential later retrieval/management if needed, though LVGL copies them.
-            // This registration is mostly for debugging or advanced scenarios.
-            char temp_name_buf[64]; 
-            snprintf(temp_name_buf, sizeof(temp_name_buf), "grid_col_dsc_%p", (void*)grid_obj);
-            lvgl_json_register_ptr(temp_name_buf, "lv_coord_array_temp", (void*)col_dsc_array); 
-            snprintf(temp_name_buf, sizeof(temp_name_buf), "grid_row_dsc_%p", (void*)grid_obj);
-            lvgl_json_register_ptr(temp_name_buf, "lv_coord_array_temp", (void*)row_dsc_array); 
-            
-            lv_obj_set_grid_dsc_array(grid_obj, col_dsc_array, row_dsc_array);
-        } else {
-            if (col_dsc_array) { LV_FREE(col_dsc_array); } 
-            if (row_dsc_array) { LV_FREE(row_dsc_array); } 
-            LOG_ERR_JSON(node, "Grid Error: Failed to set up complete grid descriptors. Grid layout will not apply.");
-        }
-    }
-"""
-    c_code += grid_setup_c_code
+    c_code += "    if (created_entity && is_widget && strcmp(actual_type_str_for_node, \"grid\") == 0) {\n"
+    c_code += "        apply_grid_layout(node, (lv_obj_t*)created_entity);\n"
+    c_code += "    }\n"
 
     c_code += "    // 3. Set Properties, handle children, etc., using the new function\n"
     c_code += "    if (created_entity) {\n"
@@ -711,7 +949,8 @@ static bool apply_setters_and_attributes(
     c_code += "    // Context restoration\n"
     c_code += "    if (context_was_locally_changed_by_this_node) {\n"
     c_code += "        set_current_context(original_context_for_this_node_call);\n"
-    c_code += "    }\n\n"
+    c_code += "    }\n"
+    c_code += "    registry_path_free(effective_path_for_node_and_children, effective_path_buf);\n\n"
     c_code += "    return created_entity;\n"
     c_code += "}\n\n"
 
@@ -732,6 +971,7 @@ static bool apply_setters_and_attributes(
     c_code += "        }\n"
     c_code += "    }\n\n"
 
+    c_code += "    render_pass_begin();\n"
     c_code += "    bool overall_success = true;\n"
     c_code += "    if (cJSON_IsArray(root_json)) {\n"
     c_code += "        cJSON *node_in_array = NULL;\n"
@@ -764,7 +1004,8 @@ static bool apply_setters_and_attributes(
     c_code += "    } else {\n"
     c_code += "        LOG_ERR_JSON(root_json, \"Render Error: root_json must be a JSON object or array.\");\n"
     c_code += "        overall_success = false;\n"
-    c_code += "    }\n\n"
+    c_code += "    }\n"
+    c_code += "    render_pass_end();\n\n"
     c_code += "    if (!overall_success) {\n"
     c_code += "         LOG_ERR(\"UI Rendering failed.\");\n"
     c_code += "    } else {\n"
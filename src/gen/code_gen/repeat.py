@@ -0,0 +1,196 @@
+# code_gen/repeat.py
+import logging
+
+logger = logging.getLogger(__name__)
+
+
+def generate_repeat_code():
+    """
+    Generates the 'for-each' node: renders its 'for' node once per item of an array.
+
+    Items come from a JSON array in the spec, a '$' variable holding one, a registered cJSON
+    array or a registered lvgl_json_list_source_cb_t. Each item is pushed as a context frame
+    (an object item's members are variables themselves), with the item as '$item' and its
+    position as '$index' on top. The 'for' node is compiled into a template program once and
+    replayed per item; templates are kept until the outermost for-each is done, so nested
+    repeats compile their bodies once too instead of once per outer item.
+    """
+    return r"""
+// --- Repeats ---
+
+typedef struct repeat_template_s {
+    struct repeat_template_s *next;
+    const cJSON *body;                  // 'for' node the template was compiled from
+    lvgl_json_program_t *program;       // NULL if nothing of it could be compiled
+} repeat_template_t;
+
+static repeat_template_t *g_repeat_templates; // Compiled bodies, freed when the outermost for-each is done
+static uint32_t g_repeat_depth;
+
+static lvgl_json_program_t* repeat_template(cJSON *body) {
+    for (repeat_template_t *t = g_repeat_templates; t; t = t->next) {
+        if (t->body == body) return t->program;
+    }
+    render_arena_suspend(); // Kept while the outermost for-each renders
+    repeat_template_t *t = (repeat_template_t *)mem_alloc(LVGL_JSON_MEM_TEMPLATES, sizeof(repeat_template_t));
+    if (t) {
+        t->body = body;
+        t->program = prog_compile_template(body);
+        t->next = g_repeat_templates;
+        g_repeat_templates = t;
+    }
+    render_arena_resume();
+    return t ? t->program : NULL;
+}
+
+static void repeat_templates_free(void) {
+    while (g_repeat_templates) {
+        repeat_template_t *t = g_repeat_templates;
+        g_repeat_templates = t->next;
+        lvgl_json_free_program(t->program);
+        mem_free(LVGL_JSON_MEM_TEMPLATES, t, sizeof(*t));
+    }
+}
+
+// Value of the variable `name`, following variables that pass another one on ({"files": "$files"})
+// the way context_unmarshal_value() does.
+static cJSON* repeat_lookup(const char *name) {
+    render_scope_t *saved = g_render_scope;
+    cJSON *value = NULL;
+    for (int hops = 0; hops < 8; ++hops) { // Bounded: variables may pass each other on in a cycle
+        render_scope_t *scope = NULL;
+        value = context_lookup(name, &scope);
+        if (!cJSON_IsString(value) || value->valuestring[0] != '$' || value->valuestring[1] == '$') break;
+        name = value->valuestring + 1;
+        render_scope_t *outer = scope->parent;
+        while (outer && outer->values == scope->values) outer = outer->parent;
+        g_render_scope = outer;
+    }
+    g_render_scope = saved;
+    return value;
+}
+
+// '@name' items: a registered cJSON array, or a data source (*source) that needs 'count'.
+static cJSON* repeat_registered_items(const char *name, lvgl_json_list_source_cb_t *source) {
+    if (!g_registry) return NULL;
+    const registry_entry_t *entry = &g_registry[registry_slot(NULL, 0, name, registry_hash(NULL, 0, name))];
+    if (entry->ptr && entry->type_name == str_pool_lookup("cJSON", 5)) return (cJSON *)entry->ptr;
+    *source = (lvgl_json_list_source_cb_t)lvgl_json_get_registered_ptr(name, "lvgl_json_list_source_cb_t");
+    return NULL;
+}
+
+static const char* repeat_name(cJSON *node, const char *key, const char *default_name) {
+    cJSON *item = cJSON_GetObjectItemCaseSensitive(node, key);
+    if (!item) return default_name;
+    if (cJSON_IsString(item) && item->valuestring[0] && item->valuestring[0] != '$') return item->valuestring;
+    LOG_WARN_JSON(item, "For-Each Warning: '%s' must be a variable name without '$'. Using '%s'.", key, default_name);
+    return default_name;
+}
+
+// Resolves the items of a 'for-each' node: an array (*items), a data source (*source) or neither
+// for a plain 'count'. Logs and returns false if the node is malformed.
+static bool repeat_resolve(cJSON *node, lv_obj_t *parent, cJSON **items, lvgl_json_list_source_cb_t *source, uint32_t *count) {
+    if (!cJSON_IsObject(cJSON_GetObjectItemCaseSensitive(node, "for"))) {
+        LOG_ERR_JSON(node, "For-Each Error: Requires 'for' (object), the node rendered for each item.");
+        return false;
+    }
+
+    cJSON *items_item = cJSON_GetObjectItemCaseSensitive(node, "items");
+    cJSON *count_item = cJSON_GetObjectItemCaseSensitive(node, "count");
+    *items = NULL;
+    *source = NULL;
+    if (cJSON_IsArray(items_item)) {
+        *items = items_item;
+    } else if (cJSON_IsString(items_item) && items_item->valuestring[0] == '$') {
+        *items = repeat_lookup(items_item->valuestring + 1);
+    } else if (cJSON_IsString(items_item) && items_item->valuestring[0] == '@') {
+        *items = repeat_registered_items(items_item->valuestring + 1, source);
+    }
+    if (items_item && !cJSON_IsArray(*items) && !*source) {
+        LOG_ERR_JSON(node, "For-Each Error: 'items' must be an array, a '$variable' holding one, or the '@name' of a registered cJSON array or lvgl_json_list_source_cb_t.");
+        return false;
+    }
+    *count = 0;
+    if (count_item && !unmarshal_value(count_item, TYPE_ID_UINT32, "uint32_t", count, parent)) {
+        LOG_ERR_JSON(node, "For-Each Error: 'count' must be a number.");
+        return false;
+    }
+    if (!items_item && !count_item) {
+        LOG_ERR_JSON(node, "For-Each Error: Requires 'items', 'count' or both.");
+        return false;
+    }
+    if (*items) {
+        uint32_t size = (uint32_t)cJSON_GetArraySize(*items);
+        if (!count_item || *count > size) *count = size; // 'count' limits an array
+    }
+    return true;
+}
+
+// Renders item `i` of a 'for-each' node (`item` from its array, or from `source`) in its own
+// context frame. Call inside render_arena_enter(); the frame is rewound before returning.
+static void* repeat_render_item(cJSON *node, lvgl_json_program_t *program, uint32_t i, cJSON *item,
+                                lvgl_json_list_source_cb_t source, const char *item_name, const char *index_name,
+                                lv_obj_t *parent, const char *named_path_prefix) {
+    cJSON *body = cJSON_GetObjectItemCaseSensitive(node, "for");
+    render_arena_mark_t mark = render_arena_mark();
+    cJSON *source_item = source ? cJSON_CreateObject() : NULL;
+    if (source_item) source(i, source_item, NULL);
+    cJSON *values = source ? source_item : item;
+    cJSON *frame = cJSON_CreateObject();
+    if (frame) {
+        cJSON_AddNumberToObject(frame, index_name, (double)i);
+        if (values) cJSON_AddItemReferenceToObject(frame, item_name, values);
+    }
+
+    void *entity = NULL;
+    if (!frame || (source && !source_item)) {
+        LOG_ERR_JSON(node, "For-Each Error: Out of memory for item %u.", (unsigned)i);
+    } else {
+        render_scope_t *saved_scope = get_current_context();
+        render_scope_t item_scope, frame_scope;
+        if (cJSON_IsObject(values)) push_context(&item_scope, values);
+        push_context(&frame_scope, frame);
+        // The body node renders many widgets; a live UI renders a changed for-each again
+        live_map_t *saved_capture = g_live_capture;
+        g_live_capture = NULL;
+        entity = program ? prog_run_template(program, parent, named_path_prefix)
+                         : render_json_node(body, parent, named_path_prefix);
+        g_live_capture = saved_capture;
+        set_current_context(saved_scope);
+        if (!entity) LOG_ERR_JSON(body, "For-Each Error: Failed to render item %u. Aborting the rest.", (unsigned)i);
+    }
+    cJSON_Delete(frame);
+    cJSON_Delete(source_item);
+    render_arena_rewind(mark);
+    return entity;
+}
+
+// Renders a 'for-each' node. Returns the entity of the last item, (void*)1 if there were none.
+static void* repeat_render(cJSON *node, lv_obj_t *parent, const char *named_path_prefix) {
+#if LVGL_JSON_USE_SLICING
+    if (g_slice_defer && g_repeat_depth == 0) return slice_defer_repeat(node, parent, named_path_prefix);
+#endif
+
+    cJSON *items = NULL;
+    lvgl_json_list_source_cb_t source = NULL;
+    uint32_t count = 0;
+    if (!repeat_resolve(node, parent, &items, &source, &count)) return NULL;
+    const char *item_name = repeat_name(node, "as", "item");
+    const char *index_name = repeat_name(node, "index", "index");
+
+    g_repeat_depth++;
+    render_arena_enter(); // Item frames are transient
+    cJSON *body = cJSON_GetObjectItemCaseSensitive(node, "for");
+    lvgl_json_program_t *program = count >= LVGL_JSON_REPEAT_COMPILE_MIN ? repeat_template(body) : NULL;
+
+    void *last_entity = (void*)1;
+    cJSON *item = items ? items->child : NULL;
+    for (uint32_t i = 0; i < count && last_entity; ++i, item = item ? item->next : NULL) {
+        last_entity = repeat_render_item(node, program, i, item, source, item_name, index_name, parent, named_path_prefix);
+    }
+
+    render_arena_leave();
+    if (--g_repeat_depth == 0) repeat_templates_free();
+    return last_entity;
+}
+"""
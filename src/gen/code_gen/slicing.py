@@ -0,0 +1,421 @@
+# code_gen/slicing.py
+import logging
+
+logger = logging.getLogger(__name__)
+
+
+def generate_slicing_code():
+    """
+    Generates time-sliced rendering: lvgl_json_render_start() and lvgl_json_render_step().
+
+    A step renders one node at a time until its time budget is used up. A node whose last
+    attribute is "children" hands the array to slice_defer_children() instead of rendering it,
+    which pushes a work item (parent, cursor into the array, path, variables in scope) onto an
+    explicit stack. The next unit takes the top of the stack, so widgets are created in the
+    same depth-first order as lvgl_json_render_ui() creates them. Children of hidden
+    containers and of tiles or tabs their view does not show go to a second queue that is only
+    worked on once everything on screen is built. A 'for-each' becomes a work item too and
+    renders one item per unit.
+
+    Work items share the variables of the unit that deferred them while the scope is the same,
+    and keep a merged copy (lazy_capture_context()) otherwise.
+    """
+    return r"""
+// --- Time-Sliced Rendering ---
+
+#if LVGL_JSON_USE_SLICING
+
+#ifndef LVGL_JSON_RENDER_CLOCK_US
+#include <time.h>
+static uint32_t slice_clock_us(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000u + (uint64_t)ts.tv_nsec / 1000u);
+}
+#define LVGL_JSON_RENDER_CLOCK_US() slice_clock_us()
+#endif
+
+typedef struct {
+    uint32_t refs;
+    cJSON *values;              // Merged copy of the variables in scope
+    size_t json_bytes;          // Accounted to LVGL_JSON_MEM_TEMPORARY
+} slice_context_t;
+
+typedef struct slice_work_s {
+    struct slice_work_s *next;
+    lv_obj_t *parent;
+    cJSON *cursor;              // Next node, or the array item of the next 'for-each' item
+    slice_context_t *context;   // Variables in scope when the work was deferred, NULL if none
+    const char *path;           // Interned path prefix
+    bool top_level;             // A failure aborts the render
+    bool offscreen;             // Below a hidden container or a page not shown: built with the offscreen queue
+    struct slice_work_s *siblings; // 'for-each' work: the nodes after it, dropped if an item fails
+    // 'for-each' work: one item per unit
+    cJSON *repeat;
+    lvgl_json_program_t *program;
+    lvgl_json_list_source_cb_t source;
+    const char *item_name;
+    const char *index_name;
+    uint32_t index;
+    uint32_t count;
+} slice_work_t;
+
+typedef struct {
+    bool active;
+    bool ok;
+    lvgl_json_render_done_cb_t done_cb;
+    void *user_data;
+    lv_timer_t *timer;
+    uint32_t budget_us;
+    uint32_t unit_peak_us;               // Decaying maximum of the time one unit took
+    slice_work_t *stack;                 // On screen, depth first: the top was deferred last
+    slice_work_t *offscreen;             // Hidden containers and pages not shown, in order
+    slice_work_t *offscreen_tail;
+    render_scope_t *unit_scope;          // Scope the running unit pushed for unit_context
+    slice_context_t *unit_context;
+    slice_work_t *unit_work;             // Work of the running unit
+    cJSON *unit_node;                    // Node it renders
+    bool unit_offscreen;                 // Its work is offscreen: the subtree is built now, in order
+    slice_work_t **unit_insert;          // Where the next work it defers goes, after the ones before
+} slice_job_t;
+
+static slice_job_t g_slice;
+
+static void slice_context_release(slice_context_t *context) {
+    if (!context || --context->refs > 0) return;
+    mem_unaccount(LVGL_JSON_MEM_TEMPORARY, context->json_bytes);
+    cJSON_Delete(context->values);
+    mem_free(LVGL_JSON_MEM_TEMPORARY, context, sizeof(*context));
+}
+
+// The variables in scope for deferred work: the running unit's own while no scope was pushed
+// since, a merged copy otherwise. Returns false if out of memory.
+static bool slice_context_acquire(slice_context_t **out) {
+    *out = NULL;
+    if (!g_render_scope) return true;
+    if (g_render_scope == g_slice.unit_scope && g_slice.unit_context) {
+        g_slice.unit_context->refs++;
+        *out = g_slice.unit_context;
+        return true;
+    }
+    render_arena_suspend(); // Kept until the work is done
+    slice_context_t *context = (slice_context_t *)mem_alloc(LVGL_JSON_MEM_TEMPORARY, sizeof(slice_context_t));
+    cJSON *values = context ? lazy_capture_context() : NULL;
+    render_arena_resume();
+    if (!values) {
+        mem_free(LVGL_JSON_MEM_TEMPORARY, context, sizeof(slice_context_t));
+        return false;
+    }
+    RENDER_STAT_INC(heap_allocs);
+    RENDER_STAT_INC(json_allocs);
+    context->refs = 1;
+    context->values = values;
+    context->json_bytes = mem_json_bytes(values);
+    mem_account(LVGL_JSON_MEM_TEMPORARY, context->json_bytes);
+    *out = context;
+    return true;
+}
+
+static slice_work_t* slice_work_new(lv_obj_t *parent, const char *path) {
+    slice_work_t *work = (slice_work_t *)mem_alloc(LVGL_JSON_MEM_TEMPORARY, sizeof(slice_work_t));
+    if (!work) return NULL;
+    memset(work, 0, sizeof(*work));
+    if (!slice_context_acquire(&work->context)) {
+        mem_free(LVGL_JSON_MEM_TEMPORARY, work, sizeof(*work));
+        return NULL;
+    }
+    RENDER_STAT_INC(heap_allocs);
+    work->parent = parent;
+    work->path = str_pool_retain(path ? path : "", path ? strlen(path) : 0);
+    return work;
+}
+
+static void slice_work_free(slice_work_t *work) {
+    lvgl_json_free_program(work->program);
+    slice_context_release(work->context);
+    str_pool_release(work->path);
+    mem_free(LVGL_JSON_MEM_TEMPORARY, work, sizeof(*work));
+}
+
+// Hidden, or a tile or tab its view does not show (the first one until a page is chosen).
+static bool slice_offscreen(lv_obj_t *parent) {
+    if (lv_obj_has_flag(parent, LV_OBJ_FLAG_HIDDEN)) return true;
+    lv_obj_t *view = lazy_find_view(parent);
+    if (!view) return false;
+    lv_obj_t *active = lazy_view_active_page(view);
+    return active ? active != parent : lv_obj_get_index(parent) != 0;
+}
+
+// On the stack above the running unit's work, after the work it deferred before
+static void slice_push(slice_work_t *work) {
+    slice_work_t **link = g_slice.unit_insert ? g_slice.unit_insert : &g_slice.stack;
+    work->offscreen = g_slice.unit_offscreen;
+    work->next = *link;
+    *link = work;
+    g_slice.unit_insert = &work->next;
+}
+
+static void slice_queue(slice_work_t *work) {
+    if (!g_slice.unit_offscreen && slice_offscreen(work->parent)) {
+        work->offscreen = true;
+        if (g_slice.offscreen_tail) g_slice.offscreen_tail->next = work;
+        else g_slice.offscreen = work;
+        g_slice.offscreen_tail = work;
+    } else {
+        slice_push(work);
+    }
+}
+
+// Only the node of the running unit defers: its own "children" and those of its 'with' blocks.
+// Whatever a deeper node renders after its children would otherwise come before them.
+static bool slice_unit_attributes(cJSON *attributes) {
+    if (attributes == g_slice.unit_node) return true;
+    cJSON *item = NULL;
+    cJSON_ArrayForEach(item, g_slice.unit_node) {
+        if (item->string && strcmp(item->string, "with") == 0 && cJSON_GetObjectItemCaseSensitive(item, "do") == attributes) return true;
+    }
+    return false;
+}
+
+static void slice_unlink(slice_work_t *work) {
+    for (slice_work_t **link = &g_slice.stack; *link; link = &(*link)->next) {
+        if (*link == work) {
+            *link = work->next;
+            return;
+        }
+    }
+    slice_work_t *prev = NULL;
+    for (slice_work_t **link = &g_slice.offscreen; *link; prev = *link, link = &(*link)->next) {
+        if (*link == work) {
+            *link = work->next;
+            if (g_slice.offscreen_tail == work) g_slice.offscreen_tail = prev;
+            return;
+        }
+    }
+}
+
+static bool slice_defer_children(cJSON *attributes, lv_obj_t *parent, cJSON *children, const char *path) {
+    if (!slice_unit_attributes(attributes)) return false;
+    if (!children->child) return true;
+    slice_work_t *work = slice_work_new(parent, path);
+    if (!work) return false;
+    work->cursor = children->child;
+    slice_queue(work);
+    return true;
+}
+
+static void* slice_defer_repeat(cJSON *node, lv_obj_t *parent, const char *named_path_prefix) {
+    // Not the unit's node: what follows it renders now, so its items have to as well
+    slice_work_t *work = node == g_slice.unit_node ? slice_work_new(parent, named_path_prefix) : NULL;
+    if (!work) {
+        g_slice_defer = false;
+        void *entity = repeat_render(node, parent, named_path_prefix);
+        g_slice_defer = true;
+        return entity;
+    }
+    // Resolved in the work's own scope: '$items' must stay valid until the last item
+    render_scope_t *saved_scope = get_current_context();
+    render_scope_t scope;
+    g_render_scope = NULL;
+    if (work->context) push_context(&scope, work->context->values);
+    cJSON *items = NULL;
+    bool ok = repeat_resolve(node, parent, &items, &work->source, &work->count);
+    set_current_context(saved_scope);
+    if (!ok || work->count == 0) {
+        slice_work_free(work);
+        return ok ? (void*)1 : NULL;
+    }
+    work->repeat = node;
+    work->top_level = g_slice.unit_work->top_level; // Its items fail like the node itself would
+    work->siblings = g_slice.unit_work->cursor ? g_slice.unit_work : NULL;
+    work->cursor = items ? items->child : NULL;
+    work->item_name = repeat_name(node, "as", "item");
+    work->index_name = repeat_name(node, "index", "index");
+    if (work->count >= LVGL_JSON_REPEAT_COMPILE_MIN) {
+        render_arena_suspend(); // Kept until the last item
+        work->program = prog_compile_template(cJSON_GetObjectItemCaseSensitive(node, "for"));
+        render_arena_resume();
+    }
+    // Right above the unit's work, whatever its parent: the nodes after it wait for its items
+    slice_push(work);
+    return (void*)1;
+}
+
+static void slice_clear(void) {
+    while (g_slice.stack) {
+        slice_work_t *work = g_slice.stack;
+        g_slice.stack = work->next;
+        slice_work_free(work);
+    }
+    while (g_slice.offscreen) {
+        slice_work_t *work = g_slice.offscreen;
+        g_slice.offscreen = work->next;
+        slice_work_free(work);
+    }
+    g_slice.offscreen_tail = NULL;
+    if (g_repeat_depth == 0) repeat_templates_free();
+}
+
+// Renders the next node or 'for-each' item. Returns false if there was no work left.
+static bool slice_run_unit(void) {
+    slice_work_t *work = g_slice.stack ? g_slice.stack : g_slice.offscreen;
+    if (!work) return false;
+    g_slice.unit_offscreen = work->offscreen;
+
+    render_scope_t scope;
+    g_render_scope = NULL;
+    if (work->context) push_context(&scope, work->context->values);
+    g_slice.unit_scope = g_render_scope;
+    g_slice.unit_context = work->context;
+
+    cJSON *node = work->repeat ? work->repeat : work->cursor;
+    void *entity;
+    bool done;
+    if (work->repeat) {
+        g_repeat_depth++; // Nested repeats render with their item; their templates are kept
+        entity = repeat_render_item(work->repeat, work->program, work->index, work->cursor, work->source,
+                                    work->item_name, work->index_name, work->parent, work->path);
+        g_repeat_depth--;
+        work->cursor = work->cursor ? work->cursor->next : NULL;
+        done = ++work->index >= work->count;
+    } else {
+        work->cursor = node->next; // Before rendering: its children go on top of `work`
+        g_slice.unit_work = work;
+        g_slice.unit_node = node;
+        g_slice.unit_insert = &g_slice.stack;
+        g_slice_defer = true;
+        entity = render_json_node(node, work->parent, work->path);
+        g_slice_defer = false;
+        g_slice.unit_work = NULL;
+        g_slice.unit_node = NULL;
+        g_slice.unit_insert = NULL;
+        done = !work->cursor;
+    }
+    set_current_context(NULL);
+    g_slice.unit_scope = NULL;
+    g_slice.unit_context = NULL;
+
+    if (!entity && work->top_level) {
+        LOG_ERR_JSON(node, "Render Error: Failed to render top-level node. Aborting.");
+        g_slice.ok = false;
+        slice_clear();
+        return true;
+    }
+    if (!entity && !work->repeat) {
+        LOG_ERR_JSON(node, "Failed to render child node from 'children' attribute. Aborting siblings for this 'children' array.");
+    }
+    if (!entity && work->siblings) {
+        LOG_ERR_JSON(node, "Failed to render child node from 'children' attribute. Aborting siblings for this 'children' array.");
+        slice_unlink(work->siblings);
+        slice_work_free(work->siblings);
+    }
+    if (done || !entity) {
+        slice_unlink(work);
+        slice_work_free(work);
+    }
+    return true;
+}
+
+static void slice_finish(void) {
+    slice_clear();
+    if (g_slice.timer) lv_timer_delete(g_slice.timer);
+    mem_pass_end();
+    lvgl_json_render_done_cb_t done_cb = g_slice.done_cb;
+    void *user_data = g_slice.user_data;
+    bool ok = g_slice.ok;
+    memset(&g_slice, 0, sizeof(g_slice));
+    if (done_cb) done_cb(ok, user_data); // May start the next render
+}
+
+static void slice_timer_cb(lv_timer_t *timer) {
+    (void)timer;
+    lvgl_json_render_step(g_slice.budget_us);
+}
+
+bool lvgl_json_render_start(cJSON *root_json, lv_obj_t *implicit_root_parent, lvgl_json_render_done_cb_t done_cb, void *user_data) {
+    if (g_slice.active) {
+        LOG_ERR("Render Error: A time-sliced render is already running.");
+        return false;
+    }
+    if (!cJSON_IsArray(root_json) && !cJSON_IsObject(root_json)) {
+        LOG_ERR("Render Error: root_json must be a JSON object or array.");
+        return false;
+    }
+    lv_obj_t *parent = implicit_root_parent ? implicit_root_parent : lv_screen_active();
+    if (!parent) {
+        LOG_ERR("Render Error: Cannot get active screen.");
+        return false;
+    }
+    slice_work_t *work = NULL;
+    cJSON *first = cJSON_IsArray(root_json) ? root_json->child : root_json;
+    if (first) {
+        work = slice_work_new(parent, NULL);
+        if (!work) {
+            LOG_ERR("Render Error: Out of memory.");
+            return false;
+        }
+        work->cursor = first;
+        work->top_level = true;
+        work->next = NULL;
+        g_slice.stack = work;
+    }
+    g_slice.active = true;
+    g_slice.ok = true;
+    g_slice.done_cb = done_cb;
+    g_slice.user_data = user_data;
+    mem_pass_begin(); // Ends with the render: the LVGL heap snapshots span all steps
+    return true;
+}
+
+bool lvgl_json_render_step(uint32_t budget_us) {
+    if (!g_slice.active) return false;
+    uint32_t start_us = LVGL_JSON_RENDER_CLOCK_US();
+    uint32_t elapsed_us = 0;
+    render_scope_t *saved_scope = get_current_context();
+    render_arena_enter();
+    do {
+        uint32_t unit_start_us = LVGL_JSON_RENDER_CLOCK_US();
+        if (!slice_run_unit()) break;
+        uint32_t now_us = LVGL_JSON_RENDER_CLOCK_US();
+        uint32_t unit_us = now_us - unit_start_us;
+        g_slice.unit_peak_us -= g_slice.unit_peak_us / 8;
+        if (unit_us > g_slice.unit_peak_us) g_slice.unit_peak_us = unit_us;
+        elapsed_us = now_us - start_us;
+    } while (elapsed_us + g_slice.unit_peak_us < budget_us); // Stop before a unit is likely to overrun
+    render_arena_leave();
+    g_render_scope = saved_scope;
+
+    RENDER_STAT_INC(slice_steps);
+    if (elapsed_us > budget_us) RENDER_STAT_INC(slice_steps_over_budget);
+    if (elapsed_us > g_render_stats.slice_max_step_us) g_render_stats.slice_max_step_us = elapsed_us;
+    if (g_slice.stack || g_slice.offscreen) return true;
+    slice_finish();
+    return false;
+}
+
+bool lvgl_json_render_async(cJSON *root_json, lv_obj_t *implicit_root_parent, uint32_t budget_us,
+                            lvgl_json_render_done_cb_t done_cb, void *user_data) {
+    if (!lvgl_json_render_start(root_json, implicit_root_parent, done_cb, user_data)) return false;
+    g_slice.budget_us = budget_us;
+    g_slice.timer = lv_timer_create(slice_timer_cb, LVGL_JSON_RENDER_STEP_PERIOD_MS, NULL);
+    if (!g_slice.timer) {
+        LOG_ERR("Render Error: Cannot create the render timer.");
+        g_slice.done_cb = NULL;
+        slice_finish();
+        return false;
+    }
+    return true;
+}
+
+void lvgl_json_render_cancel(void) {
+    if (!g_slice.active) return;
+    g_slice.ok = false;
+    slice_finish();
+}
+
+bool lvgl_json_render_pending(void) {
+    return g_slice.active;
+}
+
+#endif // LVGL_JSON_USE_SLICING
+"""
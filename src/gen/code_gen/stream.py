@@ -0,0 +1,624 @@
+# code_gen/stream.py
+import logging
+
+logger = logging.getLogger(__name__)
+
+
+def generate_stream_renderer(custom_creators_map):
+    """
+    Generates lvgl_json_render_stream(), which renders a UI while it is being read.
+
+    A small pull tokenizer reads the spec in fixed-size chunks. Widget nodes are buffered only
+    up to their "children" array: at that point the node is created from the attributes seen so
+    far, its children are streamed one by one, and attributes that follow the array are applied
+    afterwards. Everything else ('component' definitions, 'use-view', property values, 'with'
+    blocks) is small and is buffered as cJSON and handed to the regular renderer, so peak memory
+    is bounded by nesting depth instead of spec size.
+    """
+    c_code = "// --- Streaming Renderer ---\n\n#if LVGL_JSON_USE_STREAM\n\n"
+    c_code += "// Types created by custom creators (not widgets, cannot have children)\n"
+    c_code += "static bool stream_is_managed_type(const char *type_str) {\n"
+    for type_name in custom_creators_map:
+        c_code += f"    if (strcmp(type_str, \"{type_name}\") == 0) return true;\n"
+    c_code += "    return false;\n"
+    c_code += "}\n"
+
+    c_code += r"""
+#ifndef LVGL_JSON_STREAM_CHUNK_SIZE
+#define LVGL_JSON_STREAM_CHUNK_SIZE 256
+#endif
+#ifndef LVGL_JSON_STREAM_MAX_DEPTH
+#define LVGL_JSON_STREAM_MAX_DEPTH 64
+#endif
+
+typedef struct {
+    lvgl_json_read_cb_t read_cb;
+    void *user_data;
+    char chunk[LVGL_JSON_STREAM_CHUNK_SIZE];
+    size_t chunk_len;
+    size_t chunk_pos;
+    bool eof;
+    bool error;             // Syntax error, read error or out of memory; stops everything
+    uint32_t line;
+    char *text;             // Last string token
+    size_t text_cap;
+} json_stream_t;
+
+static int js_peek(json_stream_t *s) {
+    if (s->chunk_pos == s->chunk_len) {
+        if (s->eof || s->error) return -1;
+        s->chunk_len = s->read_cb(s->user_data, s->chunk, sizeof(s->chunk));
+        s->chunk_pos = 0;
+        if (s->chunk_len == 0) {
+            s->eof = true;
+            return -1;
+        }
+    }
+    return (unsigned char)s->chunk[s->chunk_pos];
+}
+
+static int js_next(json_stream_t *s) {
+    int c = js_peek(s);
+    if (c >= 0) {
+        s->chunk_pos++;
+        if (c == '\n') s->line++;
+    }
+    return c;
+}
+
+static int js_skip_ws(json_stream_t *s) {
+    int c;
+    while ((c = js_peek(s)) == ' ' || c == '\t' || c == '\n' || c == '\r') js_next(s);
+    return c;
+}
+
+static void js_fail(json_stream_t *s, const char *what) {
+    if (!s->error) {
+        LOG_ERR("Stream Error: %s at line %u.", what, (unsigned)s->line);
+        s->error = true;
+    }
+}
+
+static bool js_expect(json_stream_t *s, int expected) {
+    if (js_skip_ws(s) != expected) {
+        js_fail(s, expected == ':' ? "Expected ':'" : "Unexpected character");
+        return false;
+    }
+    js_next(s);
+    return true;
+}
+
+// After a value inside an object/array: returns true if another one follows, false at the end.
+static bool js_more(json_stream_t *s, int close) {
+    int c = js_skip_ws(s);
+    if (c == ',') {
+        js_next(s);
+        return true;
+    }
+    if (c == close) {
+        js_next(s);
+        return false;
+    }
+    js_fail(s, close == '}' ? "Expected ',' or '}'" : "Expected ',' or ']'");
+    return false;
+}
+
+static bool js_text_append(json_stream_t *s, size_t *len, const char *data, size_t n) {
+    if (*len + n >= s->text_cap) {
+        size_t new_cap = s->text_cap ? s->text_cap : 64;
+        while (*len + n >= new_cap) new_cap *= 2;
+        char *text = (char *)mem_realloc(LVGL_JSON_MEM_TEMPORARY, s->text, s->text_cap, new_cap);
+        if (!text) {
+            js_fail(s, "Out of memory");
+            return false;
+        }
+        s->text = text;
+        s->text_cap = new_cap;
+    }
+    memcpy(s->text + *len, data, n);
+    *len += n;
+    return true;
+}
+
+static bool js_text_push(json_stream_t *s, size_t *len, char c) {
+    return js_text_append(s, len, &c, 1);
+}
+
+static bool js_read_hex4(json_stream_t *s, uint32_t *out) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; ++i) {
+        int c = js_next(s);
+        v <<= 4;
+        if (c >= '0' && c <= '9') v |= (uint32_t)(c - '0');
+        else if (c >= 'a' && c <= 'f') v |= (uint32_t)(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') v |= (uint32_t)(c - 'A' + 10);
+        else {
+            js_fail(s, "Invalid \\u escape");
+            return false;
+        }
+    }
+    *out = v;
+    return true;
+}
+
+// Reads a "\uXXXX" escape (the backslash and 'u' already consumed) and appends it as UTF-8.
+static bool js_read_unicode_escape(json_stream_t *s, size_t *len) {
+    uint32_t cp;
+    if (!js_read_hex4(s, &cp)) return false;
+    if (cp >= 0xD800 && cp <= 0xDBFF) {
+        uint32_t low;
+        if (js_next(s) != '\\' || js_next(s) != 'u' || !js_read_hex4(s, &low) || low < 0xDC00 || low > 0xDFFF) {
+            js_fail(s, "Invalid UTF-16 surrogate pair");
+            return false;
+        }
+        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+    } else if ((cp >= 0xDC00 && cp <= 0xDFFF) || cp == 0) {
+        js_fail(s, "Invalid \\u escape");
+        return false;
+    }
+    char utf8[4];
+    int n;
+    if (cp < 0x80) { utf8[0] = (char)cp; n = 1; }
+    else if (cp < 0x800) { utf8[0] = (char)(0xC0 | (cp >> 6)); utf8[1] = (char)(0x80 | (cp & 0x3F)); n = 2; }
+    else if (cp < 0x10000) { utf8[0] = (char)(0xE0 | (cp >> 12)); utf8[1] = (char)(0x80 | ((cp >> 6) & 0x3F)); utf8[2] = (char)(0x80 | (cp & 0x3F)); n = 3; }
+    else { utf8[0] = (char)(0xF0 | (cp >> 18)); utf8[1] = (char)(0x80 | ((cp >> 12) & 0x3F)); utf8[2] = (char)(0x80 | ((cp >> 6) & 0x3F)); utf8[3] = (char)(0x80 | (cp & 0x3F)); n = 4; }
+    for (int i = 0; i < n; ++i) {
+        if (!js_text_push(s, len, utf8[i])) return false;
+    }
+    return true;
+}
+
+// Reads a string token into s->text.
+static bool js_read_string(json_stream_t *s) {
+    size_t len = 0;
+    if (js_skip_ws(s) != '"') {
+        js_fail(s, "Expected string");
+        return false;
+    }
+    js_next(s);
+    for (;;) {
+        // Copy runs without escapes straight from the chunk
+        size_t run_end = s->chunk_pos;
+        while (run_end < s->chunk_len) {
+            unsigned char ch = (unsigned char)s->chunk[run_end];
+            if (ch == '"' || ch == '\\' || ch < 0x20) break;
+            run_end++;
+        }
+        if (run_end > s->chunk_pos) {
+            if (!js_text_append(s, &len, s->chunk + s->chunk_pos, run_end - s->chunk_pos)) return false;
+            s->chunk_pos = run_end;
+        }
+        int c = js_next(s);
+        if (c < 0) {
+            js_fail(s, "Unterminated string");
+            return false;
+        }
+        if (c == '"') break;
+        if (c < 0x20) {
+            js_fail(s, "Control character in string");
+            return false;
+        }
+        if (c == '\\') {
+            c = js_next(s);
+            switch (c) {
+                case '"': case '\\': case '/': break;
+                case 'b': c = '\b'; break;
+                case 'f': c = '\f'; break;
+                case 'n': c = '\n'; break;
+                case 'r': c = '\r'; break;
+                case 't': c = '\t'; break;
+                case 'u':
+                    if (!js_read_unicode_escape(s, &len)) return false;
+                    continue;
+                default:
+                    js_fail(s, "Invalid escape in string");
+                    return false;
+            }
+        }
+        if (!js_text_push(s, &len, (char)c)) return false;
+    }
+    return js_text_push(s, &len, '\0');
+}
+
+// Keeps the last string token (an object key) while the member's value is read: copied into
+// `local` if it fits, otherwise the token buffer itself is taken over and returned in *owned
+// (with its capacity in *owned_cap, for mem_free()).
+static const char* js_keep_text(json_stream_t *s, char *local, size_t local_size, char **owned, size_t *owned_cap) {
+    *owned = NULL;
+    *owned_cap = 0;
+    size_t len = strlen(s->text);
+    if (len < local_size) {
+        memcpy(local, s->text, len + 1);
+        return local;
+    }
+    *owned = s->text;
+    *owned_cap = s->text_cap;
+    s->text = NULL;
+    s->text_cap = 0;
+    return *owned;
+}
+
+// Parses a number or true/false/null.
+static cJSON* js_parse_scalar(json_stream_t *s) {
+    char token[64];
+    size_t len = 0;
+    int c;
+    while ((c = js_peek(s)) >= 0 && (c == '-' || c == '+' || c == '.' || (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || c == 'E')) {
+        if (len + 1 >= sizeof(token)) {
+            js_fail(s, "Token too long");
+            return NULL;
+        }
+        token[len++] = (char)js_next(s);
+    }
+    token[len] = '\0';
+    if (strcmp(token, "true") == 0) return cJSON_CreateTrue();
+    if (strcmp(token, "false") == 0) return cJSON_CreateFalse();
+    if (strcmp(token, "null") == 0) return cJSON_CreateNull();
+    char *end = NULL;
+    double number = strtod(token, &end);
+    if (len == 0 || *end != '\0') {
+        js_fail(s, "Invalid value");
+        return NULL;
+    }
+    return cJSON_CreateNumber(number);
+}
+
+// Parses a complete value into cJSON (used for everything that is not streamed).
+static cJSON* js_parse_value(json_stream_t *s, int depth) {
+    if (depth > LVGL_JSON_STREAM_MAX_DEPTH) {
+        js_fail(s, "Nesting too deep");
+        return NULL;
+    }
+    int c = js_skip_ws(s);
+    cJSON *item = NULL;
+    if (c == '{' || c == '[') {
+        bool is_object = (c == '{');
+        js_next(s);
+        item = is_object ? cJSON_CreateObject() : cJSON_CreateArray();
+        if (!item) {
+            js_fail(s, "Out of memory");
+            return NULL;
+        }
+        if (js_skip_ws(s) == (is_object ? '}' : ']')) {
+            js_next(s);
+            return item;
+        }
+        do {
+            char key_buf[64];
+            char *key_owned = NULL;
+            size_t key_owned_cap = 0;
+            const char *key = NULL;
+            if (is_object) {
+                if (!js_read_string(s)) {
+                    cJSON_Delete(item);
+                    return NULL;
+                }
+                key = js_keep_text(s, key_buf, sizeof(key_buf), &key_owned, &key_owned_cap);
+                if (!js_expect(s, ':')) {
+                    mem_free(LVGL_JSON_MEM_TEMPORARY, key_owned, key_owned_cap);
+                    cJSON_Delete(item);
+                    return NULL;
+                }
+            }
+            cJSON *member = js_parse_value(s, depth + 1);
+            if (member) {
+                if (is_object) cJSON_AddItemToObject(item, key, member);
+                else cJSON_AddItemToArray(item, member);
+            }
+            mem_free(LVGL_JSON_MEM_TEMPORARY, key_owned, key_owned_cap);
+            if (!member) {
+                cJSON_Delete(item);
+                return NULL;
+            }
+        } while (js_more(s, is_object ? '}' : ']'));
+    } else if (c == '"') {
+        if (!js_read_string(s)) return NULL;
+        item = cJSON_CreateString(s->text);
+    } else if (c < 0) {
+        js_fail(s, "Unexpected end of input");
+        return NULL;
+    } else {
+        item = js_parse_scalar(s);
+        if (!item && s->error) return NULL;
+    }
+    if (!item) {
+        js_fail(s, "Out of memory");
+        return NULL;
+    }
+    if (s->error) {
+        cJSON_Delete(item);
+        return NULL;
+    }
+    return item;
+}
+
+// Consumes a value without building it (siblings skipped after a failed child).
+static bool js_skip_value(json_stream_t *s, int depth) {
+    if (depth > LVGL_JSON_STREAM_MAX_DEPTH) {
+        js_fail(s, "Nesting too deep");
+        return false;
+    }
+    int c = js_skip_ws(s);
+    if (c == '{' || c == '[') {
+        bool is_object = (c == '{');
+        js_next(s);
+        if (js_skip_ws(s) == (is_object ? '}' : ']')) {
+            js_next(s);
+            return true;
+        }
+        do {
+            if (is_object && (!js_read_string(s) || !js_expect(s, ':'))) return false;
+            if (!js_skip_value(s, depth + 1)) return false;
+        } while (js_more(s, is_object ? '}' : ']'));
+        return !s->error;
+    }
+    if (c == '"') return js_read_string(s);
+    cJSON *scalar = js_parse_scalar(s);
+    cJSON_Delete(scalar);
+    return !s->error;
+}
+
+static const char* stream_node_type(cJSON *attrs) {
+    cJSON *type_item = cJSON_GetObjectItemCaseSensitive(attrs, "type");
+    return (type_item && cJSON_IsString(type_item)) ? type_item->valuestring : "obj";
+}
+
+// True if the node can be created before its children are known. Nodes that render their
+// content from elsewhere (components, views, context wrappers) or are no widgets are buffered.
+static bool stream_node_can_split(cJSON *attrs) {
+    const char *type_str = stream_node_type(attrs);
+    return strcmp(type_str, "component") != 0 && strcmp(type_str, "use-view") != 0 &&
+           strcmp(type_str, "context") != 0 && strcmp(type_str, "virtual-list") != 0 &&
+           strcmp(type_str, "for-each") != 0 && !stream_is_managed_type(type_str) &&
+           !lazy_requested(attrs);
+}
+
+// Path prefix for a split node's "named" attributes and children, as render_json_node() and
+// apply_setters_and_attributes() derive them. `node_path` receives the node's own path; both
+// results are released with registry_path_free().
+static void stream_node_paths(cJSON *attrs, cJSON *late_attrs, const char *named_path_prefix,
+                              char *node_buf, char *children_buf, char **node_path, char **children_path) {
+    const char *segment = NULL;
+    cJSON *id_item = cJSON_GetObjectItemCaseSensitive(attrs, "id");
+    if (id_item && cJSON_IsString(id_item) && id_item->valuestring && id_item->valuestring[0] == '@') {
+        segment = id_item->valuestring + 1;
+    }
+    *node_path = registry_path_join(node_buf, named_path_prefix, segment);
+
+    const char *named = NULL;
+    cJSON *lists[2] = { attrs, late_attrs };
+    for (int i = 0; i < 2; ++i) {
+        cJSON *item = NULL;
+        for (item = lists[i] ? lists[i]->child : NULL; item != NULL; item = item->next) {
+            if (!item->string || strcmp(item->string, "named") != 0 || !cJSON_IsString(item)) continue;
+            named = item->valuestring;
+        }
+    }
+    *children_path = registry_path_join(children_buf, *node_path, named);
+}
+
+static void* stream_render_node(json_stream_t *s, lv_obj_t *parent, const char *named_path_prefix, int depth);
+
+static void stream_render_children(json_stream_t *s, lv_obj_t *parent, const char *path, int depth) {
+    js_next(s); // '['
+    if (js_skip_ws(s) == ']') {
+        js_next(s);
+        return;
+    }
+    bool aborted = false;
+    do {
+        if (aborted) {
+            if (!js_skip_value(s, depth)) return;
+        } else if (stream_render_node(s, parent, path, depth) == NULL) {
+            if (s->error) return;
+            LOG_ERR("Failed to render child node from 'children' attribute (before line %u). Aborting siblings for this 'children' array.", (unsigned)s->line);
+            aborted = true;
+        }
+    } while (js_more(s, ']'));
+}
+
+static void* stream_render_node(json_stream_t *s, lv_obj_t *parent, const char *named_path_prefix, int depth) {
+    if (depth > LVGL_JSON_STREAM_MAX_DEPTH) {
+        js_fail(s, "Nesting too deep");
+        return NULL;
+    }
+    // Everything parsed for this node is released when it is done, which bounds the arena by depth.
+    render_arena_mark_t arena_mark = render_arena_mark();
+    if (js_skip_ws(s) != '{') {
+        // Not an object: let the regular renderer report it
+        cJSON *value = js_parse_value(s, depth);
+        if (!value) {
+            render_arena_rewind(arena_mark);
+            return NULL;
+        }
+        void *entity = render_json_node(value, parent, named_path_prefix);
+        cJSON_Delete(value);
+        render_arena_rewind(arena_mark);
+        return entity;
+    }
+    js_next(s);
+
+    cJSON *attrs = cJSON_CreateObject();      // Members before the first "children" array
+    cJSON *late_attrs = cJSON_CreateObject(); // Members after it, applied once the children exist
+    if (!attrs || !late_attrs) {
+        cJSON_Delete(attrs);
+        cJSON_Delete(late_attrs);
+        js_fail(s, "Out of memory");
+        render_arena_rewind(arena_mark);
+        return NULL;
+    }
+
+    void *entity = NULL;
+    bool created = false;   // Entity created before the end of the node
+    bool failed = false;    // Creation failed; the rest of the node is skipped
+    render_scope_t *saved_context = get_current_context();
+    render_scope_t context_scope;
+    bool context_set = false;
+    char node_path_buf[REGISTRY_PATH_BUF_SIZE];
+    char children_path_buf[REGISTRY_PATH_BUF_SIZE];
+    char *node_path = NULL;
+    char *children_path = NULL;
+
+    if (js_skip_ws(s) == '}') {
+        js_next(s);
+    } else do {
+        if (!js_read_string(s)) break;
+        char key_buf[64];
+        char *key_owned;
+        size_t key_owned_cap;
+        const char *key = js_keep_text(s, key_buf, sizeof(key_buf), &key_owned, &key_owned_cap);
+        if (!js_expect(s, ':')) {
+            mem_free(LVGL_JSON_MEM_TEMPORARY, key_owned, key_owned_cap);
+            break;
+        }
+        int c = js_skip_ws(s);
+
+        if (failed) {
+            js_skip_value(s, depth + 1);
+        } else if (strcmp(key, "children") == 0 && c == '[' && (created || stream_node_can_split(attrs))) {
+            if (!created) {
+                // Set the node's context here so that it also covers the streamed children.
+                cJSON *context_item = cJSON_GetObjectItemCaseSensitive(attrs, "context");
+                if (context_item && cJSON_IsObject(context_item)) {
+                    push_context(&context_scope, context_item);
+                    context_set = true;
+                }
+                entity = render_json_node(attrs, parent, named_path_prefix);
+                created = true;
+                failed = (entity == NULL);
+            }
+            if (failed) {
+                js_skip_value(s, depth + 1);
+            } else {
+                registry_path_free(children_path, children_path_buf);
+                registry_path_free(node_path, node_path_buf);
+                stream_node_paths(attrs, late_attrs, named_path_prefix, node_path_buf, children_path_buf, &node_path, &children_path);
+                stream_render_children(s, (lv_obj_t *)entity, children_path, depth + 1);
+            }
+        } else if (strcmp(key, "for") == 0 && c == '{' && !created && strcmp(stream_node_type(attrs), "context") == 0 &&
+                   cJSON_IsObject(cJSON_GetObjectItemCaseSensitive(attrs, "values"))) {
+            // Context wrapper: stream the wrapped node with the values active
+            push_context(&context_scope, cJSON_GetObjectItemCaseSensitive(attrs, "values"));
+            context_set = true;
+            entity = stream_render_node(s, parent, named_path_prefix, depth + 1);
+            created = true;
+            failed = (entity == NULL);
+        } else {
+            cJSON *value = js_parse_value(s, depth + 1);
+            if (value) {
+                if (created && (strcmp(key, "type") == 0 || strcmp(key, "id") == 0 || strcmp(key, "context") == 0)) {
+                    LOG_WARN_JSON(value, "Stream Warning: '%s' after 'children' is ignored.", key);
+                }
+                cJSON_AddItemToObject(created ? late_attrs : attrs, key, value);
+            }
+        }
+        mem_free(LVGL_JSON_MEM_TEMPORARY, key_owned, key_owned_cap);
+    } while (!s->error && js_more(s, '}'));
+
+    if (!s->error) {
+        if (!created) {
+            entity = render_json_node(attrs, parent, named_path_prefix);
+        } else if (!failed && late_attrs->child && strcmp(stream_node_type(attrs), "context") != 0) {
+            const char *actual_type_str = stream_node_type(attrs);
+            const char *create_type_str = actual_type_str;
+            if (strcmp(actual_type_str, "grid") == 0 || strcmp(actual_type_str, "with") == 0) create_type_str = "obj";
+            if (strcmp(actual_type_str, "with") == 0) actual_type_str = "obj";
+            char type_name_for_registry[64];
+            snprintf(type_name_for_registry, sizeof(type_name_for_registry), "lv_%s_t", create_type_str);
+            if (!apply_setters_and_attributes(late_attrs, entity, actual_type_str, create_type_str, true,
+                                              (lv_obj_t *)entity, node_path ? node_path : "", type_name_for_registry)) {
+                LOG_ERR_JSON(late_attrs, "Failed to apply attributes or process children for node type '%s'.", actual_type_str);
+            }
+        }
+    }
+
+    if (context_set) set_current_context(saved_context);
+    registry_path_free(children_path, children_path_buf);
+    registry_path_free(node_path, node_path_buf);
+    cJSON_Delete(attrs);
+    cJSON_Delete(late_attrs);
+    render_arena_rewind(arena_mark);
+    return (s->error || failed) ? NULL : entity;
+}
+
+static size_t stream_read_memory(void *user_data, char *buf, size_t buf_size) {
+    const char **cursor = (const char **)user_data;
+    size_t n = 0;
+    while (n < buf_size && (*cursor)[n] != '\0') n++;
+    memcpy(buf, *cursor, n);
+    *cursor += n;
+    return n;
+}
+
+bool lvgl_json_render_stream(lvgl_json_read_cb_t read_cb, void *user_data, lv_obj_t *implicit_root_parent) {
+    if (!read_cb) {
+        LOG_ERR("Render Error: read_cb is NULL.");
+        return false;
+    }
+    lv_obj_t *effective_parent = implicit_root_parent;
+    if (!effective_parent) {
+        LOG_WARN("Render Warning: implicit_root_parent is NULL. Using lv_screen_active().");
+        effective_parent = lv_screen_active();
+        if (!effective_parent) {
+            LOG_ERR("Render Error: Cannot get active screen.");
+            return false;
+        }
+    }
+
+    render_pass_begin();
+    json_stream_t *s = (json_stream_t *)render_scratch_alloc(sizeof(json_stream_t));
+    if (!s) {
+        LOG_ERR("Render Error: Failed to allocate stream state.");
+        render_pass_end();
+        return false;
+    }
+    memset(s, 0, sizeof(*s));
+    s->read_cb = read_cb;
+    s->user_data = user_data;
+    s->line = 1;
+
+    bool overall_success = true;
+    int c = js_skip_ws(s);
+    if (c == '[') {
+        js_next(s);
+        if (js_skip_ws(s) == ']') {
+            js_next(s);
+        } else do {
+            if (stream_render_node(s, effective_parent, NULL, 1) == NULL) {
+                if (!s->error) LOG_ERR("Render Error: Failed to render top-level node (before line %u). Aborting.", (unsigned)s->line);
+                overall_success = false;
+                break;
+            }
+        } while (js_more(s, ']'));
+    } else if (c == '{') {
+        overall_success = stream_render_node(s, effective_parent, NULL, 1) != NULL;
+    } else {
+        LOG_ERR("Render Error: root must be a JSON object or array.");
+        overall_success = false;
+    }
+    if (s->error) overall_success = false;
+
+    mem_free(LVGL_JSON_MEM_TEMPORARY, s->text, s->text_cap);
+    render_scratch_free(s, sizeof(json_stream_t));
+    render_pass_end();
+
+    if (!overall_success) {
+        LOG_ERR("UI Rendering failed.");
+    } else {
+        LOG_INFO("UI Rendering completed successfully.");
+    }
+    return overall_success;
+}
+
+bool lvgl_json_render_stream_str(const char *json_text, lv_obj_t *implicit_root_parent) {
+    if (!json_text) {
+        LOG_ERR("Render Error: json_text is NULL.");
+        return false;
+    }
+    const char *cursor = json_text;
+    return lvgl_json_render_stream(stream_read_memory, (void *)&cursor, implicit_root_parent);
+}
+
+#endif // LVGL_JSON_USE_STREAM
+"""
+    return c_code
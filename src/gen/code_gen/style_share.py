@@ -0,0 +1,303 @@
+# code_gen/style_share.py
+import logging
+
+logger = logging.getLogger(__name__)
+
+
+def generate_style_share():
+    """
+    Generates shared local styles (lvgl_json_set_style_sharing()).
+
+    Style properties given directly on a widget ('bg_color', 'pad_all', ...) normally become
+    lv_obj_set_style_<prop>() calls, so every widget carries its own local style. With sharing
+    on, the style properties of a widget are collected while its attributes are applied and
+    added at the end as one lv_style_t per selector with lv_obj_add_style(). Styles are kept in
+    a table keyed by their unmarshalled property values, so rows with identical styling all use
+    the same lv_style_t. Compiled programs collect constant properties when they are compiled.
+    """
+    return r"""
+// --- Shared Local Styles ---
+
+#if LVGL_JSON_STYLE_SHARING
+
+#define STYLE_SHARE_MAX_PROPS 16            // Style properties of one widget that can be shared
+#define STYLE_SHARE_MIN_CAPACITY 32
+#define STYLE_SHARE_SETTER_CACHE_SIZE 32    // Power of two
+
+typedef struct {
+    const invoke_table_entry_t *entry;      // lv_style_set_<prop>
+    invoke_value_t value;                   // Unmarshalled into a zeroed value, compared as .i
+} style_share_prop_t;
+
+typedef struct {
+    uint32_t hash;
+    uint32_t count;
+    lv_style_t style;
+    style_share_prop_t props[];             // The properties the style was built from
+} style_share_entry_t;
+
+// Style properties of the widget whose attributes are being applied
+typedef struct style_share_batch_s {
+    struct style_share_batch_s *next_free;
+    uint32_t count;
+    uint32_t local_count;
+    style_share_prop_t props[STYLE_SHARE_MAX_PROPS];
+    uint32_t selectors[STYLE_SHARE_MAX_PROPS];
+    const invoke_table_entry_t *local[STYLE_SHARE_MAX_PROPS]; // Style properties set on the widget itself
+} style_share_batch_t;
+
+static bool g_style_share_enabled = false;
+
+static struct {
+    style_share_entry_t **slots;            // Open addressing on the property hash
+    uint32_t capacity;
+    uint32_t count;
+    uint32_t bytes;                         // Entries plus the values LVGL stores in their styles
+    style_share_batch_t *free_batches;      // One per nesting level of widgets, reused
+} g_style_share;
+
+static struct {
+    const invoke_table_entry_t *setter;
+    const invoke_table_entry_t *style_setter;
+} g_style_share_setters[STYLE_SHARE_SETTER_CACHE_SIZE];
+
+void lvgl_json_set_style_sharing(bool enable) {
+    g_style_share_enabled = enable;
+}
+
+// lv_style_set_<prop> for an lv_obj_set_style_<prop> setter, NULL if the property cannot be shared.
+static const invoke_table_entry_t* style_share_style_setter(const invoke_table_entry_t *setter) {
+    static const char prefix[] = "lv_obj_set_style_";
+    uint32_t i = hash_finalize((uint32_t)((uintptr_t)setter >> 3)) & (STYLE_SHARE_SETTER_CACHE_SIZE - 1);
+    if (g_style_share_setters[i].setter == setter) return g_style_share_setters[i].style_setter;
+
+    const invoke_table_entry_t *style_setter = NULL;
+    if (setter->call && setter->arity == 3 && setter->first_json_arg == 1 && strncmp(setter->name, prefix, sizeof(prefix) - 1) == 0) {
+        // Strings may point into JSON that goes away; only values and registered pointers are compared
+        uint8_t base = TYPE_ID_BASE(setter->arg_type_ids[1]);
+        if (base != TYPE_ID_STRING && base != TYPE_ID_VOID_PTR && base != TYPE_ID_CHAR) {
+            char name[96];
+            snprintf(name, sizeof(name), "lv_style_set_%s", setter->name + sizeof(prefix) - 1);
+            style_setter = find_invoke_entry(name);
+            if (style_setter && (!style_setter->call || style_setter->arity != 2)) style_setter = NULL;
+        }
+    }
+    g_style_share_setters[i].setter = setter;
+    g_style_share_setters[i].style_setter = style_setter;
+    return style_setter;
+}
+
+static style_share_batch_t* style_share_batch_get(style_share_batch_t **batch) {
+    if (*batch) return *batch;
+    style_share_batch_t *b = g_style_share.free_batches;
+    if (b) {
+        g_style_share.free_batches = b->next_free;
+    } else {
+        b = (style_share_batch_t *)mem_alloc(LVGL_JSON_MEM_STYLES, sizeof(style_share_batch_t));
+        if (!b) return NULL;
+        RENDER_STAT_INC(heap_allocs);
+    }
+    b->count = 0;
+    b->local_count = 0;
+    *batch = b;
+    return b;
+}
+
+static void style_share_batch_release(style_share_batch_t *batch) {
+    if (!batch) return;
+    batch->next_free = g_style_share.free_batches;
+    g_style_share.free_batches = batch;
+}
+
+// Records that `setter` was called on the widget itself. A later value of the same property
+// must then be set locally too, or the local one would win.
+static void style_share_mark_local(style_share_batch_t **batch, const invoke_table_entry_t *setter) {
+    const invoke_table_entry_t *style_setter = style_share_style_setter(setter);
+    if (!style_setter || !style_share_batch_get(batch)) return;
+    style_share_batch_t *b = *batch;
+    for (uint32_t i = 0; i < b->local_count; ++i) {
+        if (b->local[i] == style_setter) return;
+    }
+    if (b->local_count < STYLE_SHARE_MAX_PROPS) b->local[b->local_count++] = style_setter;
+}
+
+// Takes `setter` with its unmarshalled value and selector into the batch. False if it has to be
+// called on the widget instead.
+static bool style_share_collect(style_share_batch_t **batch, const invoke_table_entry_t *setter, const invoke_value_t *values) {
+    const invoke_table_entry_t *style_setter = style_share_style_setter(setter);
+    if (!style_setter || !style_share_batch_get(batch)) return false;
+    style_share_batch_t *b = *batch;
+    for (uint32_t i = 0; i < b->local_count; ++i) {
+        if (b->local[i] == style_setter) return false;
+    }
+    if (b->count == STYLE_SHARE_MAX_PROPS) {
+        style_share_mark_local(batch, setter);
+        return false;
+    }
+    b->props[b->count].entry = style_setter;
+    b->props[b->count].value = values[0];
+    b->selectors[b->count] = (uint32_t)values[1].i;
+    b->count++;
+    return true;
+}
+
+// JSON arguments version of style_share_collect().
+static bool style_share_collect_json(style_share_batch_t **batch, const invoke_table_entry_t *setter, const invoke_args_t *args, void *target) {
+    if (!style_share_style_setter(setter)) return false;
+    invoke_value_t values[2];
+    memset(values, 0, sizeof(values));
+    if (args->count != 2 ||
+        !unmarshal_value(args->items[0], setter->arg_type_ids[1], setter->arg_types[1], &values[0], target) ||
+        !unmarshal_value(args->items[1], setter->arg_type_ids[2], setter->arg_types[2], &values[1], target)) {
+        // The setter reports the problem when it is called
+        style_share_mark_local(batch, setter);
+        return false;
+    }
+    return style_share_collect(batch, setter, values);
+}
+
+// Copies the properties of batch entry `first`'s selector into `group`. Returns their number,
+// 0 if an earlier entry had the same selector.
+static uint32_t style_share_group(const style_share_batch_t *batch, uint32_t first, style_share_prop_t *group) {
+    uint32_t selector = batch->selectors[first];
+    for (uint32_t i = 0; i < first; ++i) {
+        if (batch->selectors[i] == selector) return 0;
+    }
+    uint32_t count = 0;
+    for (uint32_t i = first; i < batch->count; ++i) {
+        if (batch->selectors[i] == selector) group[count++] = batch->props[i];
+    }
+    return count;
+}
+
+static uint32_t style_share_hash(const style_share_prop_t *props, uint32_t count) {
+    uint32_t hash = count;
+    for (uint32_t i = 0; i < count; ++i) {
+        uint64_t value = (uint64_t)props[i].value.i;
+        hash = hash * 31 + (uint32_t)((uintptr_t)props[i].entry >> 3);
+        hash = hash * 31 + (uint32_t)value;
+        hash = hash * 31 + (uint32_t)(value >> 32);
+    }
+    return hash_finalize(hash);
+}
+
+// Compared field by field, props may contain padding
+static bool style_share_equal(const style_share_prop_t *a, const style_share_prop_t *b, uint32_t count) {
+    if (a == b) return true;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (a[i].entry != b[i].entry || a[i].value.i != b[i].value.i) return false;
+    }
+    return true;
+}
+
+static bool style_share_grow(void) {
+    uint32_t capacity = g_style_share.capacity ? g_style_share.capacity * 2 : STYLE_SHARE_MIN_CAPACITY;
+    style_share_entry_t **slots = (style_share_entry_t **)mem_alloc(LVGL_JSON_MEM_STYLES, capacity * sizeof(style_share_entry_t *));
+    if (!slots) return false;
+    RENDER_STAT_INC(heap_allocs);
+    memset(slots, 0, capacity * sizeof(style_share_entry_t *));
+    for (uint32_t i = 0; i < g_style_share.capacity; ++i) {
+        style_share_entry_t *entry = g_style_share.slots[i];
+        if (!entry) continue;
+        uint32_t j = entry->hash & (capacity - 1);
+        while (slots[j]) j = (j + 1) & (capacity - 1);
+        slots[j] = entry;
+    }
+    mem_free(LVGL_JSON_MEM_STYLES, g_style_share.slots, g_style_share.capacity * sizeof(style_share_entry_t *));
+    g_style_share.slots = slots;
+    g_style_share.capacity = capacity;
+    return true;
+}
+
+// Shared style holding `props`, built on first use. NULL if out of memory.
+static lv_style_t* style_share_get(const style_share_prop_t *props, uint32_t count) {
+    uint32_t hash = style_share_hash(props, count);
+    uint32_t mask = g_style_share.capacity - 1;
+    for (uint32_t i = hash & mask; g_style_share.capacity && g_style_share.slots[i]; i = (i + 1) & mask) {
+        style_share_entry_t *entry = g_style_share.slots[i];
+        if (entry->hash == hash && entry->count == count && style_share_equal(entry->props, props, count)) return &entry->style;
+    }
+
+    if ((g_style_share.count + 1) * 4 > g_style_share.capacity * 3 && !style_share_grow()) return NULL;
+    size_t size = sizeof(style_share_entry_t) + count * sizeof(style_share_prop_t);
+    style_share_entry_t *entry = (style_share_entry_t *)mem_alloc(LVGL_JSON_MEM_STYLES, size);
+    if (!entry) return NULL;
+    RENDER_STAT_INC(heap_allocs);
+    entry->hash = hash;
+    entry->count = count;
+    memcpy(entry->props, props, count * sizeof(style_share_prop_t));
+    lv_style_init(&entry->style);
+    for (uint32_t i = 0; i < count; ++i) {
+        props[i].entry->call(props[i].entry, &entry->style, NULL, &props[i].value);
+    }
+    mask = g_style_share.capacity - 1;
+    uint32_t i = hash & mask;
+    while (g_style_share.slots[i]) i = (i + 1) & mask;
+    g_style_share.slots[i] = entry;
+    g_style_share.count++;
+    g_style_share.bytes += (uint32_t)(size + count * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t)));
+    return &entry->style;
+}
+
+// Adds the shared style for `props` to `obj`, or sets them as local styles if out of memory.
+static void style_share_add(lv_obj_t *obj, const style_share_prop_t *props, uint32_t count, uint32_t selector) {
+    lv_style_t *style = style_share_get(props, count);
+    if (!style) {
+        for (uint32_t i = 0; i < count; ++i) {
+            char name[96];
+            snprintf(name, sizeof(name), "lv_obj_set_style_%s", props[i].entry->name + sizeof("lv_style_set_") - 1);
+            const invoke_table_entry_t *setter = find_invoke_entry(name);
+            invoke_value_t values[2] = { props[i].value, { .i = selector } };
+            if (setter) setter->call(setter, obj, NULL, values);
+        }
+        return;
+    }
+    lv_obj_add_style(obj, style, selector);
+    RENDER_STAT_INC(shared_style_uses);
+    // What LVGL would have allocated for the local style: the style and its values
+    g_render_stats.local_style_bytes_saved += (uint32_t)(sizeof(lv_style_t) + count * (sizeof(lv_style_value_t) + sizeof(lv_style_prop_t)));
+}
+
+// Adds the batched properties to `obj`, one shared style per selector, and releases the batch.
+static void style_share_flush(style_share_batch_t *batch, lv_obj_t *obj) {
+    if (!batch) return;
+    style_share_prop_t group[STYLE_SHARE_MAX_PROPS];
+    for (uint32_t i = 0; i < batch->count; ++i) {
+        uint32_t count = style_share_group(batch, i, group);
+        if (count) style_share_add(obj, group, count, batch->selectors[i]);
+    }
+    style_share_batch_release(batch);
+}
+
+static void style_share_get_stats(lvgl_json_render_stats_t *out) {
+    out->shared_styles = g_style_share.count;
+    out->shared_style_bytes = g_style_share.bytes;
+}
+
+void lvgl_json_shared_styles_clear(void) {
+    for (uint32_t i = 0; i < g_style_share.capacity; ++i) {
+        style_share_entry_t *entry = g_style_share.slots[i];
+        if (!entry) continue;
+        lv_style_reset(&entry->style);
+        mem_free(LVGL_JSON_MEM_STYLES, entry, sizeof(style_share_entry_t) + entry->count * sizeof(style_share_prop_t));
+    }
+    mem_free(LVGL_JSON_MEM_STYLES, g_style_share.slots, g_style_share.capacity * sizeof(style_share_entry_t *));
+    while (g_style_share.free_batches) {
+        style_share_batch_t *next = g_style_share.free_batches->next_free;
+        mem_free(LVGL_JSON_MEM_STYLES, g_style_share.free_batches, sizeof(style_share_batch_t));
+        g_style_share.free_batches = next;
+    }
+    memset(&g_style_share, 0, sizeof(g_style_share));
+}
+
+#else
+
+void lvgl_json_set_style_sharing(bool enable) {
+    (void)enable;
+}
+
+void lvgl_json_shared_styles_clear(void) {
+}
+
+#endif // LVGL_JSON_STYLE_SHARING
+"""
@@ -1,11 +1,10 @@
 # code_gen/unmarshal.py
 import logging
 from type_utils import get_c_type_str, is_lvgl_struct_ptr, get_unmarshal_signature_type
+from . import perfect_hash
 
 logger = logging.getLogger(__name__)
 
-MAX_USER_ENUMS = 64 # Max user-defined enum mappings
-
 # Map C types to the specific unmarshal function names we will generate
 # *** Remove lv_coord_t from this map ***
 UNMARSHAL_FUNC_MAP = {
@@ -33,6 +32,26 @@ UNMARSHAL_FUNC_MAP = {
     # Enums are handled by unmarshal_enum_value
 }
 
+# TYPE_ID -> (unmarshal function, C type of dest) used by unmarshal_value's switch
+TYPE_ID_UNMARSHAL_FUNCS = [
+    ("TYPE_ID_INT", "unmarshal_int", "int"),
+    ("TYPE_ID_INT8", "unmarshal_int8", "int8_t"),
+    ("TYPE_ID_UINT8", "unmarshal_uint8", "uint8_t"),
+    ("TYPE_ID_INT16", "unmarshal_int16", "int16_t"),
+    ("TYPE_ID_UINT16", "unmarshal_uint16", "uint16_t"),
+    ("TYPE_ID_INT32", "unmarshal_int32", "int32_t"),
+    ("TYPE_ID_UINT32", "unmarshal_uint32", "uint32_t"),
+    ("TYPE_ID_INT64", "unmarshal_int64", "int64_t"),
+    ("TYPE_ID_UINT64", "unmarshal_uint64", "uint64_t"),
+    ("TYPE_ID_SIZE_T", "unmarshal_size_t", "size_t"),
+    ("TYPE_ID_OPA", "unmarshal_opa", "lv_opa_t"),
+    ("TYPE_ID_CHAR", "unmarshal_char", "char"),
+    ("TYPE_ID_BOOL", "unmarshal_bool", "bool"),
+    ("TYPE_ID_FLOAT", "unmarshal_float", "float"),
+    ("TYPE_ID_DOUBLE", "unmarshal_double", "double"),
+    ("TYPE_ID_COLOR", "unmarshal_color", "lv_color_t"),
+]
+
 # Function to generate the get_unmarshal_call string remains the same,
 # it will now call unmarshal_value for lv_coord_t, which will then dispatch correctly.
 def get_unmarshal_call(c_type, pointer_level, is_array, json_var_name, dest_var_name):
@@ -76,19 +95,41 @@ def get_unmarshal_call(c_type, pointer_level, is_array, json_var_name, dest_var_
 
 def generate_enum_unmarshalers(hashed_and_sorted_enum_members, all_enum_members_map_for_type_check):
     """
-    Generates C code for parsing enum strings using a hybrid approach:
-    1. A small, runtime-configurable user table (linear scan).
-    2. A large, pre-hashed, sorted table of generated enums (bsearch + strcmp for collisions).
+    Generates the enum/constant resolver used by unmarshal_enum_value():
+    1. Runtime user mappings in a growable hash table (checked first, so they can override).
+    2. The generated enum members behind a perfect hash (see code_gen/perfect_hash.py).
+
+    Values can combine names and numbers with '|' or come as arrays, which are ORed together.
 
     Args:
         hashed_and_sorted_enum_members (list): List of dicts, pre-sorted by hash then name.
             Each dict: {'name': str, 'value': int, 'hash': int, 'original_type_name': str}
-        all_enum_members_map_for_type_check (dict): The old map, can be used by unmarshal_value's
-                                                    heuristic if needed, but primary lookup is here.
+        all_enum_members_map_for_type_check (dict): Legacy name -> value map (unused).
     """
-    c_code = "// --- Enum Unmarshaling (Hybrid Hashed Approach) ---\n\n"
-
-    # --- 1. C Hash Function ---
+    # Enum type of each member for the optional type check; 0 = none (macros, anonymous enums)
+    members = []
+    seen = set()
+    type_index = {}
+    for member in hashed_and_sorted_enum_members:
+        if member['name'] in seen:
+            continue
+        seen.add(member['name'])
+        type_name = member['original_type_name']
+        if type_name in ("UNKNOWN_TYPE", "MACRO_FROM_STRING_VALUES"):
+            index = 0
+        else:
+            index = type_index.setdefault(type_name, len(type_index) + 1)
+        members.append((member, index))
+    ph = perfect_hash.build_perfect_hash([m['name'] for m, _ in members])
+
+    c_code = "// --- Enum Unmarshaling ---\n"
+    c_code += "// Names resolve through the user mappings first (they may override generated values), then a\n"
+    c_code += "// perfect hash over the generated members. \"A|B|0x10\" and [\"A\", \"B\"] are ORed into one value.\n\n"
+    c_code += "#ifndef LVGL_JSON_ENUM_TYPE_CHECK\n"
+    c_code += "#define LVGL_JSON_ENUM_TYPE_CHECK 0 // 1: reject members of another enum than the argument's\n"
+    c_code += "#endif\n\n"
+
+    # --- 1. Hash functions ---
     c_code += "static uint32_t djb2_hash_c(const char *str) {\n"
     c_code += "    uint32_t hash = 5381;\n"
     c_code += "    unsigned char c;\n" # Use unsigned char for safety with char values > 127
@@ -97,63 +138,180 @@ def generate_enum_unmarshalers(hashed_and_sorted_enum_members, all_enum_members_
     c_code += "    }\n"
     c_code += "    return hash;\n"
     c_code += "}\n\n"
+    c_code += "// djb2 of s[0..len), for names inside '|' expressions\n"
+    c_code += "static uint32_t djb2_hash_n(const char *s, size_t len) {\n"
+    c_code += "    uint32_t hash = 5381;\n"
+    c_code += "    for (size_t i = 0; i < len; ++i) hash = ((hash << 5) + hash) + (unsigned char)s[i];\n"
+    c_code += "    return hash;\n"
+    c_code += "}\n\n"
+    c_code += perfect_hash.generate_ph_mix_function()
 
     # --- 2. User-Defined Enum Table ---
-    c_code += "// User-defined enum mappings (runtime configurable)\n"
+    c_code += "// User-defined enum mappings (runtime configurable, open addressing, grows as needed)\n"
     c_code += "typedef struct {\n"
-    c_code += "    const char *name; // Copied string, user responsible for lifetime if not literal\n"
-    c_code += "    uint32_t hash;\n"
+    c_code += "    const char *name; // Interned\n"
+    c_code += "    uint32_t hash;    // djb2\n"
     c_code += "    int value;\n"
     c_code += "} user_enum_entry_t;\n\n"
-    c_code += f"static user_enum_entry_t g_user_enum_table[{MAX_USER_ENUMS}];\n"
-    c_code += f"static size_t g_num_user_enums = 0;\n\n"
+    c_code += "static user_enum_entry_t *g_user_enum_table = NULL;\n"
+    c_code += "static uint32_t g_user_enum_capacity = 0; // Power of two\n"
+    c_code += "static uint32_t g_num_user_enums = 0;\n\n"
+
+    c_code += "static user_enum_entry_t* user_enum_slot(user_enum_entry_t *table, uint32_t capacity, const char *s, size_t len, uint32_t hash) {\n"
+    c_code += "    uint32_t mask = capacity - 1;\n"
+    c_code += "    uint32_t i = hash_finalize(hash) & mask;\n"
+    c_code += "    while (table[i].name && !(table[i].hash == hash && strncmp(table[i].name, s, len) == 0 && table[i].name[len] == '\\0')) {\n"
+    c_code += "        i = (i + 1) & mask;\n"
+    c_code += "    }\n"
+    c_code += "    return &table[i];\n"
+    c_code += "}\n\n"
+
+    c_code += "static bool user_enum_grow(void) {\n"
+    c_code += "    uint32_t capacity = g_user_enum_capacity ? g_user_enum_capacity * 2 : 16;\n"
+    c_code += "    user_enum_entry_t *table = (user_enum_entry_t *)mem_alloc(LVGL_JSON_MEM_REGISTRY, capacity * sizeof(user_enum_entry_t));\n"
+    c_code += "    if (!table) return false;\n"
+    c_code += "    RENDER_STAT_INC(heap_allocs);\n"
+    c_code += "    memset(table, 0, capacity * sizeof(user_enum_entry_t));\n"
+    c_code += "    for (uint32_t i = 0; i < g_user_enum_capacity; ++i) {\n"
+    c_code += "        user_enum_entry_t *e = &g_user_enum_table[i];\n"
+    c_code += "        if (e->name) *user_enum_slot(table, capacity, e->name, strlen(e->name), e->hash) = *e;\n"
+    c_code += "    }\n"
+    c_code += "    mem_free(LVGL_JSON_MEM_REGISTRY, g_user_enum_table, g_user_enum_capacity * sizeof(user_enum_entry_t));\n"
+    c_code += "    g_user_enum_table = table;\n"
+    c_code += "    g_user_enum_capacity = capacity;\n"
+    c_code += "    return true;\n"
+    c_code += "}\n\n"
 
-    c_code += "// Function to add user-defined enum mappings (exposed via lvgl_json_renderer.h if needed)\n"
-    c_code += "// For now, keep it static. If exposing, ensure thread safety if applicable.\n"
     c_code += "bool lvgl_json_add_user_enum_mapping(const char* name, int value) {\n"
-    c_code += f"    if (g_num_user_enums >= {MAX_USER_ENUMS}) {{\n"
-    c_code += "        LOG_ERR(\"User enum table full. Cannot add '%s'.\", name);\n"
+    c_code += "    if (!name || !name[0]) return false;\n"
+    c_code += "    size_t len = strlen(name);\n"
+    c_code += "    if ((g_num_user_enums + 1) * 4 > g_user_enum_capacity * 3 && !user_enum_grow()) {\n"
+    c_code += "        LOG_ERR(\"User enum table: Out of memory, cannot add '%s'.\", name);\n"
     c_code += "        return false;\n"
     c_code += "    }\n"
-    c_code += "    // Consider if 'name' should be strdup'd if not a literal. For now, assume it's persistent.\n"
-    c_code += "    g_user_enum_table[g_num_user_enums].name = name; \n"
-    c_code += "    g_user_enum_table[g_num_user_enums].hash = djb2_hash_c(name);\n"
-    c_code += "    g_user_enum_table[g_num_user_enums].value = value;\n"
-    c_code += "    g_num_user_enums++;\n"
+    c_code += "    uint32_t hash = djb2_hash_n(name, len);\n"
+    c_code += "    user_enum_entry_t *slot = user_enum_slot(g_user_enum_table, g_user_enum_capacity, name, len, hash);\n"
+    c_code += "    if (!slot->name) {\n"
+    c_code += "        slot->name = str_pool_retain(name, len);\n"
+    c_code += "        if (!slot->name) {\n"
+    c_code += "            LOG_ERR(\"User enum table: Out of memory, cannot add '%s'.\", name);\n"
+    c_code += "            return false;\n"
+    c_code += "        }\n"
+    c_code += "        slot->hash = hash;\n"
+    c_code += "        g_num_user_enums++;\n"
+    c_code += "    }\n"
+    c_code += "    slot->value = value; // Adding a name again updates it\n"
     c_code += "    return true;\n"
     c_code += "}\n\n"
-    c_code += "void lvgl_json_clear_user_enum_mappings() {\n"
-    c_code += "    // If names were strdup'd, free them here.\n"
+    c_code += "void lvgl_json_clear_user_enum_mappings(void) {\n"
+    c_code += "    for (uint32_t i = 0; i < g_user_enum_capacity; ++i) {\n"
+    c_code += "        if (g_user_enum_table[i].name) str_pool_release(g_user_enum_table[i].name);\n"
+    c_code += "    }\n"
+    c_code += "    mem_free(LVGL_JSON_MEM_REGISTRY, g_user_enum_table, g_user_enum_capacity * sizeof(user_enum_entry_t));\n"
+    c_code += "    g_user_enum_table = NULL;\n"
+    c_code += "    g_user_enum_capacity = 0;\n"
     c_code += "    g_num_user_enums = 0;\n"
     c_code += "}\n\n"
 
-
     # --- 3. Generated (Hard-coded) Enum Table ---
-    c_code += "// Generated enum table (sorted by hash, then name)\n"
+    c_code += "// Enum types of the generated members (index 0: no type check)\n"
+    c_code += "static const char *const g_enum_type_names[] = {\n"
+    c_code += "    NULL,\n"
+    for type_name in type_index:
+        c_code += f"    \"{type_name}\",\n"
+    c_code += "};\n\n"
     c_code += "typedef struct {\n"
-    c_code += "    uint32_t hash;\n"
-    c_code += "    const char *original_name; // For collision resolution\n"
+    c_code += "    const char *name;\n"
     c_code += "    int c_value;\n"
-    c_code += "    // const char *original_type_name; // Optional: for type checking, adds to size\n"
+    c_code += "    uint16_t type_index; // Into g_enum_type_names\n"
     c_code += "} generated_enum_entry_t;\n\n"
 
     c_code += "static const generated_enum_entry_t g_generated_enum_table[] = {\n"
-    if not hashed_and_sorted_enum_members:
+    if not members:
         c_code += "    // No enum members were processed or included.\n"
-    for member in hashed_and_sorted_enum_members:
-        # Ensure name string is C-escaped if it could contain special chars (though unlikely for enum names)
-        c_code += f"    {{0x{member['hash']:08x}, \"{member['name']}\", {member['value']:#04x} }}, // Type: {member['original_type_name']}\n"
+    for member, index in members:
+        c_code += f"    {{\"{member['name']}\", {member['value']:#04x}, {index} }},\n"
     c_code += "};\n"
     c_code += "#define G_GENERATED_ENUM_TABLE_SIZE (sizeof(g_generated_enum_table) / sizeof(g_generated_enum_table[0]))\n\n"
+    c_code += "// Perfect hash index for g_generated_enum_table (generated, see code_gen/perfect_hash.py)\n"
+    c_code += perfect_hash.generate_ph_tables("g_enum", "ENUM", ph)
+    c_code += perfect_hash.generate_ph_find("g_enum", "ENUM", ph, "g_generated_enum_table[idx].name")
+
+    # --- 4. Lookup ---
+    c_code += "static const generated_enum_entry_t* generated_enum_find(const char *s, size_t len, uint32_t hash) {\n"
+    c_code += "    uint32_t idx = g_enum_ph_find(s, len, hash);\n"
+    c_code += "    return idx == ENUM_PH_EMPTY ? NULL : &g_generated_enum_table[idx];\n"
+    c_code += "}\n\n"
 
-    # --- 4. bsearch Comparator for Generated Table ---
-    c_code += "// Comparator for bsearch on g_generated_enum_table (compares only hash for initial range find)\n"
-    c_code += "static int compare_generated_enum_hash(const void *key_hash_ptr, const void *element_ptr) {\n"
-    c_code += "    uint32_t key_hash = *(const uint32_t*)key_hash_ptr;\n"
-    c_code += "    const generated_enum_entry_t *element = (const generated_enum_entry_t *)element_ptr;\n"
-    c_code += "    if (key_hash < element->hash) return -1;\n"
-    c_code += "    if (key_hash > element->hash) return 1;\n"
-    c_code += "    return 0; // Hashes match\n"
+    c_code += "// Resolves the name s[0..len) with djb2 `hash`. *enum_type receives the member's enum type, NULL if it has none.\n"
+    c_code += "static bool enum_lookup(const char *s, size_t len, uint32_t hash, int *value, const char **enum_type) {\n"
+    c_code += "    *enum_type = NULL;\n"
+    c_code += "    if (g_num_user_enums) {\n"
+    c_code += "        user_enum_entry_t *user = user_enum_slot(g_user_enum_table, g_user_enum_capacity, s, len, hash);\n"
+    c_code += "        if (user->name) {\n"
+    c_code += "            *value = user->value;\n"
+    c_code += "            return true;\n"
+    c_code += "        }\n"
+    c_code += "    }\n"
+    c_code += "    const generated_enum_entry_t *entry = generated_enum_find(s, len, hash);\n"
+    c_code += "    if (!entry) return false;\n"
+    c_code += "    *value = entry->c_value;\n"
+    c_code += "    *enum_type = g_enum_type_names[entry->type_index];\n"
+    c_code += "    return true;\n"
+    c_code += "}\n\n"
+
+    c_code += "#if LVGL_JSON_ENUM_TYPE_CHECK\n"
+    c_code += "// Integer arguments (e.g. style selectors) take any member; only enum arguments are checked.\n"
+    c_code += "static bool enum_type_is_generated(const char *type_name) {\n"
+    c_code += "    for (size_t i = 1; i < sizeof(g_enum_type_names) / sizeof(g_enum_type_names[0]); ++i) {\n"
+    c_code += "        if (strcmp(g_enum_type_names[i], type_name) == 0) return true;\n"
+    c_code += "    }\n"
+    c_code += "    return false;\n"
+    c_code += "}\n"
+    c_code += "#endif\n\n"
+
+    c_code += "// Parses \"NAME\" or \"NAME|NAME|0x10\" (blanks around '|' are allowed) into one value.\n"
+    c_code += "static bool enum_parse_expression(cJSON *json_value, const char *str, const char *expected_enum_type_name, int *dest) {\n"
+    c_code += "    int result = 0;\n"
+    c_code += "    const char *p = str;\n"
+    c_code += "    for (;;) {\n"
+    c_code += "        while (*p == ' ' || *p == '\\t') p++;\n"
+    c_code += "        const char *start = p;\n"
+    c_code += "        const char *end = p;\n"
+    c_code += "        uint32_t hash = 5381; // djb2 of the operand, computed while looking for its end\n"
+    c_code += "        for (; *p && *p != '|'; ++p) {\n"
+    c_code += "            if (*p == ' ' || *p == '\\t') continue;\n"
+    c_code += "            hash = ((hash << 5) + hash) + (unsigned char)*p;\n"
+    c_code += "            end = p + 1;\n"
+    c_code += "        }\n"
+    c_code += "        size_t len = (size_t)(end - start);\n"
+    c_code += "        int value = 0;\n"
+    c_code += "        const char *member_type = NULL;\n"
+    c_code += "        bool known;\n"
+    c_code += "        if (len > 0 && ((start[0] >= '0' && start[0] <= '9') || start[0] == '-')) {\n"
+    c_code += "            char *num_end = NULL;\n"
+    c_code += "            value = (int)strtol(start, &num_end, 0);\n"
+    c_code += "            known = (num_end == end);\n"
+    c_code += "        } else {\n"
+    c_code += "            known = len > 0 && enum_lookup(start, len, hash, &value, &member_type);\n"
+    c_code += "        }\n"
+    c_code += "        if (!known) {\n"
+    c_code += "            LOG_ERR_JSON(json_value, \"Enum Unmarshal Error: Unknown string value '%.*s' for enum type '%s'\", (int)len, start, expected_enum_type_name ? expected_enum_type_name : \"unknown\");\n"
+    c_code += "            return false;\n"
+    c_code += "        }\n"
+    c_code += "#if LVGL_JSON_ENUM_TYPE_CHECK\n"
+    c_code += "        if (member_type && expected_enum_type_name && strcmp(member_type, expected_enum_type_name) != 0 &&\n"
+    c_code += "            enum_type_is_generated(expected_enum_type_name)) {\n"
+    c_code += "            LOG_ERR_JSON(json_value, \"Enum Unmarshal Error: '%.*s' is a %s, expected %s\", (int)len, start, member_type, expected_enum_type_name);\n"
+    c_code += "            return false;\n"
+    c_code += "        }\n"
+    c_code += "#endif\n"
+    c_code += "        result |= value;\n"
+    c_code += "        if (!*p) break;\n"
+    c_code += "        p++; // Skip '|'\n"
+    c_code += "    }\n"
+    c_code += "    *dest = result;\n"
+    c_code += "    return true;\n"
     c_code += "}\n\n"
 
     # --- 5. The unmarshal_enum_value function ---
@@ -165,61 +323,23 @@ def generate_enum_unmarshalers(hashed_and_sorted_enum_members, all_enum_members_
     c_code += "        *dest = (int)json_value->valuedouble;\n"
     c_code += "        return true;\n"
     c_code += "    }\n\n"
+    c_code += "    // Flag lists: [\"LV_OBJ_FLAG_A\", \"LV_OBJ_FLAG_B\"]\n"
+    c_code += "    if (cJSON_IsArray(json_value)) {\n"
+    c_code += "        int result = 0;\n"
+    c_code += "        cJSON *item;\n"
+    c_code += "        cJSON_ArrayForEach(item, json_value) {\n"
+    c_code += "            int value;\n"
+    c_code += "            if (!unmarshal_enum_value(item, expected_enum_type_name, &value)) return false;\n"
+    c_code += "            result |= value;\n"
+    c_code += "        }\n"
+    c_code += "        *dest = result;\n"
+    c_code += "        return true;\n"
+    c_code += "    }\n\n"
     c_code += "    if (!cJSON_IsString(json_value) || !json_value->valuestring) {\n"
     c_code += "       LOG_ERR_JSON(json_value, \"Enum Unmarshal Error: Expected string or number for enum type '%s', got type %d\", expected_enum_type_name ? expected_enum_type_name : \"unknown\", json_value->type);\n"
     c_code += "       return false;\n"
     c_code += "    }\n"
-    c_code += "    const char *str_value = json_value->valuestring;\n"
-    c_code += "    uint32_t input_hash = djb2_hash_c(str_value);\n\n"
-
-    c_code += "    // 1. Search user-defined table first (allows overriding generated)\n"
-    c_code += "    for (size_t i = 0; i < g_num_user_enums; ++i) {\n"
-    c_code += "        if (g_user_enum_table[i].hash == input_hash) {\n"
-    c_code += "            if (strcmp(g_user_enum_table[i].name, str_value) == 0) {\n"
-    c_code += "                *dest = g_user_enum_table[i].value;\n"
-    c_code += "                return true;\n"
-    c_code += "            }\n"
-    c_code += "        }\n"
-    c_code += "    }\n\n"
-
-    c_code += "    // 2. Search generated table using bsearch + strcmp for collisions\n"
-    c_code += "    if (G_GENERATED_ENUM_TABLE_SIZE > 0) { // Only search if table is not empty\n"
-    c_code += "        const generated_enum_entry_t *found_any_hash_match = (const generated_enum_entry_t *)bsearch(\n"
-    c_code += "            &input_hash,\n"
-    c_code += "            g_generated_enum_table,\n"
-    c_code += "            G_GENERATED_ENUM_TABLE_SIZE,\n"
-    c_code += "            sizeof(generated_enum_entry_t),\n"
-    c_code += "            compare_generated_enum_hash);\n\n"
-    c_code += "        if (found_any_hash_match) {\n"
-    c_code += "            // bsearch found an element with matching hash. Now check original_name for exact match.\n"
-    c_code += "            // Since table is sorted by hash then name, all collisions are contiguous.\n"
-    c_code += "            // Iterate backwards from found_any_hash_match.\n"
-    c_code += "            const generated_enum_entry_t *current_entry = found_any_hash_match;\n"
-    c_code += "            while (current_entry >= g_generated_enum_table && current_entry->hash == input_hash) {\n"
-    c_code += "                if (strcmp(current_entry->original_name, str_value) == 0) {\n"
-    c_code += "                    // Optional: Check if current_entry->original_type_name matches expected_enum_type_name if type safety is critical\n"
-    c_code += "                    *dest = current_entry->c_value;\n"
-    c_code += "                    return true;\n"
-    c_code += "                }\n"
-    c_code += "                // Optimization: if original_name is already \"lesser\" than str_value (and table is sorted by name within hash groups), we can stop early for this direction\n"
-    c_code += "                // but simple iteration is fine.\n"
-    c_code += "                if (current_entry == g_generated_enum_table) break; // Boundary condition for first element\n"
-    c_code += "                current_entry--;\n"
-    c_code += "            }\n\n"
-    c_code += "            // Iterate forwards from found_any_hash_match + 1 (found_any_hash_match itself was checked or was part of backward scan if it was the first match)\n"
-    c_code += "            current_entry = found_any_hash_match + 1;\n"
-    c_code += "            while (current_entry < (g_generated_enum_table + G_GENERATED_ENUM_TABLE_SIZE) && current_entry->hash == input_hash) {\n"
-    c_code += "                if (strcmp(current_entry->original_name, str_value) == 0) {\n"
-    c_code += "                    *dest = current_entry->c_value;\n"
-    c_code += "                    return true;\n"
-    c_code += "                }\n"
-    c_code += "                current_entry++;\n"
-    c_code += "            }\n"
-    c_code += "        }\n"
-    c_code += "    }\n\n"
-
-    c_code += "    LOG_ERR_JSON(json_value, \"Enum Unmarshal Error: Unknown string value '%s' for enum type '%s' (hash 0x%08x)\", str_value, expected_enum_type_name ? expected_enum_type_name : \"unknown\", input_hash);\n"
-    c_code += "    return false;\n"
+    c_code += "    return enum_parse_expression(json_value, json_value->valuestring, expected_enum_type_name, dest);\n"
     c_code += "}\n\n"
 
     return c_code
@@ -411,9 +531,7 @@ def generate_custom_unmarshalers(api_info):
     code += f"}}\n\n"
 
     code += "// Context Value ($variable_name)\n"
-    code += "static cJSON* get_current_context(void); // Forward declaration from renderer code\n"
-    code += "// unmarshal_value is also forward declared later or should be available\n\n"
-    code += "static bool unmarshal_context_value(cJSON *json_source_node, const char *expected_c_type, void *dest) {\n"
+    code += "static bool unmarshal_context_value(cJSON *json_source_node, uint8_t type_id, const char *expected_c_type, void *dest) {\n"
     code += "    if (!cJSON_IsString(json_source_node) || !json_source_node->valuestring || json_source_node->valuestring[0] != '$') {\n"
     code += "        LOG_ERR_JSON(json_source_node, \"Context Unmarshal Error: Expected string starting with '$'\");\n"
     code += "        return false;\n"
@@ -423,23 +541,19 @@ def generate_custom_unmarshalers(api_info):
     code += "        LOG_ERR_JSON(json_source_node, \"Context Unmarshal Error: Empty variable name after '$'.\");\n"
     code += "        return false;\n"
     code += "    }\n\n"
-    code += "    cJSON *current_ctx = get_current_context();\n"
-    code += "    if (!current_ctx) {\n"
+    code += "    if (!get_current_context()) {\n"
     code += "        LOG_ERR_JSON(json_source_node, \"Context Unmarshal Error: No context active for variable '%s'.\", var_name);\n"
     code += "        return false;\n"
     code += "    }\n\n"
-    code += "    cJSON *value_from_context = cJSON_GetObjectItemCaseSensitive(current_ctx, var_name);\n"
+    code += "    // Innermost scope first, so inner contexts shadow outer ones\n"
+    code += "    render_scope_t *defining_scope = NULL;\n"
+    code += "    cJSON *value_from_context = context_lookup(var_name, &defining_scope);\n"
     code += "    if (!value_from_context) {\n"
     code += "        LOG_ERR_JSON(json_source_node, \"Context Unmarshal Error: Variable '%s' not found in current context.\", var_name);\n"
-    # Log the current context for debugging
-    # code += "        char* ctx_str = json_node_to_string(current_ctx);\n"
-    # code += "        LOG_DEBUG(\"Current context for failed lookup of '%s': %s\", var_name, ctx_str ? ctx_str : \"N/A\");\n"
-    # code += "        if (ctx_str) cJSON_free(ctx_str);\n"
     code += "        return false;\n"
     code += "    }\n\n"
-    code += "    // Recursively call unmarshal_value with the node found in the context\n"
-    code += "    // This allows context values to be numbers, strings, booleans, or even other context/pointer refs.\n"
-    code += "    if (!unmarshal_value(value_from_context, expected_c_type, dest, NULL)) {\n"
+    code += "    // Context values can be numbers, strings, booleans, or even other context/pointer refs.\n"
+    code += "    if (!context_unmarshal_value(value_from_context, defining_scope, type_id, expected_c_type, dest)) {\n"
     # unmarshal_value would have logged the specific error
     code += "        LOG_ERR_JSON(json_source_node, \"Context Unmarshal Error: Failed to unmarshal context variable '%s' as type '%s'.\", var_name, expected_c_type);\n"
     code += "        return false;\n"
@@ -460,7 +574,7 @@ def generate_main_unmarshaler():
     code += "static bool unmarshal_color(cJSON *node, lv_color_t *dest);\n"
     code += "static bool unmarshal_coord(cJSON *node, lv_coord_t *dest);\n" # Added forward decl
     code += "static bool unmarshal_registered_ptr(cJSON *node, const char* expected_ptr_type, void **dest);\n"
-    code += "static bool unmarshal_context_value(cJSON *json_source_node, const char *expected_c_type, void *dest);\n"
+    code += "static bool unmarshal_context_value(cJSON *json_source_node, uint8_t type_id, const char *expected_c_type, void *dest);\n"
     # Add forwards for all primitive unmarshalers generated
     code += "static bool unmarshal_int(cJSON *node, int *dest);\n"
     code += "static bool unmarshal_int8(cJSON *node, int8_t *dest);\n"
@@ -480,14 +594,29 @@ def generate_main_unmarshaler():
     code += "static bool unmarshal_char(cJSON *node, char *dest);\n"
 
     code += "\n"
-    code += "// The core dispatcher for unmarshaling any value from JSON based on expected C type.\n"
-    code += "static bool unmarshal_value(cJSON *json_value, const char *expected_c_type, void *dest, void *implicit_parent) {\n"
-    code += "    if (!json_value || !expected_c_type || !dest) {\n"
+    code += "// True for the integer type ids; strings passed for these are looked up as enum/constant names.\n"
+    code += "static inline bool type_id_is_integer(uint8_t base_type_id) {\n"
+    code += "    return base_type_id >= TYPE_ID_INT && base_type_id <= TYPE_ID_OPA;\n"
+    code += "}\n\n"
+
+    code += "static bool unmarshal_value_body(cJSON *json_value, uint8_t type_id, const char *expected_c_type, void *dest, void *implicit_parent);\n\n"
+    code += "// The core dispatcher for unmarshaling any value from JSON based on the expected type.\n"
+    code += "// type_id selects the conversion; expected_c_type is only used for '@' registry type checks and messages.\n"
+    code += "static bool unmarshal_value(cJSON *json_value, uint8_t type_id, const char *expected_c_type, void *dest, void *implicit_parent) {\n"
+    code += "    PROFILE_SPAN_BEGIN(span);\n"
+    code += "    bool ok = unmarshal_value_body(json_value, type_id, expected_c_type, dest, implicit_parent);\n"
+    code += "    PROFILE_SPAN_END(span, PROFILE_CAT_UNMARSHAL, expected_c_type ? expected_c_type : \"?\", json_value ? json_value->string : NULL);\n"
+    code += "    return ok;\n"
+    code += "}\n\n"
+    code += "static bool unmarshal_value_body(cJSON *json_value, uint8_t type_id, const char *expected_c_type, void *dest, void *implicit_parent) {\n"
+    code += "    if (!json_value || !dest) {\n"
     code += "        LOG_ERR(\"Unmarshal Error: NULL argument passed to unmarshal_value (%p, %s, %p)\", json_value, expected_c_type ? expected_c_type : \"NULL\", dest);\n"
     code += "        return false;\n"
-    code += "     }\n\n"
+    code += "     }\n"
+    code += "    if (!expected_c_type) expected_c_type = \"?\";\n"
+    code += "    uint8_t base_type_id = TYPE_ID_BASE(type_id);\n\n"
 
-    code += "    if (cJSON_IsNull(json_value) && strcmp(expected_c_type, \"void *\") == 0) {\n"
+    code += "    if (cJSON_IsNull(json_value) && base_type_id == TYPE_ID_VOID_PTR) {\n"
     code += "      *((char **) dest) = NULL;\n"
     code += "      return true;\n"
     code += "    }\n\n"
@@ -503,15 +632,19 @@ def generate_main_unmarshaler():
     code += "                LOG_ERR_JSON(json_value, \"Unmarshal Error: Nested call function '%s' not found in invoke table.\", func_name);\n"
     code += "                return false;\n"
     code += "            }\n"
-    code += "            size_t args = 0; for (args = 0; entry->arg_types[args] != NULL; ++args) {}\n"
+    code += "            invoke_args_t call_args;\n"
+    code += "            invoke_args_init(&call_args, args_item);\n"
     code += "            lv_obj_t *target_obj_ptr = NULL;\n"
-    code += "            if (entry->arg_types[0] && strcmp(entry->arg_types[0], \"lv_obj_t *\") == 0 && cJSON_GetArraySize(args_item) < args) { target_obj_ptr = implicit_parent; }\n" 
+    code += "            if (entry->arity > 0 && entry->arg_type_ids[0] == TYPE_ID_OBJ_PTR && call_args.count < entry->arity) { target_obj_ptr = implicit_parent; }\n"
     code += "            // Make the nested call. Result goes into 'dest'. target_obj_ptr is NULL.\n"
-    code += "            if (!entry->invoke(entry, target_obj_ptr, dest, args_item)) {\n"
+    code += "            PROFILE_SPAN_BEGIN(call_span);\n"
+    code += "            bool called = entry->invoke(entry, target_obj_ptr, dest, &call_args);\n"
+    code += "            PROFILE_SPAN_END(call_span, PROFILE_CAT_INVOKE, entry->name, json_value->string);\n"
+    code += "            if (!called) {\n"
     code += "                 LOG_ERR_JSON(json_value, \"Unmarshal Error: Nested call to '%s' failed.\", func_name);\n"
     code += "                 return false;\n"
     code += "            }\n"
-    # TODO: Check if return type of nested call matches expected_c_type? Requires more info.
+    # TODO: Check if return type of nested call matches expected type? Requires more info.
     code += "            return true; // Nested call successful\n"
     code += "        }\n"
     code += "        // If it's an object but not a 'call' object, it's an error unless expecting a specific struct type?\n"
@@ -527,7 +660,7 @@ def generate_main_unmarshaler():
     code += "        if (len) {\n"
     code += "            if (len > 2 && str_val[len - 1] == '%') {\n"
     code += "               if (str_val[len - 2] != '%') {\n"
-    code += "                 if (strcmp(expected_c_type, \"lv_coord_t\") == 0 || strcmp(expected_c_type, \"int32_t\") == 0) {\n"
+    code += "                 if (base_type_id == TYPE_ID_INT32) {\n"
     code += "                     return unmarshal_coord(json_value, (lv_coord_t *)dest);\n"
     code += "                 } else {\n"
     code += "                     LOG_ERR_JSON(json_value, \"Unmarshal Error: Found percent string '%s' but expected type '%s'\", str_val, expected_c_type);\n"
@@ -538,7 +671,7 @@ def generate_main_unmarshaler():
     code += "               }\n"
     code += "            }\n"
     code += "            if (str_val[0] == '#') {\n"
-    code += "               if (strcmp(expected_c_type, \"lv_color_t\") == 0) {\n"
+    code += "               if (base_type_id == TYPE_ID_COLOR) {\n"
     code += "                   return unmarshal_color(json_value, (lv_color_t*)dest);\n"
     code += "               } else {\n"
     code += "                   LOG_ERR_JSON(json_value, \"Unmarshal Error: Found color string '%s' but expected type '%s'\", str_val, expected_c_type);\n"
@@ -549,20 +682,12 @@ def generate_main_unmarshaler():
     code += "            if (str_val[0] == '@') {\n"
     code += "               if (str_val[len - 1] != '@') {\n"
     code += "                 return unmarshal_registered_ptr(json_value, expected_c_type, (void**)dest);\n"
-    #                         Too many special cases and type-defs for this simlpe check to work
-    # code += "                 // Ensure expected type is some kind of pointer or a special component type\n"
-    # code += "                 if (strchr(expected_c_type, '*') || strcmp(expected_c_type, \"component_json_node\") == 0) {\n"
-    # code += "                      return unmarshal_registered_ptr(json_value, expected_c_type, (void**)dest);\n"
-    # code += "                 } else {\n"
-    # code += "                     LOG_ERR_JSON(json_value, \"Unmarshal Error: Found registered pointer string '%s' but expected non-pointer type '%s'\", str_val, expected_c_type);\n"
-    # code += "                     //return false;\n"
-    # code += "                 }\n"
     code += "               } else { str_val[--len] = '\\0'; }\n"
     code += "            }\n"
     code += "            // Check for '!' (registered, static string) prefix\n"
     code += "            if (str_val[0] == '!') {\n"
     code += "               if (str_val[len - 1] != '!') {\n"
-    code += "                 if (strcmp(expected_c_type, \"const char *\") == 0 || strcmp(expected_c_type, \"char *\") == 0) {\n"
+    code += "                 if (base_type_id == TYPE_ID_STRING) {\n"
     code += "                      const char *res = NULL; unmarshal_string_ptr(json_value, (const char **) &res);\n"
     code += "                      *((char **) dest) = lvgl_json_register_str(res + 1);\n"
     code += "                      LOG_INFO(\"Unmarshaled static string '%s'\", res);\n"
@@ -577,76 +702,47 @@ def generate_main_unmarshaler():
     code += "            if (str_val[0] == '$') {\n"
     code += "                if (str_val[len - 1] == '$') {\n"
     code += "                   str_val[--len] = '\\0';\n"
-    code += "                } else { return unmarshal_context_value(json_value, expected_c_type, dest); }\n"
+    code += "                } else { return unmarshal_context_value(json_value, type_id, expected_c_type, dest); }\n"
     code += "            }\n"
-    code += "        }\n"
+    code += "        }\n\n"
 
     # --- String Fallback Handling (Enums or Regular Strings) ---
-    code += "        // If no prefix, it could be an enum name or a regular string.\n"
-    code += "        // Try enum first if the type looks like an LVGL type/typedef\n"
-    code += "        // Heuristic: Check if expected_c_type looks like an enum name (e.g. lv_align_t, LV_...)\n"
-    code += "        // We need a reliable way to know if expected_c_type IS an enum.\n"
-    code += "        // For now, let's try enum unmarshal if it looks like lv_..._t or LV_..._T\n"
-    code += "        bool maybe_enum = (strncmp(expected_c_type, \"lv_\", 3) == 0 && strstr(expected_c_type, \"_t\")) || \n"
-    code += "                          (strncmp(expected_c_type, \"LV_\", 3) == 0 && strstr(expected_c_type, \"_T\")) || \n"
-    code += "                          (strncmp(expected_c_type, \"int\", 3) == 0) || (strncmp(expected_c_type, \"uint\", 4) == 0);\n"
-    code += "        if (maybe_enum && strcmp(expected_c_type, \"lv_obj_t\") != 0 && strcmp(expected_c_type, \"lv_style_t\") != 0 /* add other known non-enums */) {\n"
+    code += "        // If no prefix, it is an enum/constant name for integer types or a regular string.\n"
+    code += "        if ((type_id & TYPE_ID_ENUM_BIT) || type_id_is_integer(base_type_id)) {\n"
     code += "            if (unmarshal_enum_value(json_value, expected_c_type, (int*)dest)) {\n"
     code += "                 return true; // Successfully parsed as enum string\n"
     code += "            }\n"
-    code += "            // If unmarshal_enum_value failed, it logged the error. Fall through?\n"
-    code += "            // Maybe don't fall through, enum name was expected but invalid.\n"
-    code += "            LOG_WARN_JSON(json_value, \"Enum parse failed for '%s' as type %s, falling back to string?\", str_val, expected_c_type);\n"
-    code += "            // return false; // Strict: If it looked like an enum, it must parse as one.\n"
+    code += "            LOG_WARN_JSON(json_value, \"Enum parse failed for '%s' as type %s\", str_val, expected_c_type);\n"
+    code += "            return false;\n"
     code += "        }\n\n"
 
-    code += "        // Finally, try as a regular string pointer if expected type is `const char *` (or rarely void * - DANGER!)\n"
-    code += "        if (strcmp(expected_c_type, \"const char *\") == 0 || strcmp(expected_c_type, \"char *\") == 0 || strcmp(expected_c_type, \"void *\") == 0) {\n"
-    code += "             return unmarshal_string_ptr(json_value, (const char **)dest);\n"
-    code += "        }\n"
-
-    code += "        // If it's a string but none of the above matched, it's an error.\n"
-    code += "        // Except if expecting lv_coord_t, handled below.\n"
-    code += "        if (strcmp(expected_c_type, \"lv_coord_t\") != 0) { // Don't error here for coord % strings\n"
-    code += "           LOG_ERR_JSON(json_value, \"Unmarshal Error: Got string '%s' but couldn't interpret as color, ptr, enum, or expected string type '%s'\", str_val, expected_c_type);\n"
-    code += "           return false;\n"
+    code += "        switch (base_type_id) {\n"
+    code += "            case TYPE_ID_STRING:\n"
+    code += "            case TYPE_ID_VOID_PTR: // Rarely what is wanted - DANGER!\n"
+    code += "                return unmarshal_string_ptr(json_value, (const char **)dest);\n"
+    code += "            case TYPE_ID_CHAR:\n"
+    code += "                return unmarshal_char(json_value, (char *)dest);\n"
+    code += "            default:\n"
+    code += "                LOG_ERR_JSON(json_value, \"Unmarshal Error: Got string '%s' but couldn't interpret as color, ptr, enum, or expected string type '%s'\", str_val, expected_c_type);\n"
+    code += "                return false;\n"
     code += "        }\n"
     code += "    }\n\n" # End of cJSON_IsString block
 
-
-    code += "    // 3. Dispatch based on explicitly known C types\n"
-    code += "    if (strcmp(expected_c_type, \"lv_coord_t\") == 0) {\n"
-    code += "        return unmarshal_coord(json_value, (lv_coord_t*)dest);\n"
+    code += "    // 3. Dispatch based on the type id\n"
+    code += "    // Arrays for integer arguments are flag lists\n"
+    code += "    if ((type_id & TYPE_ID_ENUM_BIT) || (cJSON_IsArray(json_value) && type_id_is_integer(base_type_id))) {\n"
+    code += "        return unmarshal_enum_value(json_value, expected_c_type, (int*)dest);\n"
     code += "    }\n"
-    # Add lv_color_t here too for completeness, although '#' prefix usually catches it.
-    code += "    else if (strcmp(expected_c_type, \"lv_color_t\") == 0) {\n"
-    code += "        return unmarshal_color(json_value, (lv_color_t*)dest);\n"
-    code += "    }\n"
-    # Check other base types defined in UNMARSHAL_FUNC_MAP
-    first = True
-    for ctype, funcname in UNMARSHAL_FUNC_MAP.items():
-         # Skip types already handled (color, pointers implicitly, coord explicitly)
-         if ctype == "lv_color_t" or "*" in ctype: continue
-         code += f"    else if (strcmp(expected_c_type, \"{ctype}\") == 0) {{\n"
-         code += f"        return {funcname}(json_value, ({ctype.replace('const ', '')}*)dest);\n"
-         code += f"    }}\n"
-         first = False # Not strictly needed as we use else if
-
-    # --- Final Fallback / Error ---
-    code += "    else {\n"
-    code += "        // We might reach here if:\n"
-    code += "        // - expected_c_type is an enum not caught by the heuristic string check above.\n"
-    code += "        // - expected_c_type is a pointer not using '@' syntax.\n"
-    code += "        // - expected_c_type is an unhandled struct/union/etc.\n"
-    code += "        // Let's try one last time to parse as an enum if it looks like one.\n"
-    code += "        bool maybe_enum = (strncmp(expected_c_type, \"lv_\", 3) == 0 && strstr(expected_c_type, \"_t\")) || \n"
-    code += "                          (strncmp(expected_c_type, \"LV_\", 3) == 0 && strstr(expected_c_type, \"_T\"))  || strcmp(expected_c_type, \"uint32_t\") == 0;\n"
-    code += "        if (maybe_enum && strcmp(expected_c_type, \"lv_obj_t\") != 0 /* add others */) {\n"
-    code += "             if (unmarshal_enum_value(json_value, expected_c_type, (int*)dest)) return true;\n"
-    code += "        }\n\n"
-    code += "        LOG_ERR_JSON(json_value, \"Unmarshal Error: Unhandled expected C type '%s' or invalid JSON value type (%d)\", expected_c_type, json_value->type);\n"
-    code += "        return false;\n"
+    code += "    switch (base_type_id) {\n"
+    for type_id, func, c_type in TYPE_ID_UNMARSHAL_FUNCS:
+        code += f"        case {type_id}: return {func}(json_value, ({c_type}*)dest);\n"
+    code += "        case TYPE_ID_STRING: return unmarshal_string_ptr(json_value, (const char **)dest);\n"
+    code += "        default:\n"
+    code += "            // - pointers not using '@' syntax\n"
+    code += "            // - unhandled structs/unions/etc.\n"
+    code += "            LOG_ERR_JSON(json_value, \"Unmarshal Error: Unhandled expected C type '%s' or invalid JSON value type (%d)\", expected_c_type, json_value->type);\n"
+    code += "            return false;\n"
     code += "    }\n"
     code += "}\n\n"
 
-    return code
\ No newline at end of file
+    return code
@@ -0,0 +1,402 @@
+# code_gen/virtual_list.py
+import logging
+
+logger = logging.getLogger(__name__)
+
+
+def generate_virtual_list():
+    """
+    Generates the 'virtual-list' node: a scrollable container that shows `count` items through
+    a few recycled rows rendered from a component.
+
+    Only the rows in the viewport plus `overscan` above and below exist. Item i is shown by
+    row slot i % slot_count; when scrolling moves an item into a slot, the slot is bound to it:
+    the data source fills an object with the item's values, and the row's properties that use
+    '$' variables are applied again with that object as context. Rows whose component cannot be
+    re-bound property by property (nested views, '$' in 'named', 'with' or add_ calls) are
+    rendered again instead. Either way the widget count depends on the viewport, not on `count`.
+    """
+    return r"""
+// --- Virtual Lists ---
+
+#define VLIST_NO_INDEX UINT32_MAX
+
+typedef struct {
+    const cJSON *node;          // Node of the row component that uses '$' variables
+    cJSON *patch;               // References to those properties, applied when a row is bound
+    const char *actual_type;    // Points into the component's JSON
+    const char *create_type;
+} vlist_binding_t;
+
+typedef struct {
+    lv_obj_t *obj;              // Row root, NULL until first needed
+    uint32_t index;             // Item shown, VLIST_NO_INDEX if none
+} vlist_slot_t;
+
+typedef struct vlist_s {
+    struct vlist_s *next;
+    lv_obj_t *obj;
+    component_def_t *component;
+    lvgl_json_list_source_cb_t source;
+    void *source_user_data;
+    uint32_t count;
+    int32_t row_height;
+    uint32_t overscan;
+    const char *path;           // Interned path prefix of the rows
+    vlist_slot_t *slots;        // Followed by slot_count * binding_count widgets the bindings apply to
+    uint32_t slot_count;
+    vlist_binding_t *bindings;
+    uint32_t binding_count;
+    size_t patch_bytes;         // Accounted to LVGL_JSON_MEM_OTHER with the bindings
+    bool rerender;              // Rows are rendered again instead of re-bound
+    bool updating;
+} vlist_t;
+
+static vlist_t *g_vlists; // Every virtual list alive, newest first
+
+static bool vlist_has_variable(const cJSON *value) {
+    if (cJSON_IsString(value)) return value->valuestring[0] == '$' && value->valuestring[1] != '$';
+    const cJSON *item = NULL;
+    cJSON_ArrayForEach(item, value) {
+        if (vlist_has_variable(item)) return true;
+    }
+    return false;
+}
+
+// Collects the nodes of the row component whose properties depend on the item.
+static bool vlist_plan(vlist_t *list, const cJSON *node) {
+    if (!cJSON_IsObject(node)) return true;
+    cJSON *type_item = cJSON_GetObjectItemCaseSensitive(node, "type");
+    const char *type_str = cJSON_IsString(type_item) ? type_item->valuestring : "obj";
+    // Views and wrappers render nodes that are not part of this tree
+    if (strcmp(type_str, "use-view") == 0 || strcmp(type_str, "context") == 0 || strcmp(type_str, "component") == 0 ||
+        strcmp(type_str, "virtual-list") == 0 || strcmp(type_str, "style") == 0 || lazy_requested((cJSON *)node)) {
+        list->rerender = true;
+        return true;
+    }
+    cJSON *patch = NULL;
+    const cJSON *item = NULL;
+    cJSON_ArrayForEach(item, node) {
+        if (strcmp(item->string, "children") == 0 || !vlist_has_variable(item)) continue;
+        if (live_attr_is_structural(item->string)) {
+            cJSON_Delete(patch);
+            list->rerender = true;
+            return true;
+        }
+        if (!patch && !(patch = cJSON_CreateObject())) return false;
+        cJSON_AddItemReferenceToObject(patch, item->string, (cJSON *)item);
+        list->patch_bytes += sizeof(cJSON) + strlen(item->string) + 1;
+    }
+    if (patch) {
+        vlist_binding_t *bindings = (vlist_binding_t *)mem_realloc(LVGL_JSON_MEM_OTHER, list->bindings,
+            list->binding_count * sizeof(vlist_binding_t), (list->binding_count + 1) * sizeof(vlist_binding_t));
+        if (!bindings) {
+            cJSON_Delete(patch);
+            return false;
+        }
+        list->bindings = bindings;
+        vlist_binding_t *binding = &bindings[list->binding_count++];
+        binding->node = node;
+        binding->patch = patch;
+        binding->actual_type = type_str;
+        binding->create_type = strcmp(type_str, "grid") == 0 ? "obj" : type_str;
+        list->patch_bytes += sizeof(cJSON);
+    }
+    cJSON *children = cJSON_GetObjectItemCaseSensitive(node, "children");
+    cJSON_ArrayForEach(item, children) {
+        if (!vlist_plan(list, item)) return false;
+    }
+    return true;
+}
+
+static void vlist_free_bindings(vlist_t *list) {
+    for (uint32_t i = 0; i < list->binding_count; ++i) cJSON_Delete(list->bindings[i].patch);
+    mem_free(LVGL_JSON_MEM_OTHER, list->bindings, list->binding_count * sizeof(vlist_binding_t));
+    list->bindings = NULL;
+    list->binding_count = 0;
+}
+
+static size_t vlist_slots_bytes(uint32_t slot_count, uint32_t binding_count) {
+    return slot_count * (sizeof(vlist_slot_t) + binding_count * sizeof(lv_obj_t *));
+}
+
+// Widgets of a slot's row that its bindings apply to, NULL where the row has none.
+static lv_obj_t** vlist_slot_objs(vlist_t *list, uint32_t slot) {
+    return (lv_obj_t **)&list->slots[list->slot_count] + (size_t)slot * list->binding_count;
+}
+
+// Renders a row, recording the widgets its bindings apply to.
+static lv_obj_t* vlist_create_row(vlist_t *list, uint32_t slot) {
+    live_map_t capture;
+    memset(&capture, 0, sizeof(capture));
+    live_map_t *saved_capture = g_live_capture;
+    g_live_capture = list->rerender || !list->binding_count ? NULL : &capture;
+    lv_obj_t *row = (lv_obj_t *)render_json_node(list->component->root, list->obj, list->path);
+    g_live_capture = saved_capture;
+    for (uint32_t i = 0; row && i < list->binding_count; ++i) {
+        live_node_t *rec = live_map_find(&capture, list->bindings[i].node);
+        if (rec && rec->shared) list->rerender = true; // Bound node shared through an alias: which widget is it?
+        vlist_slot_objs(list, slot)[i] = rec ? rec->obj : NULL;
+    }
+    live_map_clear(&capture);
+    return row;
+}
+
+static void vlist_bind(vlist_t *list, uint32_t slot_index, uint32_t index) {
+    vlist_slot_t *slot = &list->slots[slot_index];
+    render_arena_enter(); // Not a render pass: scrolling should not take LVGL heap snapshots
+    cJSON *item = cJSON_CreateObject();
+    if (item) {
+        cJSON_AddNumberToObject(item, "index", (double)index);
+        if (list->source) list->source(index, item, list->source_user_data);
+    }
+    render_scope_t *saved_scope = get_current_context();
+    render_scope_t scope;
+    if (item) push_context(&scope, item);
+
+    if (slot->obj && list->rerender) {
+        lv_obj_delete(slot->obj);
+        slot->obj = NULL;
+    }
+    if (!slot->obj) {
+        slot->obj = vlist_create_row(list, slot_index);
+    } else {
+#if LVGL_JSON_STYLE_SHARING
+        // Values set again go on top of the row's styles, not into another shared style
+        bool saved_style_sharing = g_style_share_enabled;
+        g_style_share_enabled = false;
+#endif
+        for (uint32_t i = 0; i < list->binding_count; ++i) {
+            vlist_binding_t *binding = &list->bindings[i];
+            lv_obj_t *obj = vlist_slot_objs(list, slot_index)[i];
+            if (!obj) continue;
+            char type_name_for_registry[64];
+            snprintf(type_name_for_registry, sizeof(type_name_for_registry), "lv_%s_t", binding->create_type);
+            apply_setters_and_attributes(binding->patch, obj, binding->actual_type, binding->create_type, true,
+                                         obj, list->path, type_name_for_registry);
+        }
+#if LVGL_JSON_STYLE_SHARING
+        g_style_share_enabled = saved_style_sharing;
+#endif
+    }
+    set_current_context(saved_scope);
+    render_arena_leave();
+
+    slot->index = slot->obj ? index : VLIST_NO_INDEX;
+    if (slot->obj) {
+        lv_obj_set_y(slot->obj, (int32_t)index * list->row_height);
+        lv_obj_set_height(slot->obj, list->row_height);
+        lv_obj_remove_flag(slot->obj, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+static bool vlist_grow(vlist_t *list, uint32_t slot_count) {
+    size_t objs_count = (size_t)list->slot_count * list->binding_count;
+    vlist_slot_t *slots = (vlist_slot_t *)mem_realloc(LVGL_JSON_MEM_OTHER, list->slots,
+        vlist_slots_bytes(list->slot_count, list->binding_count), vlist_slots_bytes(slot_count, list->binding_count));
+    if (!slots) return false;
+    lv_obj_t **objs = (lv_obj_t **)&slots[slot_count];
+    memmove(objs, &slots[list->slot_count], objs_count * sizeof(lv_obj_t *));
+    memset(objs + objs_count, 0, ((size_t)slot_count * list->binding_count - objs_count) * sizeof(lv_obj_t *));
+    memset(&slots[list->slot_count], 0, (slot_count - list->slot_count) * sizeof(vlist_slot_t));
+    // Items map to other slots now: bind every row again
+    for (uint32_t i = 0; i < slot_count; ++i) slots[i].index = VLIST_NO_INDEX;
+    list->slots = slots;
+    list->slot_count = slot_count;
+    return true;
+}
+
+// Shows the items in and around the viewport, binding the slots that show a different item.
+static void vlist_update(vlist_t *list) {
+    int32_t view_height = lv_obj_get_content_height(list->obj);
+    if (view_height <= 0 || list->updating) return; // Not laid out yet
+    list->updating = true; // Moving rows must not re-enter through scroll events
+
+    uint32_t needed = (uint32_t)(view_height / list->row_height) + 2 + 2 * list->overscan;
+    if (needed > list->count) needed = list->count;
+    if (needed > list->slot_count && !vlist_grow(list, needed)) {
+        LOG_ERR("Virtual List Error: Out of memory for %u rows.", (unsigned)needed);
+    }
+
+    int32_t scroll_y = lv_obj_get_scroll_y(list->obj);
+    uint32_t first = scroll_y > 0 ? (uint32_t)(scroll_y / list->row_height) : 0;
+    first = first > list->overscan ? first - list->overscan : 0;
+    if (list->count < list->slot_count) {
+        first = 0;
+    } else if (first > list->count - list->slot_count) {
+        first = list->count - list->slot_count;
+    }
+    for (uint32_t i = 0; i < list->slot_count; ++i) {
+        vlist_slot_t *slot = &list->slots[i];
+        if (slot->obj && slot->index != VLIST_NO_INDEX && slot->index >= list->count) {
+            lv_obj_add_flag(slot->obj, LV_OBJ_FLAG_HIDDEN);
+            slot->index = VLIST_NO_INDEX;
+        }
+    }
+    uint32_t end = first + list->slot_count < list->count ? first + list->slot_count : list->count;
+    for (uint32_t index = first; index < end; ++index) {
+        uint32_t slot = index % list->slot_count;
+        if (list->slots[slot].index != index) vlist_bind(list, slot, index);
+    }
+    list->updating = false;
+}
+
+static void vlist_event_cb(lv_event_t *e) {
+    vlist_t *list = (vlist_t *)lv_event_get_user_data(e);
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_GET_SELF_SIZE) {
+        lv_point_t *size = (lv_point_t *)lv_event_get_param(e);
+        int64_t height = (int64_t)list->count * list->row_height;
+        size->y = LV_MAX(size->y, (int32_t)LV_MIN(height, (int64_t)INT32_MAX));
+    } else if (code == LV_EVENT_SCROLL || code == LV_EVENT_SIZE_CHANGED) {
+        vlist_update(list);
+    } else if (code == LV_EVENT_DELETE) {
+        for (vlist_t **link = &g_vlists; *link; link = &(*link)->next) {
+            if (*link == list) {
+                *link = list->next;
+                break;
+            }
+        }
+        mem_free(LVGL_JSON_MEM_OTHER, list->slots, vlist_slots_bytes(list->slot_count, list->binding_count));
+        mem_unaccount(LVGL_JSON_MEM_OTHER, list->patch_bytes);
+        vlist_free_bindings(list);
+        str_pool_release(list->path);
+        mem_free(LVGL_JSON_MEM_OTHER, list, sizeof(vlist_t));
+    }
+}
+
+static vlist_t* vlist_find(lv_obj_t *obj) {
+    for (vlist_t *list = g_vlists; list; list = list->next) {
+        if (list->obj == obj) return list;
+    }
+    return NULL;
+}
+
+static bool vlist_is_own_attribute(const char *name) {
+    static const char *const names[] = { "type", "row", "count", "source", "row_height", "overscan", "children" };
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+        if (strcmp(name, names[i]) == 0) return true;
+    }
+    return false;
+}
+
+// Renders a 'virtual-list' node: an lv_obj container with the node's other properties.
+static void* vlist_render(cJSON *node, lv_obj_t *parent, const char *named_path_prefix) {
+    cJSON *row_item = cJSON_GetObjectItemCaseSensitive(node, "row");
+    component_def_t *component = NULL;
+    if (cJSON_IsString(row_item) && row_item->valuestring[0] == '@') {
+        component = (component_def_t *)lvgl_json_get_registered_ptr(row_item->valuestring + 1, "component_def");
+    }
+    if (!component) {
+        LOG_ERR_JSON(node, "Virtual List Error: 'row' must name a component ('@name').");
+        return NULL;
+    }
+    uint32_t count = 0, overscan = LVGL_JSON_VLIST_OVERSCAN;
+    int32_t row_height = 0;
+    cJSON *count_item = cJSON_GetObjectItemCaseSensitive(node, "count");
+    cJSON *overscan_item = cJSON_GetObjectItemCaseSensitive(node, "overscan");
+    if ((count_item && !unmarshal_value(count_item, TYPE_ID_UINT32, "uint32_t", &count, parent)) ||
+        (overscan_item && !unmarshal_value(overscan_item, TYPE_ID_UINT32, "uint32_t", &overscan, parent)) ||
+        !unmarshal_value(cJSON_GetObjectItemCaseSensitive(node, "row_height"), TYPE_ID_INT32, "int32_t", &row_height, parent) ||
+        row_height <= 0) {
+        LOG_ERR_JSON(node, "Virtual List Error: Needs a positive 'row_height'; 'count' and 'overscan' must be numbers.");
+        return NULL;
+    }
+    lvgl_json_list_source_cb_t source = NULL;
+    cJSON *source_item = cJSON_GetObjectItemCaseSensitive(node, "source");
+    if (source_item) {
+        if (cJSON_IsString(source_item) && source_item->valuestring[0] == '@') {
+            source = (lvgl_json_list_source_cb_t)lvgl_json_get_registered_ptr(source_item->valuestring + 1, "lvgl_json_list_source_cb_t");
+        }
+        if (!source) LOG_WARN_JSON(node, "Virtual List Warning: 'source' is not a registered lvgl_json_list_source_cb_t. Rows get $index only.");
+    }
+    if (cJSON_GetObjectItemCaseSensitive(node, "children")) {
+        LOG_WARN_JSON(node, "Virtual List Warning: 'children' is ignored, rows are rendered from 'row'.");
+    }
+
+    lv_obj_t *obj = lv_obj_create(parent);
+    if (!obj) return NULL;
+    mem_count_widget("virtual-list");
+    render_arena_suspend(); // The row bindings live as long as the list
+    vlist_t *list = (vlist_t *)mem_alloc(LVGL_JSON_MEM_OTHER, sizeof(vlist_t));
+    bool planned = false;
+    if (list) {
+        memset(list, 0, sizeof(*list));
+        planned = vlist_plan(list, component->root);
+    }
+    render_arena_resume();
+    if (planned && list->rerender) {
+        vlist_free_bindings(list); // Rows are rendered again on every bind
+        list->patch_bytes = 0;
+    }
+    if (!planned) {
+        if (list) vlist_free_bindings(list);
+        mem_free(LVGL_JSON_MEM_OTHER, list, sizeof(vlist_t));
+        lv_obj_delete(obj);
+        LOG_ERR_JSON(node, "Virtual List Error: Out of memory.");
+        return NULL;
+    }
+    RENDER_STAT_INC(heap_allocs);
+    mem_account(LVGL_JSON_MEM_OTHER, list->patch_bytes);
+    list->obj = obj;
+    list->component = component;
+    list->source = source;
+    list->count = count;
+    list->row_height = row_height;
+    list->overscan = overscan;
+    list->path = str_pool_retain(named_path_prefix ? named_path_prefix : "", named_path_prefix ? strlen(named_path_prefix) : 0);
+    list->next = g_vlists;
+    g_vlists = list;
+    lv_obj_add_event_cb(obj, vlist_event_cb, LV_EVENT_SCROLL, list);
+    lv_obj_add_event_cb(obj, vlist_event_cb, LV_EVENT_SIZE_CHANGED, list);
+    lv_obj_add_event_cb(obj, vlist_event_cb, LV_EVENT_GET_SELF_SIZE, list);
+    lv_obj_add_event_cb(obj, vlist_event_cb, LV_EVENT_DELETE, list);
+    lv_obj_set_scroll_dir(obj, LV_DIR_VER);
+
+    // Everything else ('named', size, styles, ...) applies to the container
+    cJSON *attrs = cJSON_CreateObject();
+    cJSON *item = NULL;
+    cJSON_ArrayForEach(item, node) {
+        if (attrs && !vlist_is_own_attribute(item->string)) cJSON_AddItemReferenceToObject(attrs, item->string, item);
+    }
+    bool ok = attrs && apply_setters_and_attributes(attrs, obj, "obj", "obj", true, obj, named_path_prefix, "lv_obj_t");
+    cJSON_Delete(attrs);
+    lv_obj_refresh_self_size(obj);
+    vlist_update(list); // Sizes in pixels are known already; otherwise on the first layout
+    return ok ? obj : NULL;
+}
+
+bool lvgl_json_virtual_list_set_source(lv_obj_t *list_obj, lvgl_json_list_source_cb_t source, void *user_data) {
+    vlist_t *list = vlist_find(list_obj);
+    if (!list) return false;
+    list->source = source;
+    list->source_user_data = user_data;
+    lvgl_json_virtual_list_refresh(list_obj);
+    return true;
+}
+
+bool lvgl_json_virtual_list_set_count(lv_obj_t *list_obj, uint32_t count) {
+    vlist_t *list = vlist_find(list_obj);
+    if (!list) return false;
+    list->count = count;
+    lv_obj_refresh_self_size(list_obj);
+    vlist_update(list);
+    return true;
+}
+
+bool lvgl_json_virtual_list_refresh(lv_obj_t *list_obj) {
+    vlist_t *list = vlist_find(list_obj);
+    if (!list) return false;
+    for (uint32_t i = 0; i < list->slot_count; ++i) {
+        if (list->slots[i].index != VLIST_NO_INDEX) vlist_bind(list, i, list->slots[i].index);
+    }
+    return true;
+}
+
+lv_obj_t *lvgl_json_virtual_list_get_row(lv_obj_t *list_obj, uint32_t index) {
+    vlist_t *list = vlist_find(list_obj);
+    if (!list || !list->slot_count) return NULL;
+    vlist_slot_t *slot = &list->slots[index % list->slot_count];
+    return slot->index == index ? slot->obj : NULL;
+}
+"""
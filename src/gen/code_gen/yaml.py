@@ -0,0 +1,1049 @@
+# code_gen/yaml.py
+import logging
+
+logger = logging.getLogger(__name__)
+
+
+def generate_yaml_code():
+    """
+    Generates lvgl_json_parse_yaml(), the YAML front-end: YAML text straight to the cJSON tree the
+    renderer takes, without converting to JSON text first.
+
+    A recursive descent parser over the text for the YAML that UI specs are written in: block
+    mappings and sequences, flow collections, plain, quoted and block scalars, comments and the
+    1.2 core schema. Repeated keys are kept in order, like cJSON does. An alias becomes a cJSON
+    reference to its anchored node, so aliased subtrees are shared instead of copied, and merge
+    keys ('<<') add references to the merged members.
+    """
+    return r"""
+// --- YAML front-end ---
+
+#if LVGL_JSON_USE_YAML
+
+#include <math.h> // For INFINITY, NAN
+
+#ifndef LVGL_JSON_YAML_MAX_DEPTH
+#define LVGL_JSON_YAML_MAX_DEPTH 64
+#endif
+#ifndef LVGL_JSON_YAML_MAX_MERGES
+#define LVGL_JSON_YAML_MAX_MERGES 8 // Merge keys ('<<') per mapping
+#endif
+
+typedef struct {
+    const char *name;       // Points into the text
+    size_t len;
+    cJSON *node;            // NULL once the node was merged away
+} yaml_anchor_t;
+
+typedef struct {
+    const char *cur;
+    const char *end;
+    const char *line_start;
+    uint32_t line;
+    bool error;             // Syntax error or out of memory; stops everything
+    char *text;             // Last scalar, NUL-terminated
+    size_t text_len;
+    size_t text_cap;
+    yaml_anchor_t *anchors;
+    uint32_t anchor_count;
+    uint32_t anchor_cap;
+    uint32_t aliases;       // Aliases resolved to shared nodes
+} yaml_parser_t;
+
+typedef struct {
+    const char *cur;
+    const char *line_start;
+    uint32_t line;
+} yaml_mark_t;
+
+typedef struct {
+    const char *anchor;     // '&name', NULL if none
+    size_t anchor_len;
+    bool is_str;            // '!!str' or '!': the scalar is a string whatever it looks like
+} yaml_props_t;
+
+typedef struct {
+    cJSON *value;           // Mapping, alias of one or a sequence of those (owned)
+    cJSON *after;           // Member the merged ones follow, NULL = first
+    uint32_t anchors_begin; // Anchors defined inside `value`
+    uint32_t anchors_end;
+} yaml_merge_t;
+
+static cJSON* yaml_parse_node(yaml_parser_t *p, int indent, bool indentless, int depth);
+static cJSON* yaml_parse_flow(yaml_parser_t *p, int depth);
+
+static void yaml_fail(yaml_parser_t *p, const char *what) {
+    if (!p->error) {
+        LOG_ERR("YAML Error: %s at line %u, column %u.", what, (unsigned)p->line, (unsigned)(p->cur - p->line_start) + 1);
+        p->error = true;
+    }
+}
+
+static char yaml_at(const yaml_parser_t *p, size_t offset) {
+    return (size_t)(p->end - p->cur) > offset ? p->cur[offset] : '\0';
+}
+
+static bool yaml_is_break(char c) {
+    return c == '\n' || c == '\r' || c == '\0';
+}
+
+static bool yaml_is_blankz(char c) {
+    return c == ' ' || c == '\t' || yaml_is_break(c);
+}
+
+static bool yaml_is_flow_indicator(char c) {
+    return c == ',' || c == '[' || c == ']' || c == '{' || c == '}';
+}
+
+static int yaml_column(const yaml_parser_t *p) {
+    return (int)(p->cur - p->line_start);
+}
+
+static yaml_mark_t yaml_mark(const yaml_parser_t *p) {
+    yaml_mark_t mark = { p->cur, p->line_start, p->line };
+    return mark;
+}
+
+static void yaml_reset(yaml_parser_t *p, yaml_mark_t mark) {
+    p->cur = mark.cur;
+    p->line_start = mark.line_start;
+    p->line = mark.line;
+}
+
+static bool yaml_text_append(yaml_parser_t *p, const char *data, size_t n) {
+    if (p->text_len + n >= p->text_cap) {
+        size_t new_cap = p->text_cap ? p->text_cap : 64;
+        while (p->text_len + n >= new_cap) new_cap *= 2;
+        char *text = (char *)mem_realloc(LVGL_JSON_MEM_TEMPORARY, p->text, p->text_cap, new_cap);
+        if (!text) {
+            yaml_fail(p, "Out of memory");
+            return false;
+        }
+        p->text = text;
+        p->text_cap = new_cap;
+    }
+    memcpy(p->text + p->text_len, data, n);
+    p->text_len += n;
+    p->text[p->text_len] = '\0';
+    return true;
+}
+
+static bool yaml_text_repeat(yaml_parser_t *p, char c, uint32_t count) {
+    while (count--) {
+        if (!yaml_text_append(p, &c, 1)) return false;
+    }
+    return true;
+}
+
+static bool yaml_text_utf8(yaml_parser_t *p, uint32_t cp) {
+    char out[4];
+    size_t n;
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+        n = 1;
+    } else if (cp < 0x800) {
+        out[0] = (char)(0xC0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        n = 2;
+    } else if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        n = 3;
+    } else {
+        out[0] = (char)(0xF0 | (cp >> 18));
+        out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+        out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[3] = (char)(0x80 | (cp & 0x3F));
+        n = 4;
+    }
+    return yaml_text_append(p, out, n);
+}
+
+// Copies the last scalar, e.g. a key that must survive parsing its value.
+static const char* yaml_keep_text(yaml_parser_t *p, char *buf, size_t buf_size, char **owned, size_t *owned_size) {
+    if (p->text_len < buf_size) {
+        memcpy(buf, p->text, p->text_len + 1);
+        return buf;
+    }
+    *owned = (char *)mem_alloc(LVGL_JSON_MEM_TEMPORARY, p->text_len + 1);
+    if (!*owned) {
+        yaml_fail(p, "Out of memory");
+        return NULL;
+    }
+    *owned_size = p->text_len + 1;
+    memcpy(*owned, p->text, p->text_len + 1);
+    return *owned;
+}
+
+static void yaml_newline(yaml_parser_t *p) {
+    if (p->cur < p->end && *p->cur == '\r') p->cur++;
+    if (p->cur < p->end && *p->cur == '\n') p->cur++;
+    p->line++;
+    p->line_start = p->cur;
+}
+
+// Skips blanks and a comment. Returns true at the end of the line (or of the text).
+static bool yaml_skip_inline(yaml_parser_t *p) {
+    while (p->cur < p->end && (*p->cur == ' ' || *p->cur == '\t')) p->cur++;
+    if (p->cur < p->end && *p->cur == '#') {
+        while (p->cur < p->end && *p->cur != '\n' && *p->cur != '\r') p->cur++;
+    }
+    return p->cur >= p->end || *p->cur == '\n' || *p->cur == '\r';
+}
+
+// "---" or "..." at the start of a line.
+static bool yaml_is_document_marker(const yaml_parser_t *p) {
+    if (p->cur != p->line_start || p->end - p->cur < 3) return false;
+    if (memcmp(p->cur, "---", 3) != 0 && memcmp(p->cur, "...", 3) != 0) return false;
+    return p->end - p->cur == 3 || yaml_is_blankz(p->cur[3]);
+}
+
+// Moves to the next content, over blanks, comments and line breaks. False at the end of the
+// document (or on an error).
+static bool yaml_next_content(yaml_parser_t *p) {
+    for (;;) {
+        bool at_line_start = (p->cur == p->line_start);
+        while (p->cur < p->end && *p->cur == ' ') p->cur++;
+        const char *tab = (p->cur < p->end && *p->cur == '\t') ? p->cur : NULL;
+        if (!yaml_skip_inline(p)) {
+            if (tab && at_line_start) {
+                p->cur = tab;
+                yaml_fail(p, "Tab used for indentation");
+                return false;
+            }
+            return true;
+        }
+        if (p->cur >= p->end) return false;
+        yaml_newline(p);
+        if (yaml_is_document_marker(p)) return false;
+    }
+}
+
+static bool yaml_is_sequence_entry(const yaml_parser_t *p) {
+    return yaml_at(p, 0) == '-' && yaml_is_blankz(yaml_at(p, 1));
+}
+
+// True if an implicit key ("key: ...") starts at the current position. Consumes nothing.
+static bool yaml_is_key(const yaml_parser_t *p) {
+    const char *c = p->cur;
+    if (*c == '"' || *c == '\'') {
+        char quote = *c++;
+        for (; c < p->end && *c != '\n' && *c != '\r'; ++c) {
+            if (quote == '"' && *c == '\\') {
+                if (c + 1 < p->end) c++;
+                continue;
+            }
+            if (*c == quote) {
+                if (quote == '\'' && c + 1 < p->end && c[1] == '\'') {
+                    c++;
+                    continue;
+                }
+                break;
+            }
+        }
+        if (c >= p->end || *c != quote) return false;
+        for (c++; c < p->end && (*c == ' ' || *c == '\t'); ++c) {}
+        return c < p->end && *c == ':' && (c + 1 >= p->end || yaml_is_blankz(c[1]));
+    }
+    for (; c < p->end && *c != '\n' && *c != '\r'; ++c) {
+        if (*c == ':' && (c + 1 >= p->end || yaml_is_blankz(c[1]))) return true;
+        if (*c == '#' && c > p->cur && (c[-1] == ' ' || c[-1] == '\t')) return false;
+    }
+    return false;
+}
+
+static bool yaml_parse_props(yaml_parser_t *p, yaml_props_t *props) {
+    memset(props, 0, sizeof(*props));
+    for (;;) {
+        char c = yaml_at(p, 0);
+        if (c != '&' && c != '!') return true;
+        const char *start = p->cur;
+        while (p->cur < p->end && !yaml_is_blankz(*p->cur) && !yaml_is_flow_indicator(*p->cur)) p->cur++;
+        size_t len = (size_t)(p->cur - start);
+        if (c == '&') {
+            if (props->anchor || len == 1) {
+                p->cur = start;
+                yaml_fail(p, props->anchor ? "Node has two anchors" : "Anchor without a name");
+                return false;
+            }
+            props->anchor = start + 1;
+            props->anchor_len = len - 1;
+        } else {
+            // Other tags (!!int, !!map, application tags) do not change how the node is built
+            props->is_str = (len == 1) || (len == 5 && memcmp(start, "!!str", 5) == 0);
+        }
+        while (p->cur < p->end && (*p->cur == ' ' || *p->cur == '\t')) p->cur++;
+    }
+}
+
+static void yaml_set_anchor(yaml_parser_t *p, const yaml_props_t *props, cJSON *node) {
+    if (!props->anchor || !node) return;
+    if (p->anchor_count == p->anchor_cap) {
+        uint32_t new_cap = p->anchor_cap ? p->anchor_cap * 2 : 16;
+        yaml_anchor_t *anchors = (yaml_anchor_t *)mem_realloc(LVGL_JSON_MEM_TEMPORARY, p->anchors,
+                                                              p->anchor_cap * sizeof(yaml_anchor_t), new_cap * sizeof(yaml_anchor_t));
+        if (!anchors) {
+            yaml_fail(p, "Out of memory");
+            return;
+        }
+        p->anchors = anchors;
+        p->anchor_cap = new_cap;
+    }
+    yaml_anchor_t *anchor = &p->anchors[p->anchor_count++];
+    anchor->name = props->anchor;
+    anchor->len = props->anchor_len;
+    anchor->node = node;
+}
+
+// A node that shares the anchored `node`: containers and strings are cJSON references (nothing is
+// copied, cJSON_Delete() leaves the target alone), other scalars are small enough to copy.
+static cJSON* yaml_share(const cJSON *node) {
+    if (cJSON_IsObject(node)) return cJSON_CreateObjectReference(node->child);
+    if (cJSON_IsArray(node)) return cJSON_CreateArrayReference(node->child);
+    if (cJSON_IsString(node)) return cJSON_CreateStringReference(node->valuestring);
+    if (cJSON_IsNumber(node)) return cJSON_CreateNumber(node->valuedouble);
+    if (cJSON_IsBool(node)) return cJSON_CreateBool(cJSON_IsTrue(node));
+    return cJSON_CreateNull();
+}
+
+static cJSON* yaml_parse_alias(yaml_parser_t *p) {
+    const char *start = ++p->cur;
+    while (p->cur < p->end && !yaml_is_blankz(*p->cur) && !yaml_is_flow_indicator(*p->cur)) p->cur++;
+    size_t len = (size_t)(p->cur - start);
+    // The latest definition wins; an anchor is defined once its node is complete, so an alias
+    // cannot point into its own anchored node
+    for (uint32_t i = p->anchor_count; i-- > 0;) {
+        yaml_anchor_t *anchor = &p->anchors[i];
+        if (anchor->len != len || memcmp(anchor->name, start, len) != 0) continue;
+        if (!anchor->node) {
+            if (!p->error) LOG_ERR("YAML Error: Anchor '%.*s' is inside a merged mapping and cannot be aliased (line %u).", (int)len, start, (unsigned)p->line);
+            p->error = true;
+            return NULL;
+        }
+        cJSON *node = yaml_share(anchor->node);
+        if (!node) yaml_fail(p, "Out of memory");
+        p->aliases++;
+        return node;
+    }
+    if (!p->error) LOG_ERR("YAML Error: Unknown anchor '%.*s' at line %u.", (int)len, start, (unsigned)p->line);
+    p->error = true;
+    return NULL;
+}
+
+static bool yaml_hex(yaml_parser_t *p, int digits, uint32_t *out) {
+    uint32_t v = 0;
+    for (int i = 0; i < digits; ++i) {
+        char c = yaml_at(p, 0);
+        v <<= 4;
+        if (c >= '0' && c <= '9') v |= (uint32_t)(c - '0');
+        else if (c >= 'a' && c <= 'f') v |= (uint32_t)(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') v |= (uint32_t)(c - 'A' + 10);
+        else {
+            yaml_fail(p, "Invalid escape");
+            return false;
+        }
+        p->cur++;
+    }
+    *out = v;
+    return true;
+}
+
+// Folds the line breaks at the current position into the scalar: one becomes a space, each
+// further one a newline. Leading blanks of the next line are dropped.
+static bool yaml_fold_breaks(yaml_parser_t *p) {
+    uint32_t breaks = 0;
+    do {
+        yaml_newline(p);
+        breaks++;
+        while (p->cur < p->end && (*p->cur == ' ' || *p->cur == '\t')) p->cur++;
+    } while (p->cur < p->end && (*p->cur == '\n' || *p->cur == '\r'));
+    return breaks == 1 ? yaml_text_append(p, " ", 1) : yaml_text_repeat(p, '\n', breaks - 1);
+}
+
+static bool yaml_read_escape(yaml_parser_t *p) {
+    char e = yaml_at(p, 0);
+    if (e == '\n' || e == '\r') { // Escaped line break: the lines are joined without a space
+        yaml_newline(p);
+        while (p->cur < p->end && (*p->cur == ' ' || *p->cur == '\t')) p->cur++;
+        return true;
+    }
+    p->cur++;
+    uint32_t cp;
+    switch (e) {
+        case '0': cp = 0; break;
+        case 'a': cp = '\a'; break;
+        case 'b': cp = '\b'; break;
+        case 't': case '\t': cp = '\t'; break;
+        case 'n': cp = '\n'; break;
+        case 'v': cp = '\v'; break;
+        case 'f': cp = '\f'; break;
+        case 'r': cp = '\r'; break;
+        case 'e': cp = 0x1B; break;
+        case ' ': case '"': case '/': case '\\': cp = (uint32_t)e; break;
+        case 'N': cp = 0x85; break;
+        case '_': cp = 0xA0; break;
+        case 'L': cp = 0x2028; break;
+        case 'P': cp = 0x2029; break;
+        case 'x': if (!yaml_hex(p, 2, &cp)) return false; break;
+        case 'U': if (!yaml_hex(p, 8, &cp)) return false; break;
+        case 'u':
+            if (!yaml_hex(p, 4, &cp)) return false;
+            // A UTF-16 surrogate pair, as JSON writes characters outside the BMP
+            if (cp >= 0xD800 && cp <= 0xDBFF && yaml_at(p, 0) == '\\' && yaml_at(p, 1) == 'u') {
+                uint32_t low;
+                p->cur += 2;
+                if (!yaml_hex(p, 4, &low)) return false;
+                if (low >= 0xDC00 && low <= 0xDFFF) cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                else if (!yaml_text_utf8(p, cp)) return false;
+                else cp = low;
+            }
+            break;
+        default:
+            p->cur--;
+            yaml_fail(p, "Invalid escape");
+            return false;
+    }
+    return yaml_text_utf8(p, cp);
+}
+
+static bool yaml_read_quoted(yaml_parser_t *p) {
+    char quote = *p->cur++;
+    size_t kept = 0; // Escaped blanks before a line break are not trimmed
+    p->text_len = 0;
+    if (!yaml_text_append(p, "", 0)) return false;
+    for (;;) {
+        if (p->cur >= p->end) {
+            yaml_fail(p, "Unterminated string");
+            return false;
+        }
+        char c = *p->cur;
+        if (c == quote) {
+            if (quote == '\'' && yaml_at(p, 1) == '\'') {
+                p->cur += 2;
+                if (!yaml_text_append(p, "'", 1)) return false;
+                continue;
+            }
+            p->cur++;
+            return true;
+        }
+        if (c == '\n' || c == '\r') {
+            while (p->text_len > kept && (p->text[p->text_len - 1] == ' ' || p->text[p->text_len - 1] == '\t')) p->text_len--;
+            if (!yaml_fold_breaks(p)) return false;
+            if (yaml_is_document_marker(p)) {
+                yaml_fail(p, "Unterminated string");
+                return false;
+            }
+            continue;
+        }
+        if (quote == '"' && c == '\\') {
+            p->cur++;
+            if (!yaml_read_escape(p)) return false;
+            kept = p->text_len;
+            continue;
+        }
+        const char *start = p->cur;
+        while (p->cur < p->end && *p->cur != quote && *p->cur != '\n' && *p->cur != '\r' && !(quote == '"' && *p->cur == '\\')) p->cur++;
+        if (!yaml_text_append(p, start, (size_t)(p->cur - start))) return false;
+    }
+}
+
+// Reads a plain scalar. In block context it continues on lines indented more than `indent`
+// (multiline), in flow context it ends at a flow indicator.
+static bool yaml_read_plain(yaml_parser_t *p, int indent, bool flow, bool multiline) {
+    p->text_len = 0;
+    if (!yaml_text_append(p, "", 0)) return false;
+    for (;;) {
+        const char *start = p->cur, *stop = p->cur;
+        while (p->cur < p->end) {
+            char c = *p->cur;
+            if (c == '\n' || c == '\r') break;
+            if (c == ':' && (yaml_is_blankz(yaml_at(p, 1)) || (flow && yaml_is_flow_indicator(yaml_at(p, 1))))) break;
+            if (flow && yaml_is_flow_indicator(c)) break;
+            if (c == '#' && p->cur > start && (p->cur[-1] == ' ' || p->cur[-1] == '\t')) break;
+            p->cur++;
+            if (c != ' ' && c != '\t') stop = p->cur;
+        }
+        if (!yaml_text_append(p, start, (size_t)(stop - start))) return false;
+        if (!multiline || p->cur >= p->end || (*p->cur != '\n' && *p->cur != '\r')) return true;
+
+        // A continuation line? Otherwise the scalar ends at this line break
+        yaml_mark_t line_end = yaml_mark(p);
+        uint32_t breaks = 0;
+        bool more;
+        do {
+            yaml_newline(p);
+            breaks++;
+            more = !yaml_is_document_marker(p);
+            while (p->cur < p->end && *p->cur == ' ') p->cur++;
+            more = more && (flow || yaml_column(p) > indent);
+            while (p->cur < p->end && (*p->cur == ' ' || *p->cur == '\t')) p->cur++;
+        } while (p->cur < p->end && (*p->cur == '\n' || *p->cur == '\r'));
+        char c = yaml_at(p, 0);
+        more = more && c != '\0' && c != '#' && !(flow && yaml_is_flow_indicator(c)) &&
+               !(c == ':' && (flow || yaml_is_blankz(yaml_at(p, 1))));
+        if (!more) {
+            yaml_reset(p, line_end);
+            return true;
+        }
+        if (!(breaks == 1 ? yaml_text_append(p, " ", 1) : yaml_text_repeat(p, '\n', breaks - 1))) return false;
+    }
+}
+
+// '|' (literal) and '>' (folded) scalars, with chomping and indentation indicators.
+static bool yaml_read_block_scalar(yaml_parser_t *p, int indent) {
+    bool folded = (*p->cur++ == '>');
+    int chomp = 0; // -1 strip, 0 clip, 1 keep
+    int content_indent = -1;
+    for (int i = 0; i < 2; ++i) {
+        char c = yaml_at(p, 0);
+        if ((c == '-' || c == '+') && chomp == 0) {
+            chomp = (c == '-') ? -1 : 1;
+            p->cur++;
+        } else if (c >= '1' && c <= '9' && content_indent < 0) {
+            content_indent = (indent < 0 ? 0 : indent) + (c - '0');
+            p->cur++;
+        }
+    }
+    if (!yaml_skip_inline(p)) {
+        yaml_fail(p, "Unexpected content after a block scalar indicator");
+        return false;
+    }
+    p->text_len = 0;
+    if (!yaml_text_append(p, "", 0)) return false;
+    uint32_t breaks = 0; // Since the last content line
+    bool has_content = false, last_more_indented = false;
+    while (p->cur < p->end) {
+        yaml_mark_t line_end = yaml_mark(p);
+        yaml_newline(p);
+        breaks++;
+        const char *c = p->cur;
+        while (c < p->end && *c == ' ') c++;
+        int spaces = (int)(c - p->cur);
+        if (c >= p->end || *c == '\n' || *c == '\r') { // Empty line
+            p->cur = c;
+            continue;
+        }
+        if (content_indent < 0 && spaces > indent) content_indent = spaces;
+        if (content_indent < 0 || spaces < content_indent || yaml_is_document_marker(p)) {
+            yaml_reset(p, line_end);
+            breaks--;
+            break;
+        }
+        p->cur += content_indent;
+        bool more_indented = (*p->cur == ' ' || *p->cur == '\t');
+        bool ok;
+        if (!has_content) ok = yaml_text_repeat(p, '\n', breaks - 1);
+        else if (folded && !more_indented && !last_more_indented) ok = (breaks == 1) ? yaml_text_append(p, " ", 1) : yaml_text_repeat(p, '\n', breaks - 1);
+        else ok = yaml_text_repeat(p, '\n', breaks);
+        const char *start = p->cur;
+        while (p->cur < p->end && *p->cur != '\n' && *p->cur != '\r') p->cur++;
+        if (!ok || !yaml_text_append(p, start, (size_t)(p->cur - start))) return false;
+        has_content = true;
+        last_more_indented = more_indented;
+        breaks = 0;
+    }
+    // The line break that ended the last content line counts as a trailing one
+    if (has_content && p->cur < p->end) breaks++;
+    if (chomp > 0) return yaml_text_repeat(p, '\n', breaks);
+    return chomp == 0 && has_content && breaks ? yaml_text_append(p, "\n", 1) : true;
+}
+
+// YAML 1.2 core schema: null, booleans, integers (decimal, 0o, 0x) and floats; the rest are strings.
+static cJSON* yaml_resolve_plain(const char *s, size_t len) {
+    if (len == 0 || (len == 1 && s[0] == '~') || strcmp(s, "null") == 0 || strcmp(s, "Null") == 0 || strcmp(s, "NULL") == 0) {
+        return cJSON_CreateNull();
+    }
+    if (strcmp(s, "true") == 0 || strcmp(s, "True") == 0 || strcmp(s, "TRUE") == 0) return cJSON_CreateTrue();
+    if (strcmp(s, "false") == 0 || strcmp(s, "False") == 0 || strcmp(s, "FALSE") == 0) return cJSON_CreateFalse();
+
+    const char *c = s;
+    if (*c == '-' || *c == '+') c++;
+    if (c[0] == '.' && (strcmp(c + 1, "inf") == 0 || strcmp(c + 1, "Inf") == 0 || strcmp(c + 1, "INF") == 0)) {
+        return cJSON_CreateNumber(s[0] == '-' ? -INFINITY : INFINITY);
+    }
+    if (s[0] == '.' && (strcmp(s + 1, "nan") == 0 || strcmp(s + 1, "NaN") == 0 || strcmp(s + 1, "NAN") == 0)) {
+        return cJSON_CreateNumber(NAN);
+    }
+    if (s[0] == '0' && (s[1] == 'x' || s[1] == 'o') && s[2]) {
+        char *end = NULL;
+        unsigned long long v = strtoull(s + 2, &end, s[1] == 'x' ? 16 : 8);
+        if (*end == '\0') return cJSON_CreateNumber((double)v);
+        return cJSON_CreateString(s);
+    }
+    // [-+]? ( \. [0-9]+ | [0-9]+ ( \. [0-9]* )? ) ( [eE] [-+]? [0-9]+ )?
+    const char *d = c;
+    while (*d >= '0' && *d <= '9') d++;
+    bool digits = (d > c);
+    if (*d == '.') {
+        const char *f = ++d;
+        while (*d >= '0' && *d <= '9') d++;
+        digits = digits || d > f;
+    }
+    if (digits && (*d == 'e' || *d == 'E')) {
+        d++;
+        if (*d == '-' || *d == '+') d++;
+        const char *x = d;
+        while (*d >= '0' && *d <= '9') d++;
+        if (d == x) digits = false;
+    }
+    if (digits && *d == '\0') return cJSON_CreateNumber(strtod(s, NULL));
+    return cJSON_CreateString(s);
+}
+
+// A scalar or alias in block context ending the line, or a flow collection.
+static cJSON* yaml_parse_inline(yaml_parser_t *p, int indent, const yaml_props_t *props, int depth) {
+    char c = *p->cur;
+    if (c == '[' || c == '{') return yaml_parse_flow(p, depth);
+    if (c == '*') return yaml_parse_alias(p);
+    if (c == '|' || c == '>') {
+        if (!yaml_read_block_scalar(p, indent)) return NULL;
+        return cJSON_CreateString(p->text);
+    }
+    if (c == '"' || c == '\'') {
+        if (!yaml_read_quoted(p)) return NULL;
+        return cJSON_CreateString(p->text);
+    }
+    if (c == '#' || c == '%' || c == ',' || c == ']' || c == '}' || ((c == '?' || c == ':') && yaml_is_blankz(yaml_at(p, 1)))) {
+        yaml_fail(p, "Unexpected character");
+        return NULL;
+    }
+    if (!yaml_read_plain(p, indent, false, true)) return NULL;
+    return props->is_str ? cJSON_CreateString(p->text) : yaml_resolve_plain(p->text, p->text_len);
+}
+
+// Reads a mapping key into p->text. Returns false on an error.
+static bool yaml_read_key(yaml_parser_t *p, bool flow, bool *is_merge) {
+    char c = yaml_at(p, 0);
+    *is_merge = false;
+    if (c == '"' || c == '\'') return yaml_read_quoted(p);
+    if (c == '?' && yaml_is_blankz(yaml_at(p, 1))) {
+        yaml_fail(p, "Complex mapping keys are not supported");
+        return false;
+    }
+    if (c == '*' || c == '&' || c == '!' || c == '[' || c == '{') {
+        yaml_fail(p, "Mapping keys must be scalars without anchors or tags");
+        return false;
+    }
+    if (!yaml_read_plain(p, 0, flow, flow)) return false;
+    *is_merge = (p->text_len == 2 && p->text[0] == '<' && p->text[1] == '<');
+    return true;
+}
+
+// Inserts the detached `item` into `object` after the member `after` (NULL = first).
+static void yaml_link_after(cJSON *object, cJSON *after, cJSON *item) {
+    cJSON *first = object->child;
+    if (!first) {
+        object->child = item;
+        item->prev = item;
+        item->next = NULL;
+    } else if (!after) {
+        item->prev = first->prev;
+        item->next = first;
+        first->prev = item;
+        object->child = item;
+    } else {
+        item->prev = after;
+        item->next = after->next;
+        if (after->next) after->next->prev = item;
+        else first->prev = item;
+        after->next = item;
+    }
+}
+
+// Adds the members of `source` whose keys `object` does not have yet after *after. Members of an
+// alias are shared, those of a mapping written in place are moved.
+static bool yaml_merge_source(yaml_parser_t *p, cJSON *object, cJSON **after, cJSON *source) {
+    if (!cJSON_IsObject(source)) {
+        yaml_fail(p, "Merge key value must be a mapping or a sequence of mappings");
+        return false;
+    }
+    bool shared = (source->type & cJSON_IsReference) != 0;
+    cJSON *member = source->child;
+    while (member) {
+        cJSON *next = member->next;
+        if (!cJSON_GetObjectItemCaseSensitive(object, member->string)) {
+            cJSON *item;
+            if (shared) {
+                item = yaml_share(member);
+                if (!item || !cJSON_AddItemToObject(object, member->string, item)) {
+                    cJSON_Delete(item);
+                    yaml_fail(p, "Out of memory");
+                    return false;
+                }
+                cJSON_DetachItemViaPointer(object, item); // Keeps its key; linked at its place below
+            } else {
+                item = cJSON_DetachItemViaPointer(source, member);
+            }
+            yaml_link_after(object, *after, item);
+            *after = item;
+        }
+        member = next;
+    }
+    return true;
+}
+
+// Merge keys: keys written in the mapping win over merged ones, earlier sources over later ones.
+// Merged members take the place of their '<<' entry.
+static bool yaml_apply_merges(yaml_parser_t *p, cJSON *object, yaml_merge_t *merges, uint32_t count) {
+    bool ok = true;
+    cJSON *last_anchor = NULL, *last_inserted = NULL;
+    for (uint32_t i = 0; i < count; ++i) {
+        yaml_merge_t *merge = &merges[i];
+        cJSON *after = merge->after;
+        if (i > 0 && merge->after == last_anchor) after = last_inserted; // Consecutive '<<' entries keep their order
+        last_anchor = merge->after;
+        if (ok && cJSON_IsArray(merge->value)) {
+            for (cJSON *source = merge->value->child; ok && source; source = source->next) {
+                ok = yaml_merge_source(p, object, &after, source);
+            }
+        } else if (ok) {
+            ok = yaml_merge_source(p, object, &after, merge->value);
+        }
+        last_inserted = after;
+        // What is left of a mapping written in place goes away with it
+        for (uint32_t a = merge->anchors_begin; a < merge->anchors_end; ++a) p->anchors[a].node = NULL;
+        cJSON_Delete(merge->value);
+        merge->value = NULL;
+    }
+    return ok;
+}
+
+static cJSON* yaml_parse_block_mapping(yaml_parser_t *p, int column, int depth) {
+    cJSON *object = cJSON_CreateObject();
+    if (!object) {
+        yaml_fail(p, "Out of memory");
+        return NULL;
+    }
+    yaml_merge_t merges[LVGL_JSON_YAML_MAX_MERGES];
+    uint32_t merge_count = 0;
+    for (;;) {
+        bool is_merge;
+        char key_buf[64];
+        char *key_owned = NULL;
+        size_t key_owned_size = 0;
+        const char *key = NULL;
+        if (yaml_read_key(p, false, &is_merge)) {
+            key = yaml_keep_text(p, key_buf, sizeof(key_buf), &key_owned, &key_owned_size);
+        }
+        while (p->cur < p->end && (*p->cur == ' ' || *p->cur == '\t')) p->cur++;
+        if (key && yaml_at(p, 0) != ':') yaml_fail(p, "Expected ':' after a mapping key");
+        cJSON *value = NULL;
+        uint32_t anchors_begin = p->anchor_count;
+        if (!p->error) {
+            p->cur++;
+            value = yaml_parse_node(p, column, true, depth + 1);
+        }
+        if (value && is_merge) {
+            if (merge_count == LVGL_JSON_YAML_MAX_MERGES) {
+                yaml_fail(p, "Too many merge keys in one mapping");
+                cJSON_Delete(value);
+            } else {
+                yaml_merge_t *merge = &merges[merge_count++];
+                merge->value = value;
+                merge->after = object->child ? object->child->prev : NULL;
+                merge->anchors_begin = anchors_begin;
+                merge->anchors_end = p->anchor_count;
+            }
+        } else if (value) {
+            cJSON_AddItemToObject(object, key, value);
+        }
+        mem_free(LVGL_JSON_MEM_TEMPORARY, key_owned, key_owned_size);
+        if (p->error) break;
+
+        if (!yaml_skip_inline(p)) {
+            yaml_fail(p, "Unexpected content after a mapping value");
+            break;
+        }
+        yaml_mark_t line_end = yaml_mark(p);
+        if (!yaml_next_content(p) || yaml_column(p) < column) {
+            yaml_reset(p, line_end);
+            break;
+        }
+        if (yaml_column(p) > column) {
+            yaml_fail(p, "Bad indentation of a mapping entry");
+            break;
+        }
+        if (!yaml_is_key(p)) {
+            if (!yaml_is_sequence_entry(p)) yaml_fail(p, "Expected a mapping key");
+            yaml_reset(p, line_end); // A sequence entry at this column belongs to the parent
+            break;
+        }
+    }
+    if (merge_count && !yaml_apply_merges(p, object, merges, merge_count)) merge_count = 0;
+    for (uint32_t i = 0; i < merge_count; ++i) cJSON_Delete(merges[i].value);
+    if (p->error) {
+        cJSON_Delete(object);
+        return NULL;
+    }
+    return object;
+}
+
+static cJSON* yaml_parse_block_sequence(yaml_parser_t *p, int column, int depth) {
+    cJSON *array = cJSON_CreateArray();
+    if (!array) {
+        yaml_fail(p, "Out of memory");
+        return NULL;
+    }
+    for (;;) {
+        p->cur++; // '-'
+        cJSON *item = yaml_parse_node(p, column, false, depth + 1);
+        if (!item) break;
+        cJSON_AddItemToArray(array, item);
+        if (!yaml_skip_inline(p)) {
+            yaml_fail(p, "Unexpected content after a sequence entry");
+            break;
+        }
+        yaml_mark_t line_end = yaml_mark(p);
+        if (!yaml_next_content(p) || yaml_column(p) < column) {
+            yaml_reset(p, line_end);
+            break;
+        }
+        if (yaml_column(p) > column) {
+            yaml_fail(p, "Bad indentation of a sequence entry");
+            break;
+        }
+        if (!yaml_is_sequence_entry(p)) {
+            yaml_reset(p, line_end); // The next key of the mapping of an indentless sequence
+            break;
+        }
+    }
+    if (p->error) {
+        cJSON_Delete(array);
+        return NULL;
+    }
+    return array;
+}
+
+// The node after an indicator ('key:', '- ', start of the document) whose parent collection has
+// its entries at column `indent`. The node starts on the same line or on a later, deeper indented
+// one; a mapping value may also be a sequence at the key's column (`indentless`). Nothing there
+// is null. Like every node, it leaves the position right after its last character.
+static cJSON* yaml_parse_node(yaml_parser_t *p, int indent, bool indentless, int depth) {
+    if (depth > LVGL_JSON_YAML_MAX_DEPTH) {
+        yaml_fail(p, "Nesting too deep");
+        return NULL;
+    }
+    yaml_props_t props;
+    memset(&props, 0, sizeof(props));
+    uint32_t props_line = p->line;
+    bool same_line = !yaml_skip_inline(p);
+    if (same_line) {
+        if (!yaml_parse_props(p, &props)) return NULL;
+        same_line = !yaml_skip_inline(p);
+    }
+    if (!same_line) {
+        yaml_mark_t line_end = yaml_mark(p);
+        bool found = yaml_next_content(p);
+        int c = yaml_column(p);
+        if (p->error) return NULL;
+        if (!found || !(c > indent || (indentless && c == indent && yaml_is_sequence_entry(p)))) {
+            // Empty: the parent goes on from the end of this line
+            yaml_reset(p, line_end);
+            cJSON *node = props.is_str ? cJSON_CreateString("") : cJSON_CreateNull();
+            if (!node) yaml_fail(p, "Out of memory");
+            yaml_set_anchor(p, &props, node);
+            return node;
+        }
+        if (*p->cur == '&' || *p->cur == '!') {
+            if (props.anchor || props.is_str) {
+                yaml_fail(p, "Node properties split over lines");
+                return NULL;
+            }
+            props_line = p->line;
+            if (!yaml_parse_props(p, &props)) return NULL;
+            if (yaml_skip_inline(p)) {
+                yaml_fail(p, "Node properties must be followed by their node");
+                return NULL;
+            }
+        }
+    }
+
+    cJSON *node;
+    int column = yaml_column(p);
+    bool is_sequence = yaml_is_sequence_entry(p);
+    if (same_line && indentless && (is_sequence || (*p->cur != '[' && *p->cur != '{' && yaml_is_key(p)))) {
+        yaml_fail(p, "A block collection cannot start on the line of its key");
+        return NULL;
+    }
+    if (is_sequence) {
+        node = yaml_parse_block_sequence(p, column, depth);
+    } else if (*p->cur != '[' && *p->cur != '{' && yaml_is_key(p)) {
+        if ((props.anchor || props.is_str) && props_line == p->line) {
+            yaml_fail(p, "Node properties before a mapping must be on the line above");
+            return NULL;
+        }
+        node = yaml_parse_block_mapping(p, column, depth);
+    } else {
+        node = yaml_parse_inline(p, indent, &props, depth);
+        if (!node && !p->error) yaml_fail(p, "Out of memory");
+    }
+    if (p->error) {
+        cJSON_Delete(node);
+        return NULL;
+    }
+    yaml_set_anchor(p, &props, node);
+    return node;
+}
+
+// Blanks, comments and line breaks inside flow collections.
+static void yaml_skip_flow_space(yaml_parser_t *p) {
+    while (yaml_skip_inline(p) && p->cur < p->end) yaml_newline(p);
+}
+
+static cJSON* yaml_parse_flow(yaml_parser_t *p, int depth) {
+    if (depth > LVGL_JSON_YAML_MAX_DEPTH) {
+        yaml_fail(p, "Nesting too deep");
+        return NULL;
+    }
+    yaml_skip_flow_space(p);
+    yaml_props_t props;
+    if (!yaml_parse_props(p, &props)) return NULL;
+    yaml_skip_flow_space(p);
+    char c = yaml_at(p, 0);
+    cJSON *node = NULL;
+    if (c == '[' || c == '{') {
+        bool is_object = (c == '{');
+        char close = is_object ? '}' : ']';
+        yaml_merge_t merges[LVGL_JSON_YAML_MAX_MERGES];
+        uint32_t merge_count = 0;
+        p->cur++;
+        node = is_object ? cJSON_CreateObject() : cJSON_CreateArray();
+        if (!node) yaml_fail(p, "Out of memory");
+        while (!p->error) {
+            yaml_skip_flow_space(p);
+            if (yaml_at(p, 0) == close) {
+                p->cur++;
+                break;
+            }
+            if (is_object) {
+                bool is_merge;
+                char key_buf[64];
+                char *key_owned = NULL;
+                size_t key_owned_size = 0;
+                const char *key = NULL;
+                if (yaml_read_key(p, true, &is_merge)) {
+                    key = yaml_keep_text(p, key_buf, sizeof(key_buf), &key_owned, &key_owned_size);
+                }
+                yaml_skip_flow_space(p);
+                cJSON *value = NULL;
+                uint32_t anchors_begin = p->anchor_count;
+                if (p->error) {
+                    // Reported
+                } else if (yaml_at(p, 0) == ':') {
+                    p->cur++;
+                    yaml_skip_flow_space(p);
+                    c = yaml_at(p, 0);
+                    value = (c == ',' || c == '}') ? cJSON_CreateNull() : yaml_parse_flow(p, depth + 1);
+                } else {
+                    value = cJSON_CreateNull(); // {a, b}
+                }
+                if (!value && !p->error) yaml_fail(p, "Out of memory");
+                if (value && is_merge) {
+                    if (merge_count == LVGL_JSON_YAML_MAX_MERGES) {
+                        yaml_fail(p, "Too many merge keys in one mapping");
+                        cJSON_Delete(value);
+                    } else {
+                        yaml_merge_t *merge = &merges[merge_count++];
+                        merge->value = value;
+                        merge->after = node->child ? node->child->prev : NULL;
+                        merge->anchors_begin = anchors_begin;
+                        merge->anchors_end = p->anchor_count;
+                    }
+                } else if (value) {
+                    cJSON_AddItemToObject(node, key, value);
+                }
+                mem_free(LVGL_JSON_MEM_TEMPORARY, key_owned, key_owned_size);
+            } else {
+                cJSON *item = yaml_parse_flow(p, depth + 1);
+                if (item) cJSON_AddItemToArray(node, item);
+                yaml_skip_flow_space(p);
+                if (item && yaml_at(p, 0) == ':') yaml_fail(p, "Mappings inside flow sequences are not supported");
+            }
+            if (p->error) break;
+            yaml_skip_flow_space(p);
+            c = yaml_at(p, 0);
+            if (c == ',') {
+                p->cur++;
+            } else if (c != close) {
+                yaml_fail(p, is_object ? "Expected ',' or '}'" : "Expected ',' or ']'");
+            }
+        }
+        if (merge_count && !yaml_apply_merges(p, node, merges, merge_count)) merge_count = 0;
+        for (uint32_t i = 0; i < merge_count; ++i) cJSON_Delete(merges[i].value);
+    } else if (c == '*') {
+        node = yaml_parse_alias(p);
+    } else if (c == '"' || c == '\'') {
+        if (yaml_read_quoted(p)) node = cJSON_CreateString(p->text);
+    } else if (c == '\0' || yaml_is_flow_indicator(c) || c == '#' || ((c == '?' || c == ':') && yaml_is_blankz(yaml_at(p, 1)))) {
+        yaml_fail(p, c == '\0' ? "Unexpected end of input" : "Unexpected character");
+    } else if (yaml_read_plain(p, 0, true, true)) {
+        node = props.is_str ? cJSON_CreateString(p->text) : yaml_resolve_plain(p->text, p->text_len);
+    }
+    if (!node && !p->error) yaml_fail(p, "Out of memory");
+    if (p->error) {
+        cJSON_Delete(node);
+        return NULL;
+    }
+    yaml_set_anchor(p, &props, node);
+    return node;
+}
+
+static cJSON* yaml_parse(const char *text, size_t len, uint32_t *aliases) {
+    yaml_parser_t p;
+    memset(&p, 0, sizeof(p));
+    p.cur = p.line_start = text;
+    p.end = text + len;
+    p.line = 1;
+    if (len >= 3 && memcmp(text, "\xEF\xBB\xBF", 3) == 0) p.cur = p.line_start = text + 3;
+
+    render_arena_suspend(); // The tree outlives any render pass
+    cJSON *root = NULL;
+    bool found = yaml_next_content(&p);
+    // Directives ('%YAML 1.2') end with the document start marker
+    while (found && *p.cur == '%' && p.cur == p.line_start) {
+        while (p.cur < p.end && *p.cur != '\n' && *p.cur != '\r') p.cur++;
+        found = yaml_next_content(&p);
+    }
+    if (!p.error && (found || (p.cur < p.end && *p.cur == '-'))) {
+        if (yaml_is_document_marker(&p) && *p.cur == '-') p.cur += 3;
+        root = yaml_parse_node(&p, -1, false, 0);
+    }
+    if (!p.error && !root) {
+        root = cJSON_CreateNull(); // Empty document
+        if (!root) yaml_fail(&p, "Out of memory");
+    }
+    if (!p.error && (!yaml_skip_inline(&p) || yaml_next_content(&p)) && !yaml_is_document_marker(&p)) {
+        yaml_fail(&p, "Unexpected content");
+    }
+    if (!p.error && p.cur < p.end && yaml_is_document_marker(&p)) {
+        // "..." ends the document; only one document is read
+        bool end_marker = (*p.cur == '.');
+        p.cur += 3;
+        bool more = !yaml_skip_inline(&p) || yaml_next_content(&p) || p.cur < p.end;
+        if (!end_marker || more) {
+            yaml_fail(&p, "Only one YAML document is supported");
+        }
+    }
+    render_arena_resume();
+
+    mem_free(LVGL_JSON_MEM_TEMPORARY, p.text, p.text_cap);
+    mem_free(LVGL_JSON_MEM_TEMPORARY, p.anchors, p.anchor_cap * sizeof(yaml_anchor_t));
+    if (p.error) {
+        cJSON_Delete(root);
+        return NULL;
+    }
+    if (aliases) *aliases = p.aliases;
+    return root;
+}
+
+cJSON* lvgl_json_parse_yaml(const char *text, size_t len) {
+    if (!text) {
+        LOG_ERR("YAML Error: text is NULL.");
+        return NULL;
+    }
+    return yaml_parse(text, len, NULL);
+}
+
+#endif // LVGL_JSON_USE_YAML
+"""
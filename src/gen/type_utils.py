@@ -159,4 +159,78 @@ def lvgl_type_to_widget_name(lv_type):
     """Extracts 'label' from 'lv_label_t', 'obj' from 'lv_obj_t'"""
     if lv_type.startswith("lv_") and lv_type.endswith("_t"):
         return lv_type[3:-2]
-    return None
\ No newline at end of file
+    return None
+
+
+# --- Type IDs ---
+# Compact per-argument type identifiers stored in the invoke table (see TYPE_ID_* in the
+# generated C). They encode exactly the decisions unmarshal_value() used to make with
+# strcmp on the C type string, so the runtime dispatch is a single switch.
+TYPE_ID_ENUM_BIT = "TYPE_ID_ENUM_BIT"
+
+# Integer C types with a dedicated unmarshaler. Typedefs are resolved to these where possible.
+INTEGER_TYPE_IDS = {
+    "int": "TYPE_ID_INT",
+    "int8_t": "TYPE_ID_INT8",
+    "uint8_t": "TYPE_ID_UINT8",
+    "int16_t": "TYPE_ID_INT16",
+    "uint16_t": "TYPE_ID_UINT16",
+    "int32_t": "TYPE_ID_INT32",
+    "uint32_t": "TYPE_ID_UINT32",
+    "int64_t": "TYPE_ID_INT64",
+    "uint64_t": "TYPE_ID_UINT64",
+    "size_t": "TYPE_ID_SIZE_T",
+    "lv_opa_t": "TYPE_ID_OPA",
+    "lv_coord_t": "TYPE_ID_INT32", # Coordinates are int32_t in LVGL 9
+    "char": "TYPE_ID_CHAR",
+}
+
+def _resolve_typedef_to_integer(c_type, typedef_map):
+    """Follows simple (non-pointer) typedef chains until an integer type with a TYPE_ID is found."""
+    seen = set()
+    while c_type not in INTEGER_TYPE_IDS and c_type in typedef_map and c_type not in seen:
+        seen.add(c_type)
+        target = typedef_map[c_type]
+        if not isinstance(target, dict) or target.get('json_type') not in ('stdlib_type', 'primitive_type', 'lvgl_type') or not target.get('name'):
+            return None
+        c_type = target['name']
+    return INTEGER_TYPE_IDS.get(c_type)
+
+def get_type_id(c_type, pointer_level, is_array, typedef_map, enum_names):
+    """
+    Returns the C expression for the TYPE_ID of an argument, e.g. "TYPE_ID_UINT32" or
+    "TYPE_ID_INT | TYPE_ID_ENUM_BIT". The category follows get_unmarshal_signature_type() so
+    the value always fits the invoker's stack buffer for that argument.
+    """
+    sig_comp = get_unmarshal_signature_type(c_type, pointer_level, is_array)
+    if sig_comp == "const char *":
+        return "TYPE_ID_STRING"
+    if pointer_level > 0 or is_array:
+        if c_type == "void" and pointer_level == 1:
+            return "TYPE_ID_VOID_PTR"
+        if c_type == "lv_obj_t" and pointer_level == 1:
+            return "TYPE_ID_OBJ_PTR"
+        return "TYPE_ID_POINTER"
+    if sig_comp == "FLOAT":
+        return "TYPE_ID_FLOAT" if c_type == "float" else "TYPE_ID_DOUBLE"
+    if sig_comp == "BOOL":
+        return "TYPE_ID_BOOL"
+    if sig_comp == "lv_color_t":
+        return "TYPE_ID_COLOR"
+    if sig_comp == "INT":
+        if c_type in enum_names:
+            return f"TYPE_ID_INT | {TYPE_ID_ENUM_BIT}"
+        # Everything else that is passed in an integer buffer but isn't a known integer
+        # (bool typedefs, structs by value, ...) is read as a plain int like enums are.
+        return _resolve_typedef_to_integer(c_type, typedef_map) or "TYPE_ID_INT"
+    return "TYPE_ID_UNKNOWN"
+
+def get_ret_kind(c_type, pointer_level):
+    """Returns the RET_KIND_* constant describing how an invoker stores a function's result."""
+    if pointer_level > 0:
+        return "RET_KIND_POINTER"
+    if c_type == "void":
+        return "RET_KIND_VOID"
+    if c_type in ("float", "double"):
+        return "RET_KIND_FLOAT"
+    return "RET_KIND_INT"
@@ -0,0 +1,170 @@
+#!/usr/bin/env python3
+# ui_binary.py
+"""
+Converts a JSON (or YAML) UI spec into the binary UI format read by lvgl_json_render_binary().
+
+Layout (little endian, all offsets from the start of the buffer):
+
+    header   32 bytes   magic "LVJB", version, header size, node count,
+                        node table offset, string pool offset, string pool size
+    nodes    24 bytes each, in document (pre-)order, node 0 is the root
+    strings  NUL-terminated strings, deduplicated
+
+Node record: type (u8), 3 reserved bytes, key (u32 string offset of the object member name,
+or LVJB_NONE), next (u32 index of the next sibling or LVJB_NONE), value (u32: first child
+index for arrays/objects, string offset for strings), number (f64).
+
+Children always directly follow their parent and siblings always come later in the table,
+which lets the C side validate a buffer in a single pass.
+"""
+import argparse
+import json
+import logging
+import struct
+import sys
+
+logger = logging.getLogger(__name__)
+
+LVJB_MAGIC = b"LVJB"
+LVJB_VERSION = 1
+LVJB_NONE = 0xFFFFFFFF
+
+LVJB_HEADER_FORMAT = "<4sHHIIIIII"  # 32 bytes
+LVJB_NODE_FORMAT = "<B3xIIId"       # 24 bytes
+
+# Node types (must match lvjb_node_type_t in code_gen/binary_format.py)
+LVJB_NULL = 0
+LVJB_FALSE = 1
+LVJB_TRUE = 2
+LVJB_NUMBER = 3
+LVJB_STRING = 4
+LVJB_ARRAY = 5
+LVJB_OBJECT = 6
+
+assert struct.calcsize(LVJB_HEADER_FORMAT) == 32
+assert struct.calcsize(LVJB_NODE_FORMAT) == 24
+
+
+class ObjectPairs(list):
+    """JSON object as a list of (key, value) pairs. Keeps repeated keys, which the renderer
+    processes in order (e.g. several 'with' blocks on one widget)."""
+
+
+class _StringPool:
+    def __init__(self):
+        self.data = bytearray()
+        self.offsets = {}
+
+    def add(self, s):
+        offset = self.offsets.get(s)
+        if offset is None:
+            encoded = s.encode("utf-8")
+            if b"\0" in encoded:
+                raise ValueError(f"String contains a NUL character: {s!r}")
+            offset = len(self.data)
+            self.data += encoded + b"\0"
+            self.offsets[s] = offset
+        return offset
+
+
+def encode_ui(spec):
+    """Encodes a parsed UI spec (list, dict or ObjectPairs) and returns the binary buffer as bytes."""
+    if not isinstance(spec, (list, dict)):
+        raise ValueError("UI spec root must be an array or an object")
+
+    nodes = []  # [type, key, next, value, number]
+    pool = _StringPool()
+
+    def emit(value, key):
+        index = len(nodes)
+        node = [LVJB_NULL, LVJB_NONE if key is None else pool.add(key), LVJB_NONE, LVJB_NONE, 0.0]
+        nodes.append(node)
+        if value is None:
+            node[0] = LVJB_NULL
+        elif value is True:
+            node[0] = LVJB_TRUE
+        elif value is False:
+            node[0] = LVJB_FALSE
+        elif isinstance(value, (int, float)):
+            node[0] = LVJB_NUMBER
+            node[4] = float(value)
+        elif isinstance(value, str):
+            node[0] = LVJB_STRING
+            node[3] = pool.add(value)
+        elif isinstance(value, (list, dict)):
+            is_object = isinstance(value, (dict, ObjectPairs))
+            node[0] = LVJB_OBJECT if is_object else LVJB_ARRAY
+            if isinstance(value, dict):
+                members = value.items()
+            elif is_object:
+                members = value
+            else:
+                members = ((None, v) for v in value)
+            previous = None
+            for member_key, member_value in members:
+                if is_object and not isinstance(member_key, str):
+                    member_key = str(member_key)  # YAML allows non-string keys
+                child = emit(member_value, member_key)
+                if previous is None:
+                    node[3] = child
+                else:
+                    nodes[previous][2] = child
+                previous = child
+        else:
+            raise ValueError(f"Unsupported value of type {type(value).__name__} in UI spec")
+        return index
+
+    emit(spec, None)
+
+    header_size = struct.calcsize(LVJB_HEADER_FORMAT)
+    nodes_offset = header_size
+    strings_offset = nodes_offset + len(nodes) * struct.calcsize(LVJB_NODE_FORMAT)
+    if strings_offset + len(pool.data) >= LVJB_NONE:
+        raise ValueError("UI spec too large for the binary format")
+
+    out = bytearray(struct.pack(LVJB_HEADER_FORMAT, LVJB_MAGIC, LVJB_VERSION, header_size, len(nodes),
+                                nodes_offset, strings_offset, len(pool.data), 0, 0))
+    for node_type, key, next_index, value, number in nodes:
+        out += struct.pack(LVJB_NODE_FORMAT, node_type, key, next_index, value, number)
+    out += pool.data
+    logger.info(f"Encoded {len(nodes)} nodes, {len(pool.data)} bytes of strings, {len(out)} bytes total.")
+    return bytes(out)
+
+
+def load_spec(path):
+    with open(path, "r", encoding="utf-8") as f:
+        if path.endswith((".yaml", ".yml")):
+            try:
+                import yaml
+            except ImportError:
+                raise SystemExit("PyYAML is required to read YAML specs (pip install pyyaml).")
+            return yaml.safe_load(f)
+        return json.load(f, object_pairs_hook=ObjectPairs)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Convert a JSON/YAML UI spec into the binary UI format.")
+    parser.add_argument("input", help="UI spec (.json, .yaml or .yml)")
+    parser.add_argument("-o", "--output", help="Output file (default: input with .bin extension)")
+    parser.add_argument("-v", "--verbose", action="store_true", help="Log encoding statistics.")
+    args = parser.parse_args()
+
+    logging.basicConfig(level=logging.INFO if args.verbose else logging.WARNING, format="%(levelname)s: %(message)s")
+
+    output = args.output
+    if not output:
+        output = (args.input.rsplit(".", 1)[0] if "." in args.input else args.input) + ".bin"
+
+    try:
+        data = encode_ui(load_spec(args.input))
+    except (ValueError, json.JSONDecodeError) as e:
+        logger.error(f"Failed to encode '{args.input}': {e}")
+        sys.exit(1)
+
+    with open(output, "wb") as f:
+        f.write(data)
+    print(f"Wrote {output} ({len(data)} bytes)")
+
+
+if __name__ == "__main__":
+    main()
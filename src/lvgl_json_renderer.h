@@ -13,44 +13,253 @@ extern "C" {
 #include <stdio.h> // For logging fprintf
 #include <stdlib.h> // For logging malloc/free (if used in json_node_to_string)
 
-// --- Logging Macros (Provide basic implementation or allow override) ---
+// --- Logging ---
+// LVGL_JSON_LOG_LEVEL selects the messages compiled in; calls above it compile to nothing and
+// their arguments are never evaluated. All LOG_* macros can still be overridden.
+#define LVGL_JSON_LOG_LEVEL_NONE 0
+#define LVGL_JSON_LOG_LEVEL_ERROR 1
+#define LVGL_JSON_LOG_LEVEL_WARN 2
+#define LVGL_JSON_LOG_LEVEL_INFO 3
+#define LVGL_JSON_LOG_LEVEL_DEBUG 4
+
+#ifndef LVGL_JSON_LOG_LEVEL
+#ifdef LVGL_JSON_RENDERER_DEBUG
+#define LVGL_JSON_LOG_LEVEL LVGL_JSON_LOG_LEVEL_DEBUG
+#else
+#define LVGL_JSON_LOG_LEVEL LVGL_JSON_LOG_LEVEL_INFO
+#endif
+#endif
+
+// 1: keep log records in a ring buffer (see lvgl_json_log_drain()) instead of printing them
+#ifndef LVGL_JSON_LOG_SINK_RING
+#define LVGL_JSON_LOG_SINK_RING 0
+#endif
+#ifndef LVGL_JSON_LOG_RING_RECORDS
+#define LVGL_JSON_LOG_RING_RECORDS 16 // Power of two
+#endif
+
+// 1: build in the render profiler (lvgl_json_profile_start()); 0 compiles it out
+#ifndef LVGL_JSON_PROFILE
+#define LVGL_JSON_PROFILE 0
+#endif
+#ifndef LVGL_JSON_PROFILE_DEFAULT_EVENTS
+#define LVGL_JSON_PROFILE_DEFAULT_EVENTS 65536
+#endif
+
+// Lazy page prefetch: timer period, and how long input must be idle before a page is built
+#ifndef LVGL_JSON_LAZY_PREFETCH_PERIOD_MS
+#define LVGL_JSON_LAZY_PREFETCH_PERIOD_MS 100
+#endif
+#ifndef LVGL_JSON_LAZY_PREFETCH_IDLE_MS
+#define LVGL_JSON_LAZY_PREFETCH_IDLE_MS 300
+#endif
+
+// Rows a virtual list keeps above and below the viewport unless its 'overscan' says otherwise
+#ifndef LVGL_JSON_VLIST_OVERSCAN
+#define LVGL_JSON_VLIST_OVERSCAN 2
+#endif
+
+// A 'for-each' with at least this many items compiles its 'for' node into a template first
+#ifndef LVGL_JSON_REPEAT_COMPILE_MIN
+#define LVGL_JSON_REPEAT_COMPILE_MIN 2
+#endif
+
+// Period of the timer lvgl_json_render_async() steps a render from
+#ifndef LVGL_JSON_RENDER_STEP_PERIOD_MS
+#define LVGL_JSON_RENDER_STEP_PERIOD_MS 1
+#endif
+
+// 1: build in the YAML parser, projects, the live UI, the streaming renderer and time-sliced
+// rendering; 0 compiles them out (the firmware builds do)
+#ifndef LVGL_JSON_USE_YAML
+#define LVGL_JSON_USE_YAML 1
+#endif
+#ifndef LVGL_JSON_USE_PROJECT
+#define LVGL_JSON_USE_PROJECT 1
+#endif
+#ifndef LVGL_JSON_USE_LIVE
+#define LVGL_JSON_USE_LIVE 1
+#endif
+#ifndef LVGL_JSON_USE_STREAM
+#define LVGL_JSON_USE_STREAM 1
+#endif
+#ifndef LVGL_JSON_USE_SLICING
+#define LVGL_JSON_USE_SLICING 1
+#endif
+
+// Hash of the generator sources; part of the key of artifacts cached by lvgl_json_project_load()
+#define LVGL_JSON_GENERATOR_VERSION "b2ea98bfb0e8"
+
 // Helper to stringify JSON node (defined in .c file)
 // NOTE: Caller must free the returned string using cJSON_free()
 char* json_node_to_string(cJSON *node); // Exposed for potential external use? Maybe keep static.
 
-#ifndef LOG_ERR
-#define LOG_ERR(fmt, ...) fprintf(stderr, "ERROR: [%s:%d] " fmt "\n", __FILE__, __LINE__, ##__VA_ARGS__)
+#if LVGL_JSON_LOG_SINK_RING
+/** Value kinds of lvgl_json_log_record_t::value_type. */
+#define LVGL_JSON_LOG_VALUE_NONE 0
+#define LVGL_JSON_LOG_VALUE_NULL 1
+#define LVGL_JSON_LOG_VALUE_FALSE 2
+#define LVGL_JSON_LOG_VALUE_TRUE 3
+#define LVGL_JSON_LOG_VALUE_NUMBER 4
+#define LVGL_JSON_LOG_VALUE_STRING 5
+#define LVGL_JSON_LOG_VALUE_ARRAY 6
+#define LVGL_JSON_LOG_VALUE_OBJECT 7
+/** lvgl_json_log_record_t::flags: the string in `value` was cut off. */
+#define LVGL_JSON_LOG_FLAG_TRUNCATED 0x01
+/**
+ * lvgl_json_log_record_t::code of log calls outside the renderer (LOG_ERR() etc. in application
+ * code): this bit plus the caller's __LINE__. Calls in lvgl_json_renderer.c are LOG_*_ID() with
+ * a site ID the generator assigns, which tools/lvgl_log_decode.py maps back to the call.
+ */
+#define LVGL_JSON_LOG_CODE_LINE 0x80000000u
+
+/**
+ * @brief A log call stored by the ring buffer sink. The layout is fixed (232 bytes, little
+ * endian on all supported targets) so raw dumps can be decoded with tools/lvgl_log_decode.py.
+ */
+typedef struct {
+    uint32_t seq;             /**< Number of the log call; gaps mean records were dropped. */
+    uint32_t code;            /**< Site ID of the log call, or LVGL_JSON_LOG_CODE_LINE | line outside the renderer. */
+    double number;            /**< The JSON value if it is a number. */
+    uint8_t level;            /**< LVGL_JSON_LOG_LEVEL_*. */
+    uint8_t value_type;       /**< LVGL_JSON_LOG_VALUE_*, NONE if no JSON was logged. */
+    uint8_t flags;            /**< LVGL_JSON_LOG_FLAG_*. */
+    uint8_t reserved;
+    char node_id[28];         /**< 'id' (else 'named' or 'type') of the node being rendered. */
+    char property[24];        /**< Member name of the JSON value. */
+    char value[32];           /**< String value, or the 'type' of an object. */
+    char message[128];        /**< Formatted message. */
+} lvgl_json_log_record_t;
+
+void lvgl_json_log_write(uint8_t level, uint32_t code, const cJSON *json, const char *fmt, ...)
+#ifdef __GNUC__
+    __attribute__((format(printf, 4, 5)))
 #endif
-#ifndef LOG_ERR_JSON
-#define LOG_ERR_JSON(node, fmt, ...) do { \
+    ;
+
+/**
+ * @brief Moves up to `max_records` of the oldest log records to `out`.
+ *
+ * The ring has one producer (the thread rendering) and one consumer; drain it from a single
+ * task, e.g. the one that owns the UART. Records logged while the ring is full are dropped.
+ * @return The number of records copied.
+ */
+size_t lvgl_json_log_drain(lvgl_json_log_record_t *out, size_t max_records);
+
+/**
+ * @brief Formats a record as a log line, including a JSON snippet of the logged value.
+ * @return The length of the text written to `buf` (truncated to `size` - 1).
+ */
+int lvgl_json_log_format(const lvgl_json_log_record_t *rec, char *buf, size_t size);
+
+/**
+ * @brief Number of records dropped because the ring was full.
+ */
+uint32_t lvgl_json_log_dropped(void);
+
+#define LVGL_JSON_LOG_EMIT(level, label, stream, site, json, fmt, ...) \
+    lvgl_json_log_write(level, site, json, fmt, ##__VA_ARGS__)
+#define LVGL_JSON_LOG_EMIT_JSON(level, label, stream, site, node, fmt, ...) \
+    lvgl_json_log_write(level, site, node, fmt, ##__VA_ARGS__)
+#else
+#define LVGL_JSON_LOG_EMIT(level, label, stream, site, json, fmt, ...) \
+    fprintf(stream, label ": [%s:%d] " fmt "\n", __FILE__, __LINE__, ##__VA_ARGS__)
+#define LVGL_JSON_LOG_EMIT_JSON(level, label, stream, site, node, fmt, ...) do { \
         char* _json_str = json_node_to_string(node); \
-        fprintf(stderr, "ERROR: [%s:%d] " fmt " [Near JSON: %s]\n", __FILE__, __LINE__, ##__VA_ARGS__, _json_str ? _json_str : " N/A"); \
+        fprintf(stream, label ": [%s:%d] " fmt " [Near JSON: %s]\n", __FILE__, __LINE__, ##__VA_ARGS__, _json_str ? _json_str : " N/A"); \
         if (_json_str) cJSON_free(_json_str); \
     } while(0)
 #endif
+
+// Compiled out, but the format string and arguments are still type checked
+#define LVGL_JSON_LOG_DISCARD(fmt, ...) do { if (0) printf(fmt, ##__VA_ARGS__); } while(0)
+#define LVGL_JSON_LOG_DISCARD_JSON(node, fmt, ...) do { (void)sizeof(node); if (0) printf(fmt, ##__VA_ARGS__); } while(0)
+
+#if LVGL_JSON_LOG_LEVEL >= LVGL_JSON_LOG_LEVEL_ERROR
+#ifndef LOG_ERR
+#define LOG_ERR(fmt, ...) LVGL_JSON_LOG_EMIT(LVGL_JSON_LOG_LEVEL_ERROR, "ERROR", stderr, LVGL_JSON_LOG_CODE_LINE | __LINE__, NULL, fmt, ##__VA_ARGS__)
+#endif
+#ifndef LOG_ERR_ID
+#define LOG_ERR_ID(site, fmt, ...) LVGL_JSON_LOG_EMIT(LVGL_JSON_LOG_LEVEL_ERROR, "ERROR", stderr, site, NULL, fmt, ##__VA_ARGS__)
+#endif
+#ifndef LOG_ERR_JSON
+#define LOG_ERR_JSON(node, fmt, ...) LVGL_JSON_LOG_EMIT_JSON(LVGL_JSON_LOG_LEVEL_ERROR, "ERROR", stderr, LVGL_JSON_LOG_CODE_LINE | __LINE__, node, fmt, ##__VA_ARGS__)
+#endif
+#ifndef LOG_ERR_JSON_ID
+#define LOG_ERR_JSON_ID(site, node, fmt, ...) LVGL_JSON_LOG_EMIT_JSON(LVGL_JSON_LOG_LEVEL_ERROR, "ERROR", stderr, site, node, fmt, ##__VA_ARGS__)
+#endif
+#endif
+#if LVGL_JSON_LOG_LEVEL >= LVGL_JSON_LOG_LEVEL_WARN
 #ifndef LOG_WARN
-#define LOG_WARN(fmt, ...) fprintf(stderr, "WARN: [%s:%d] " fmt "\n", __FILE__, __LINE__, ##__VA_ARGS__)
+#define LOG_WARN(fmt, ...) LVGL_JSON_LOG_EMIT(LVGL_JSON_LOG_LEVEL_WARN, "WARN", stderr, LVGL_JSON_LOG_CODE_LINE | __LINE__, NULL, fmt, ##__VA_ARGS__)
+#endif
+#ifndef LOG_WARN_ID
+#define LOG_WARN_ID(site, fmt, ...) LVGL_JSON_LOG_EMIT(LVGL_JSON_LOG_LEVEL_WARN, "WARN", stderr, site, NULL, fmt, ##__VA_ARGS__)
 #endif
 #ifndef LOG_WARN_JSON
-#define LOG_WARN_JSON(node, fmt, ...) do { \
-        char* _json_str = json_node_to_string(node); \
-        fprintf(stderr, "WARN: [%s:%d] " fmt " [Near JSON: %s]\n", __FILE__, __LINE__, ##__VA_ARGS__, _json_str ? _json_str : " N/A"); \
-        if (_json_str) cJSON_free(_json_str); \
-    } while(0)
+#define LOG_WARN_JSON(node, fmt, ...) LVGL_JSON_LOG_EMIT_JSON(LVGL_JSON_LOG_LEVEL_WARN, "WARN", stderr, LVGL_JSON_LOG_CODE_LINE | __LINE__, node, fmt, ##__VA_ARGS__)
+#endif
+#ifndef LOG_WARN_JSON_ID
+#define LOG_WARN_JSON_ID(site, node, fmt, ...) LVGL_JSON_LOG_EMIT_JSON(LVGL_JSON_LOG_LEVEL_WARN, "WARN", stderr, site, node, fmt, ##__VA_ARGS__)
+#endif
 #endif
+#if LVGL_JSON_LOG_LEVEL >= LVGL_JSON_LOG_LEVEL_INFO
 #ifndef LOG_INFO
-#define LOG_INFO(fmt, ...) printf("INFO: [%s:%d] " fmt "\n", __FILE__, __LINE__, ##__VA_ARGS__)
+#define LOG_INFO(fmt, ...) LVGL_JSON_LOG_EMIT(LVGL_JSON_LOG_LEVEL_INFO, "INFO", stdout, LVGL_JSON_LOG_CODE_LINE | __LINE__, NULL, fmt, ##__VA_ARGS__)
 #endif
+#ifndef LOG_INFO_ID
+#define LOG_INFO_ID(site, fmt, ...) LVGL_JSON_LOG_EMIT(LVGL_JSON_LOG_LEVEL_INFO, "INFO", stdout, site, NULL, fmt, ##__VA_ARGS__)
+#endif
+#endif
+#if LVGL_JSON_LOG_LEVEL >= LVGL_JSON_LOG_LEVEL_DEBUG
 #ifndef LOG_DEBUG
-#ifdef LVGL_JSON_RENDERER_DEBUG
-#define LOG_DEBUG(fmt, ...) printf("DEBUG: [%s:%d] " fmt "\n", __FILE__, __LINE__, ##__VA_ARGS__)
-#else
-#define LOG_DEBUG(fmt, ...) (void)0
+#define LOG_DEBUG(fmt, ...) LVGL_JSON_LOG_EMIT(LVGL_JSON_LOG_LEVEL_DEBUG, "DEBUG", stdout, LVGL_JSON_LOG_CODE_LINE | __LINE__, NULL, fmt, ##__VA_ARGS__)
+#endif
+#ifndef LOG_DEBUG_ID
+#define LOG_DEBUG_ID(site, fmt, ...) LVGL_JSON_LOG_EMIT(LVGL_JSON_LOG_LEVEL_DEBUG, "DEBUG", stdout, site, NULL, fmt, ##__VA_ARGS__)
 #endif
 #endif
 
+#ifndef LOG_ERR
+#define LOG_ERR(fmt, ...) LVGL_JSON_LOG_DISCARD(fmt, ##__VA_ARGS__)
+#endif
+#ifndef LOG_ERR_ID
+#define LOG_ERR_ID(site, fmt, ...) LVGL_JSON_LOG_DISCARD(fmt, ##__VA_ARGS__)
+#endif
+#ifndef LOG_ERR_JSON
+#define LOG_ERR_JSON(node, fmt, ...) LVGL_JSON_LOG_DISCARD_JSON(node, fmt, ##__VA_ARGS__)
+#endif
+#ifndef LOG_ERR_JSON_ID
+#define LOG_ERR_JSON_ID(site, node, fmt, ...) LVGL_JSON_LOG_DISCARD_JSON(node, fmt, ##__VA_ARGS__)
+#endif
+#ifndef LOG_WARN
+#define LOG_WARN(fmt, ...) LVGL_JSON_LOG_DISCARD(fmt, ##__VA_ARGS__)
+#endif
+#ifndef LOG_WARN_ID
+#define LOG_WARN_ID(site, fmt, ...) LVGL_JSON_LOG_DISCARD(fmt, ##__VA_ARGS__)
+#endif
+#ifndef LOG_WARN_JSON
+#define LOG_WARN_JSON(node, fmt, ...) LVGL_JSON_LOG_DISCARD_JSON(node, fmt, ##__VA_ARGS__)
+#endif
+#ifndef LOG_WARN_JSON_ID
+#define LOG_WARN_JSON_ID(site, node, fmt, ...) LVGL_JSON_LOG_DISCARD_JSON(node, fmt, ##__VA_ARGS__)
+#endif
+#ifndef LOG_INFO
+#define LOG_INFO(fmt, ...) LVGL_JSON_LOG_DISCARD(fmt, ##__VA_ARGS__)
+#endif
+#ifndef LOG_INFO_ID
+#define LOG_INFO_ID(site, fmt, ...) LVGL_JSON_LOG_DISCARD(fmt, ##__VA_ARGS__)
+#endif
+#ifndef LOG_DEBUG
+#define LOG_DEBUG(fmt, ...) LVGL_JSON_LOG_DISCARD(fmt, ##__VA_ARGS__)
+#endif
+#ifndef LOG_DEBUG_ID
+#define LOG_DEBUG_ID(site, fmt, ...) LVGL_JSON_LOG_DISCARD(fmt, ##__VA_ARGS__)
+#endif
+
 
 #define LV_MALLOC lv_malloc
+#define LV_REALLOC lv_realloc
 #define LV_FREE lv_free
 #define LV_GRID_FR_1 LV_GRID_FR(1)
 #define LV_GRID_FR_2 LV_GRID_FR(2)
@@ -75,12 +284,12 @@ extern lv_obj_t *lv_screen_active(void);
 
 /**
  * @brief Adds a custom string-to-integer mapping for enum unmarshaling.
- * Allows overriding or extending generated enum values at runtime.
- * The 'name' string must persist for the lifetime of its use or be a literal.
+ * Allows overriding or extending generated enum values at runtime. The name is copied;
+ * adding it again updates its value. Mappings can be combined with '|' like generated names.
  *
  * @param name The string representation of the enum member.
  * @param value The integer value of the enum member.
- * @return true if added successfully, false if the user enum table is full.
+ * @return true if added successfully, false if out of memory.
  */
 bool lvgl_json_add_user_enum_mapping(const char *name, int value);
 
@@ -102,12 +311,271 @@ void lvgl_json_clear_user_enum_mappings(void);
  */
 bool lvgl_json_render_ui(cJSON *root_json, lv_obj_t *implicit_root_parent);
 
+#if LVGL_JSON_USE_SLICING
+/**
+ * @brief Called when a time-sliced render is done: `success` is false if a top-level node
+ *        failed or the render was cancelled.
+ */
+typedef void (*lvgl_json_render_done_cb_t)(bool success, void *user_data);
+
+/**
+ * @brief Starts rendering a UI spec in steps; lvgl_json_render_step() does the work.
+ *
+ * Widgets are created in the same order as lvgl_json_render_ui() creates them, except that
+ * the children of hidden containers and of tiles or tabs not shown come last. A 'for-each'
+ * renders one item per unit of work. Only one time-sliced render runs at a time.
+ *
+ * `root_json` must stay valid until `done_cb` is called. Call lvgl_json_render_cancel() before
+ * deleting `implicit_root_parent` or widgets the render is still adding children to.
+ *
+ * @return false if a render is already running or `root_json` is not an object or array.
+ */
+bool lvgl_json_render_start(cJSON *root_json, lv_obj_t *implicit_root_parent, lvgl_json_render_done_cb_t done_cb, void *user_data);
+
+/**
+ * @brief Renders nodes of the running time-sliced render for up to `budget_us` microseconds.
+ *
+ * A step stops before the next node if the nodes before took longer than the budget left,
+ * but always renders at least one. A single node with many attributes can still overrun;
+ * lvgl_json_render_stats_t has the number of such steps. Calls `done_cb` when the last node
+ * is rendered.
+ *
+ * @return true while there is work left.
+ */
+bool lvgl_json_render_step(uint32_t budget_us);
+
+/**
+ * @brief lvgl_json_render_start() with an LVGL timer that calls lvgl_json_render_step(budget_us)
+ *        every LVGL_JSON_RENDER_STEP_PERIOD_MS until the render is done.
+ */
+bool lvgl_json_render_async(cJSON *root_json, lv_obj_t *implicit_root_parent, uint32_t budget_us,
+                            lvgl_json_render_done_cb_t done_cb, void *user_data);
+
+/**
+ * @brief Stops the running time-sliced render. Widgets created so far are kept; `done_cb` is
+ *        called with `success` false.
+ */
+void lvgl_json_render_cancel(void);
+
+/**
+ * @brief Whether a time-sliced render is running.
+ */
+bool lvgl_json_render_pending(void);
+#endif // LVGL_JSON_USE_SLICING
+
+/**
+ * @brief A UI spec compiled by lvgl_json_compile_ui(). Opaque.
+ */
+typedef struct lvgl_json_program_s lvgl_json_program_t;
+
+/**
+ * @brief Compiles a UI spec into a program that can be run repeatedly.
+ *
+ * Setters, create functions and constant property values (including enum names and user enum
+ * mappings) are resolved once here. Values starting with '@', '$' or '!' are kept symbolic and
+ * resolved whenever the program runs, like lvgl_json_render_ui() does. Nodes that cannot be
+ * compiled are rendered from JSON when the program runs.
+ *
+ * @param root_json The root cJSON object (must be an array of objects or a single object).
+ *                  The program keeps its own copy; root_json can be deleted afterwards.
+ * @return The program, or NULL on error. Free with lvgl_json_free_program().
+ */
+lvgl_json_program_t *lvgl_json_compile_ui(cJSON *root_json);
+
+/**
+ * @brief Runs a compiled program. Equivalent to lvgl_json_render_ui() on the compiled spec.
+ *
+ * @param program The program returned by lvgl_json_compile_ui().
+ * @param implicit_root_parent The LVGL parent object for all top-level elements.
+ *                             If NULL, lv_screen_active() will be used.
+ * @return true if rendering was successful, false otherwise. Errors are logged.
+ */
+bool lvgl_json_run_program(const lvgl_json_program_t *program, lv_obj_t *implicit_root_parent);
+
+/**
+ * @brief Frees a compiled program.
+ *
+ * Widgets created by the program may point at strings owned by it (e.g. label texts set with
+ * lv_label_set_text_static), so only free it once those widgets are deleted.
+ */
+void lvgl_json_free_program(lvgl_json_program_t *program);
+
+/**
+ * @brief Renders a UI from the binary format produced by gen/ui_binary.py.
+ *
+ * The buffer is read in place (e.g. memory-mapped from a flash partition or loaded from a file),
+ * no JSON text is parsed. Strings handed to LVGL point into `buf`, so it must stay valid for as
+ * long as widgets may reference them, like the cJSON tree passed to lvgl_json_render_ui().
+ *
+ * @param buf The binary UI data.
+ * @param len Size of `buf` in bytes.
+ * @param parent The LVGL parent object for all top-level elements. If NULL, lv_screen_active() is used.
+ * @return true if rendering was successful, false if the buffer is invalid or rendering failed.
+ */
+bool lvgl_json_render_binary(const void *buf, size_t len, lv_obj_t *parent);
+
+/**
+ * @brief Encodes a UI spec into the binary format read by lvgl_json_render_binary().
+ *
+ * The output is the same as gen/ui_binary.py writes for the spec.
+ *
+ * @param root_json The root cJSON object (an array or an object).
+ * @param len Receives the size of the returned buffer in bytes.
+ * @return The binary UI data, or NULL on error. Free with lv_free().
+ */
+void *lvgl_json_encode_binary(const cJSON *root_json, size_t *len);
+
+#if LVGL_JSON_USE_STREAM
+/**
+ * @brief Reads up to `buf_size` bytes of UI spec text into `buf`.
+ * @return Number of bytes read, 0 at the end of the input or on error.
+ */
+typedef size_t (*lvgl_json_read_cb_t)(void *user_data, char *buf, size_t buf_size);
+
+/**
+ * @brief Renders a UI while reading its JSON text, without building the whole document first.
+ *
+ * Widgets are created as soon as their attributes up to the "children" array have been read, and
+ * children are rendered one after another. Only component definitions, 'use-view' nodes and
+ * property values are buffered, so transient memory depends on nesting depth, not on spec size.
+ * Attributes placed after a node's "children" are applied once its children exist ('type', 'id'
+ * and 'context' must come before "children").
+ *
+ * Rendering stops at the first syntax error; widgets created up to that point are kept.
+ *
+ * @param read_cb Called to fetch more input, e.g. a wrapper around fread().
+ * @param user_data Passed to read_cb.
+ * @param implicit_root_parent The LVGL parent object for all top-level elements.
+ *                             If NULL, lv_screen_active() will be used.
+ * @return true if rendering was successful, false otherwise. Errors are logged.
+ */
+bool lvgl_json_render_stream(lvgl_json_read_cb_t read_cb, void *user_data, lv_obj_t *implicit_root_parent);
+
+/**
+ * @brief lvgl_json_render_stream() over a NUL-terminated string already in memory.
+ */
+bool lvgl_json_render_stream_str(const char *json_text, lv_obj_t *implicit_root_parent);
+#endif // LVGL_JSON_USE_STREAM
+
+#if LVGL_JSON_USE_YAML
+/**
+ * @brief Parses a YAML UI spec into the cJSON tree lvgl_json_render_ui() takes.
+ *
+ * Covers the YAML specs are written in: block and flow collections, plain, quoted and block
+ * ('|', '>') scalars, comments and the YAML 1.2 core schema (null, true/false, numbers, anything
+ * else is a string). Repeated keys are kept in order. An alias (*name) is a cJSON reference to
+ * the anchored node (cJSON_IsReference is set in its type), so the subtree is shared, not copied;
+ * merge keys (<<: *name) add references to the merged members. Complex keys, tags other than
+ * !!str and multiple documents are not supported.
+ *
+ * @param text The YAML text; need not be NUL-terminated.
+ * @param len Length of `text` in bytes.
+ * @return The tree, or NULL on a syntax error (logged with its line). Free with cJSON_Delete(),
+ *         which frees shared nodes once.
+ */
+cJSON *lvgl_json_parse_yaml(const char *text, size_t len);
+#endif // LVGL_JSON_USE_YAML
+
+#if LVGL_JSON_USE_PROJECT
+/**
+ * @brief A UI spec split over several files with 'import' nodes. Opaque.
+ */
+typedef struct lvgl_json_project_s lvgl_json_project_t;
+
+/**
+ * @brief File access of a project, e.g. on a flash file system. Paths are passed as imported,
+ *        joined to the directory of the importing file.
+ */
+typedef struct {
+    int32_t (*size)(const char *path, void *user_data);   /**< Size of the file in bytes, -1 if it cannot be read. */
+    bool (*read)(const char *path, void *buf, size_t len, void *user_data); /**< Reads the whole file into `buf`. */
+    bool (*write)(const char *path, const void *data, size_t len, void *user_data); /**< Replaces a file; NULL disables the cache. */
+    void *user_data;
+} lvgl_json_project_io_t;
+
+/**
+ * @brief What lvgl_json_project_load() did with the files of a project.
+ */
+typedef struct {
+    uint32_t files;             /**< Files the spec was linked from. */
+    uint32_t files_reused;      /**< Unchanged since the last load; their parsed tree was kept. */
+    uint32_t files_cached;      /**< Read from their cached binary artifact instead of being parsed. */
+    uint32_t files_parsed;      /**< Parsed from JSON or YAML text (and their artifact written to the cache). */
+    uint32_t bytes_read;        /**< Bytes of files and artifacts read. */
+} lvgl_json_project_stats_t;
+
+/**
+ * @brief Creates a project.
+ *
+ * @param io File access, or NULL for stdio (fopen() and friends).
+ * @param cache_dir Existing directory for binary artifacts of parsed files, or NULL for none.
+ *                  Artifacts are named after the content hash of their file and
+ *                  LVGL_JSON_GENERATOR_VERSION; stale ones are never read again and the
+ *                  directory can be emptied at any time.
+ * @return The project, or NULL if out of memory. Free with lvgl_json_project_free().
+ */
+lvgl_json_project_t *lvgl_json_project_create(const lvgl_json_project_io_t *io, const char *cache_dir);
+
+/**
+ * @brief Loads the spec in `path` and the files it imports, and links them into one spec.
+ *
+ * A top-level node {"import": "styles.json"} is replaced by the top-level nodes of that file,
+ * resolved relative to the importing file. Files named *.yaml or *.yml are parsed with
+ * lvgl_json_parse_yaml() (they fail to load without LVGL_JSON_USE_YAML), others as JSON. A file
+ * is linked once, where it is first imported, so several files can import the same styles and
+ * import cycles are harmless.
+ *
+ * Each file is read and hashed on every load but only parsed if its content changed since the
+ * last load and has no cached artifact. The returned spec is an array of references into the
+ * parsed files: delete it with cJSON_Delete() or hand it to lvgl_json_live_ui_update(). Files
+ * that changed keep their previous tree until the next successful load has returned, so the
+ * live UI can still compare against the spec it was given before.
+ *
+ * @param stats Receives what happened to the files, or NULL.
+ * @return The linked spec, or NULL if a file could not be read or parsed. Errors are logged.
+ */
+cJSON *lvgl_json_project_load(lvgl_json_project_t *project, const char *path, lvgl_json_project_stats_t *stats);
+
+/**
+ * @brief Number of files of the last load, including one that failed to load.
+ */
+uint32_t lvgl_json_project_file_count(const lvgl_json_project_t *project);
+
+/**
+ * @brief Path of file `index` of the last load, e.g. to watch it for changes.
+ */
+const char *lvgl_json_project_file_path(const lvgl_json_project_t *project, uint32_t index);
+
+/**
+ * @brief Frees a project and the parsed files. Delete widgets rendered from its specs first,
+ *        like the cJSON tree passed to lvgl_json_render_ui().
+ */
+void lvgl_json_project_free(lvgl_json_project_t *project);
+#endif // LVGL_JSON_USE_PROJECT
+
 
+/**
+ * @brief Returns the interned copy of `name`, kept until lvgl_json_register_str_clear().
+ *
+ * Used for '!static' strings that LVGL keeps a pointer to. Registry names and type names are
+ * interned in the same pool, so each distinct string is stored once.
+ */
 char *lvgl_json_register_str(const char *name);
+
+/**
+ * @brief Releases the strings returned by lvgl_json_register_str(); call it with the UI they belong to.
+ * Strings still used by registry entries are kept until those entries go away.
+ */
 void lvgl_json_register_str_clear();
 
 void lvgl_json_register_clear();
 
+/**
+ * @brief Forgets the setters resolved for (type, property) pairs so far, and releases their
+ *        interned names. The cache holds at most 256 pairs and refills on the next render.
+ */
+void lvgl_json_setter_cache_clear(void);
+
 /**
  * @brief Registers a pointer with a given name. Used for referencing objects/styles by ID ('@name').
  *
@@ -135,6 +603,60 @@ void* lvgl_json_get_registered_ptr(const char *name, const char *expected_ptr_ty
  */
 void lvgl_json_registry_clear();
 
+/**
+ * @brief Handle of a registered path (an interned name), valid until the path is removed.
+ */
+typedef const char *lvgl_json_path_t;
+
+/**
+ * @brief Callback of lvgl_json_registry_enumerate(); return false to stop the walk.
+ */
+typedef bool (*lvgl_json_registry_visit_cb_t)(const char *name, const char *type_name, void *ptr, void *user_data);
+
+/**
+ * @brief Calls `cb` for every registered entry at or below `path` (e.g. "main:header"),
+ * depth first. NULL or "" visits the whole registry.
+ * @return The number of entries visited.
+ */
+size_t lvgl_json_registry_enumerate(const char *path, lvgl_json_registry_visit_cb_t cb, void *user_data);
+
+/**
+ * @brief Looks up a path once so that entries below it can be fetched with
+ * lvgl_json_get_registered_ptr_at() without building the full name.
+ * @return The path handle, or NULL if nothing is registered at or below `path`.
+ */
+lvgl_json_path_t lvgl_json_registry_find_path(const char *path);
+
+/**
+ * @brief Like lvgl_json_get_registered_ptr() for the name `base:relative_path`.
+ */
+void* lvgl_json_get_registered_ptr_at(lvgl_json_path_t base, const char *relative_path, const char *expected_ptr_type_name);
+
+/**
+ * @brief Removes `path` and every entry below it (e.g. all named widgets of a screen).
+ * Pointers registered with auto-free are freed; widgets themselves are not deleted.
+ * @return The number of registered entries removed.
+ */
+size_t lvgl_json_registry_remove(const char *path);
+
+/**
+ * @brief Load statistics of the pointer registry.
+ */
+typedef struct {
+    uint32_t count;           /**< Registered names. */
+    uint32_t placeholder_count; /**< Path nodes that only exist as parents of registered names. */
+    uint32_t capacity;        /**< Table slots (grows at 75% load). */
+    uint32_t max_probe_len;   /**< Longest probe sequence of a stored name (1 = home slot). */
+    float avg_probe_len;      /**< Average probe length over all stored names. */
+    size_t table_bytes;       /**< Memory used by the table itself. */
+    size_t string_bytes;      /**< Memory used by the interned names, type names and static strings. */
+} lvgl_json_registry_stats_t;
+
+/**
+ * @brief Fills `out` with the current registry statistics.
+ */
+void lvgl_json_registry_stats(lvgl_json_registry_stats_t *out);
+
 /**
  * @brief Generates a JSON string of predefined macro values.
  *
@@ -153,6 +675,300 @@ void lvgl_json_registry_clear();
  */
 char* lvgl_json_generate_values_json(void);
 
+/**
+ * @brief Counters collected by the renderer, mainly to verify that hot paths stay allocation-free.
+ */
+typedef struct {
+    uint32_t properties_set;  /**< Setter invocations attempted for properties. */
+    uint32_t json_allocs;     /**< cJSON nodes created or duplicated by the renderer itself. */
+    uint32_t heap_allocs;     /**< LV_MALLOC / lv_strdup calls made by the renderer and registry. */
+    uint32_t arena_allocs;    /**< Transient allocations served by the render pass arena. */
+    uint32_t arena_bytes;     /**< Bytes handed out by the arena. */
+    uint32_t arena_peak_bytes; /**< Largest amount of arena memory in use at once. */
+    uint32_t arena_chunk_bytes; /**< Arena chunk memory currently held on the heap (not reset). */
+    uint32_t shared_style_uses; /**< Style property groups added as a shared style instead of local styles. */
+    uint32_t local_style_bytes_saved; /**< Estimated LVGL heap the local styles of those groups would have used. */
+    uint32_t shared_styles;   /**< Distinct shared styles held (not reset). */
+    uint32_t shared_style_bytes; /**< Heap used by the shared styles, LVGL's style values included (not reset). */
+    uint32_t lazy_deferred;   /**< Containers whose children were kept for later ('lazy'). */
+    uint32_t slice_steps;     /**< lvgl_json_render_step() calls. */
+    uint32_t slice_steps_over_budget; /**< Steps that took longer than their budget. */
+    uint32_t slice_max_step_us; /**< Longest step, in microseconds. */
+} lvgl_json_render_stats_t;
+
+/**
+ * @brief Copies the current render counters into `out`.
+ *
+ * Counters accumulate across renders until lvgl_json_reset_render_stats() is called.
+ *
+ * @param out Destination for the counters, must not be NULL.
+ */
+void lvgl_json_get_render_stats(lvgl_json_render_stats_t *out);
+
+/**
+ * @brief Resets all render counters to zero.
+ */
+void lvgl_json_reset_render_stats(void);
+
+#if LVGL_JSON_PROFILE
+/**
+ * @brief Starts recording a profile of the following renders (LVGL_JSON_PROFILE=1 builds).
+ *
+ * Each call of render_json_node(), apply_setters_and_attributes(), unmarshal_value() and of a
+ * setter or create function through the invoke table becomes one event with its duration, the
+ * source path of the node being rendered (indices into the spec's arrays, e.g. "/0/3/1") and
+ * the node's type. Events that do not fit into the buffer are counted as dropped. Previous
+ * events are discarded. Call it between renders.
+ *
+ * @param max_events Size of the event buffer, 0 for LVGL_JSON_PROFILE_DEFAULT_EVENTS.
+ * @return false if the buffer could not be allocated.
+ */
+bool lvgl_json_profile_start(uint32_t max_events);
+
+/**
+ * @brief Stops recording; the events are kept until the next start or reset.
+ */
+void lvgl_json_profile_stop(void);
+
+/**
+ * @brief Stops recording and frees the events and their buffer.
+ */
+void lvgl_json_profile_reset(void);
+
+/**
+ * @brief Number of events recorded; `dropped` (optional) receives the number that did not fit.
+ */
+uint32_t lvgl_json_profile_event_count(uint32_t *dropped);
+
+/**
+ * @brief Writes the events as Chrome trace-event JSON, viewable in chrome://tracing or Perfetto.
+ * @return false if the file could not be written.
+ */
+bool lvgl_json_profile_write_trace(const char *path);
+
+/**
+ * @brief Prints the self time per category and the `top_n` setters with the most total time.
+ */
+void lvgl_json_profile_print_summary(uint32_t top_n);
+#endif
+
+/**
+ * @brief Categories of the heap memory held by the renderer (lvgl_json_memory_report_t::bytes).
+ */
+typedef enum {
+    LVGL_JSON_MEM_REGISTRY,   /**< Registry table and user enum mappings. */
+    LVGL_JSON_MEM_TEMPLATES,  /**< Component definitions (with their JSON), compiled programs, lazy children. */
+    LVGL_JSON_MEM_GRID,       /**< Grid row and column descriptors. */
+    LVGL_JSON_MEM_STYLES,     /**< Styles of 'style' nodes and shared styles. */
+    LVGL_JSON_MEM_STRINGS,    /**< Interned names and lvgl_json_register_str() strings. */
+    LVGL_JSON_MEM_TEMPORARY,  /**< Render arena chunks, context indexes, scratch and stream buffers. */
+    LVGL_JSON_MEM_OTHER,      /**< Setter cache, live UI, virtual lists, projects, profiler, other managed objects. */
+    LVGL_JSON_MEM_CATEGORY_COUNT
+} lvgl_json_mem_category_t;
+
+#define LVGL_JSON_MEM_REPORT_WIDGET_TYPES 32 // Widget types listed in the report
+
+/**
+ * @brief LVGL heap usage from lv_mem_monitor() (zero unless LVGL's built-in allocator is used).
+ */
+typedef struct {
+    uint32_t total_size;
+    uint32_t free_size;
+    uint32_t free_biggest_size;
+    uint8_t used_pct;
+    uint8_t frag_pct;
+} lvgl_json_heap_snapshot_t;
+
+/**
+ * @brief Memory held by the renderer, widgets created and registry contents.
+ */
+typedef struct {
+    uint32_t bytes[LVGL_JSON_MEM_CATEGORY_COUNT];      /**< Heap held now, per category. */
+    uint32_t peak_bytes[LVGL_JSON_MEM_CATEGORY_COUNT]; /**< Most heap held at once, per category. */
+    uint32_t allocs[LVGL_JSON_MEM_CATEGORY_COUNT];     /**< Allocations made so far, per category. */
+    uint32_t total_bytes;                              /**< Sum of `bytes`. */
+
+    bool lvgl_heap_valid;                   /**< A render has run and the snapshots below are set. */
+    lvgl_json_heap_snapshot_t lvgl_before;  /**< LVGL heap when the last render began... */
+    lvgl_json_heap_snapshot_t lvgl_after;   /**< ...and when it ended. */
+
+    uint32_t widgets_created;               /**< Widgets created since lvgl_json_reset_render_stats(). */
+    uint32_t widget_type_count;             /**< Entries used in `widget_types`. */
+    struct {
+        char type[24];                      /**< Widget type, e.g. "button". */
+        uint32_t count;
+    } widget_types[LVGL_JSON_MEM_REPORT_WIDGET_TYPES];
+
+    lvgl_json_registry_stats_t registry;    /**< As returned by lvgl_json_registry_stats(). */
+    uint32_t registry_components;           /**< Registered component definitions. */
+    uint32_t registry_styles;               /**< Registered styles. */
+    uint32_t strings;                       /**< Interned strings, static ones included. */
+    uint32_t static_strings;                /**< Strings of lvgl_json_register_str(). */
+} lvgl_json_memory_report_t;
+
+/**
+ * @brief Fills `out` with the heap the renderer holds by category, the LVGL heap before and
+ * after the last render, the widgets created per type and registry statistics.
+ *
+ * Every LV_MALLOC of the renderer is counted; cJSON trees it keeps (component definitions) are
+ * estimated from their nodes and strings. Memory LVGL allocates for the widgets and their
+ * styles only shows in the LVGL heap snapshots. Widget counts are reset together with the
+ * render stats, byte counts are not.
+ */
+void lvgl_json_get_memory_report(lvgl_json_memory_report_t *out);
+
+/**
+ * @brief Name of a memory category, e.g. "registry".
+ */
+const char* lvgl_json_mem_category_name(lvgl_json_mem_category_t category);
+
+/**
+ * @brief Frees the chunks retained by the render pass arena.
+ *
+ * Transient data of a render (cJSON nodes created while rendering, stream and binary views) is
+ * allocated from arena chunks that are kept for the next render. Call this after loading a UI
+ * to return that memory to the LVGL heap; it must not be called during a render.
+ */
+void lvgl_json_render_arena_release(void);
+
+/**
+ * @brief Shares identical local style properties between widgets (off by default).
+ *
+ * Style properties set directly on a widget ('bg_color', 'pad_all', ...) normally create a
+ * local style on every widget. With sharing on, the style properties of a widget are added at
+ * the end of its attributes as one lv_style_t per selector (lv_obj_add_style()), and widgets
+ * with the same values use the same style. That saves a local style per widget and lets LVGL
+ * refresh the styles of a widget once instead of once per property.
+ *
+ * Precedence changes slightly: the shared style is the newest normal style of the widget, so
+ * it still wins over 'add_style' in the same node, but a style added to the widget later (e.g.
+ * by a 'with' block) wins over it, which it would not over a local style. Strings and 'void *'
+ * values are always set locally. Templates of components are compiled with the setting at
+ * their first use. Compile with -DLVGL_JSON_STYLE_SHARING=0 to leave it out.
+ *
+ * @param enable true to share style properties of widgets rendered from now on.
+ */
+void lvgl_json_set_style_sharing(bool enable);
+
+/**
+ * @brief Frees the shared styles. Call it after deleting the widgets that use them.
+ */
+void lvgl_json_shared_styles_clear(void);
+
+#if LVGL_JSON_USE_LIVE
+/**
+ * @brief A rendered UI that can be updated from a changed spec. Opaque.
+ */
+typedef struct lvgl_json_live_ui_s lvgl_json_live_ui_t;
+
+/**
+ * @brief What lvgl_json_live_ui_update() did.
+ */
+typedef struct {
+    uint32_t widgets_kept;     /**< Widgets reused from the previous spec. */
+    uint32_t widgets_patched;  /**< Reused widgets whose changed properties were re-applied. */
+    uint32_t properties_set;   /**< Properties re-applied on reused widgets. */
+    uint32_t subtrees_created; /**< Nodes rendered from scratch, with their children. */
+    uint32_t subtrees_deleted; /**< Widgets deleted, with their children. */
+    bool full_render;          /**< The whole UI was rendered again. */
+} lvgl_json_live_stats_t;
+
+/**
+ * @brief Creates a live UI that renders into `parent` (lv_screen_active() if NULL).
+ * The live UI owns the children of `parent`; the first update cleans it.
+ * @return The live UI, or NULL if out of memory. Free with lvgl_json_live_ui_free().
+ */
+lvgl_json_live_ui_t *lvgl_json_live_ui_create(lv_obj_t *parent);
+
+/**
+ * @brief Shows `spec`, patching the widgets rendered from the previous spec.
+ *
+ * The previous and the new spec are compared node by node; children are paired with the next
+ * old sibling of the same type, 'id' and 'named', so inserted and removed nodes leave the others.
+ * Widgets of unchanged nodes are kept with their state (scroll position, focus, ...) and changed
+ * property values are re-applied to the existing widget. A node whose properties were added,
+ * removed or reordered, or whose 'type', 'id', 'named', 'context', 'action' or add_/remove_
+ * calls changed, is rendered again with its children. The 'do' blocks of use-view instances
+ * and 'with' blocks are patched the same way on the component root or the 'with' target; any
+ * other change to a use-view node renders that instance again, and a context wrapper with
+ * changed values renders its node again. Changes to styles and component definitions, which
+ * may be used anywhere, render the whole UI again; that also releases the strings of
+ * lvgl_json_register_str() and the shared styles, which patched widgets may still point to
+ * otherwise. A patch releases the lvgl_json_register_str() strings ('!' values) that
+ * the new spec no longer contains.
+ *
+ * @param ui The live UI.
+ * @param spec The new spec. The live UI takes ownership and keeps it until the next update.
+ * @param stats Optional, receives what was done.
+ * @return true if the UI was updated (or rendered) successfully.
+ */
+bool lvgl_json_live_ui_update(lvgl_json_live_ui_t *ui, cJSON *spec, lvgl_json_live_stats_t *stats);
+
+/**
+ * @brief Frees a live UI and its spec. The widgets are not deleted.
+ */
+void lvgl_json_live_ui_free(lvgl_json_live_ui_t *ui);
+#endif // LVGL_JSON_USE_LIVE
+
+/**
+ * @brief Builds the children of a container rendered with "lazy": true now.
+ *
+ * Lazy children are otherwise built when the container is first drawn, or when its tileview
+ * or tabview switches to it. Call this before touching them, e.g. to find a 'named' widget.
+ *
+ * @return true if the children were built by this call, false if they already were or
+ *         `container` is not lazy.
+ */
+bool lvgl_json_lazy_build(lv_obj_t *container);
+
+/**
+ * @brief Number of lazy containers whose children have not been built yet.
+ */
+uint32_t lvgl_json_lazy_pending(void);
+
+/**
+ * @brief Turns prefetching of lazy pages on or off.
+ *
+ * While on, a timer builds the lazy tiles and tabs next to the one their view shows, one per
+ * LVGL_JSON_LAZY_PREFETCH_PERIOD_MS, once input has been idle for LVGL_JSON_LAZY_PREFETCH_IDLE_MS.
+ */
+void lvgl_json_lazy_set_prefetch(bool enable);
+
+/**
+ * @brief Data source of a 'virtual-list' or 'for-each': fills `item` with the values of item `index`.
+ *
+ * `item` is an empty JSON object apart from "index"; add members with cJSON_Add*ToObject().
+ * They are the '$' variables of the row component while the row is bound. Register it with
+ * lvgl_json_register_ptr(name, "lvgl_json_list_source_cb_t", (void *)cb) for `source: '@name'`,
+ * or for `items: '@name'` in a 'for-each' (which passes no "index" member and NULL user data).
+ */
+typedef void (*lvgl_json_list_source_cb_t)(uint32_t index, cJSON *item, void *user_data);
+
+/**
+ * @brief Sets the data source of a virtual list and binds its rows again.
+ * @return false if `list` is not a virtual list.
+ */
+bool lvgl_json_virtual_list_set_source(lv_obj_t *list, lvgl_json_list_source_cb_t source, void *user_data);
+
+/**
+ * @brief Changes the number of items of a virtual list.
+ * @return false if `list` is not a virtual list.
+ */
+bool lvgl_json_virtual_list_set_count(lv_obj_t *list, uint32_t count);
+
+/**
+ * @brief Binds the rows on screen again, e.g. after the data behind the source changed.
+ * @return false if `list` is not a virtual list.
+ */
+bool lvgl_json_virtual_list_refresh(lv_obj_t *list);
+
+/**
+ * @brief The row showing item `index`, NULL if that item has no row now.
+ *
+ * Rows are reused for other items while scrolling; do not keep the pointer.
+ */
+lv_obj_t *lvgl_json_virtual_list_get_row(lv_obj_t *list, uint32_t index);
+
 // --- Custom Managed Object Creator Prototypes ---
 /** @brief Creates a managed lv_fs_drv_t identified by name. Allocates memory. */
 extern lv_fs_drv_t* lv_fs_drv_create_managed(const char *name);
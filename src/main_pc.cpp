@@ -23,6 +23,11 @@
 // #include "lv_drivers/sdl/sdl.h"
 #include "lvgl_json_renderer.h" // Your UI builder header
 
+// Reloading goes through a project and a live UI; --async-render needs time slicing too
+#if !LVGL_JSON_USE_PROJECT || !LVGL_JSON_USE_LIVE
+#error "The preview app needs LVGL_JSON_USE_PROJECT and LVGL_JSON_USE_LIVE"
+#endif
+
 // Define resolution if not coming from lv_conf.h or elsewhere
 #ifndef SDL_HOR_RES
 #define SDL_HOR_RES 480
@@ -50,8 +55,23 @@
 
 // --- Global state for file monitoring ---
 static char *monitored_filepath = NULL;
-static time_t last_mod_time = 0; // Store last modification time
 static uint32_t last_file_check_time = 0; // Track time for polling interval
+static lvgl_json_live_ui_t *live_ui = NULL; // Widgets of the last JSON or YAML file, patched on reload
+static const char *profile_trace_path = NULL; // --profile: Chrome trace written after each load
+static const char *scroll_bench_list = NULL; // --scroll-bench: virtual list scrolled after the first load
+static uint32_t async_render_budget_us = 0; // --async-render: JSON is rendered in steps of this budget instead of live
+static lvgl_json_project_t *project = NULL; // JSON or YAML file and its imports; unchanged files are not parsed again on reload
+static bool project_loaded = false; // The last load read the project's files (not a binary file)
+static const char *cache_dir = NULL; // --cache-dir: artifacts of parsed JSON and YAML files, "" for none
+static bool no_live = false; // --no-live: JSON is streamed from the file and rendered again on every reload
+
+// --- Watched files: the monitored file and, for JSON and YAML, the files it imports ---
+typedef struct {
+    char *path;
+    time_t mtime; // 0 if the file did not exist
+} watched_file_t;
+static watched_file_t *watched_files = NULL;
+static uint32_t watched_file_count = 0;
 
 
 volatile sig_atomic_t bRunning = true; // Keep the signal handler flag
@@ -64,6 +84,141 @@ void signal_handler(int interrupt) {
 }
 
 
+// Read callback for lvgl_json_render_stream()
+static size_t read_ui_file(void *user_data, char *buf, size_t buf_size) {
+    return fread(buf, 1, buf_size, (FILE *)user_data);
+}
+
+static bool is_yaml_file(const char *path) {
+    const char *dot = strrchr(path, '.');
+    return dot && (strcmp(dot, ".yaml") == 0 || strcmp(dot, ".yml") == 0);
+}
+
+// Logs LVGL heap usage and fragmentation, to compare before and after a reload.
+static void log_lvgl_heap(const char *when) {
+    lv_mem_monitor_t mon;
+    lv_mem_monitor(&mon);
+    LOG_INFO("LVGL heap %s: used %u%% (%u of %u bytes free), fragmentation %u%%, biggest free block %u bytes.",
+             when, (unsigned)mon.used_pct, (unsigned)mon.free_size, (unsigned)mon.total_size,
+             (unsigned)mon.frag_pct, (unsigned)mon.free_biggest_size);
+}
+
+// Logs lvgl_json_get_memory_report(): renderer heap by category, LVGL heap around the last
+// render pass, widgets created per type and registry contents.
+static void log_memory_report(void) {
+    lvgl_json_memory_report_t report;
+    lvgl_json_get_memory_report(&report);
+    char line[512];
+    int len = snprintf(line, sizeof(line), "Memory: %u bytes held by the renderer (", (unsigned)report.total_bytes);
+    for (int c = 0; c < LVGL_JSON_MEM_CATEGORY_COUNT && len < (int)sizeof(line); ++c) {
+        len += snprintf(line + len, sizeof(line) - len, "%s%s %u, peak %u", c ? "; " : "",
+                        lvgl_json_mem_category_name((lvgl_json_mem_category_t)c),
+                        (unsigned)report.bytes[c], (unsigned)report.peak_bytes[c]);
+    }
+    LOG_INFO("%s).", line);
+    if (report.lvgl_heap_valid) {
+        LOG_INFO("Memory: LVGL heap during the render went from %u%% to %u%% used (%u -> %u bytes free), fragmentation %u%% -> %u%%.",
+                 (unsigned)report.lvgl_before.used_pct, (unsigned)report.lvgl_after.used_pct,
+                 (unsigned)report.lvgl_before.free_size, (unsigned)report.lvgl_after.free_size,
+                 (unsigned)report.lvgl_before.frag_pct, (unsigned)report.lvgl_after.frag_pct);
+    }
+    len = snprintf(line, sizeof(line), "Memory: %u widgets created (", (unsigned)report.widgets_created);
+    for (uint32_t i = 0; i < report.widget_type_count && len < (int)sizeof(line); ++i) {
+        len += snprintf(line + len, sizeof(line) - len, "%s%s %u", i ? ", " : "",
+                        report.widget_types[i].type, (unsigned)report.widget_types[i].count);
+    }
+    LOG_INFO("%s).", line);
+    LOG_INFO("Memory: registry holds %u names (%u components, %u styles) and %u path nodes in %u slots, %u interned strings (%u static).",
+             (unsigned)report.registry.count, (unsigned)report.registry_components, (unsigned)report.registry_styles,
+             (unsigned)report.registry.placeholder_count, (unsigned)report.registry.capacity,
+             (unsigned)report.strings, (unsigned)report.static_strings);
+}
+
+// Rows for `source: '@demo_list_source'` in virtual lists (see examples/virtual_list.json).
+static void demo_list_source(uint32_t index, cJSON *item, void *user_data) {
+    (void)user_data;
+    char text[32];
+    snprintf(text, sizeof(text), "file_%05u.gcode", (unsigned)index);
+    cJSON_AddStringToObject(item, "name", text);
+    snprintf(text, sizeof(text), "%u kB", (unsigned)((index * 7919u) % 4096u));
+    cJSON_AddStringToObject(item, "size", text);
+    cJSON_AddStringToObject(item, "color", index % 2 ? "#202020" : "#303030");
+}
+
+// Scrolls the virtual list registered as `name` to its end, one refresh per step, and logs frame times.
+static void run_scroll_bench(const char *name) {
+    lv_obj_t *list = (lv_obj_t *)lvgl_json_get_registered_ptr(name, "lv_obj_t");
+    if (!list || !lvgl_json_virtual_list_refresh(list)) {
+        LOG_ERROR("Scroll bench: '%s' is not a virtual list.", name);
+        return;
+    }
+    lv_refr_now(NULL);
+    const int32_t step = 8;
+    double freq_ms = (double)SDL_GetPerformanceFrequency() / 1000.0;
+    double total_ms = 0, worst_ms = 0;
+    uint32_t frames = 0;
+    while (lv_obj_get_scroll_bottom(list) > 0) {
+        uint64_t start = SDL_GetPerformanceCounter();
+        lv_obj_scroll_by(list, 0, -step, LV_ANIM_OFF);
+        lv_refr_now(NULL);
+        double ms = (double)(SDL_GetPerformanceCounter() - start) / freq_ms;
+        total_ms += ms;
+        if (ms > worst_ms) worst_ms = ms;
+        frames++;
+    }
+    LOG_INFO("Scroll bench: %u frames of %d px, %.3f ms average, %.3f ms worst, %u children in the list.",
+             (unsigned)frames, (int)step, frames ? total_ms / frames : 0.0, worst_ms,
+             (unsigned)lv_obj_get_child_count(list));
+    log_memory_report();
+}
+
+static time_t file_mtime(const char *path) {
+    struct stat st;
+    return stat(path, &st) == 0 ? st.st_mtime : 0;
+}
+
+static void watch_file(const char *path) {
+    for (uint32_t i = 0; i < watched_file_count; ++i) {
+        if (strcmp(watched_files[i].path, path) == 0) return;
+    }
+    watched_file_t *files = (watched_file_t *)realloc(watched_files, (watched_file_count + 1) * sizeof(watched_file_t));
+    if (!files) return;
+    watched_files = files;
+    watched_files[watched_file_count].path = strdup(path);
+    watched_files[watched_file_count].mtime = file_mtime(path);
+    if (watched_files[watched_file_count].path) watched_file_count++;
+}
+
+// Remembers the modification times of the files the last load read, including one that failed.
+static void watch_loaded_files(void) {
+    for (uint32_t i = 0; i < watched_file_count; ++i) free(watched_files[i].path);
+    watched_file_count = 0;
+    watch_file(monitored_filepath);
+    uint32_t count = project_loaded ? lvgl_json_project_file_count(project) : 0;
+    for (uint32_t i = 0; i < count; ++i) watch_file(lvgl_json_project_file_path(project, i));
+}
+
+// Returns a watched file that was modified, created or deleted since watch_loaded_files(), NULL if none.
+static const char *changed_watched_file(void) {
+    for (uint32_t i = 0; i < watched_file_count; ++i) {
+        if (file_mtime(watched_files[i].path) != watched_files[i].mtime) return watched_files[i].path;
+    }
+    return NULL;
+}
+
+#if LVGL_JSON_USE_SLICING
+// End of an --async-render load: frees the spec and logs how the steps kept to their budget.
+static void async_render_done(bool success, void *user_data) {
+    cJSON_Delete((cJSON *)user_data);
+    lvgl_json_render_stats_t stats;
+    lvgl_json_get_render_stats(&stats);
+    LOG_INFO("Async render %s: %u steps of %u us, %u over budget, %u us worst.",
+             success ? "done" : "stopped", (unsigned)stats.slice_steps, (unsigned)async_render_budget_us,
+             (unsigned)stats.slice_steps_over_budget, (unsigned)stats.slice_max_step_us);
+    log_memory_report();
+}
+#endif
+
 // --- Helper Function: Load UI from File ---
 // (Copied from previous file-watching example, adapted logging)
 bool load_and_build_ui(const char *filepath) {
@@ -101,9 +256,13 @@ bool load_and_build_ui(const char *filepath) {
         fclose(fp);
         // Treat empty file as "show nothing". build_ui_from_json should handle null/empty string gracefully
         // or we clear explicitly here.
+        lvgl_json_live_ui_free(live_ui);
+        live_ui = NULL;
         lv_obj_t * scr = lv_screen_active();
         if (scr) {
             lv_obj_clean(scr);
+            lvgl_json_register_str_clear();
+            lvgl_json_shared_styles_clear();
             lv_obj_t* lbl = lv_label_create(scr);
             lv_label_set_text(lbl, "Error:\nFailed processing\nempty UI file.");
             lv_obj_center(lbl);
@@ -111,43 +270,157 @@ bool load_and_build_ui(const char *filepath) {
         return false; // Indicate failure
     }
 
-    // --- Allocate buffer and read file ---
-    // Use malloc for file content buffer, size based on file
-    char *file_content = (char *)malloc(file_size + 1); // +1 for null terminator
-    if (!file_content) {
-        LOG_ERROR("Failed to allocate %ld bytes for file content from '%s'", file_size + 1, filepath);
-        fclose(fp);
-        return false;
+    // --- Build UI ---
+    // Binary UI files (gen/ui_binary.py) are loaded and rendered in place. JSON and YAML (*.yaml,
+    // *.yml; no yq step) are loaded with their imports by the project, which only parses files
+    // that changed, and handed to the live UI, which only patches the widgets of nodes that changed.
+    // With --no-live, JSON is streamed straight from the file instead: no copy of the spec is kept
+    // between reloads, imports are not followed and every reload renders everything again.
+    char magic[4] = {0};
+    bool is_binary = file_size >= 4 && fread(magic, 1, 4, fp) == 4 && memcmp(magic, "LVJB", 4) == 0;
+#if LVGL_JSON_USE_STREAM
+    bool is_stream = !is_binary && no_live && !async_render_budget_us && !is_yaml_file(filepath);
+#else
+    bool is_stream = false;
+#endif
+    char *file_content = NULL;
+    if (is_binary || is_stream) {
+        if (fseek(fp, 0, SEEK_SET) != 0) {
+            LOG_ERROR("fseek SEEK_SET failed for '%s': %s", filepath, strerror(errno));
+            fclose(fp);
+            return false;
+        }
     }
-
-    size_t bytes_read = fread(file_content, 1, file_size, fp);
-    fclose(fp); // Close file as soon as read is done
-
-    if (bytes_read != (size_t)file_size) {
-        LOG_ERROR("Failed to read entire file '%s' (%zu bytes read, %ld expected)", filepath, bytes_read, file_size);
-        free(file_content);
-        return false;
+    if (is_binary) {
+        file_content = (char *)malloc(file_size);
+        if (!file_content) {
+            LOG_ERROR("Failed to allocate %ld bytes for file content from '%s'", file_size, filepath);
+            fclose(fp);
+            return false;
+        }
+        size_t bytes_read = fread(file_content, 1, file_size, fp);
+        if (bytes_read != (size_t)file_size) {
+            LOG_ERROR("Failed to read entire file '%s' (%zu bytes read, %ld expected)", filepath, bytes_read, file_size);
+            free(file_content);
+            fclose(fp);
+            return false;
+        }
     }
+    if (!is_stream) fclose(fp); // Close file as soon as read is done
+    project_loaded = !is_binary && !is_stream;
 
-    file_content[file_size] = '\0'; // Null-terminate the content for cJSON
-
-    // --- Build UI ---
-    // build_ui_from_json will clear the screen before building
-    cJSON *root = cJSON_Parse(file_content);
-    if (!root) {
-        LOG_ERROR("Failed to parse JSON");
-        return false;
+    // The binary buffer stays alive until the next reload since widgets may point into it.
+    static char *binary_content = NULL;
+    lv_obj_t * scr = lv_screen_active();
+#if LVGL_JSON_USE_SLICING
+    lvgl_json_render_cancel(); // An --async-render load still running: its widgets go now
+#endif
+    log_lvgl_heap("before render");
+    lvgl_json_reset_render_stats();
+#if LVGL_JSON_PROFILE
+    if (profile_trace_path) lvgl_json_profile_start(0);
+#endif
+    bool success;
+    if (is_binary) {
+        lvgl_json_live_ui_free(live_ui);
+        live_ui = NULL;
+        lvgl_json_register_str_clear();
+        lv_obj_clean(scr);
+        lvgl_json_shared_styles_clear();
+        free(binary_content);
+        binary_content = file_content;
+        success = lvgl_json_render_binary(binary_content, (size_t)file_size, scr);
+#if LVGL_JSON_USE_STREAM
+    } else if (is_stream) {
+        lvgl_json_live_ui_free(live_ui);
+        live_ui = NULL;
+        lvgl_json_register_str_clear();
+        lv_obj_clean(scr);
+        lvgl_json_shared_styles_clear();
+        success = lvgl_json_render_stream(read_ui_file, fp, scr);
+        fclose(fp);
+#endif
+    } else {
+        uint64_t start = SDL_GetPerformanceCounter();
+        if (!project) project = lvgl_json_project_create(NULL, cache_dir[0] ? cache_dir : NULL);
+        lvgl_json_project_stats_t project_stats;
+        cJSON *spec = lvgl_json_project_load(project, filepath, &project_stats);
+        if (!spec) {
+            // Keep showing the last UI that loaded, a file is probably being edited
+            LOG_ERROR("Failed to load '%s' and its imports.", filepath);
+#if LVGL_JSON_PROFILE
+            if (profile_trace_path) lvgl_json_profile_stop();
+#endif
+            return false;
+        }
+        uint64_t parsed = SDL_GetPerformanceCounter();
+        LOG_INFO("Project: %u files, %u unchanged, %u from the cache, %u parsed (%u bytes read) in %.2f ms.",
+                 (unsigned)project_stats.files, (unsigned)project_stats.files_reused, (unsigned)project_stats.files_cached,
+                 (unsigned)project_stats.files_parsed, (unsigned)project_stats.bytes_read,
+                 (double)(parsed - start) * 1000.0 / (double)SDL_GetPerformanceFrequency());
+#if LVGL_JSON_USE_SLICING
+        if (async_render_budget_us) {
+            // Widgets appear over the next frames; async_render_done() frees the spec
+            lv_obj_clean(scr);
+            lvgl_json_register_str_clear();
+            lvgl_json_shared_styles_clear();
+            success = lvgl_json_render_async(spec, scr, async_render_budget_us, async_render_done, spec);
+            if (!success) cJSON_Delete(spec);
+        } else
+#endif
+        {
+            if (!live_ui) {
+                lv_obj_clean(scr);
+                live_ui = lvgl_json_live_ui_create(scr);
+            }
+            lvgl_json_live_stats_t live_stats;
+            if (live_ui) {
+                success = lvgl_json_live_ui_update(live_ui, spec, &live_stats);
+            } else {
+                cJSON_Delete(spec);
+                success = false;
+            }
+            double freq_ms = (double)SDL_GetPerformanceFrequency() / 1000.0;
+            double parse_ms = (double)(parsed - start) / freq_ms;
+            double total_ms = (double)(SDL_GetPerformanceCounter() - start) / freq_ms;
+            if (live_ui) {
+                LOG_INFO("Reload: %s, %u widgets kept (%u patched, %u properties), %u created, %u deleted in %.2f ms (load %.2f ms).",
+                         live_stats.full_render ? "full render" : "patched", (unsigned)live_stats.widgets_kept,
+                         (unsigned)live_stats.widgets_patched, (unsigned)live_stats.properties_set,
+                         (unsigned)live_stats.subtrees_created, (unsigned)live_stats.subtrees_deleted, total_ms, parse_ms);
+            }
+        }
     }
-    free(file_content); // Free the buffer
 
-    lvgl_json_register_str_clear();
+#if LVGL_JSON_PROFILE
+    if (profile_trace_path) {
+        lvgl_json_profile_stop();
+        if (lvgl_json_profile_write_trace(profile_trace_path)) {
+            LOG_INFO("Profile: trace of %u events written to '%s'.", (unsigned)lvgl_json_profile_event_count(NULL), profile_trace_path);
+        }
+        lvgl_json_profile_print_summary(15);
+    }
+#endif
 
-    lv_obj_t * scr = lv_screen_active();
-    lv_obj_clean(scr);
-    bool success = lvgl_json_render_ui(root, scr);
+    lvgl_json_render_stats_t stats;
+    lvgl_json_get_render_stats(&stats);
+    LOG_INFO("Render: %u heap allocations, %u arena allocations (%u bytes, peak %u, %u bytes of chunks).",
+             (unsigned)stats.heap_allocs, (unsigned)stats.arena_allocs, (unsigned)stats.arena_bytes,
+             (unsigned)stats.arena_peak_bytes, (unsigned)stats.arena_chunk_bytes);
+    if (stats.shared_style_uses) {
+        LOG_INFO("Shared styles: %u added to widgets, %u styles held (%u bytes), about %u bytes of local styles saved.",
+                 (unsigned)stats.shared_style_uses, (unsigned)stats.shared_styles, (unsigned)stats.shared_style_bytes,
+                 (unsigned)stats.local_style_bytes_saved);
+    }
+    if (stats.lazy_deferred) {
+        LOG_INFO("Lazy: %u containers deferred their children, %u not built yet.",
+                 (unsigned)stats.lazy_deferred, (unsigned)lvgl_json_lazy_pending());
+    }
+    log_lvgl_heap("after render");
+    log_memory_report();
 
     if (!success) {
-        LOG_ERROR("Failed to build UI from JSON content of '%s'.", filepath);
+        LOG_ERROR("Failed to build UI from the content of '%s'.", filepath);
          // build_ui_from_json might have cleared screen, show error
          // lv_obj_t * scr = lv_screen_active();
          if (scr) {
@@ -226,21 +499,36 @@ int main_transpiled(int argc, char *argv[]) {
 }
 
 int main_render(int argc, char *argv[]) {
+    // Build lazy tiles and tabs next to the shown one while there is no input
+    lvgl_json_lazy_set_prefetch(true);
+
     // --- Initial UI Load ---
     LOG_USER("Monitoring file: %s", monitored_filepath);
+    if (!cache_dir) {
+        // Artifacts are named after their content, so one directory serves all UI files
+        static char default_cache_dir[512];
+        const char *tmp = getenv("TMPDIR");
+        snprintf(default_cache_dir, sizeof(default_cache_dir), "%s/lvgl_json_cache", tmp && tmp[0] ? tmp : "/tmp");
+        cache_dir = default_cache_dir;
+    }
+    if (cache_dir[0] && mkdir(cache_dir, 0755) != 0 && errno != EEXIST) {
+        LOG_WARN("Cannot create cache directory '%s': %s. UI files are parsed on every start.", cache_dir, strerror(errno));
+        cache_dir = "";
+    }
     struct stat initial_stat;
     bool initial_load_success = false;
     if (stat(monitored_filepath, &initial_stat) == 0) {
-        if (load_and_build_ui(monitored_filepath)) {
-             last_mod_time = initial_stat.st_mtime; // Store initial mod time on success
-             initial_load_success = true;
-        }
+        initial_load_success = load_and_build_ui(monitored_filepath);
         // Error message handled within load_and_build_ui if it failed
+        if (initial_load_success && scroll_bench_list) run_scroll_bench(scroll_bench_list);
     } else {
         // File doesn't exist or error stating it initially
         LOG_WARN("Initial stat failed for '%s': %s. Waiting for file creation.", monitored_filepath, strerror(errno));
-        // last_mod_time remains 0, so the first successful stat will trigger a load
+        // Its creation shows up as a change of the watched file
     }
+    int initial_errno = errno;
+    watch_loaded_files();
+    errno = initial_errno;
 
     if (!initial_load_success) {
         // Show a waiting message if initial load didn't happen or failed
@@ -261,36 +549,20 @@ int main_render(int argc, char *argv[]) {
     while (bRunning) {
         uint32_t current_time_ms = SDL_GetTicks(); // Get current time once per loop
 
-        // --- Check File for Modifications (Polling) ---
+        // --- Check Files for Modifications (Polling) ---
         if (current_time_ms - last_file_check_time >= FILE_POLL_INTERVAL_MS) {
             last_file_check_time = current_time_ms; // Update check time
-            struct stat current_stat;
-            if (stat(monitored_filepath, &current_stat) == 0) {
-                // File exists, check modification time
-                if (current_stat.st_mtime != last_mod_time) {
-                    LOG_INFO("Detected file change (mtime: %ld -> %ld). Reloading...",
-                              (long)last_mod_time, (long)current_stat.st_mtime);
-
-                    // Attempt to reload UI, update last_mod_time only on success
-                    if (load_and_build_ui(monitored_filepath)) {
-                        last_mod_time = current_stat.st_mtime;
-                    } else {
-                        // Reload failed, keep old mod time to retry on next change
-                        // Error message handled within load_and_build_ui
-                    }
-                }
-            } else {
-                // Stat failed - file might be deleted or inaccessible
-                if (errno == ENOENT) {
-                    if (last_mod_time != 0) { // Log only if it existed before
-                        LOG_WARN("Monitored file '%s' seems to have been deleted.", monitored_filepath);
-                        // Keep the last valid UI displayed
-                        last_mod_time = 0; // Reset time so it reloads if recreated
-                    }
+            const char *changed_path = changed_watched_file();
+            if (changed_path) {
+                if (file_mtime(changed_path) == 0) {
+                    // Keep the last valid UI displayed, it reloads once the file is back
+                    LOG_WARN("Watched file '%s' seems to have been deleted.", changed_path);
                 } else {
-                     // Other error (e.g., permissions)
-                     LOG_WARN("stat failed for '%s': %s", monitored_filepath, strerror(errno));
+                    LOG_INFO("Detected a change of '%s'. Reloading...", changed_path);
                 }
+                // A failed reload is retried on the next change; errors are handled within load_and_build_ui
+                load_and_build_ui(monitored_filepath);
+                watch_loaded_files();
             }
         }
 
@@ -326,11 +598,41 @@ void btn_clicked(lv_event_t *evt) {
 int main(int argc, char *argv[]) {
 
     // --- Argument Parsing ---
-    if (argc < 2) {
-        fprintf(stderr, "Usage: %s <path_to_ui_json_file>\n", argv[0]);
+    for (int i = 1; i < argc; ++i) {
+        if (strcmp(argv[i], "--share-styles") == 0) {
+            lvgl_json_set_style_sharing(true);
+        } else if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+#if LVGL_JSON_PROFILE
+            profile_trace_path = argv[++i];
+#else
+            fprintf(stderr, "--profile needs a build with -D LVGL_JSON_PROFILE=1\n");
+            return 1;
+#endif
+        } else if (strcmp(argv[i], "--scroll-bench") == 0 && i + 1 < argc) {
+            scroll_bench_list = argv[++i];
+        } else if (strcmp(argv[i], "--async-render") == 0 && i + 1 < argc) {
+#if LVGL_JSON_USE_SLICING
+            async_render_budget_us = (uint32_t)strtoul(argv[++i], NULL, 10);
+#else
+            fprintf(stderr, "--async-render needs a build with -D LVGL_JSON_USE_SLICING=1\n");
+            return 1;
+#endif
+        } else if (strcmp(argv[i], "--cache-dir") == 0 && i + 1 < argc) {
+            cache_dir = argv[++i];
+        } else if (strcmp(argv[i], "--no-live") == 0) {
+            no_live = true;
+        } else if (argv[i][0] == '-') {
+            fprintf(stderr, "Unknown option '%s'\n", argv[i]);
+            monitored_filepath = NULL;
+            break;
+        } else {
+            monitored_filepath = argv[i];
+        }
+    }
+    if (!monitored_filepath) {
+        fprintf(stderr, "Usage: %s [--share-styles] [--profile <trace.json>] [--scroll-bench <list_name>] [--async-render <budget_us>] [--cache-dir <dir>] [--no-live] <path_to_ui_json_yaml_or_bin_file>\n", argv[0]);
         return 1;
     }
-    monitored_filepath = argv[1];
 
 
     // --- LVGL & SDL Initialization (using target code's style) ---
@@ -379,6 +681,7 @@ int main(int argc, char *argv[]) {
     lvgl_json_register_ptr("font_montserrat_12", "lv_font_t", (void *) &lv_font_montserrat_12);
 
     lvgl_json_register_ptr("btn_clicked", "lv_event_cb_t", (void *) &btn_clicked);
+    lvgl_json_register_ptr("demo_list_source", "lvgl_json_list_source_cb_t", (void *) &demo_list_source);
 
 //#define TRANSPILE
 #ifdef TRANSPILE
@@ -0,0 +1,39 @@
+// Host benchmarks for lvgl_json_renderer: pio run -e bench -t execute
+// (or .pio/build/bench/program <bench> [args]). See README "Benchmarks".
+#ifndef LVGL_JSON_BENCH_H
+#define LVGL_JSON_BENCH_H
+
+#include "lvgl_json_renderer.h"
+#include <stdint.h>
+#include <stddef.h>
+
+// Monotonic clock in nanoseconds.
+uint64_t bench_now_ns(void);
+
+// Reads a whole file, NUL-terminated. Free with free(); NULL if it cannot be read.
+char *bench_read_file(const char *path, size_t *len);
+
+// A new empty screen; the previous one is deleted. Render into it so runs start alike.
+lv_obj_t *bench_screen(void);
+
+// --- Renderer internals (bench_internal.c) ---
+uint32_t bench_invoke_count(void);
+const char *bench_invoke_name(uint32_t index);
+const void *bench_find_invoke_entry(const char *name);
+const void *bench_find_invoke_entry_linear(const char *name); // The scan find_invoke_entry() replaced
+size_t bench_binary_view_bytes(const void *buf, size_t len);     // cJSON view lvgl_json_render_binary() builds
+bool bench_component_force_json(const char *id);                 // Before its first use-view: skip the template
+
+// --- Benchmarks: argv[0] is the benchmark name; return 0 on success ---
+int bench_invoke(int argc, char **argv);
+int bench_binary(int argc, char **argv);
+int bench_registry(int argc, char **argv);
+int bench_template(int argc, char **argv);
+int bench_live(int argc, char **argv);
+int bench_styles(int argc, char **argv);
+int bench_vlist(int argc, char **argv);
+int bench_slicing(int argc, char **argv);
+int bench_project(int argc, char **argv);
+int bench_yaml(int argc, char **argv);
+
+#endif // LVGL_JSON_BENCH_H
@@ -0,0 +1,88 @@
+// Boot time and memory of a UI loaded from JSON text (cJSON_Parse() + lvgl_json_render_ui())
+// and from the binary format (lvgl_json_render_binary(), encoded once up front).
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// cJSON allocations while parsing, with a size header so frees can be counted too
+static size_t parse_bytes, parse_allocs;
+
+static void *counting_malloc(size_t size) {
+    size_t *p = (size_t *)malloc(size + sizeof(max_align_t));
+    if (!p) return NULL;
+    *p = size;
+    parse_bytes += size;
+    parse_allocs++;
+    return (char *)p + sizeof(max_align_t);
+}
+
+static void counting_free(void *ptr) {
+    if (ptr) free((char *)ptr - sizeof(max_align_t));
+}
+
+static int compare_u64(const void *a, const void *b) {
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+static void report(const char *what, uint64_t *times, int reps) {
+    qsort(times, (size_t)reps, sizeof(times[0]), compare_u64);
+    printf("  %-22s min %.3f ms  median %.3f ms\n", what, times[0] / 1e6, times[reps / 2] / 1e6);
+}
+
+int bench_binary(int argc, char **argv) {
+    const char *path = argc > 1 ? argv[1] : "ui.json";
+    int reps = argc > 2 ? atoi(argv[2]) : 200;
+    size_t text_len;
+    char *text = bench_read_file(path, &text_len);
+    if (!text || reps <= 0) {
+        fprintf(stderr, "binary: cannot read '%s'\n", path);
+        free(text);
+        return 1;
+    }
+
+    cJSON_Hooks hooks = { counting_malloc, counting_free };
+    cJSON_InitHooks(&hooks);
+    cJSON *spec = cJSON_Parse(text);
+    size_t bin_len = 0;
+    void *bin = spec ? lvgl_json_encode_binary(spec, &bin_len) : NULL;
+    cJSON_Delete(spec);
+    cJSON_InitHooks(NULL);
+    if (!bin) {
+        fprintf(stderr, "binary: cannot encode '%s'\n", path);
+        free(text);
+        return 1;
+    }
+
+    uint64_t *json_times = (uint64_t *)malloc((size_t)reps * sizeof(uint64_t));
+    uint64_t *bin_times = (uint64_t *)malloc((size_t)reps * sizeof(uint64_t));
+    bool ok = json_times && bin_times;
+    for (int r = 0; ok && r < reps; ++r) {
+        lv_obj_t *scr = bench_screen();
+        uint64_t t0 = bench_now_ns();
+        cJSON *tree = cJSON_Parse(text);
+        ok = tree && lvgl_json_render_ui(tree, scr);
+        cJSON_Delete(tree);
+        json_times[r] = bench_now_ns() - t0;
+
+        scr = bench_screen();
+        t0 = bench_now_ns();
+        ok = ok && lvgl_json_render_binary(bin, bin_len, scr);
+        bin_times[r] = bench_now_ns() - t0;
+    }
+    bench_screen();
+
+    if (ok) {
+        printf("binary: %s, %u bytes of JSON, %u bytes binary, %d boots\n", path, (unsigned)text_len, (unsigned)bin_len, reps);
+        report("cJSON_Parse + render", json_times, reps);
+        report("render_binary", bin_times, reps);
+        printf("  cJSON_Parse tree %u bytes in %u allocations; binary view %u bytes in 1\n",
+               (unsigned)parse_bytes, (unsigned)parse_allocs, (unsigned)bench_binary_view_bytes(bin, bin_len));
+    }
+    free(json_times);
+    free(bin_times);
+    lv_free(bin);
+    free(text);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,39 @@
+// Builds the renderer into the bench program and exposes the internals the benchmarks time.
+// The bench env compiles this file instead of src/lvgl_json_renderer.c.
+#include "../../src/lvgl_json_renderer.c"
+#include "bench.h"
+
+uint32_t bench_invoke_count(void) {
+    return INVOKE_TABLE_SIZE;
+}
+
+const char *bench_invoke_name(uint32_t index) {
+    return index < INVOKE_TABLE_SIZE ? g_invoke_table[index].name : NULL;
+}
+
+const void *bench_find_invoke_entry(const char *name) {
+    return find_invoke_entry(name);
+}
+
+const void *bench_find_invoke_entry_linear(const char *name) {
+    for (uint32_t i = 0; i < INVOKE_TABLE_SIZE; ++i) {
+        if (strcmp(g_invoke_table[i].name, name) == 0) return &g_invoke_table[i];
+    }
+    return NULL;
+}
+
+size_t bench_binary_view_bytes(const void *buf, size_t len) {
+    size_t size = 0;
+    render_pass_begin();
+    cJSON *view = lvjb_view_create(buf, len, false, &size);
+    render_scratch_free(view, size);
+    render_pass_end();
+    return view ? size : 0;
+}
+
+bool bench_component_force_json(const char *id) {
+    component_def_t *component = (component_def_t *)lvgl_json_get_registered_ptr(id, "component_def");
+    if (!component || component->template_compiled) return false;
+    component->template_compiled = true; // Never compiled: every use-view renders the JSON root
+    return true;
+}
@@ -0,0 +1,48 @@
+// Invoke table lookups: every table name (hits) and every name with a suffix (misses), the way
+// property resolution probes candidate setter names.
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+int bench_invoke(int argc, char **argv) {
+    int reps = argc > 1 ? atoi(argv[1]) : 200;
+    uint32_t n = bench_invoke_count();
+    char (*miss)[96] = (char (*)[96])malloc(n * sizeof(*miss));
+    if (!miss || reps <= 0) {
+        free(miss);
+        return 1;
+    }
+    int bad = 0;
+    for (uint32_t i = 0; i < n; ++i) {
+        snprintf(miss[i], sizeof(miss[i]), "%s_x", bench_invoke_name(i));
+        if (bench_find_invoke_entry(bench_invoke_name(i)) != bench_find_invoke_entry_linear(bench_invoke_name(i))) bad++;
+        if (bench_find_invoke_entry(miss[i]) != bench_find_invoke_entry_linear(miss[i])) bad++;
+    }
+
+    const void *volatile sink;
+    double lookups = (double)reps * n;
+    int linear_reps = reps / 20 > 0 ? reps / 20 : 1;
+    double linear_lookups = (double)linear_reps * n;
+
+    uint64_t t0 = bench_now_ns();
+    for (int r = 0; r < reps; ++r)
+        for (uint32_t i = 0; i < n; ++i) sink = bench_find_invoke_entry(bench_invoke_name(i));
+    uint64_t t1 = bench_now_ns();
+    for (int r = 0; r < reps; ++r)
+        for (uint32_t i = 0; i < n; ++i) sink = bench_find_invoke_entry(miss[i]);
+    uint64_t t2 = bench_now_ns();
+    for (int r = 0; r < linear_reps; ++r)
+        for (uint32_t i = 0; i < n; ++i) sink = bench_find_invoke_entry_linear(bench_invoke_name(i));
+    uint64_t t3 = bench_now_ns();
+    for (int r = 0; r < linear_reps; ++r)
+        for (uint32_t i = 0; i < n; ++i) sink = bench_find_invoke_entry_linear(miss[i]);
+    uint64_t t4 = bench_now_ns();
+    (void)sink;
+
+    printf("invoke: %u names\n", (unsigned)n);
+    printf("  perfect hash  %7.1f ns/hit  %7.1f ns/miss\n", (t1 - t0) / lookups, (t2 - t1) / lookups);
+    printf("  linear scan   %7.1f ns/hit  %7.1f ns/miss\n", (t3 - t2) / linear_lookups, (t4 - t3) / linear_lookups);
+    if (bad) printf("  %d lookups differ from the linear scan\n", bad);
+    free(miss);
+    return bad != 0;
+}
@@ -0,0 +1,159 @@
+// Hot reload: a one-property edit applied through a live UI, against rendering the whole spec
+// again. The spec is N rows of a container with two labels and a button; each reload changes
+// the text of the middle row's first label. The same rows as 'use-view' instances of a row
+// component then have the middle instance's context edited. Copying the spec is left out of
+// all timings.
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_LIVE_WIDGETS_PER_ROW 5
+
+static cJSON *bench_live_label(const char *text) {
+    cJSON *label = cJSON_CreateObject();
+    cJSON_AddStringToObject(label, "type", "label");
+    cJSON_AddStringToObject(label, "text", text);
+    return label;
+}
+
+// The row component: a container with two labels from the context and a button
+static cJSON *bench_live_component(void) {
+    cJSON *component = cJSON_CreateObject();
+    cJSON_AddStringToObject(component, "type", "component");
+    cJSON_AddStringToObject(component, "id", "@bench_row");
+    cJSON *row = cJSON_AddObjectToObject(component, "root");
+    cJSON_AddStringToObject(row, "type", "obj");
+    cJSON_AddNumberToObject(row, "width", 300);
+    cJSON_AddNumberToObject(row, "height", 40);
+    cJSON *cells = cJSON_AddArrayToObject(row, "children");
+    cJSON_AddItemToArray(cells, bench_live_label("$title"));
+    cJSON_AddItemToArray(cells, bench_live_label("$value"));
+    cJSON *button = cJSON_CreateObject();
+    cJSON_AddStringToObject(button, "type", "button");
+    cJSON_AddItemToArray(cJSON_AddArrayToObject(button, "children"), bench_live_label("Go"));
+    cJSON_AddItemToArray(cells, button);
+    return component;
+}
+
+static cJSON *bench_live_view(int i) {
+    char text[32];
+    cJSON *view = cJSON_CreateObject();
+    cJSON_AddStringToObject(view, "type", "use-view");
+    cJSON_AddStringToObject(view, "id", "@bench_row");
+    cJSON *context = cJSON_AddObjectToObject(view, "context");
+    snprintf(text, sizeof(text), "Row %d", i);
+    cJSON_AddStringToObject(context, "title", text);
+    snprintf(text, sizeof(text), "%d", i * 10);
+    cJSON_AddStringToObject(context, "value", text);
+    return view;
+}
+
+static cJSON *bench_live_spec(int rows, bool views) {
+    cJSON *spec = cJSON_CreateArray();
+    if (views) cJSON_AddItemToArray(spec, bench_live_component());
+    cJSON *root = cJSON_CreateObject();
+    cJSON_AddStringToObject(root, "type", "obj");
+    cJSON_AddStringToObject(root, "named", "bench");
+    cJSON *children = cJSON_AddArrayToObject(root, "children");
+    for (int i = 0; i < rows; ++i) {
+        if (views) {
+            cJSON_AddItemToArray(children, bench_live_view(i));
+            continue;
+        }
+        char text[32];
+        cJSON *row = cJSON_CreateObject();
+        cJSON_AddStringToObject(row, "type", "obj");
+        cJSON_AddNumberToObject(row, "width", 300);
+        cJSON_AddNumberToObject(row, "height", 40);
+        cJSON *cells = cJSON_AddArrayToObject(row, "children");
+        snprintf(text, sizeof(text), "Row %d", i);
+        cJSON_AddItemToArray(cells, bench_live_label(text));
+        snprintf(text, sizeof(text), "%d", i * 10);
+        cJSON_AddItemToArray(cells, bench_live_label(text));
+        cJSON *button = cJSON_CreateObject();
+        cJSON_AddStringToObject(button, "type", "button");
+        cJSON_AddItemToArray(cJSON_AddArrayToObject(button, "children"), bench_live_label("Go"));
+        cJSON_AddItemToArray(cells, button);
+        cJSON_AddItemToArray(children, row);
+    }
+    cJSON_AddItemToArray(spec, root);
+    return spec;
+}
+
+// The spec with the middle row's first label showing `text`: its own text, or the title in the
+// context of its instance
+static cJSON *bench_live_edit(const cJSON *spec, int rows, const char *text) {
+    cJSON *copy = cJSON_Duplicate(spec, true);
+    cJSON *root = cJSON_GetArrayItem(copy, cJSON_GetArraySize(copy) - 1);
+    cJSON *row = cJSON_GetArrayItem(cJSON_GetObjectItemCaseSensitive(root, "children"), rows / 2);
+    cJSON *context = cJSON_GetObjectItemCaseSensitive(row, "context");
+    if (context) {
+        cJSON_ReplaceItemInObject(context, "title", cJSON_CreateString(text));
+    } else {
+        cJSON *label = cJSON_GetArrayItem(cJSON_GetObjectItemCaseSensitive(row, "children"), 0);
+        cJSON_ReplaceItemInObject(label, "text", cJSON_CreateString(text));
+    }
+    return copy;
+}
+
+// Best full render and best live update of `reps` edits; false if an update did not do what
+// the edit calls for (one property set, or one instance rendered again)
+static bool bench_live_run(int rows, bool views, int reps, uint64_t *full_best, uint64_t *patch_best,
+                           lvgl_json_live_stats_t *stats) {
+    cJSON *spec = bench_live_spec(rows, views);
+    *full_best = *patch_best = UINT64_MAX;
+    bool ok = true;
+    for (int r = 0; ok && r < reps; ++r) {
+        lv_obj_t *screen = bench_screen();
+        lvgl_json_registry_remove("bench");
+        uint64_t t0 = bench_now_ns();
+        ok = lvgl_json_render_ui(spec, screen);
+        uint64_t t = bench_now_ns() - t0;
+        if (t < *full_best) *full_best = t;
+    }
+    lvgl_json_registry_remove("bench");
+
+    lvgl_json_live_ui_t *ui = ok ? lvgl_json_live_ui_create(bench_screen()) : NULL;
+    ok = ui && lvgl_json_live_ui_update(ui, cJSON_Duplicate(spec, true), stats);
+    for (int r = 0; ok && r < reps; ++r) {
+        char text[32];
+        snprintf(text, sizeof(text), "Edit %d", r);
+        cJSON *next = bench_live_edit(spec, rows, text);
+        uint64_t t0 = bench_now_ns();
+        ok = lvgl_json_live_ui_update(ui, next, stats);
+        uint64_t t = bench_now_ns() - t0;
+        bool patched = views ? stats->subtrees_created == 1 && stats->subtrees_deleted == 1 : stats->properties_set == 1;
+        if (ok && (stats->full_render || !patched)) {
+            fprintf(stderr, "live: the edit was not patched (full render %d, %u properties set, %u created)\n",
+                    stats->full_render, (unsigned)stats->properties_set, (unsigned)stats->subtrees_created);
+            ok = false;
+        }
+        if (t < *patch_best) *patch_best = t;
+    }
+    lvgl_json_live_ui_free(ui);
+    lvgl_json_registry_remove("bench");
+    lvgl_json_registry_remove("bench_row");
+    cJSON_Delete(spec);
+    return ok;
+}
+
+int bench_live(int argc, char **argv) {
+    int rows = argc > 1 ? atoi(argv[1]) : 240;
+    int reps = argc > 2 ? atoi(argv[2]) : 50;
+    if (rows <= 0 || reps <= 0) return 1;
+    uint64_t full_best, patch_best, view_full_best, view_patch_best;
+    lvgl_json_live_stats_t stats, view_stats;
+    if (!bench_live_run(rows, false, reps, &full_best, &patch_best, &stats) ||
+        !bench_live_run(rows, true, reps, &view_full_best, &view_patch_best, &view_stats)) {
+        return 1;
+    }
+
+    printf("live: %d rows (%d widgets), one label text edited per reload, best of %d\n", rows,
+           rows * BENCH_LIVE_WIDGETS_PER_ROW + 1, reps);
+    printf("  full render          %8.3f ms\n", full_best / 1e6);
+    printf("  one-property patch   %8.3f ms (%u widgets kept)\n", patch_best / 1e6, (unsigned)stats.widgets_kept);
+    printf("  as use-view rows: full render %8.3f ms, one instance rendered again %8.3f ms (%u nodes kept)\n",
+           view_full_best / 1e6, view_patch_best / 1e6, (unsigned)view_stats.widgets_kept);
+    return 0;
+}
@@ -0,0 +1,121 @@
+// Host benchmarks for lvgl_json_renderer. Without arguments every benchmark runs with its
+// default size; `program <name> [args]` runs one. LVGL draws into a headless display.
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_HOR_RES 480
+#define BENCH_VER_RES 320
+
+LV_FONT_DECLARE(font_kode_14);
+LV_FONT_DECLARE(font_kode_20);
+LV_FONT_DECLARE(font_kode_24);
+LV_FONT_DECLARE(font_kode_30);
+LV_FONT_DECLARE(font_kode_36);
+LV_FONT_DECLARE(lcd_7_segment_24);
+LV_FONT_DECLARE(lcd_7_segment_18);
+LV_FONT_DECLARE(lcd_7_segment_14);
+
+typedef struct {
+    const char *name;
+    int (*run)(int argc, char **argv);
+    const char *usage;
+} bench_t;
+
+static const bench_t benches[] = {
+    { "invoke", bench_invoke, "invoke [reps]: invoke table lookups, perfect hash vs. linear scan" },
+    { "binary", bench_binary, "binary [spec.json] [reps]: boot from JSON text vs. the binary format" },
+    { "registry", bench_registry, "registry [names...]: registry insert/lookup/miss at 1k/10k/100k names, table size over remove cycles" },
+    { "template", bench_template, "template [instances] [reps]: use-views of a component, compiled template vs. JSON" },
+    { "live", bench_live, "live [rows] [reps]: one-property edit patched by the live UI vs. a full render" },
+    { "styles", bench_styles, "styles [rows] [reps]: rows of styled buttons, local styles vs. shared styles" },
+    { "vlist", bench_vlist, "vlist [spec.json] [count]: virtual list widgets and scrolling vs. a for-each building every row" },
+    { "slicing", bench_slicing, "slicing [rows] [budget_us] [renders]: step time histogram of time-sliced renders" },
+    { "project", bench_project, "project [reps]: reloads of a generated 20-file project, cold, cached and warm" },
+    { "yaml", bench_yaml, "yaml [spec.yaml] [reps] [rows]: YAML vs. cJSON parse time, aliased rows vs. expanded" },
+};
+
+uint64_t bench_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + (uint64_t)ts.tv_nsec;
+}
+
+char *bench_read_file(const char *path, size_t *len) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    char *buf = size >= 0 ? (char *)malloc((size_t)size + 1) : NULL;
+    if (buf && fread(buf, 1, (size_t)size, f) != (size_t)size) {
+        free(buf);
+        buf = NULL;
+    }
+    fclose(f);
+    if (!buf) return NULL;
+    buf[size] = '\0';
+    if (len) *len = (size_t)size;
+    return buf;
+}
+
+lv_obj_t *bench_screen(void) {
+    lv_obj_t *old = lv_screen_active();
+    lv_obj_t *scr = lv_obj_create(NULL);
+    lv_screen_load(scr);
+    if (old) lv_obj_delete(old);
+    return scr;
+}
+
+static uint32_t bench_tick(void) {
+    return (uint32_t)(bench_now_ns() / 1000000u);
+}
+
+static void bench_flush(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
+    (void)area;
+    (void)px_map;
+    lv_display_flush_ready(disp);
+}
+
+static void bench_init(void) {
+    static uint8_t draw_buf[BENCH_HOR_RES * 40 * 4];
+    lv_init();
+    lv_tick_set_cb(bench_tick);
+    lv_display_t *disp = lv_display_create(BENCH_HOR_RES, BENCH_VER_RES);
+    lv_display_set_buffers(disp, draw_buf, NULL, sizeof(draw_buf), LV_DISPLAY_RENDER_MODE_PARTIAL);
+    lv_display_set_flush_cb(disp, bench_flush);
+
+    // The fonts main_pc registers, so the sample specs render the same
+    lvgl_json_register_ptr("font_kode_14", "lv_font_t", (void *) &font_kode_14);
+    lvgl_json_register_ptr("font_kode_20", "lv_font_t", (void *) &font_kode_20);
+    lvgl_json_register_ptr("font_kode_24", "lv_font_t", (void *) &font_kode_24);
+    lvgl_json_register_ptr("font_kode_30", "lv_font_t", (void *) &font_kode_30);
+    lvgl_json_register_ptr("font_kode_36", "lv_font_t", (void *) &font_kode_36);
+    lvgl_json_register_ptr("lcd_7_segment_14", "lv_font_t", (void *) &lcd_7_segment_14);
+    lvgl_json_register_ptr("lcd_7_segment_18", "lv_font_t", (void *) &lcd_7_segment_18);
+    lvgl_json_register_ptr("lcd_7_segment_24", "lv_font_t", (void *) &lcd_7_segment_24);
+    lvgl_json_register_ptr("font_montserrat_24", "lv_font_t", (void *) &lv_font_montserrat_24);
+    lvgl_json_register_ptr("font_montserrat_14", "lv_font_t", (void *) &lv_font_montserrat_14);
+    lvgl_json_register_ptr("font_montserrat_12", "lv_font_t", (void *) &lv_font_montserrat_12);
+}
+
+int main(int argc, char **argv) {
+    size_t count = sizeof(benches) / sizeof(benches[0]);
+    bench_init();
+    if (argc < 2) {
+        int failed = 0;
+        for (size_t i = 0; i < count; ++i) {
+            char *bench_argv[] = { (char *)benches[i].name, NULL };
+            failed |= benches[i].run(1, bench_argv);
+        }
+        return failed;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (strcmp(argv[1], benches[i].name) == 0) return benches[i].run(argc - 1, argv + 1);
+    }
+    fprintf(stderr, "Usage: %s [benchmark [args]]\n", argv[0]);
+    for (size_t i = 0; i < count; ++i) fprintf(stderr, "  %s\n", benches[i].usage);
+    return 2;
+}
@@ -0,0 +1,372 @@
+// Projects: reloads of a generated 20-file project (styles, 3 component files, 15 screens) through
+// lvgl_json_project_load() and a live UI, cold and warm, with and without cached artifacts, against
+// the same UI read and parsed as one file. The files are written to a temporary directory.
+#include "bench.h"
+#include <dirent.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define BENCH_PROJECT_STYLES 24
+#define BENCH_PROJECT_COMPONENT_FILES 3
+#define BENCH_PROJECT_CARDS 4
+#define BENCH_PROJECT_SCREENS 15
+#define BENCH_PROJECT_WIDGETS 60
+#define BENCH_PROJECT_FILES (BENCH_PROJECT_COMPONENT_FILES + BENCH_PROJECT_SCREENS + 2)
+#define BENCH_PROJECT_EDITED 7 // The screen file the warm reloads edit
+
+static char root[64];
+static char paths[BENCH_PROJECT_FILES + 1][128]; // The project files and the single-file version
+static int path_count;
+static const char *edited_path;
+static size_t project_bytes;
+
+static uint32_t rng = 7;
+
+static uint32_t bench_project_random(void) {
+    rng = rng * 1103515245u + 12345u;
+    return (rng >> 16) % 100;
+}
+
+static char *bench_project_path(char *buf, size_t size, const char *dir, const char *name) {
+    snprintf(buf, size, "%s/%s", dir, name);
+    return buf;
+}
+
+// Writes `spec` (deleted here) as indented JSON under the temporary directory
+static bool bench_project_write(const char *name, cJSON *spec) {
+    char *text = cJSON_Print(spec);
+    cJSON_Delete(spec);
+    char *path = bench_project_path(paths[path_count], sizeof(paths[0]), root, name);
+    FILE *f = text ? fopen(path, "w") : NULL;
+    bool ok = f && fputs(text, f) >= 0;
+    if (f && fclose(f) != 0) ok = false;
+    if (ok) {
+        project_bytes += strlen(text);
+        path_count++;
+    }
+    cJSON_free(text);
+    return ok;
+}
+
+static cJSON *bench_project_import(const char *path) {
+    cJSON *node = cJSON_CreateObject();
+    cJSON_AddStringToObject(node, "import", path);
+    return node;
+}
+
+static cJSON *bench_project_add_style(const char *id) {
+    cJSON *args = cJSON_CreateArray();
+    cJSON_AddItemToArray(args, cJSON_CreateString(id));
+    cJSON_AddItemToArray(args, cJSON_CreateNumber(0));
+    return args;
+}
+
+static cJSON *bench_project_label(const char *text) {
+    cJSON *label = cJSON_CreateObject();
+    cJSON_AddStringToObject(label, "type", "label");
+    cJSON_AddStringToObject(label, "text", text);
+    return label;
+}
+
+static cJSON *bench_project_button(const char *text) {
+    cJSON *button = cJSON_CreateObject();
+    cJSON_AddStringToObject(button, "type", "button");
+    cJSON_AddItemToArray(cJSON_AddArrayToObject(button, "children"), bench_project_label(text));
+    return button;
+}
+
+static bool bench_project_styles(void) {
+    cJSON *spec = cJSON_CreateArray();
+    for (int i = 0; i < BENCH_PROJECT_STYLES; ++i) {
+        char text[32];
+        cJSON *style = cJSON_CreateObject();
+        cJSON_AddStringToObject(style, "type", "style");
+        snprintf(text, sizeof(text), "@st%d", i);
+        cJSON_AddStringToObject(style, "id", text);
+        snprintf(text, sizeof(text), "#%02x3366", (i * 9) & 0xff);
+        cJSON_AddStringToObject(style, "bg_color", text);
+        cJSON_AddNumberToObject(style, "radius", i);
+        cJSON_AddNumberToObject(style, "pad_all", 4);
+        cJSON_AddItemToArray(spec, style);
+    }
+    return bench_project_write("styles.json", spec);
+}
+
+static bool bench_project_components(int file) {
+    char text[64];
+    cJSON *spec = cJSON_CreateArray();
+    cJSON_AddItemToArray(spec, bench_project_import("../styles.json"));
+    for (int k = 0; k < BENCH_PROJECT_CARDS; ++k) {
+        cJSON *component = cJSON_CreateObject();
+        cJSON_AddStringToObject(component, "type", "component");
+        snprintf(text, sizeof(text), "@card%d_%d", file, k);
+        cJSON_AddStringToObject(component, "id", text);
+        cJSON *card = cJSON_AddObjectToObject(component, "root");
+        cJSON_AddStringToObject(card, "type", "obj");
+        cJSON_AddNumberToObject(card, "width", 200);
+        cJSON_AddNumberToObject(card, "height", 80);
+        snprintf(text, sizeof(text), "@st%d", k);
+        cJSON_AddItemToObject(card, "add_style", bench_project_add_style(text));
+        cJSON *children = cJSON_AddArrayToObject(card, "children");
+        cJSON_AddItemToArray(children, bench_project_label("$title"));
+        cJSON_AddItemToArray(children, bench_project_button("Open"));
+        cJSON_AddItemToArray(spec, component);
+    }
+    snprintf(text, sizeof(text), "components/c%d.json", file);
+    return bench_project_write(text, spec);
+}
+
+// 60 widgets: labels, buttons and cards from the component files, mixed at random
+static bool bench_project_screen(int screen) {
+    char text[64];
+    cJSON *spec = cJSON_CreateArray();
+    cJSON *root_obj = cJSON_CreateObject();
+    cJSON_AddStringToObject(root_obj, "type", "obj");
+    snprintf(text, sizeof(text), "@screen%d", screen);
+    cJSON_AddStringToObject(root_obj, "id", text);
+    cJSON_AddNumberToObject(root_obj, "width", 480);
+    cJSON_AddNumberToObject(root_obj, "height", 480);
+    cJSON_AddStringToObject(root_obj, "flex_flow", "LV_FLEX_FLOW_COLUMN");
+    cJSON *children = cJSON_AddArrayToObject(root_obj, "children");
+    for (int w = 0; w < BENCH_PROJECT_WIDGETS; ++w) {
+        uint32_t r = bench_project_random();
+        cJSON *widget;
+        if (r < 40) {
+            snprintf(text, sizeof(text), "Screen %d item %d", screen, w);
+            widget = bench_project_label(text);
+            cJSON_AddNumberToObject(widget, "x", w * 3);
+            cJSON_AddNumberToObject(widget, "y", w * 7);
+            cJSON_AddNumberToObject(widget, "width", 180);
+            cJSON_AddStringToObject(widget, "text_color", "#223344");
+            snprintf(text, sizeof(text), "@st%d", w % BENCH_PROJECT_STYLES);
+            cJSON_AddItemToObject(widget, "add_style", bench_project_add_style(text));
+        } else if (r < 70) {
+            snprintf(text, sizeof(text), "Button %d", w);
+            widget = bench_project_button(text);
+            cJSON_AddNumberToObject(widget, "width", 120);
+            cJSON_AddNumberToObject(widget, "height", 40);
+            cJSON_AddStringToObject(widget, "align", "LV_ALIGN_TOP_LEFT");
+            cJSON_AddNumberToObject(widget, "x", w);
+            cJSON_AddNumberToObject(widget, "y", w * 2);
+        } else {
+            widget = cJSON_CreateObject();
+            cJSON_AddStringToObject(widget, "type", "use-view");
+            snprintf(text, sizeof(text), "@card%d_%d", w % BENCH_PROJECT_COMPONENT_FILES, w % BENCH_PROJECT_CARDS);
+            cJSON_AddStringToObject(widget, "id", text);
+            snprintf(text, sizeof(text), "Card %d.%d", screen, w);
+            cJSON_AddStringToObject(cJSON_AddObjectToObject(widget, "context"), "title", text);
+        }
+        cJSON_AddItemToArray(children, widget);
+    }
+    cJSON_AddItemToArray(spec, root_obj);
+    snprintf(text, sizeof(text), "screens/s%02d.json", screen);
+    if (screen == BENCH_PROJECT_EDITED) edited_path = paths[path_count];
+    return bench_project_write(text, spec);
+}
+
+static bool bench_project_generate(void) {
+    char dir[128];
+    if (mkdir(bench_project_path(dir, sizeof(dir), root, "components"), 0700) != 0 ||
+        mkdir(bench_project_path(dir, sizeof(dir), root, "screens"), 0700) != 0 ||
+        mkdir(bench_project_path(dir, sizeof(dir), root, "cache"), 0700) != 0 || !bench_project_styles()) {
+        return false;
+    }
+    cJSON *main_spec = cJSON_CreateArray();
+    cJSON_AddItemToArray(main_spec, bench_project_import("styles.json"));
+    for (int c = 0; c < BENCH_PROJECT_COMPONENT_FILES; ++c) {
+        char text[64];
+        snprintf(text, sizeof(text), "components/c%d.json", c);
+        cJSON_AddItemToArray(main_spec, bench_project_import(text));
+        if (!bench_project_components(c)) {
+            cJSON_Delete(main_spec);
+            return false;
+        }
+    }
+    for (int s = 0; s < BENCH_PROJECT_SCREENS; ++s) {
+        char text[64];
+        snprintf(text, sizeof(text), "screens/s%02d.json", s);
+        cJSON_AddItemToArray(main_spec, bench_project_import(text));
+        if (!bench_project_screen(s)) {
+            cJSON_Delete(main_spec);
+            return false;
+        }
+    }
+    return bench_project_write("main.json", main_spec);
+}
+
+// Removes the generated files, the artifacts and the directories
+static void bench_project_cleanup(void) {
+    char path[256];
+    for (int i = 0; i < path_count; ++i) remove(paths[i]);
+    bench_project_path(path, sizeof(path), root, "cache");
+    DIR *dir = opendir(path);
+    struct dirent *entry;
+    while (dir && (entry = readdir(dir)) != NULL) {
+        if (entry->d_name[0] == '.') continue;
+        char artifact[512];
+        snprintf(artifact, sizeof(artifact), "%s/%s", path, entry->d_name);
+        remove(artifact);
+    }
+    if (dir) closedir(dir);
+    rmdir(path);
+    rmdir(bench_project_path(path, sizeof(path), root, "components"));
+    rmdir(bench_project_path(path, sizeof(path), root, "screens"));
+    rmdir(root);
+}
+
+// Writes the edited screen back, with a comment `k` appended (new content unless seen before)
+static void bench_project_edit(const char *original, int k) {
+    FILE *f = fopen(edited_path, "w");
+    if (!f) return;
+    fputs(original, f);
+    if (k >= 0) fprintf(f, "\n/* %d */", k);
+    fclose(f);
+}
+
+static uint32_t bench_project_nodes(const cJSON *node) {
+    uint32_t count = 1;
+    for (const cJSON *child = node->child; child; child = child->next) count += bench_project_nodes(child);
+    return count;
+}
+
+static void bench_project_keep_best(uint64_t *best, uint64_t t) {
+    if (t < *best) *best = t;
+}
+
+// Best load time of `reps` cold loads, each by a new project
+static uint64_t bench_project_cold(const char *main_path, const char *cache_dir, int reps,
+                                   lvgl_json_project_stats_t *stats) {
+    uint64_t best = UINT64_MAX;
+    for (int r = 0; r < reps; ++r) {
+        lvgl_json_project_t *project = lvgl_json_project_create(NULL, cache_dir);
+        uint64_t t0 = bench_now_ns();
+        cJSON *spec = lvgl_json_project_load(project, main_path, stats);
+        bench_project_keep_best(&best, bench_now_ns() - t0);
+        if (!spec) best = 0;
+        cJSON_Delete(spec);
+        lvgl_json_project_free(project);
+    }
+    return best;
+}
+
+// Warm reloads into a live UI; `edit` < 0 reloads unchanged files, otherwise edit + r is appended
+static void bench_project_warm(lvgl_json_project_t *project, lvgl_json_live_ui_t *ui, const char *main_path,
+                               const char *original, int edit, int reps, uint64_t *load, uint64_t *update,
+                               lvgl_json_project_stats_t *stats) {
+    lvgl_json_live_stats_t live;
+    *load = *update = UINT64_MAX;
+    for (int r = 0; r < reps; ++r) {
+        if (edit >= 0) bench_project_edit(original, edit + r);
+        uint64_t t0 = bench_now_ns();
+        cJSON *spec = lvgl_json_project_load(project, main_path, stats);
+        uint64_t t1 = bench_now_ns();
+        bool ok = spec && lvgl_json_live_ui_update(ui, spec, &live);
+        bench_project_keep_best(load, t1 - t0);
+        bench_project_keep_best(update, bench_now_ns() - t1);
+        if (!ok) *load = 0;
+    }
+}
+
+static void bench_project_row(const char *what, uint64_t load, uint64_t update, const char *files) {
+    if (update) {
+        printf("  %-36s load %7.3f ms, live update %7.3f ms%s\n", what, load / 1e6, update / 1e6, files);
+    } else {
+        printf("  %-36s load %7.3f ms%s\n", what, load / 1e6, files);
+    }
+}
+
+static int bench_project_run(int reps) {
+    char main_path[128], cache_dir[128], files[64];
+    bench_project_path(main_path, sizeof(main_path), root, "main.json");
+    bench_project_path(cache_dir, sizeof(cache_dir), root, "cache");
+    lvgl_json_project_stats_t stats;
+    uint64_t load, update;
+
+    // The same UI as one file, read and parsed on every reload
+    lvgl_json_project_t *project = lvgl_json_project_create(NULL, NULL);
+    cJSON *linked = project ? lvgl_json_project_load(project, main_path, &stats) : NULL;
+    uint32_t nodes = linked ? bench_project_nodes(linked) : 0;
+    size_t bytes = project_bytes;
+    if (!linked || !bench_project_write("single.json", linked)) {
+        lvgl_json_project_free(project);
+        return 1;
+    }
+    lvgl_json_project_free(project);
+    const char *single_path = paths[path_count - 1];
+    lvgl_json_live_ui_t *ui = lvgl_json_live_ui_create(bench_screen());
+    lvgl_json_live_stats_t live;
+    load = update = UINT64_MAX;
+    for (int r = 0; r < reps; ++r) {
+        uint64_t t0 = bench_now_ns();
+        char *text = bench_read_file(single_path, NULL);
+        cJSON *spec = text ? cJSON_Parse(text) : NULL;
+        free(text);
+        uint64_t t1 = bench_now_ns();
+        if (!spec || !lvgl_json_live_ui_update(ui, spec, &live)) {
+            lvgl_json_live_ui_free(ui);
+            return 1;
+        }
+        bench_project_keep_best(&load, t1 - t0);
+        bench_project_keep_best(&update, bench_now_ns() - t1);
+    }
+    lvgl_json_live_ui_free(ui);
+    printf("project: %d files, %zu bytes of indented JSON, %u nodes, best of %d\n", BENCH_PROJECT_FILES,
+           bytes, (unsigned)nodes, reps);
+    bench_project_row("same UI as one file, parsed again", load, update, "");
+
+    load = bench_project_cold(main_path, NULL, reps, &stats);
+    snprintf(files, sizeof(files), " (%u parsed)", (unsigned)stats.files_parsed);
+    bench_project_row("cold, all files parsed", load, 0, files);
+
+    load = bench_project_cold(main_path, cache_dir, 1, &stats);
+    snprintf(files, sizeof(files), " (%u parsed and written to the cache)", (unsigned)stats.files_parsed);
+    bench_project_row("cold, first load with a cache", load, 0, files);
+
+    load = bench_project_cold(main_path, cache_dir, reps, &stats);
+    snprintf(files, sizeof(files), " (%u from the cache)", (unsigned)stats.files_cached);
+    bench_project_row("cold, all from the cache", load, 0, files);
+
+    // Warm reloads of one project with a live UI
+    char *original = bench_read_file(edited_path, NULL);
+    project = lvgl_json_project_create(NULL, cache_dir);
+    ui = lvgl_json_live_ui_create(bench_screen());
+    cJSON *spec = original && project && ui ? lvgl_json_project_load(project, main_path, &stats) : NULL;
+    bool ok = spec && lvgl_json_live_ui_update(ui, spec, &live);
+    if (ok) {
+        bench_project_warm(project, ui, main_path, original, -1, reps, &load, &update, &stats);
+        snprintf(files, sizeof(files), " (%u reused)", (unsigned)stats.files_reused);
+        bench_project_row("warm, nothing changed", load, update, files);
+        bench_project_warm(project, ui, main_path, original, 1000, reps, &load, &update, &stats);
+        snprintf(files, sizeof(files), " (%u reused, %u parsed)", (unsigned)stats.files_reused,
+                 (unsigned)stats.files_parsed);
+        bench_project_row("warm, one screen edited", load, update, files);
+        bench_project_warm(project, ui, main_path, original, 1000, reps, &load, &update, &stats);
+        snprintf(files, sizeof(files), " (%u reused, %u cached)", (unsigned)stats.files_reused,
+                 (unsigned)stats.files_cached);
+        bench_project_row("warm, edit back to a cached version", load, update, files);
+        ok = load != 0;
+    }
+    lvgl_json_live_ui_free(ui);
+    lvgl_json_project_free(project);
+    free(original);
+    return !ok;
+}
+
+int bench_project(int argc, char **argv) {
+    int reps = argc > 1 ? atoi(argv[1]) : 21;
+    if (reps <= 0) return 1;
+    const char *tmp = getenv("TMPDIR");
+    snprintf(root, sizeof(root), "%s/lvgl_json_bench_XXXXXX", tmp && *tmp ? tmp : "/tmp");
+    if (!mkdtemp(root)) {
+        fprintf(stderr, "project: cannot create %s\n", root);
+        return 1;
+    }
+    int failed = bench_project_generate() ? bench_project_run(reps) : 1;
+    if (failed) fprintf(stderr, "project: generating or loading the project in %s failed\n", root);
+    bench_project_cleanup();
+    bench_screen();
+    return failed;
+}
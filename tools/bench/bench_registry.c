@@ -0,0 +1,75 @@
+// Pointer registry: insert, lookup and miss cost at 1k/10k/100k names with the nested
+// ":screen:container:widget" paths the renderer registers, plus the table size after
+// register/remove cycles (live edits), which must not grow.
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define BENCH_REGISTRY_NAME_LEN 48
+#define BENCH_REGISTRY_LOOKUP_REPS 10
+#define BENCH_REGISTRY_CYCLES 1000
+
+static int bench_registry_size(int n) {
+    static int target;
+    char (*names)[BENCH_REGISTRY_NAME_LEN] = (char (*)[BENCH_REGISTRY_NAME_LEN])malloc((size_t)n * sizeof(*names));
+    if (!names) return 1;
+    for (int i = 0; i < n; ++i) snprintf(names[i], sizeof(names[i]), ":screen%d:container%d:btn%d", i % 7, i / 10, i);
+
+    uint64_t t0 = bench_now_ns();
+    for (int i = 0; i < n; ++i) lvgl_json_register_ptr(names[i], "lv_obj_t", &target);
+    uint64_t t1 = bench_now_ns();
+    long hits = 0;
+    for (int r = 0; r < BENCH_REGISTRY_LOOKUP_REPS; ++r)
+        for (int i = 0; i < n; ++i) hits += lvgl_json_get_registered_ptr(names[i], "lv_obj_t *") != NULL;
+    uint64_t t2 = bench_now_ns();
+    for (int i = 0; i < n; ++i) {
+        names[i][1] = 'X'; // ":Xcreen...", same length and shape, never registered
+        hits += lvgl_json_get_registered_ptr(names[i], "lv_obj_t *") != NULL;
+    }
+    uint64_t t3 = bench_now_ns();
+
+    lvgl_json_registry_stats_t stats;
+    lvgl_json_registry_stats(&stats);
+    printf("  n=%-6d insert %6.1f ns  lookup %6.1f ns  miss %6.1f ns  probe avg %.2f max %u  table %u B\n",
+           n, (double)(t1 - t0) / n, (double)(t2 - t1) / ((double)BENCH_REGISTRY_LOOKUP_REPS * n),
+           (double)(t3 - t2) / n, stats.avg_probe_len, (unsigned)stats.max_probe_len, (unsigned)stats.table_bytes);
+
+    char root[16];
+    for (int s = 0; s < 7; ++s) {
+        snprintf(root, sizeof(root), ":screen%d", s);
+        lvgl_json_registry_remove(root);
+    }
+    free(names);
+    return hits != (long)BENCH_REGISTRY_LOOKUP_REPS * n;
+}
+
+// Registers a nested widget and removes just that widget, the way a live edit replaces a node.
+static int bench_registry_cycles(void) {
+    static int target;
+    lvgl_json_registry_stats_t before, after;
+    lvgl_json_registry_stats(&before);
+    for (int i = 0; i < BENCH_REGISTRY_CYCLES; ++i) {
+        char name[BENCH_REGISTRY_NAME_LEN];
+        snprintf(name, sizeof(name), ":live%d:panel:btn", i % 3);
+        lvgl_json_register_ptr(name, "lv_obj_t", &target);
+        lvgl_json_registry_remove(name);
+    }
+    lvgl_json_registry_stats(&after);
+    printf("  %d register/remove cycles: %u entries + %u placeholders before, %u + %u after\n",
+           BENCH_REGISTRY_CYCLES, (unsigned)before.count, (unsigned)before.placeholder_count,
+           (unsigned)after.count, (unsigned)after.placeholder_count);
+    return after.count != before.count || after.placeholder_count != before.placeholder_count;
+}
+
+int bench_registry(int argc, char **argv) {
+    static const int default_sizes[] = { 1000, 10000, 100000 };
+    int failed = 0;
+    printf("registry:\n");
+    if (argc > 1) {
+        for (int i = 1; i < argc; ++i) failed |= atoi(argv[i]) > 0 ? bench_registry_size(atoi(argv[i])) : 1;
+    } else {
+        for (size_t i = 0; i < sizeof(default_sizes) / sizeof(default_sizes[0]); ++i) failed |= bench_registry_size(default_sizes[i]);
+    }
+    failed |= bench_registry_cycles();
+    return failed;
+}
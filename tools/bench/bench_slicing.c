@@ -0,0 +1,209 @@
+// Time-sliced rendering: a list of rows rendered with lvgl_json_render_step() at a fixed budget,
+// in three forms (use-view per row, 'context' node per row, one 'for-each'). Prints the
+// single-call render time and a histogram of step times as a share of the budget, measured
+// around each lvgl_json_render_step() call, next to what the renderer measured itself. Checks
+// first that a 'for-each' item failing inside nested hidden containers drops the same siblings
+// as a single-call render does.
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_SLICING_BUCKETS 8
+
+// Upper bounds of the histogram buckets in percent of the budget; the last one is open
+static const int bucket_limits[BENCH_SLICING_BUCKETS - 1] = { 25, 50, 75, 90, 100, 110, 150 };
+
+// The row: a container with the item's name and value
+static cJSON *bench_slicing_row_body(void) {
+    cJSON *row = cJSON_CreateObject();
+    cJSON_AddStringToObject(row, "type", "obj");
+    cJSON_AddStringToObject(row, "width", "100%");
+    cJSON_AddStringToObject(row, "height", "LV_SIZE_CONTENT");
+    cJSON *children = cJSON_AddArrayToObject(row, "children");
+    static const char *const texts[] = { "$name", "$value" };
+    static const char *const aligns[] = { "LV_ALIGN_LEFT_MID", "LV_ALIGN_RIGHT_MID" };
+    for (int i = 0; i < 2; ++i) {
+        cJSON *label = cJSON_CreateObject();
+        cJSON_AddStringToObject(label, "type", "label");
+        cJSON_AddStringToObject(label, "text", texts[i]);
+        cJSON_AddStringToObject(label, "align", aligns[i]);
+        cJSON_AddItemToArray(children, label);
+    }
+    return row;
+}
+
+static cJSON *bench_slicing_item(int i) {
+    char text[32];
+    cJSON *item = cJSON_CreateObject();
+    snprintf(text, sizeof(text), "Item %d", i);
+    cJSON_AddStringToObject(item, "name", text);
+    snprintf(text, sizeof(text), "%d.000", i);
+    cJSON_AddStringToObject(item, "value", text);
+    return item;
+}
+
+static cJSON *bench_slicing_use_view(cJSON *context) {
+    cJSON *use_view = cJSON_CreateObject();
+    cJSON_AddStringToObject(use_view, "type", "use-view");
+    cJSON_AddStringToObject(use_view, "id", "@bench_row");
+    if (context) cJSON_AddItemToObject(use_view, "context", context);
+    return use_view;
+}
+
+typedef enum { ROWS_USE_VIEW, ROWS_CONTEXT, ROWS_FOR_EACH } bench_rows_t;
+
+// [ row component, a flex column with `count` rows in the given form ]
+static cJSON *bench_slicing_spec(bench_rows_t form, int count) {
+    cJSON *spec = cJSON_CreateArray();
+    cJSON *component = cJSON_CreateObject();
+    cJSON_AddStringToObject(component, "type", "component");
+    cJSON_AddStringToObject(component, "id", "@bench_row");
+    cJSON_AddItemToObject(component, "root", bench_slicing_row_body());
+    cJSON_AddItemToArray(spec, component);
+
+    cJSON *list = cJSON_CreateObject();
+    cJSON_AddStringToObject(list, "type", "obj");
+    cJSON *size = cJSON_AddArrayToObject(list, "size");
+    cJSON_AddItemToArray(size, cJSON_CreateString("100%"));
+    cJSON_AddItemToArray(size, cJSON_CreateString("100%"));
+    cJSON_AddStringToObject(list, "layout", "LV_LAYOUT_FLEX");
+    cJSON_AddStringToObject(list, "flex_flow", "LV_FLEX_FLOW_COLUMN");
+    cJSON *children = cJSON_AddArrayToObject(list, "children");
+    if (form == ROWS_FOR_EACH) {
+        cJSON *for_each = cJSON_CreateObject();
+        cJSON_AddStringToObject(for_each, "type", "for-each");
+        cJSON *items = cJSON_AddArrayToObject(for_each, "items");
+        for (int i = 0; i < count; ++i) cJSON_AddItemToArray(items, bench_slicing_item(i));
+        cJSON_AddItemToObject(for_each, "for", bench_slicing_use_view(NULL));
+        cJSON_AddItemToArray(children, for_each);
+    } else {
+        for (int i = 0; i < count; ++i) {
+            if (form == ROWS_USE_VIEW) {
+                cJSON_AddItemToArray(children, bench_slicing_use_view(bench_slicing_item(i)));
+                continue;
+            }
+            cJSON *context = cJSON_CreateObject();
+            cJSON_AddStringToObject(context, "type", "context");
+            cJSON_AddItemToObject(context, "values", bench_slicing_item(i));
+            cJSON_AddItemToObject(context, "for", bench_slicing_row_body());
+            cJSON_AddItemToArray(children, context);
+        }
+    }
+    cJSON_AddItemToArray(spec, list);
+    return spec;
+}
+
+static void bench_slicing_done(bool success, void *user_data) {
+    *(bool *)user_data = success;
+}
+
+static int bench_slicing_form(const char *name, bench_rows_t form, int rows, uint32_t budget_us, int renders) {
+    cJSON *spec = bench_slicing_spec(form, rows);
+    uint32_t histogram[BENCH_SLICING_BUCKETS] = { 0 };
+    uint64_t sync_best = UINT64_MAX, worst_step_ns = 0;
+    uint32_t steps = 0, renderer_over = 0, renderer_max_us = 0;
+    bool ok = true;
+    for (int r = 0; r < renders && ok; ++r) {
+        uint64_t t0 = bench_now_ns();
+        ok = lvgl_json_render_ui(spec, bench_screen());
+        uint64_t t = bench_now_ns() - t0;
+        if (t < sync_best) sync_best = t;
+
+        bool done_ok = false;
+        lvgl_json_reset_render_stats();
+        ok = ok && lvgl_json_render_start(spec, bench_screen(), bench_slicing_done, &done_ok);
+        bool more = ok;
+        while (more) {
+            t0 = bench_now_ns();
+            more = lvgl_json_render_step(budget_us);
+            t = bench_now_ns() - t0;
+            if (t > worst_step_ns) worst_step_ns = t;
+            uint64_t percent = t / 10 / budget_us; // t [ns] * 100 / (budget_us * 1000)
+            int bucket = 0;
+            while (bucket < BENCH_SLICING_BUCKETS - 1 && percent >= (uint64_t)bucket_limits[bucket]) bucket++;
+            histogram[bucket]++;
+            steps++;
+        }
+        lvgl_json_render_stats_t stats;
+        lvgl_json_get_render_stats(&stats);
+        renderer_over += stats.slice_steps_over_budget;
+        if (stats.slice_max_step_us > renderer_max_us) renderer_max_us = stats.slice_max_step_us;
+        ok = ok && done_ok;
+    }
+    cJSON_Delete(spec);
+    if (!ok) {
+        fprintf(stderr, "slicing: %s rows failed to render\n", name);
+        return 1;
+    }
+
+    printf("  %-8s %.2f ms in one call; %.1f steps per render, longest %.0f us (%.1f%% of budget)\n",
+           name, sync_best / 1e6, (double)steps / renders, worst_step_ns / 1e3, worst_step_ns / 10.0 / budget_us);
+    printf("           renderer: longest step %u us, %u over budget\n", (unsigned)renderer_max_us, (unsigned)renderer_over);
+    for (int b = 0; b < BENCH_SLICING_BUCKETS; ++b) {
+        if (!histogram[b]) continue;
+        if (b == 0) printf("           <%4d%%", bucket_limits[0]);
+        else if (b == BENCH_SLICING_BUCKETS - 1) printf("          >=%4d%%", bucket_limits[b - 1]);
+        else printf("      %4d-%4d%%", bucket_limits[b - 1], bucket_limits[b]);
+        printf("  %6u steps (%5.1f%%)\n", (unsigned)histogram[b], 100.0 * histogram[b] / steps);
+    }
+    return 0;
+}
+
+static cJSON *bench_slicing_node(const char *type, const char *text, bool hidden) {
+    cJSON *node = cJSON_CreateObject();
+    cJSON_AddStringToObject(node, "type", type);
+    if (text) cJSON_AddStringToObject(node, "text", text);
+    if (hidden) cJSON_AddStringToObject(node, "add_flag", "LV_OBJ_FLAG_HIDDEN");
+    return node;
+}
+
+// A hidden container in a hidden container holding a label, a 'for-each' whose first item
+// fails and a label: the failure drops the label after it, not the label after the inner one
+static int bench_slicing_failing_item(void) {
+    cJSON *outer = bench_slicing_node("obj", NULL, true);
+    cJSON *inner = bench_slicing_node("obj", NULL, true);
+    cJSON *repeat = bench_slicing_node("for-each", NULL, false);
+    cJSON_AddNumberToObject(repeat, "count", 2);
+    cJSON_AddItemToObject(repeat, "for", bench_slicing_node("no_such_widget", NULL, false));
+    cJSON *inner_children = cJSON_AddArrayToObject(inner, "children");
+    cJSON_AddItemToArray(inner_children, bench_slicing_node("label", "before", false));
+    cJSON_AddItemToArray(inner_children, repeat);
+    cJSON_AddItemToArray(inner_children, bench_slicing_node("label", "dropped", false));
+    cJSON *outer_children = cJSON_AddArrayToObject(outer, "children");
+    cJSON_AddItemToArray(outer_children, inner);
+    cJSON_AddItemToArray(outer_children, bench_slicing_node("label", "after", false));
+    cJSON *spec = cJSON_CreateArray();
+    cJSON_AddItemToArray(spec, outer);
+
+    lvgl_json_memory_report_t report;
+    lvgl_json_reset_render_stats();
+    bool sync_ok = lvgl_json_render_ui(spec, bench_screen());
+    lvgl_json_get_memory_report(&report);
+    uint32_t sync_widgets = report.widgets_created;
+
+    bool done_ok = false;
+    lvgl_json_reset_render_stats();
+    bool ok = lvgl_json_render_start(spec, bench_screen(), bench_slicing_done, &done_ok);
+    while (ok && lvgl_json_render_step(1)) {}
+    lvgl_json_get_memory_report(&report);
+    bench_screen();
+    cJSON_Delete(spec);
+    ok = ok && done_ok == sync_ok && report.widgets_created == sync_widgets;
+    printf("  failing 'for-each' item in hidden containers: %u widgets in one call, %u sliced%s\n",
+           (unsigned)sync_widgets, (unsigned)report.widgets_created, ok ? "" : " (MISMATCH)");
+    return !ok;
+}
+
+int bench_slicing(int argc, char **argv) {
+    int rows = argc > 1 ? atoi(argv[1]) : 2000;
+    int budget_us = argc > 2 ? atoi(argv[2]) : 2000;
+    int renders = argc > 3 ? atoi(argv[3]) : 20;
+    if (rows <= 0 || budget_us <= 0 || renders <= 0) return 1;
+    printf("slicing: %d rows, %d us budget, %d renders\n", rows, budget_us, renders);
+    int failed = bench_slicing_failing_item();
+    failed |= bench_slicing_form("use-view", ROWS_USE_VIEW, rows, (uint32_t)budget_us, renders);
+    failed |= bench_slicing_form("context", ROWS_CONTEXT, rows, (uint32_t)budget_us, renders);
+    failed |= bench_slicing_form("for-each", ROWS_FOR_EACH, rows, (uint32_t)budget_us, renders);
+    return failed;
+}
@@ -0,0 +1,89 @@
+// Shared styles: N rows of a button with 7 style properties and two labels with a text color,
+// rendered with local styles and with lvgl_json_set_style_sharing(true).
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static cJSON *bench_styles_label(const char *text, const char *color, const char *align) {
+    cJSON *label = cJSON_CreateObject();
+    cJSON_AddStringToObject(label, "type", "label");
+    cJSON_AddStringToObject(label, "text", text);
+    cJSON_AddStringToObject(label, "text_color", color);
+    cJSON_AddStringToObject(label, "align", align);
+    return label;
+}
+
+static cJSON *bench_styles_spec(int rows) {
+    cJSON *list = cJSON_CreateObject();
+    cJSON_AddStringToObject(list, "type", "obj");
+    cJSON_AddStringToObject(list, "named", "bench");
+    cJSON_AddStringToObject(list, "width", "100%");
+    cJSON_AddStringToObject(list, "height", "100%");
+    cJSON_AddStringToObject(list, "flex_flow", "LV_FLEX_FLOW_COLUMN");
+    cJSON_AddNumberToObject(list, "pad_row", 2);
+    cJSON *children = cJSON_AddArrayToObject(list, "children");
+    for (int i = 0; i < rows; ++i) {
+        char text[32];
+        cJSON *button = cJSON_CreateObject();
+        cJSON_AddStringToObject(button, "type", "button");
+        cJSON_AddStringToObject(button, "width", "100%");
+        cJSON_AddNumberToObject(button, "height", 40);
+        cJSON_AddStringToObject(button, "bg_color", "#202830");
+        cJSON_AddNumberToObject(button, "radius", 6);
+        cJSON_AddNumberToObject(button, "pad_all", 4);
+        cJSON_AddNumberToObject(button, "border_width", 1);
+        cJSON_AddStringToObject(button, "border_color", "#405060");
+        cJSON_AddNumberToObject(button, "bg_opa", 255);
+        cJSON *cells = cJSON_AddArrayToObject(button, "children");
+        snprintf(text, sizeof(text), "Row %d", i);
+        cJSON_AddItemToArray(cells, bench_styles_label(text, "#e0e0e0", "LV_ALIGN_LEFT_MID"));
+        snprintf(text, sizeof(text), "%d mm/min", i * 10);
+        cJSON_AddItemToArray(cells, bench_styles_label(text, "#80c0ff", "LV_ALIGN_RIGHT_MID"));
+        cJSON_AddItemToArray(children, button);
+    }
+    cJSON *spec = cJSON_CreateArray();
+    cJSON_AddItemToArray(spec, list);
+    return spec;
+}
+
+// Best of `reps` renders; *stats gets the counters of the last one
+static double bench_styles_run(cJSON *spec, bool share, int reps, lvgl_json_render_stats_t *stats) {
+    uint64_t best = UINT64_MAX;
+    lvgl_json_set_style_sharing(share);
+    for (int r = 0; r < reps; ++r) {
+        lv_obj_t *screen = bench_screen();
+        lvgl_json_shared_styles_clear(); // The widgets using them are gone
+        lvgl_json_registry_remove("bench");
+        lvgl_json_reset_render_stats();
+        uint64_t t0 = bench_now_ns();
+        bool ok = lvgl_json_render_ui(spec, screen);
+        uint64_t t = bench_now_ns() - t0;
+        if (!ok) return -1.0;
+        if (t < best) best = t;
+    }
+    lvgl_json_get_render_stats(stats);
+    bench_screen();
+    lvgl_json_shared_styles_clear();
+    lvgl_json_registry_remove("bench");
+    lvgl_json_set_style_sharing(false);
+    return best / 1e6;
+}
+
+int bench_styles(int argc, char **argv) {
+    int rows = argc > 1 ? atoi(argv[1]) : 400;
+    int reps = argc > 2 ? atoi(argv[2]) : 7;
+    if (rows <= 0 || reps <= 0) return 1;
+    cJSON *spec = bench_styles_spec(rows);
+    lvgl_json_render_stats_t local, shared;
+    double local_ms = bench_styles_run(spec, false, reps, &local);
+    double shared_ms = bench_styles_run(spec, true, reps, &shared);
+    cJSON_Delete(spec);
+
+    printf("styles: %d rows (%d widgets), best of %d\n", rows, rows * 3 + 1, reps);
+    printf("  local styles   %8.2f ms\n", local_ms);
+    printf("  shared styles  %8.2f ms, %u uses of %u styles (%u bytes), about %u bytes of local styles avoided\n",
+           shared_ms, (unsigned)shared.shared_style_uses, (unsigned)shared.shared_styles,
+           (unsigned)shared.shared_style_bytes, (unsigned)shared.local_style_bytes_saved);
+    return local_ms < 0 || shared_ms < 0;
+}
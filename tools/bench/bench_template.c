@@ -0,0 +1,102 @@
+// Component instantiation: one container with N use-views of ui.json's axis_pos_display, each
+// with its own context, rendered through the compiled template and through the component's
+// JSON root (the path every use-view took before templates).
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_TEMPLATE_COMPONENT "axis_pos_display"
+#define BENCH_TEMPLATE_COMPONENT_JSON "axis_pos_display_json" // Copy that is never compiled
+
+// The styles and components of ui.json without its widgets, plus the uncompiled copy
+static cJSON *bench_template_defs(cJSON *ui) {
+    cJSON *defs = cJSON_CreateArray();
+    cJSON *node;
+    cJSON_ArrayForEach(node, ui) {
+        const char *type = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(node, "type"));
+        if (!type || (strcmp(type, "style") != 0 && strcmp(type, "component") != 0)) continue;
+        cJSON_AddItemToArray(defs, cJSON_Duplicate(node, true));
+        const char *id = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(node, "id"));
+        if (id && strcmp(id, "@" BENCH_TEMPLATE_COMPONENT) == 0) {
+            cJSON *copy = cJSON_Duplicate(node, true);
+            cJSON_ReplaceItemInObject(copy, "id", cJSON_CreateString("@" BENCH_TEMPLATE_COMPONENT_JSON));
+            cJSON_AddItemToArray(defs, copy);
+        }
+    }
+    return defs;
+}
+
+static cJSON *bench_template_instances(int count, const char *component) {
+    static const char *const axes[] = { "X", "Y", "Z" };
+    cJSON *container = cJSON_CreateObject();
+    cJSON_AddStringToObject(container, "type", "obj");
+    cJSON_AddStringToObject(container, "named", "bench");
+    cJSON *children = cJSON_AddArrayToObject(container, "children");
+    for (int i = 0; i < count; ++i) {
+        char text[32];
+        cJSON *use_view = cJSON_CreateObject();
+        cJSON_AddStringToObject(use_view, "type", "use-view");
+        snprintf(text, sizeof(text), "@%s", component);
+        cJSON_AddStringToObject(use_view, "id", text);
+        cJSON *context = cJSON_AddObjectToObject(use_view, "context");
+        snprintf(text, sizeof(text), "axis%d", i);
+        cJSON_AddStringToObject(context, "name", text);
+        cJSON_AddStringToObject(context, "axis", axes[i % 3]);
+        snprintf(text, sizeof(text), "%d.000", i);
+        cJSON_AddStringToObject(context, "wcs_pos", text);
+        cJSON_AddStringToObject(context, "abs_pos", "1.0");
+        cJSON_AddStringToObject(context, "delta_pos", "0.5");
+        cJSON_AddItemToArray(children, use_view);
+    }
+    return container;
+}
+
+// Best of `reps` renders of the instances
+static double bench_template_run(cJSON *instances, int reps) {
+    uint64_t best = UINT64_MAX;
+    if (!instances) return -1.0;
+    for (int r = 0; r < reps; ++r) {
+        lv_obj_t *screen = bench_screen();
+        lvgl_json_registry_remove("bench");
+        uint64_t t0 = bench_now_ns();
+        bool ok = lvgl_json_render_ui(instances, screen);
+        uint64_t t = bench_now_ns() - t0;
+        if (!ok) return -1.0;
+        if (t < best) best = t;
+    }
+    lvgl_json_registry_remove("bench");
+    return best / 1e6;
+}
+
+int bench_template(int argc, char **argv) {
+    int count = argc > 1 ? atoi(argv[1]) : 1000;
+    int reps = argc > 2 ? atoi(argv[2]) : 7;
+    char *text = bench_read_file("ui.json", NULL);
+    cJSON *ui = text ? cJSON_Parse(text) : NULL;
+    free(text);
+    if (!ui || count <= 0 || reps <= 0) {
+        fprintf(stderr, "template: cannot read ui.json\n");
+        cJSON_Delete(ui);
+        return 1;
+    }
+    cJSON *defs = bench_template_defs(ui);
+    cJSON_Delete(ui);
+    bool defined = lvgl_json_render_ui(defs, bench_screen()) && bench_component_force_json(BENCH_TEMPLATE_COMPONENT_JSON);
+    cJSON_Delete(defs); // Components keep their own copy
+    if (!defined) {
+        fprintf(stderr, "template: ui.json has no component '%s'\n", BENCH_TEMPLATE_COMPONENT);
+        return 1;
+    }
+
+    cJSON *instances = bench_template_instances(count, BENCH_TEMPLATE_COMPONENT);
+    double template_ms = bench_template_run(instances, reps);
+    cJSON_Delete(instances);
+    instances = bench_template_instances(count, BENCH_TEMPLATE_COMPONENT_JSON);
+    double json_ms = bench_template_run(instances, reps);
+    cJSON_Delete(instances);
+    printf("template: %d use-views of %s, best of %d\n", count, BENCH_TEMPLATE_COMPONENT, reps);
+    printf("  compiled template  %8.2f ms\n", template_ms);
+    printf("  JSON root          %8.2f ms\n", json_ms);
+    return template_ms < 0 || json_ms < 0;
+}
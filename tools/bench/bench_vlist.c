@@ -0,0 +1,156 @@
+// Virtual lists: widgets created for the virtual list of a spec (examples/virtual_list.json by
+// default) at 100 and at N items, against a 'for-each' building every row of the same component,
+// and the cost of scrolling through all N items 8 px per frame. The list's source must be
+// '@demo_list_source', registered here with the values main_pc gives it.
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_VLIST_SCROLL_STEP 8
+
+static uint32_t source_calls;
+
+static void bench_vlist_source(uint32_t index, cJSON *item, void *user_data) {
+    (void)user_data;
+    char text[32];
+    source_calls++;
+    snprintf(text, sizeof(text), "file_%05u.gcode", (unsigned)index);
+    cJSON_AddStringToObject(item, "name", text);
+    snprintf(text, sizeof(text), "%u kB", (unsigned)((index * 7919u) % 4096u));
+    cJSON_AddStringToObject(item, "size", text);
+    cJSON_AddStringToObject(item, "color", index % 2 ? "#202020" : "#303030");
+}
+
+// The top-level node of `type` in the spec
+static cJSON *bench_vlist_node(cJSON *spec, const char *type) {
+    cJSON *node;
+    cJSON_ArrayForEach(node, spec) {
+        const char *t = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(node, "type"));
+        if (t && strcmp(t, type) == 0) return node;
+    }
+    return NULL;
+}
+
+// Widgets the render stats counted since the last reset
+static uint32_t bench_vlist_widgets(void) {
+    lvgl_json_memory_report_t report;
+    lvgl_json_get_memory_report(&report);
+    return report.widgets_created;
+}
+
+static uint32_t bench_vlist_heap(void) {
+    lvgl_json_memory_report_t report;
+    lvgl_json_get_memory_report(&report);
+    return report.total_bytes;
+}
+
+// Renders the list with `count` items and lays it out; the widgets created go to *widgets
+static lv_obj_t *bench_vlist_render(cJSON *spec, const char *name, uint32_t count, uint32_t *widgets,
+                                    uint64_t *ns) {
+    lv_obj_t *screen = bench_screen();
+    lvgl_json_registry_remove(name);
+    lvgl_json_reset_render_stats();
+    uint64_t t0 = bench_now_ns();
+    if (!lvgl_json_render_ui(spec, screen)) return NULL;
+    lv_obj_t *list = (lv_obj_t *)lvgl_json_get_registered_ptr(name, "lv_obj_t");
+    if (!list || !lvgl_json_virtual_list_set_count(list, count)) return NULL;
+    lv_obj_update_layout(list);
+    *ns = bench_now_ns() - t0;
+    *widgets = bench_vlist_widgets();
+    return list;
+}
+
+// The same rows built up front: a container with a 'for-each' over the source
+static cJSON *bench_vlist_eager_spec(cJSON *component, const char *row, uint32_t count) {
+    cJSON *spec = cJSON_CreateArray();
+    cJSON_AddItemToArray(spec, cJSON_Duplicate(component, true));
+    cJSON *list = cJSON_CreateObject();
+    cJSON_AddStringToObject(list, "type", "obj");
+    cJSON_AddStringToObject(list, "width", "100%");
+    cJSON_AddStringToObject(list, "height", "100%");
+    cJSON_AddStringToObject(list, "flex_flow", "LV_FLEX_FLOW_COLUMN");
+    cJSON *repeat = cJSON_CreateObject();
+    cJSON_AddStringToObject(repeat, "type", "for-each");
+    cJSON_AddStringToObject(repeat, "items", "@demo_list_source");
+    cJSON_AddNumberToObject(repeat, "count", count);
+    cJSON *body = cJSON_AddObjectToObject(repeat, "for");
+    cJSON_AddStringToObject(body, "type", "use-view");
+    cJSON_AddStringToObject(body, "id", row);
+    cJSON_AddItemToArray(cJSON_AddArrayToObject(list, "children"), repeat);
+    cJSON_AddItemToArray(spec, list);
+    return spec;
+}
+
+int bench_vlist(int argc, char **argv) {
+    const char *path = argc > 1 ? argv[1] : "examples/virtual_list.json";
+    long n = argc > 2 ? atol(argv[2]) : 10000;
+    if (n <= 0) return 1;
+    uint32_t count = (uint32_t)n;
+    char *text = bench_read_file(path, NULL);
+    cJSON *spec = text ? cJSON_Parse(text) : NULL;
+    free(text);
+    cJSON *vlist = spec ? bench_vlist_node(spec, "virtual-list") : NULL;
+    cJSON *component = spec ? bench_vlist_node(spec, "component") : NULL;
+    const char *name = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(vlist, "named"));
+    const char *row = cJSON_GetStringValue(cJSON_GetObjectItemCaseSensitive(vlist, "row"));
+    if (!name || !row || !component) {
+        fprintf(stderr, "vlist: %s has no named virtual-list with its row component\n", path);
+        cJSON_Delete(spec);
+        return 1;
+    }
+    lvgl_json_register_ptr("demo_list_source", "lvgl_json_list_source_cb_t", (void *)bench_vlist_source);
+
+    uint32_t widgets_small = 0, widgets = 0;
+    uint64_t render_ns = 0;
+    lv_obj_t *list = bench_vlist_render(spec, name, 100, &widgets_small, &render_ns);
+    list = list ? bench_vlist_render(spec, name, count, &widgets, &render_ns) : NULL;
+    if (!list) {
+        fprintf(stderr, "vlist: rendering %s failed\n", path);
+        cJSON_Delete(spec);
+        return 1;
+    }
+
+    // Scroll to the end, timing the scroll events the list handles
+    uint32_t heap_before = bench_vlist_heap();
+    uint32_t frames = 0, calls_before = source_calls;
+    uint64_t total_ns = 0, worst_ns = 0;
+    while (lv_obj_get_scroll_bottom(list) > 0) {
+        uint64_t t0 = bench_now_ns();
+        lv_obj_scroll_by(list, 0, -BENCH_VLIST_SCROLL_STEP, LV_ANIM_OFF);
+        uint64_t t = bench_now_ns() - t0;
+        total_ns += t;
+        if (t > worst_ns) worst_ns = t;
+        frames++;
+    }
+    uint32_t rebinds = source_calls - calls_before;
+    uint32_t scroll_widgets = bench_vlist_widgets() - widgets;
+    int32_t heap_change = (int32_t)(bench_vlist_heap() - heap_before);
+    bool at_end = lvgl_json_virtual_list_get_row(list, count - 1) != NULL;
+    lvgl_json_registry_remove(name);
+
+    cJSON *eager = bench_vlist_eager_spec(component, row, count);
+    lv_obj_t *screen = bench_screen();
+    lvgl_json_reset_render_stats();
+    uint64_t t0 = bench_now_ns();
+    bool ok = lvgl_json_render_ui(eager, screen);
+    uint64_t eager_ns = bench_now_ns() - t0;
+    uint32_t eager_widgets = bench_vlist_widgets();
+    bench_screen();
+    cJSON_Delete(eager);
+    if (ok && at_end) {
+        printf("vlist: '%s' of %s, %u items\n", name, path, (unsigned)count);
+        printf("  virtual list   %6u widgets at 100 items, %6u at %u (%.3f ms)\n", (unsigned)widgets_small,
+               (unsigned)widgets, (unsigned)count, render_ns / 1e6);
+        printf("  for-each       %6u widgets (%.3f ms)\n", (unsigned)eager_widgets, eager_ns / 1e6);
+        printf("  scroll         %u frames of %d px: %u rows bound, %u widgets created, %+d bytes renderer heap,"
+               " %.4f ms average, %.4f ms worst\n",
+               (unsigned)frames, BENCH_VLIST_SCROLL_STEP, (unsigned)rebinds, (unsigned)scroll_widgets,
+               (int)heap_change, frames ? total_ns / 1e6 / frames : 0.0, worst_ns / 1e6);
+    } else {
+        fprintf(stderr, "vlist: %s\n", ok ? "the last item has no row after scrolling" : "the for-each render failed");
+    }
+    cJSON_Delete(spec);
+    lvgl_json_registry_remove("demo_list_source");
+    return !ok || !at_end;
+}
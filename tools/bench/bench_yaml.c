@@ -0,0 +1,144 @@
+// YAML: lvgl_json_parse_yaml() against cJSON_Parse() on the same spec printed as JSON (ui.yaml by
+// default), and the tree of a list whose row is anchored once and aliased for the other rows,
+// against the same list expanded to JSON.
+#include "bench.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_YAML_CELLS 8
+
+// cJSON allocations while the hooks are installed, with a size header as in bench_binary.c
+static size_t tree_bytes;
+
+static void *counting_malloc(size_t size) {
+    size_t *p = (size_t *)malloc(size + sizeof(max_align_t));
+    if (!p) return NULL;
+    *p = size;
+    tree_bytes += size;
+    return (char *)p + sizeof(max_align_t);
+}
+
+static void counting_free(void *ptr) {
+    if (ptr) free((char *)ptr - sizeof(max_align_t));
+}
+
+// Nodes held by the tree: the children of a reference belong to the node it refers to
+static uint32_t bench_yaml_nodes(const cJSON *node) {
+    uint32_t count = 1;
+    if (node->type & cJSON_IsReference) return count;
+    for (const cJSON *child = node->child; child; child = child->next) count += bench_yaml_nodes(child);
+    return count;
+}
+
+static uint64_t bench_yaml_best(const char *text, size_t len, bool yaml, int reps) {
+    uint64_t best = UINT64_MAX;
+    for (int r = 0; r < reps; ++r) {
+        uint64_t t0 = bench_now_ns();
+        cJSON *spec = yaml ? lvgl_json_parse_yaml(text, len) : cJSON_Parse(text);
+        uint64_t t = bench_now_ns() - t0;
+        if (!spec) return 0;
+        cJSON_Delete(spec);
+        if (t < best) best = t;
+    }
+    return best;
+}
+
+// A list of `rows` rows of 8 labels: the first row anchored as &row, the others *row
+static char *bench_yaml_alias_text(int rows, size_t *len) {
+    size_t size = 256 + BENCH_YAML_CELLS * 128 + (size_t)rows * 16;
+    char *text = (char *)malloc(size);
+    if (!text) return NULL;
+    size_t n = (size_t)snprintf(text, size,
+                                "- type: obj\n"
+                                "  named: bench\n"
+                                "  children:\n"
+                                "    - &row\n"
+                                "      type: obj\n"
+                                "      size: [100%%, 40]\n"
+                                "      children:\n");
+    for (int c = 0; c < BENCH_YAML_CELLS; ++c) {
+        n += (size_t)snprintf(text + n, size - n,
+                              "        - type: label\n"
+                              "          text: 'cell %d'\n"
+                              "          align: LV_ALIGN_LEFT_MID\n"
+                              "          x: %d\n",
+                              c, c * 30);
+    }
+    for (int r = 1; r < rows; ++r) n += (size_t)snprintf(text + n, size - n, "    - *row\n");
+    *len = n;
+    return text;
+}
+
+// Parses with the counting hooks; *nodes and *bytes describe the tree, *widgets its render
+static bool bench_yaml_tree(const char *text, size_t len, bool yaml, uint32_t *nodes, size_t *bytes,
+                            uint32_t *widgets) {
+    cJSON_Hooks hooks = { counting_malloc, counting_free };
+    cJSON_InitHooks(&hooks);
+    tree_bytes = 0;
+    cJSON *spec = yaml ? lvgl_json_parse_yaml(text, len) : cJSON_Parse(text);
+    *bytes = tree_bytes;
+    *nodes = spec ? bench_yaml_nodes(spec) : 0;
+    cJSON_InitHooks(NULL); // Nodes the renderer creates and keeps use the default allocator
+    lv_obj_t *screen = bench_screen();
+    lvgl_json_registry_remove("bench");
+    lvgl_json_reset_render_stats();
+    bool ok = spec && lvgl_json_render_ui(spec, screen);
+    lvgl_json_memory_report_t report;
+    lvgl_json_get_memory_report(&report);
+    *widgets = report.widgets_created;
+    bench_screen();
+    lvgl_json_registry_remove("bench");
+    cJSON_InitHooks(&hooks);
+    cJSON_Delete(spec);
+    cJSON_InitHooks(NULL);
+    return ok;
+}
+
+int bench_yaml(int argc, char **argv) {
+    const char *path = argc > 1 ? argv[1] : "ui.yaml";
+    int reps = argc > 2 ? atoi(argv[2]) : 200;
+    int rows = argc > 3 ? atoi(argv[3]) : 200;
+    if (reps <= 0 || rows <= 0) return 1;
+
+    size_t len = 0;
+    char *text = bench_read_file(path, &len);
+    cJSON *spec = text ? lvgl_json_parse_yaml(text, len) : NULL;
+    char *json = spec ? cJSON_Print(spec) : NULL;
+    cJSON_Delete(spec);
+    uint64_t yaml_ns = json ? bench_yaml_best(text, len, true, reps) : 0;
+    uint64_t json_ns = json ? bench_yaml_best(json, 0, false, reps) : 0;
+    if (!yaml_ns || !json_ns) {
+        fprintf(stderr, "yaml: cannot parse '%s'\n", path);
+        free(text);
+        cJSON_free(json);
+        return 1;
+    }
+    printf("yaml: %s, best of %d\n", path, reps);
+    printf("  lvgl_json_parse_yaml  %8.3f ms (%zu bytes)\n", yaml_ns / 1e6, len);
+    printf("  cJSON_Parse           %8.3f ms (%zu bytes, the same spec printed as JSON)\n", json_ns / 1e6,
+           strlen(json));
+    free(text);
+    cJSON_free(json);
+
+    // Aliased rows, and the same rows expanded by printing the tree as JSON
+    text = bench_yaml_alias_text(rows, &len);
+    spec = text ? lvgl_json_parse_yaml(text, len) : NULL;
+    json = spec ? cJSON_PrintUnformatted(spec) : NULL;
+    cJSON_Delete(spec);
+    uint32_t alias_nodes = 0, json_nodes = 0, alias_widgets = 0, json_widgets = 0;
+    size_t alias_bytes = 0, json_bytes = 0;
+    bool ok = json && bench_yaml_tree(text, len, true, &alias_nodes, &alias_bytes, &alias_widgets) &&
+              bench_yaml_tree(json, 0, false, &json_nodes, &json_bytes, &json_widgets);
+    free(text);
+    cJSON_free(json);
+    if (!ok) {
+        fprintf(stderr, "yaml: the aliased list failed to parse or render\n");
+        return 1;
+    }
+    printf("  %d rows, 1 anchored  %6u nodes, %8zu bytes of cJSON heap, %u widgets\n", rows,
+           (unsigned)alias_nodes, alias_bytes, (unsigned)alias_widgets);
+    printf("  expanded as JSON     %6u nodes, %8zu bytes of cJSON heap, %u widgets\n", (unsigned)json_nodes,
+           json_bytes, (unsigned)json_widgets);
+    return alias_widgets != json_widgets;
+}
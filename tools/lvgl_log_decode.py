@@ -0,0 +1,115 @@
+#!/usr/bin/env python3
+"""
+Decodes raw log records written by the renderer's ring buffer sink (LVGL_JSON_LOG_SINK_RING=1).
+
+The device copies records out with lvgl_json_log_drain() and writes them as-is (lvgl_json_log_record_t,
+232 bytes each) to a file or serial port. This prints them like lvgl_json_log_format() does and,
+with --source, adds the log call each record came from. Log calls in lvgl_json_renderer.c carry a
+site ID the generator derives from the call itself, so a source regenerated since the firmware was
+built still maps them as long as those calls are unchanged. Log calls outside the renderer record
+their __LINE__ (LVGL_JSON_LOG_CODE_LINE is set) and are not mapped.
+
+    python3 tools/lvgl_log_decode.py log.bin --source src/lvgl_json_renderer.c
+"""
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+# Keep in sync with lvgl_json_log_record_t in lvgl_json_renderer.h
+RECORD = struct.Struct('<IIdBBBB28s24s32s128s')
+LEVELS = ['NONE', 'ERROR', 'WARN', 'INFO', 'DEBUG']
+FLAG_TRUNCATED = 0x01
+CODE_LINE = 0x80000000
+SITE_RE = re.compile(r'\bLOG_\w+_ID\((0x[0-9a-fA-F]+),')
+FUNCTION_HEAD_RE = re.compile(r'^(?!typedef\b|return\b|else\b|if\b)[A-Za-z_][\w \t\*]*?\b([A-Za-z_]\w*)\s*\([^;]*$')
+VALUE_NONE, VALUE_NULL, VALUE_FALSE, VALUE_TRUE, VALUE_NUMBER, VALUE_STRING, VALUE_ARRAY, VALUE_OBJECT = range(8)
+
+
+def c_str(raw):
+    return raw.split(b'\0', 1)[0].decode('utf-8', errors='replace')
+
+
+def json_str(s, truncated=False):
+    text = json.dumps(s, ensure_ascii=False)
+    return text[:-1] + '..."' if truncated else text
+
+
+def format_value(value_type, number, value, truncated):
+    if value_type == VALUE_NULL:
+        return 'null'
+    if value_type == VALUE_FALSE:
+        return 'false'
+    if value_type == VALUE_TRUE:
+        return 'true'
+    if value_type == VALUE_NUMBER:
+        return '%g' % number
+    if value_type == VALUE_STRING:
+        return json_str(value, truncated)
+    if value_type == VALUE_ARRAY:
+        return '[...]'
+    if value_type == VALUE_OBJECT:
+        return '{"type": %s, ...}' % json_str(value, truncated) if value else '{...}'
+    return '?'
+
+
+def load_sites(path):
+    """Maps the site IDs of the log calls in `path` to 'file:line in function: call'."""
+    sites = {}
+    function = ''
+    name = os.path.basename(path)
+    with open(path, encoding='utf-8', errors='replace') as f:
+        for line_no, text in enumerate(f, 1):
+            head = FUNCTION_HEAD_RE.match(text)
+            if head:
+                function = head.group(1)
+            for m in SITE_RE.finditer(text):
+                sites[int(m.group(1), 16)] = '%s:%d in %s(): %s' % (name, line_no, function, text.strip())
+    return sites
+
+
+def format_record(fields, sites=None):
+    seq, code, number, level, value_type, flags, _, node_id, prop, value, message = fields
+    node_id, prop, value, message = c_str(node_id), c_str(prop), c_str(value), c_str(message)
+    level_name = LEVELS[level] if level < len(LEVELS) else '?'
+    if code & CODE_LINE:
+        line = '%s: [#%u line %u' % (level_name, seq, code & ~CODE_LINE)
+    else:
+        line = '%s: [#%u site %08x' % (level_name, seq, code)
+    if node_id:
+        line += " node '%s'" % node_id
+    line += '] ' + message
+    if value_type != VALUE_NONE:
+        snippet = (json_str(prop) + ': ') if prop else ''
+        snippet += format_value(value_type, number, value, bool(flags & FLAG_TRUNCATED))
+        line += ' [Near JSON: %s]' % snippet
+    if sites is not None and not code & CODE_LINE:
+        line += '\n    at: ' + sites.get(code, 'unknown site (source does not match the firmware)')
+    return line
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.strip().splitlines()[0])
+    parser.add_argument('dump', nargs='?', help='Raw record dump (default: stdin)')
+    parser.add_argument('--source', help='lvgl_json_renderer.c to show the log call of each record')
+    args = parser.parse_args()
+
+    data = open(args.dump, 'rb').read() if args.dump else sys.stdin.buffer.read()
+    sites = load_sites(args.source) if args.source else None
+
+    if len(data) % RECORD.size:
+        print('warning: %d trailing bytes ignored' % (len(data) % RECORD.size), file=sys.stderr)
+    expected_seq = None
+    for offset in range(0, len(data) - RECORD.size + 1, RECORD.size):
+        fields = RECORD.unpack_from(data, offset)
+        if expected_seq is not None and fields[0] != expected_seq:
+            print('... %d records dropped' % ((fields[0] - expected_seq) & 0xFFFFFFFF))
+        expected_seq = (fields[0] + 1) & 0xFFFFFFFF
+        print(format_record(fields, sites))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())